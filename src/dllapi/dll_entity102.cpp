@@ -110,3 +110,16 @@ bool DLL_IGES_ENTITY_102::AddSegment( DLL_IGES_CURVE& aSegment )
 
     return ((IGES_ENTITY_102*)m_entity)->AddSegment( (IGES_CURVE*) aSegment.GetRawPtr() );
 }
+
+
+bool DLL_IGES_ENTITY_102::GetCurves( size_t& aListSize, IGES_CURVE**& aCurveList )
+{
+    if( !m_valid || NULL == m_entity )
+    {
+        aListSize = 0;
+        aCurveList = NULL;
+        return false;
+    }
+
+    return ((IGES_ENTITY_102*)m_entity)->GetCurves( aListSize, aCurveList );
+}
@@ -0,0 +1,188 @@
+/*
+ * file: dll_entity106.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include <api/dll_entity106.h>
+#include <api/dll_iges.h>
+#include <core/iges.h>
+#include <core/entity106.h>
+
+
+DLL_IGES_ENTITY_106::DLL_IGES_ENTITY_106( IGES* aParent, bool create ) : DLL_IGES_CURVE( aParent )
+{
+    m_type = ENT_COPIOUS_DATA;
+
+    if( create )
+    {
+        if( NULL != aParent )
+            aParent->NewEntity( ENT_COPIOUS_DATA, &m_entity );
+        else
+            m_entity = new IGES_ENTITY_106( NULL );
+
+        if( NULL != m_entity )
+            m_entity->AttachValidFlag( &m_valid );
+    }
+
+    return;
+}
+
+
+DLL_IGES_ENTITY_106::DLL_IGES_ENTITY_106( DLL_IGES& aParent, bool create ) : DLL_IGES_CURVE( aParent )
+{
+    m_type = ENT_COPIOUS_DATA;
+    IGES* ip = aParent.GetRawPtr();
+
+    if( !create || NULL == ip )
+        return;
+
+    ip->NewEntity( ENT_COPIOUS_DATA, &m_entity );
+
+    if( NULL != m_entity )
+        m_entity->AttachValidFlag( &m_valid );
+
+    return;
+}
+
+
+DLL_IGES_ENTITY_106::~DLL_IGES_ENTITY_106()
+{
+    return;
+}
+
+
+bool DLL_IGES_ENTITY_106::NewEntity( void )
+{
+    if( m_valid && NULL != m_entity )
+    {
+        m_entity->DetachValidFlag( &m_valid );
+        m_entity = NULL;
+    }
+
+    if( NULL != m_parent && m_hasParent )
+        m_parent->NewEntity( ENT_COPIOUS_DATA, &m_entity );
+    else
+        m_entity = new IGES_ENTITY_106( NULL );
+
+    if( NULL != m_entity )
+    {
+        m_entity->AttachValidFlag(&m_valid);
+        return true;
+    }
+
+    return false;
+}
+
+
+bool DLL_IGES_ENTITY_106::GetZT( double& aZT )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    aZT = ((IGES_ENTITY_106*)m_entity)->ZT;
+    return true;
+}
+
+
+bool DLL_IGES_ENTITY_106::SetZT( double aZT )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    ((IGES_ENTITY_106*)m_entity)->ZT = aZT;
+    return true;
+}
+
+
+bool DLL_IGES_ENTITY_106::GetTupleSize( int& aTupleSize )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    aTupleSize = ((IGES_ENTITY_106*)m_entity)->GetTupleSize();
+    return true;
+}
+
+
+bool DLL_IGES_ENTITY_106::GetNPoints( int& aNPoints )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    aNPoints = ((IGES_ENTITY_106*)m_entity)->GetNPoints();
+    return true;
+}
+
+
+bool DLL_IGES_ENTITY_106::GetData( int& aNPoints, const double*& aData )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    return ((IGES_ENTITY_106*)m_entity)->GetData( aNPoints, aData );
+}
+
+
+bool DLL_IGES_ENTITY_106::SetData( int aNPoints, const double* aData )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    return ((IGES_ENTITY_106*)m_entity)->SetData( aNPoints, aData );
+}
+
+
+bool DLL_IGES_ENTITY_106::GetPoints( std::vector<MCAD_POINT>& aPoints, bool xform )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    return ((IGES_ENTITY_106*)m_entity)->GetPoints( aPoints, xform );
+}
+
+
+bool DLL_IGES_ENTITY_106::SetPoints( const std::vector<MCAD_POINT>& aPoints )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    return ((IGES_ENTITY_106*)m_entity)->SetPoints( aPoints );
+}
+
+
+bool DLL_IGES_ENTITY_106::GetPoint( int aIndex, MCAD_POINT& pt, bool xform )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    return ((IGES_ENTITY_106*)m_entity)->GetPoint( aIndex, pt, xform );
+}
+
+
+bool DLL_IGES_ENTITY_106::GetVector( int aIndex, MCAD_POINT& aVec )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    return ((IGES_ENTITY_106*)m_entity)->GetVector( aIndex, aVec );
+}
@@ -154,3 +154,21 @@ bool DLL_IGES_ENTITY_126::GetNormal( MCAD_POINT& aNorm )
     return ((IGES_ENTITY_126*)m_entity)->GetNormal( aNorm );
 }
 
+
+bool DLL_IGES_ENTITY_126::EvalPoints( int aNPoints, const double* aParams,
+    MCAD_POINT* aPoints, bool xform )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    return ((IGES_ENTITY_126*)m_entity)->EvalPoints( aNPoints, aParams, aPoints, xform );
+}
+
+
+bool DLL_IGES_ENTITY_126::GetBoundingBox( MCAD_POINT& aMin, MCAD_POINT& aMax, bool xform )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    return ((IGES_ENTITY_126*)m_entity)->GetBoundingBox( aMin, aMax, xform );
+}
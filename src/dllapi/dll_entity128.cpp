@@ -171,3 +171,35 @@ bool DLL_IGES_ENTITY_128::isPeriodic2( bool& aResult )
     aResult = ((IGES_ENTITY_128*)m_entity)->isPeriodic2();
     return true;
 }
+
+
+bool DLL_IGES_ENTITY_128::EvalPoints( int aNPoints, const double* aUParams,
+    const double* aVParams, MCAD_POINT* aPoints, bool xform )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    return ((IGES_ENTITY_128*)m_entity)->EvalPoints( aNPoints, aUParams, aVParams,
+        aPoints, xform );
+}
+
+
+bool DLL_IGES_ENTITY_128::GetBoundingBox( MCAD_POINT& aMin, MCAD_POINT& aMax, bool xform )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    return ((IGES_ENTITY_128*)m_entity)->GetBoundingBox( aMin, aMax, xform );
+}
+
+
+bool DLL_IGES_ENTITY_128::EvalGrid( int aNU, const double* aUParams, int aNV,
+    const double* aVParams, MCAD_POINT* aPoints, MCAD_POINT* aDerivU,
+    MCAD_POINT* aDerivV, bool xform )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    return ((IGES_ENTITY_128*)m_entity)->EvalGrid( aNU, aUParams, aNV, aVParams,
+        aPoints, aDerivU, aDerivV, xform );
+}
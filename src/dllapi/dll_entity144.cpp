@@ -204,3 +204,32 @@ bool DLL_IGES_ENTITY_144::DelCutout( DLL_IGES_ENTITY_142& aPtr )
 
     return ((IGES_ENTITY_144*)m_entity)->DelPTI( (IGES_ENTITY_142*) aPtr.GetRawPtr() );
 }
+
+
+bool DLL_IGES_ENTITY_144::SetTrimTolerance( double aTolerance )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    return ((IGES_ENTITY_144*)m_entity)->SetTrimTolerance( aTolerance );
+}
+
+
+bool DLL_IGES_ENTITY_144::ClassifyPoint( double aU, double aV, bool& aInside )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    return ((IGES_ENTITY_144*)m_entity)->ClassifyPoint( aU, aV, aInside );
+}
+
+
+bool DLL_IGES_ENTITY_144::ClassifyPoints( int aNPoints, const double* aUParams,
+    const double* aVParams, bool* aResult )
+{
+    if( !m_valid || NULL == m_entity )
+        return false;
+
+    return ((IGES_ENTITY_144*)m_entity)->ClassifyPoints( aNPoints, aUParams,
+        aVParams, aResult );
+}
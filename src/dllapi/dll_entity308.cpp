@@ -113,26 +113,7 @@ bool DLL_IGES_ENTITY_308::GetDEList( size_t& aDESize, IGES_ENTITY**& aDEList )
         return false;
     }
 
-    std::list< IGES_ENTITY* >* pDE = &((IGES_ENTITY_308*)m_entity)->DE;
-    std::vector< IGES_ENTITY* >* pvDE = &((IGES_ENTITY_308*)m_entity)->m_DE;
-
-    if( pDE->size() != pvDE->size() )
-    {
-        pvDE->clear();
-
-        std::list< IGES_ENTITY* >::iterator sDL = pDE->begin();
-        std::list< IGES_ENTITY* >::iterator eDL = pDE->end();
-
-        while( sDL != eDL )
-        {
-            pvDE->push_back( *sDL );
-            ++sDL;
-        }
-    }
-
-    aDESize = pvDE->size();
-    aDEList = &((*pvDE)[0]);
-    return true;
+    return ((IGES_ENTITY_308*)m_entity)->GetDEList( aDESize, aDEList );
 }
 
 
@@ -189,15 +170,15 @@ bool DLL_IGES_ENTITY_308::GetName( const char*& aName )
     if( !m_valid || NULL == m_entity )
         return false;
 
-    std::string* sp = &((IGES_ENTITY_308*)m_entity)->NAME;
+    const std::string& name = ((IGES_ENTITY_308*)m_entity)->GetName();
 
-    if( sp->empty() )
+    if( name.empty() )
     {
         aName = NULL;
         return false;
     }
 
-    aName = sp->c_str();
+    aName = name.c_str();
     return true;
 }
 
@@ -208,9 +189,9 @@ bool DLL_IGES_ENTITY_308::SetName( const char* aName )
         return false;
 
     if( NULL == aName )
-        ((IGES_ENTITY_308*)m_entity)->NAME = "";
+        ((IGES_ENTITY_308*)m_entity)->SetName( "" );
     else
-        ((IGES_ENTITY_308*)m_entity)->NAME = aName;
+        ((IGES_ENTITY_308*)m_entity)->SetName( aName );
 
     return true;
 }
@@ -120,16 +120,122 @@ bool DLL_IGES::Read( const char* aFileName )
 }
 
 
-bool DLL_IGES::Write( const char* aFileName, bool fOverwrite )
+bool DLL_IGES::Write( const char* aFileName, bool fOverwrite, bool fSync )
 {
     if( m_valid && NULL != m_iges )
-        return m_iges->Write( aFileName, fOverwrite );
+        return m_iges->Write( aFileName, fOverwrite, fSync );
 
     ERRMSG << "\n + [BUG] invoked with invalid IGES object\n";
     return false;
 }
 
 
+bool DLL_IGES::WriteLinked( const char* aFileName, bool fOverwrite, int aMaxLines )
+{
+    if( m_valid && NULL != m_iges )
+        return m_iges->WriteLinked( aFileName, fOverwrite, aMaxLines );
+
+    ERRMSG << "\n + [BUG] invoked with invalid IGES object\n";
+    return false;
+}
+
+
+bool DLL_IGES::SetNThreads( int aNThreads )
+{
+    if( !m_valid || NULL == m_iges )
+    {
+        ERRMSG << "\n + [BUG] invoked with invalid IGES object\n";
+        return false;
+    }
+
+    m_iges->SetNThreads( aNThreads );
+    return true;
+}
+
+
+bool DLL_IGES::GetNThreads( int& aNThreads )
+{
+    if( !m_valid || NULL == m_iges )
+    {
+        ERRMSG << "\n + [BUG] invoked with invalid IGES object\n";
+        aNThreads = 0;
+        return false;
+    }
+
+    aNThreads = m_iges->GetNThreads();
+    return true;
+}
+
+
+bool DLL_IGES::SetDependencyOrder( bool aOrdered )
+{
+    if( !m_valid || NULL == m_iges )
+    {
+        ERRMSG << "\n + [BUG] invoked with invalid IGES object\n";
+        return false;
+    }
+
+    m_iges->SetDependencyOrder( aOrdered );
+    return true;
+}
+
+
+bool DLL_IGES::GetDependencyOrder( bool& aOrdered )
+{
+    if( !m_valid || NULL == m_iges )
+    {
+        ERRMSG << "\n + [BUG] invoked with invalid IGES object\n";
+        aOrdered = false;
+        return false;
+    }
+
+    aOrdered = m_iges->GetDependencyOrder();
+    return true;
+}
+
+
+bool DLL_IGES::SetPipelinedRead( bool aPipelined )
+{
+    if( !m_valid || NULL == m_iges )
+    {
+        ERRMSG << "\n + [BUG] invoked with invalid IGES object\n";
+        return false;
+    }
+
+    m_iges->SetPipelinedRead( aPipelined );
+    return true;
+}
+
+
+bool DLL_IGES::GetPipelinedRead( bool& aPipelined )
+{
+    if( !m_valid || NULL == m_iges )
+    {
+        ERRMSG << "\n + [BUG] invoked with invalid IGES object\n";
+        aPipelined = false;
+        return false;
+    }
+
+    aPipelined = m_iges->GetPipelinedRead();
+    return true;
+}
+
+
+bool DLL_IGES::GetMemoryStats( size_t& aNTypes, IGES_MEMORY_STATS const*& aStats,
+                               IGES_MEMORY_STATS& aTotal )
+{
+    if( !m_valid || NULL == m_iges )
+    {
+        ERRMSG << "\n + [BUG] invoked with invalid IGES object\n";
+        aNTypes = 0;
+        aStats = NULL;
+        return false;
+    }
+
+    return m_iges->GetMemoryStats( aNTypes, aStats, aTotal );
+}
+
+
 bool DLL_IGES::Export( DLL_IGES* newParent, IGES_ENTITY_308** packagedEntity )
 {
     if( NULL == newParent )
@@ -165,6 +271,16 @@ bool DLL_IGES::Export( IGES* newParent, IGES_ENTITY_308** packagedEntity )
 }
 
 
+bool DLL_IGES::BuildAssembly( const IGES_ASSEMBLY_PART* aParts, size_t aNParts )
+{
+    if( m_valid && NULL != m_iges )
+        return m_iges->BuildAssembly( aParts, aNParts );
+
+    ERRMSG << "\n + [BUG] invoked with invalid IGES object\n";
+    return false;
+}
+
+
 char* DLL_IGES::GetNewPartName( void )
 {
     if( m_valid && NULL != m_iges )
@@ -245,6 +361,10 @@ bool DLL_IGES::NewAPIEntity( IGES_ENTITY_TYPE aEntityType, DLL_IGES_ENTITY*& aEn
         aEntityPointer = new DLL_IGES_ENTITY_104( this->m_iges, true );
         break;
 
+    case ENT_COPIOUS_DATA:
+        aEntityPointer = new DLL_IGES_ENTITY_106( this->m_iges, true );
+        break;
+
     case ENT_LINE:
         aEntityPointer = new DLL_IGES_ENTITY_110( this->m_iges, true );
         break;
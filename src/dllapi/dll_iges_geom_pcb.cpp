@@ -142,6 +142,26 @@ bool DLL_IGES_GEOM_PCB::GetVerticalSurface( IGES* aModel, bool& error,
 }
 
 
+void DLL_IGES_GEOM_PCB::SetJoinCurves( bool aJoin )
+{
+    if( NULL == m_outline || !m_valid )
+        return;
+
+    ((IGES_GEOM_PCB*)m_outline)->SetJoinCurves( aJoin );
+    return;
+}
+
+
+void DLL_IGES_GEOM_PCB::SetExtrudeLoops( bool aExtrude )
+{
+    if( NULL == m_outline || !m_valid )
+        return;
+
+    ((IGES_GEOM_PCB*)m_outline)->SetExtrudeLoops( aExtrude );
+    return;
+}
+
+
 bool DLL_IGES_GEOM_PCB::GetTrimmedPlane( IGES* aModel, bool& error,
     IGES_ENTITY_144**& aSurfaceList,
     int& nSurfaces, double aHeight, bool aReverse )
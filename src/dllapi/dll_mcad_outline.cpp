@@ -261,6 +261,16 @@ void DLL_MCAD_OUTLINE::ClearErrors( void )
 }
 
 
+void DLL_MCAD_OUTLINE::SetFastCutouts( bool aEnable )
+{
+    if( NULL == m_outline || !m_valid )
+        return;
+
+    m_outline->SetFastCutouts( aEnable );
+    return;
+}
+
+
 bool DLL_MCAD_OUTLINE::IsClosed( bool& aResult )
 {
     if( NULL == m_outline || !m_valid )
@@ -470,3 +480,12 @@ bool DLL_MCAD_OUTLINE::AddCutout( DLL_MCAD_SEGMENT& aCircle, bool overlaps, bool
 
     return false;
 }
+
+
+bool DLL_MCAD_OUTLINE::Simplify( double aTolerance, bool& error )
+{
+    if( NULL == m_outline || !m_valid )
+        return false;
+
+    return m_outline->Simplify( aTolerance, error );
+}
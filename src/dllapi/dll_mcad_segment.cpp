@@ -308,22 +308,18 @@ bool DLL_MCAD_SEGMENT::GetIntersections( MCAD_SEGMENT const* aSegment,
         return false;
     }
 
-    std::list<MCAD_POINT> ilist;
+    MCAD_INTERSECTIONS result;
+    bool ok = m_segment->GetIntersections( *aSegment, result );
+    flags = result.flags;
 
-    if( !m_segment->GetIntersections( *aSegment, ilist, flags ) )
+    if( !ok )
         return false;
 
-    aNumIntersections = (int)ilist.size();
+    aNumIntersections = result.npoints;
     aIntersectList = new MCAD_POINT[aNumIntersections];
-    std::list<MCAD_POINT>::iterator sL = ilist.begin();
-    std::list<MCAD_POINT>::iterator eL = ilist.end();
-    int idx = 0;
 
-    while( sL != eL )
-    {
-        aIntersectList[idx++] = *sL;
-        ++sL;
-    }
+    for( int i = 0; i < result.npoints; ++i )
+        aIntersectList[i] = result.points[i];
 
     return true;
 }
@@ -346,24 +342,49 @@ bool DLL_MCAD_SEGMENT::GetIntersections( DLL_MCAD_SEGMENT& aSegment,
         return false;
     }
 
-    std::list<MCAD_POINT> ilist;
+    MCAD_INTERSECTIONS result;
+    bool ok = m_segment->GetIntersections( *aSegment.GetRawPtr(), result );
+    flags = result.flags;
 
-    if( !m_segment->GetIntersections( *aSegment.GetRawPtr(), ilist, flags ) )
+    if( !ok )
         return false;
 
-    aNumIntersections = (int)ilist.size();
+    aNumIntersections = result.npoints;
     aIntersectList = new MCAD_POINT[aNumIntersections];
-    std::list<MCAD_POINT>::iterator sL = ilist.begin();
-    std::list<MCAD_POINT>::iterator eL = ilist.end();
-    int idx = 0;
 
-    while( sL != eL )
+    for( int i = 0; i < result.npoints; ++i )
+        aIntersectList[i] = result.points[i];
+
+    return true;
+}
+
+
+bool DLL_MCAD_SEGMENT::GetIntersections( MCAD_SEGMENT const* aSegment,
+    MCAD_INTERSECTIONS& aResult )
+{
+    aResult.npoints = 0;
+    aResult.flags = MCAD_IFLAG_NONE;
+
+    if( NULL == m_segment || !m_valid )
     {
-        aIntersectList[idx++] = *sL;
-        ++sL;
+        ERRMSG << "\n + [BUG] invalid segment\n";
+        return false;
     }
 
-    return true;
+    if( NULL == aSegment )
+    {
+        ERRMSG << "\n + [BUG] invoked with NULL pointer for aSegment\n";
+        return false;
+    }
+
+    return m_segment->GetIntersections( *aSegment, aResult );
+}
+
+
+bool DLL_MCAD_SEGMENT::GetIntersections( DLL_MCAD_SEGMENT& aSegment,
+    MCAD_INTERSECTIONS& aResult )
+{
+    return GetIntersections( aSegment.GetRawPtr(), aResult );
 }
 
 
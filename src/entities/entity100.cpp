@@ -26,9 +26,15 @@
 
 #include <sstream>
 #include <cmath>
+// Windows doesn't have M_PI in cmath
+#ifndef M_PI
+    #define M_PI 3.1415926535897932384626433832795
+#endif
+
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <geom/mcad_helpers.h>
 #include <core/entity100.h>
 #include <core/entity124.h>
@@ -414,6 +420,14 @@ bool IGES_ENTITY_100::rescale( double sf )
 }
 
 
+void IGES_ENTITY_100::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+    return;
+}
+
+
 bool IGES_ENTITY_100::GetStartPoint( MCAD_POINT& pt, bool xform )
 {
     pt.x = xStart;
@@ -478,3 +492,62 @@ IGES_CURVE* IGES_ENTITY_100::GetCurve( int index )
 {
     return NULL;
 }
+
+
+bool IGES_ENTITY_100::GetPolyline( double aTolerance, std::vector<MCAD_POINT>& aPoints,
+                                   bool xform )
+{
+    if( aTolerance <= 0.0 )
+    {
+        ERRMSG << "\n + [INFO] invalid tolerance (" << aTolerance << ")\n";
+        return false;
+    }
+
+    double dx = xStart - xCenter;
+    double dy = yStart - yCenter;
+    double r = sqrt( dx * dx + dy * dy );
+    double a0 = atan2( dy, dx );
+    double a1 = atan2( yEnd - yCenter, xEnd - xCenter );
+
+    // the arc runs counterclockwise; coincident end points represent a circle
+    if( a1 <= a0 )
+        a1 += 2.0 * M_PI;
+
+    // largest angular step for which the sagitta is within the tolerance
+    double da = M_PI * 0.5;
+
+    if( aTolerance < r )
+    {
+        double ta = 2.0 * acos( 1.0 - aTolerance / r );
+
+        if( ta < da )
+            da = ta;
+    }
+
+    int ns = (int)ceil( ( a1 - a0 ) / da );
+
+    if( ns < 1 )
+        ns = 1;
+
+    size_t first = aPoints.size();
+    aPoints.push_back( MCAD_POINT( xStart, yStart, zOffset ) );
+
+    for( int i = 1; i < ns; ++i )
+    {
+        double ang = a0 + ( a1 - a0 ) * i / ns;
+        aPoints.push_back( MCAD_POINT( xCenter + r * cos( ang ),
+                                       yCenter + r * sin( ang ), zOffset ) );
+    }
+
+    aPoints.push_back( MCAD_POINT( xEnd, yEnd, zOffset ) );
+
+    if( xform && pTransform )
+    {
+        MCAD_TRANSFORM T = pTransform->GetTransformMatrix();
+
+        for( size_t i = first; i < aPoints.size(); ++i )
+            aPoints[i] = T * aPoints[i];
+    }
+
+    return true;
+}
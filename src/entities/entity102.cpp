@@ -36,6 +36,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <geom/mcad_helpers.h>
 #include <core/all_entities.h>
 
@@ -54,8 +55,8 @@ IGES_ENTITY_102::~IGES_ENTITY_102()
 {
     if( !curves.empty() )
     {
-        std::list<IGES_CURVE*>::iterator rbeg = curves.begin();
-        std::list<IGES_CURVE*>::iterator rend = curves.end();
+        IGES_CHILDREN<IGES_CURVE>::iterator rbeg = curves.begin();
+        IGES_CHILDREN<IGES_CURVE>::iterator rend = curves.end();
 
         while( rbeg != rend )
         {
@@ -182,9 +183,9 @@ bool IGES_ENTITY_102::associate(std::vector<IGES_ENTITY *> *entities)
     //     + May not consist of a single Point or Connect Point entity
     //
 
-    std::list<IGES_CURVE*>::iterator sp = curves.begin();
-    std::list<IGES_CURVE*>::iterator ep = curves.end();
-    std::list<IGES_CURVE*>::iterator pp;   // iterator to previous item
+    IGES_CHILDREN<IGES_CURVE>::iterator sp = curves.begin();
+    IGES_CHILDREN<IGES_CURVE>::iterator ep = curves.end();
+    IGES_CHILDREN<IGES_CURVE>::iterator pp;   // iterator to previous item
     int acc = 0;
     int jEnt = 0;
 
@@ -197,7 +198,7 @@ bool IGES_ENTITY_102::associate(std::vector<IGES_ENTITY *> *entities)
      * 116 *ENT_POINT
      * 126 ENT_NURBS_CURVE
      * 132 *ENT_CONNECT_POINT
-     * 106 ENT_COPIOUS_DATA FORMS: (Due to complexity, postpone any implementation of this)
+     * 106 ENT_COPIOUS_DATA FORMS:
      *        1, 2, 3
      *        11, 12, 13
      *        63
@@ -215,6 +216,13 @@ bool IGES_ENTITY_102::associate(std::vector<IGES_ENTITY *> *entities)
             cerr << iEnt << ") in Composite Curve\n";
             ok = false;
         }
+        else if( 106 == iEnt && !((IGES_ENTITY_106*)(*sp))->IsLinearPath()
+                 && !((IGES_ENTITY_106*)(*sp))->IsPointSet() )
+        {
+            ERRMSG << "\n + [INFO] Unsupported Copious Data Form (";
+            cerr << (*sp)->GetEntityForm() << ") in Composite Curve\n";
+            ok = false;
+        }
 
         // note: the specification is not very clear on this issue;
         // the specification prohibits 2 consecutive Entity 116 and
@@ -301,6 +309,24 @@ bool IGES_ENTITY_102::associate(std::vector<IGES_ENTITY *> *entities)
 }
 
 
+void IGES_ENTITY_102::getRefIndices( std::vector<int>& aList )
+{
+    std::list<int>::const_iterator sCur = iCurves.begin();
+    std::list<int>::const_iterator eCur = iCurves.end();
+
+    while( sCur != eCur )
+    {
+        if( *sCur > 0 )
+            aList.push_back( *sCur >> 1 );
+
+        ++sCur;
+    }
+
+    IGES_ENTITY::getRefIndices( aList );
+    return;
+}
+
+
 bool IGES_ENTITY_102::format( int &index )
 {
     pdout.clear();
@@ -328,8 +354,8 @@ bool IGES_ENTITY_102::format( int &index )
     string lstr = ostr.str();
     string tstr;
 
-    std::list<IGES_CURVE*>::iterator scur = curves.begin();
-    std::list<IGES_CURVE*>::iterator ecur = curves.end();
+    IGES_CHILDREN<IGES_CURVE>::iterator scur = curves.begin();
+    IGES_CHILDREN<IGES_CURVE>::iterator ecur = curves.end();
 
     while( scur != ecur )
     {
@@ -394,6 +420,14 @@ bool IGES_ENTITY_102::rescale( double sf )
 }
 
 
+void IGES_ENTITY_102::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize() + HeapSize( iCurves ) + curves.GetHeapSize();
+    return;
+}
+
+
 bool IGES_ENTITY_102::unlink(IGES_ENTITY *aChildEntity)
 {
     if(IGES_ENTITY::unlink(aChildEntity) )
@@ -402,8 +436,8 @@ bool IGES_ENTITY_102::unlink(IGES_ENTITY *aChildEntity)
     // check the list of curves; if one is unlinked and it
     // is not a terminal entity then we must relinquish
     // links to all entities
-    std::list<IGES_CURVE*>::iterator sp = curves.begin();
-    std::list<IGES_CURVE*>::iterator ep = curves.end();
+    IGES_CHILDREN<IGES_CURVE>::iterator sp = curves.begin();
+    IGES_CHILDREN<IGES_CURVE>::iterator ep = curves.end();
 
     bool clear_all = false;
 
@@ -411,10 +445,10 @@ bool IGES_ENTITY_102::unlink(IGES_ENTITY *aChildEntity)
     {
         if( aChildEntity == *sp )
         {
-            if( sp != curves.begin() && sp != (--(curves.end())) )
+            if( sp != curves.begin() && sp != curves.end() - 1 )
                 clear_all = true;
 
-            sp = curves.erase( sp );
+            curves.erase( *sp );
             break;
         }
 
@@ -605,6 +639,7 @@ bool IGES_ENTITY_102::SetEntityForm( int aForm )
 bool IGES_ENTITY_102::SetHierarchy( IGES_STAT_HIER aHierarchy )
 {
     hierarchy = aHierarchy;
+    updateDE();
     return true;
 }
 
@@ -623,12 +658,22 @@ IGES_CURVE* IGES_ENTITY_102::GetCurve( int index )
         return NULL;
     }
 
-    std::list<IGES_CURVE*>::iterator sl = curves.begin();
+    return curves[index];
+}
+
 
-    for( int i = 0; i < index; ++i )
-        ++sl;
+bool IGES_ENTITY_102::GetCurves( size_t& aListSize, IGES_CURVE**& aCurveList )
+{
+    if( curves.empty() )
+    {
+        aListSize = 0;
+        aCurveList = NULL;
+        return false;
+    }
 
-    return *sl;
+    aListSize = curves.size();
+    aCurveList = curves.data();
+    return true;
 }
 
 
@@ -637,7 +682,7 @@ bool IGES_ENTITY_102::GetStartPoint( MCAD_POINT& pt, bool xform )
     if( curves.empty() )
         return false;
 
-    std::list<IGES_CURVE*>::iterator sc = curves.begin();
+    IGES_CHILDREN<IGES_CURVE>::iterator sc = curves.begin();
 
     if( !(*sc)->GetStartPoint( pt, xform ) )
         return false;
@@ -654,7 +699,7 @@ bool IGES_ENTITY_102::GetEndPoint( MCAD_POINT& pt, bool xform )
     if( curves.empty() )
         return false;
 
-    std::list<IGES_CURVE*>::reverse_iterator sc = curves.rbegin();
+    IGES_CHILDREN<IGES_CURVE>::reverse_iterator sc = curves.rbegin();
 
     if( !(*sc)->GetEndPoint( pt, xform ) )
         return false;
@@ -672,14 +717,57 @@ int IGES_ENTITY_102::GetNSegments( void )
 }
 
 
+bool IGES_ENTITY_102::GetPolyline( double aTolerance, std::vector<MCAD_POINT>& aPoints,
+                                   bool xform )
+{
+    if( curves.empty() )
+        return false;
+
+    size_t first = aPoints.size();
+    std::vector<MCAD_POINT> pts;
+    IGES_CHILDREN<IGES_CURVE>::iterator sc = curves.begin();
+    IGES_CHILDREN<IGES_CURVE>::iterator ec = curves.end();
+
+    while( sc != ec )
+    {
+        pts.clear();
+
+        if( !(*sc)->GetPolyline( aTolerance, pts, xform ) )
+        {
+            ERRMSG << "\n + [INFO] could not approximate a segment of the compound curve\n";
+            aPoints.resize( first );
+            return false;
+        }
+
+        // each segment starts at the end of the previous segment
+        size_t i = ( aPoints.size() > first && !pts.empty() ) ? 1 : 0;
+
+        for( ; i < pts.size(); ++i )
+            aPoints.push_back( pts[i] );
+
+        ++sc;
+    }
+
+    if( xform && pTransform )
+    {
+        MCAD_TRANSFORM T = pTransform->GetTransformMatrix();
+
+        for( size_t i = first; i < aPoints.size(); ++i )
+            aPoints[i] = T * aPoints[i];
+    }
+
+    return true;
+}
+
+
 bool IGES_ENTITY_102::IsClosed( void )
 {
     if( curves.empty() )
         return false;
 
-    std::list<IGES_CURVE*>::iterator sc = curves.begin();
-    std::list<IGES_CURVE*>::iterator ec = curves.end();
-    std::list<IGES_CURVE*>::reverse_iterator lc = curves.rbegin();
+    IGES_CHILDREN<IGES_CURVE>::iterator sc = curves.begin();
+    IGES_CHILDREN<IGES_CURVE>::iterator ec = curves.end();
+    IGES_CHILDREN<IGES_CURVE>::reverse_iterator lc = curves.rbegin();
 
     // we require at least 1 item which reports segments > 0
     if( curves.size() == 1 && (*sc)->GetEntityType() != ENT_CIRCULAR_ARC )
@@ -734,6 +822,17 @@ bool IGES_ENTITY_102::AddSegment( IGES_CURVE* aSegment )
         return false;
     }
 
+    // only the point sets and piecewise linear curves of Copious Data
+    // may be segments; the annotation Forms are not curves
+    if( aSegment->GetEntityType() == ENT_COPIOUS_DATA
+        && !((IGES_ENTITY_106*)aSegment)->IsLinearPath()
+        && !((IGES_ENTITY_106*)aSegment)->IsPointSet() )
+    {
+        ERRMSG << "\n + [VIOLATION] Copious Data Form " << aSegment->GetEntityForm();
+        cerr << " is not a curve\n";
+        return false;
+    }
+
     if( !curves.empty() && IsClosed() )
     {
         ERRMSG << "\n + [ERROR] curve is aready closed\n";
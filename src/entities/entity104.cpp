@@ -29,6 +29,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <geom/mcad_helpers.h>
 #include <core/entity104.h>
 #include <core/entity124.h>
@@ -342,6 +343,7 @@ bool IGES_ENTITY_104::SetEntityForm( int aForm )
     }
 
     form = aForm;
+    updateDE();
     return true;
 }
 
@@ -372,6 +374,14 @@ bool IGES_ENTITY_104::rescale( double sf )
 }
 
 
+void IGES_ENTITY_104::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+    return;
+}
+
+
 bool IGES_ENTITY_104::GetStartPoint( MCAD_POINT& pt, bool xform )
 {
     pt.x = X1;
@@ -0,0 +1,629 @@
+/*
+ * file: entity106.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: IGES Entity 106: Copious Data, Sections 4.6 (Forms 1..3),
+ * 4.7 (Linear Path, Forms 11..13) and 4.11 (Simple Closed Planar Curve,
+ * Form 63)
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <sstream>
+#include <error_macros.h>
+#include <core/iges.h>
+#include <core/iges_io.h>
+#include <core/iges_memory.h>
+#include <core/entity106.h>
+#include <core/entity124.h>
+
+using namespace std;
+
+
+static bool checkForm106( int aForm )
+{
+    switch( aForm )
+    {
+        case 1:
+        case 2:
+        case 3:
+        case 11:
+        case 12:
+        case 13:
+        case 20:
+        case 21:
+        case 31:
+        case 32:
+        case 33:
+        case 34:
+        case 35:
+        case 36:
+        case 37:
+        case 38:
+        case 40:
+        case 63:
+            return true;
+
+        default:
+            break;
+    }
+
+    return false;
+}
+
+
+static int tupleSize106( int aIP )
+{
+    static const int ts[4] = { 0, 2, 3, 6 };
+
+    if( aIP < 1 || aIP > 3 )
+        return 0;
+
+    return ts[aIP];
+}
+
+
+IGES_ENTITY_106::IGES_ENTITY_106( IGES* aParent ) : IGES_CURVE( aParent )
+{
+    entityType = 106;
+    form = 12;
+    ZT = 0.0;
+    return;
+}
+
+
+IGES_ENTITY_106::~IGES_ENTITY_106()
+{
+    return;
+}
+
+
+bool IGES_ENTITY_106::associate(std::vector<IGES_ENTITY *> *entities)
+{
+    if( !IGES_ENTITY::associate(entities) )
+    {
+        ERRMSG << "\n + [INFO] failed to establish associations\n";
+        return false;
+    }
+
+    if( pStructure )
+    {
+        ERRMSG << "\n + [VIOLATION] Structure entity is set\n";
+        pStructure->delReference(this);
+        pStructure = NULL;
+    }
+
+    return true;
+}
+
+
+bool IGES_ENTITY_106::format( int &index )
+{
+    pdout.clear();
+    iExtras.clear();
+
+    if( index < 1 || index > 9999999 )
+    {
+        ERRMSG << "\n + [INFO] invalid Parameter Data Sequence Number\n";
+        return false;
+    }
+
+    if( data.empty() )
+    {
+        ERRMSG << "\n + [INFO] no Copious Data points\n";
+        return false;
+    }
+
+    parameterData = index;
+
+    if( !parent )
+    {
+        ERRMSG << "\n + [INFO] method invoked with no parent IGES object\n";
+        return false;
+    }
+
+    char pd = parent->globalData.pdelim;
+    char rd = parent->globalData.rdelim;
+    double uir = parent->globalData.minResolution;
+    int ip = GetIP();
+
+    ostringstream ostr;
+    ostr << entityType << pd;
+    ostr << ip << pd;
+    ostr << GetNPoints() << pd;
+    string lstr = ostr.str();
+    string tstr;
+
+    if( 1 == ip )
+    {
+        if( !FormatPDREal( tstr, ZT, pd, uir ) )
+        {
+            ERRMSG << "\n + [INFO] could not format ZT\n";
+            return false;
+        }
+
+        AddPDItem( tstr, lstr, pdout, index, sequenceNumber, pd, rd );
+    }
+
+    size_t nd = data.size();
+
+    for( size_t i = 0; i < nd; ++i )
+    {
+        char delim = ( i + 1 == nd && extras.empty() ) ? rd : pd;
+
+        if( !FormatPDREal( tstr, data[i], delim, uir ) )
+        {
+            ERRMSG << "\n + [INFO] could not format Copious Data datum [";
+            cerr << i << "]\n";
+            return false;
+        }
+
+        AddPDItem( tstr, lstr, pdout, index, sequenceNumber, pd, rd );
+    }
+
+    if( !extras.empty() && !formatExtraParams( lstr, index, pd, rd ) )
+    {
+        ERRMSG << "\n + [INFO] could not format optional parameters\n";
+        pdout.clear();
+        iExtras.clear();
+        return false;
+    }
+
+    if( !formatComments( index ) )
+    {
+        ERRMSG << "\n + [INFO] could not format comments\n";
+        pdout.clear();
+        return false;
+    }
+
+    paramLineCount = index - parameterData;
+
+    return true;
+}
+
+
+bool IGES_ENTITY_106::rescale( double sf )
+{
+    // the vectors associated with points (IP = 3) are directions
+    // and are not scaled
+    int ts = GetTupleSize();
+    size_t nd = data.size();
+
+    for( size_t i = 0; i < nd; i += ts )
+    {
+        data[i] *= sf;
+        data[i + 1] *= sf;
+
+        if( ts > 2 )
+            data[i + 2] *= sf;
+    }
+
+    ZT *= sf;
+    return true;
+}
+
+
+void IGES_ENTITY_106::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize() + HeapSize( data );
+    return;
+}
+
+
+bool IGES_ENTITY_106::unlink(IGES_ENTITY *aChildEntity)
+{
+    return IGES_ENTITY::unlink(aChildEntity);
+}
+
+
+bool IGES_ENTITY_106::isOrphaned( void )
+{
+    // an unsupported Form read from a file is discarded
+    if( !checkForm106( form ) )
+        return true;
+
+    if( refs.empty() && depends != STAT_INDEPENDENT )
+        return true;
+
+    return false;
+}
+
+
+bool IGES_ENTITY_106::addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate)
+{
+    return IGES_ENTITY::addReference(aParentEntity, isDuplicate);
+}
+
+
+bool IGES_ENTITY_106::delReference(IGES_ENTITY *aParentEntity)
+{
+    return IGES_ENTITY::delReference(aParentEntity);
+}
+
+
+bool IGES_ENTITY_106::readDE(IGES_RECORD *aRecord, std::ifstream &aFile, int &aSequenceVar)
+{
+    if( !IGES_ENTITY::readDE(aRecord, aFile, aSequenceVar) )
+    {
+        ERRMSG << "\n + [INFO] failed to read Directory Entry\n";
+        return false;
+    }
+
+    structure = 0;                  // N.A.
+    hierarchy = STAT_HIER_ALL_SUB;  // field ignored
+
+    // an unsupported Form is kept as an unsupported entity; its
+    // parameters are not interpreted and it is culled after reading
+    if( !checkForm106( form ) )
+    {
+        ERRMSG << "\n + [WARNING] unsupported Form Number (" << form;
+        cerr << ") in Copious Data; the entity will be discarded\n";
+        cerr << " + DE: " << aRecord->index << "\n";
+    }
+
+    return true;
+}
+
+
+bool IGES_ENTITY_106::readPD(std::ifstream &aFile, int &aSequenceVar)
+{
+    if( !IGES_ENTITY::readPD(aFile, aSequenceVar) )
+    {
+        ERRMSG << "\n + [INFO] could not read data for Copious Data Entity\n";
+        pdout.clear();
+        return false;
+    }
+
+    if( !checkForm106( form ) )
+    {
+        pdout.clear();
+        return true;
+    }
+
+    int idx;
+    bool eor = false;
+    char pd = parent->globalData.pdelim;
+    char rd = parent->globalData.rdelim;
+
+    idx = (int)pdout.find( pd );
+
+    if( idx < 1 || idx > 8 )
+    {
+        ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
+        cerr << idx << ")\n";
+        pdout.clear();
+        return false;
+    }
+
+    ++idx;
+
+    int ip;
+    int np;
+
+    if( !ParseInt( pdout, idx, ip, eor, pd, rd ) )
+    {
+        ERRMSG << "\n + [BAD FILE] no IP value for Copious Data Entity\n";
+        pdout.clear();
+        return false;
+    }
+
+    if( ip != GetIP() )
+    {
+        ERRMSG << "\n + [CORRUPT FILE] IP (" << ip << ") does not match Form ";
+        cerr << form << " of Copious Data Entity\n";
+        pdout.clear();
+        return false;
+    }
+
+    if( !ParseInt( pdout, idx, np, eor, pd, rd ) )
+    {
+        ERRMSG << "\n + [BAD FILE] no N value for Copious Data Entity\n";
+        pdout.clear();
+        return false;
+    }
+
+    if( np < 1 || ( IsLinearPath() && np < 2 ) )
+    {
+        ERRMSG << "\n + [CORRUPT FILE] invalid number of points (" << np;
+        cerr << ") in Copious Data Entity\n";
+        pdout.clear();
+        return false;
+    }
+
+    if( 1 == ip && !ParseReal( pdout, idx, ZT, eor, pd, rd ) )
+    {
+        ERRMSG << "\n + [BAD FILE] no ZT value for Copious Data Entity\n";
+        pdout.clear();
+        return false;
+    }
+
+    size_t nd = (size_t)np * tupleSize106( ip );
+    data.resize( nd );
+
+    for( size_t i = 0; i < nd; ++i )
+    {
+        if( !ParseReal( pdout, idx, data[i], eor, pd, rd ) )
+        {
+            ERRMSG << "\n + [BAD FILE] missing datum (" << i << " of " << nd;
+            cerr << ") for Copious Data Entity\n";
+            data.clear();
+            pdout.clear();
+            return false;
+        }
+    }
+
+    if( 63 == form && ( data[0] != data[nd - 2] || data[1] != data[nd - 1] ) )
+        ERRMSG << "\n + [VIOLATION] the last point of a Closed Planar Curve is not the first point\n";
+
+    if( !eor && !readExtraParams( idx ) )
+    {
+        ERRMSG << "\n + [BAD FILE] could not read optional pointers\n";
+        pdout.clear();
+        return false;
+    }
+
+    if( !readComments( idx ) )
+    {
+        ERRMSG << "\n + [BAD FILE] could not read extra comments\n";
+        pdout.clear();
+        return false;
+    }
+
+    pdout.clear();
+    return true;
+}
+
+
+bool IGES_ENTITY_106::SetEntityForm( int aForm )
+{
+    if( !checkForm106( aForm ) )
+    {
+        ERRMSG << "\n + [BUG] unsupported Copious Data Form (";
+        cerr << aForm << ")\n";
+        return false;
+    }
+
+    int ip = GetIP();
+    form = aForm;
+
+    // the existing tuples cannot be interpreted under a different IP
+    if( ip != GetIP() )
+        data.clear();
+
+    updateDE();
+    return true;
+}
+
+
+bool IGES_ENTITY_106::SetHierarchy( IGES_STAT_HIER aHierarchy )
+{
+    ERRMSG << "\n + [WARNING] [BUG] hierarchy is not supported by the Copious Data Entity\n";
+    return true;
+}
+
+
+int IGES_ENTITY_106::GetIP( void ) const
+{
+    // all forms other than 2, 3, 12 and 13 consist of (x, y) pairs
+    return ( form < 20 ) ? form % 10 : 1;
+}
+
+
+int IGES_ENTITY_106::GetTupleSize( void ) const
+{
+    return tupleSize106( GetIP() );
+}
+
+
+int IGES_ENTITY_106::GetNPoints( void ) const
+{
+    return (int)( data.size() / GetTupleSize() );
+}
+
+
+bool IGES_ENTITY_106::IsPointSet( void ) const
+{
+    return form < 10;
+}
+
+
+bool IGES_ENTITY_106::IsLinearPath( void ) const
+{
+    return ( form > 10 && form < 20 ) || 63 == form;
+}
+
+
+bool IGES_ENTITY_106::GetData( int& aNPoints, const double*& aData ) const
+{
+    aNPoints = GetNPoints();
+    aData = data.empty() ? NULL : &data[0];
+    return aNPoints > 0;
+}
+
+
+bool IGES_ENTITY_106::SetData( int aNPoints, const double* aData )
+{
+    int ts = GetTupleSize();
+
+    if( aNPoints < 1 || ( IsLinearPath() && aNPoints < 2 ) || NULL == aData )
+    {
+        ERRMSG << "\n + [INFO] invalid number of points (" << aNPoints;
+        cerr << ") for Copious Data Form " << form << "\n";
+        return false;
+    }
+
+    if( 63 == form && ( aData[0] != aData[( aNPoints - 1 ) * ts]
+        || aData[1] != aData[( aNPoints - 1 ) * ts + 1] ) )
+    {
+        ERRMSG << "\n + [INFO] the last point of a Closed Planar Curve must be the first point\n";
+        return false;
+    }
+
+    data.assign( aData, aData + (size_t)aNPoints * ts );
+    return true;
+}
+
+
+bool IGES_ENTITY_106::SetPoints( const std::vector<MCAD_POINT>& aPoints )
+{
+    int ts = GetTupleSize();
+    size_t np = aPoints.size();
+    std::vector<double> tmp( np * ts, 0.0 );
+
+    for( size_t i = 0; i < np; ++i )
+    {
+        double* dp = &tmp[i * ts];
+        dp[0] = aPoints[i].x;
+        dp[1] = aPoints[i].y;
+
+        if( ts > 2 )
+            dp[2] = aPoints[i].z;
+    }
+
+    if( np == 0 )
+        return SetData( 0, NULL );
+
+    return SetData( (int)np, &tmp[0] );
+}
+
+
+bool IGES_ENTITY_106::GetPoint( int aIndex, MCAD_POINT& pt, bool xform )
+{
+    if( aIndex < 0 || aIndex >= GetNPoints() )
+        return false;
+
+    int ts = GetTupleSize();
+    const double* dp = &data[(size_t)aIndex * ts];
+
+    pt.x = dp[0];
+    pt.y = dp[1];
+    pt.z = ( ts > 2 ) ? dp[2] : ZT;
+
+    if( xform && pTransform )
+        pt = pTransform->GetTransformMatrix() * pt;
+
+    return true;
+}
+
+
+bool IGES_ENTITY_106::GetPoints( std::vector<MCAD_POINT>& aPoints, bool xform )
+{
+    int np = GetNPoints();
+
+    if( np < 1 )
+        return false;
+
+    aPoints.reserve( aPoints.size() + np );
+
+    for( int i = 0; i < np; ++i )
+    {
+        MCAD_POINT pt;
+        GetPoint( i, pt, xform );
+        aPoints.push_back( pt );
+    }
+
+    return true;
+}
+
+
+bool IGES_ENTITY_106::GetVector( int aIndex, MCAD_POINT& aVec ) const
+{
+    if( 3 != GetIP() || aIndex < 0 || aIndex >= GetNPoints() )
+        return false;
+
+    const double* dp = &data[(size_t)aIndex * 6 + 3];
+
+    aVec.x = dp[0];
+    aVec.y = dp[1];
+    aVec.z = dp[2];
+    return true;
+}
+
+
+bool IGES_ENTITY_106::GetStartPoint( MCAD_POINT& pt, bool xform )
+{
+    return GetPoint( 0, pt, xform );
+}
+
+
+bool IGES_ENTITY_106::GetEndPoint( MCAD_POINT& pt, bool xform )
+{
+    return GetPoint( GetNPoints() - 1, pt, xform );
+}
+
+
+int IGES_ENTITY_106::GetNSegments( void )
+{
+    if( !IsLinearPath() || GetNPoints() < 2 )
+        return 0;
+
+    return GetNPoints() - 1;
+}
+
+
+bool IGES_ENTITY_106::IsClosed( void )
+{
+    if( !IsLinearPath() || GetNPoints() < 3 )
+        return false;
+
+    if( 63 == form )
+        return true;
+
+    int ts = GetTupleSize();
+    size_t last = data.size() - ts;
+
+    for( int i = 0; i < 3 && i < ts; ++i )
+    {
+        if( data[i] != data[last + i] )
+            return false;
+    }
+
+    return true;
+}
+
+
+int IGES_ENTITY_106::GetNCurves( void )
+{
+    // a set of points or an annotation Form is not a curve
+    if( !IsLinearPath() )
+        return -2;
+
+    return 0;
+}
+
+
+IGES_CURVE* IGES_ENTITY_106::GetCurve( int index )
+{
+    return NULL;
+}
+
+
+bool IGES_ENTITY_106::GetPolyline( double aTolerance, std::vector<MCAD_POINT>& aPoints,
+                                   bool xform )
+{
+    if( !IsLinearPath() )
+    {
+        ERRMSG << "\n + [INFO] Copious Data Form " << form << " is not a curve\n";
+        return false;
+    }
+
+    return GetPoints( aPoints, xform );
+}
@@ -28,6 +28,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/entity108.h>
 
 /*
@@ -151,6 +152,16 @@ bool IGES_ENTITY_108::associate(std::vector<IGES_ENTITY *> *entities)
 }
 
 
+void IGES_ENTITY_108::getRefIndices( std::vector<int>& aList )
+{
+    if( iPtr > 0 )
+        aList.push_back( iPtr >> 1 );
+
+    IGES_ENTITY::getRefIndices( aList );
+    return;
+}
+
+
 bool IGES_ENTITY_108::format( int &index )
 {
     if ((0 == form) && (NULL != PTR))
@@ -307,6 +318,14 @@ bool IGES_ENTITY_108::rescale( double sf )
 }
 
 
+void IGES_ENTITY_108::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+    return;
+}
+
+
 bool IGES_ENTITY_108::unlink(IGES_ENTITY *aChildEntity)
 {
     // check if there are any extra entities to unlink
@@ -516,6 +535,7 @@ bool IGES_ENTITY_108::SetEntityForm( int aForm )
     }
 
     form = aForm;
+    updateDE();
     return true;
 }
 
@@ -28,6 +28,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/entity110.h>
 #include <core/entity124.h>
 
@@ -156,6 +157,14 @@ bool IGES_ENTITY_110::rescale( double sf )
 }
 
 
+void IGES_ENTITY_110::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+    return;
+}
+
+
 bool IGES_ENTITY_110::unlink(IGES_ENTITY *aChildEntity)
 {
     return IGES_ENTITY::unlink(aChildEntity);
@@ -301,6 +310,7 @@ bool IGES_ENTITY_110::SetEntityForm( int aForm )
     }
 
     form = aForm;
+    updateDE();
     return true;
 }
 
@@ -360,3 +370,17 @@ IGES_CURVE* IGES_ENTITY_110::GetCurve( int index )
 {
     return NULL;
 }
+
+
+bool IGES_ENTITY_110::GetPolyline( double aTolerance, std::vector<MCAD_POINT>& aPoints,
+                                   bool xform )
+{
+    MCAD_POINT p0;
+    MCAD_POINT p1;
+
+    GetStartPoint( p0, xform );
+    GetEndPoint( p1, xform );
+    aPoints.push_back( p0 );
+    aPoints.push_back( p1 );
+    return true;
+}
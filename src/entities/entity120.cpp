@@ -33,6 +33,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/iges_curve.h>
 #include <core/entity120.h>
 #include <core/entity124.h>
@@ -152,6 +153,19 @@ bool IGES_ENTITY_120::associate(std::vector<IGES_ENTITY *> *entities)
 }
 
 
+void IGES_ENTITY_120::getRefIndices( std::vector<int>& aList )
+{
+    if( iL > 0 )
+        aList.push_back( iL >> 1 );
+
+    if( iC > 0 )
+        aList.push_back( iC >> 1 );
+
+    IGES_ENTITY::getRefIndices( aList );
+    return;
+}
+
+
 bool IGES_ENTITY_120::format( int &index )
 {
     pdout.clear();
@@ -247,6 +261,14 @@ bool IGES_ENTITY_120::rescale( double sf )
 }
 
 
+void IGES_ENTITY_120::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+    return;
+}
+
+
 bool IGES_ENTITY_120::unlink(IGES_ENTITY *aChild)
 {
     if(IGES_ENTITY::unlink(aChild) )
@@ -29,6 +29,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <geom/mcad_helpers.h>
 #include <core/entity124.h>
 #include <core/entity122.h>
@@ -115,6 +116,16 @@ bool IGES_ENTITY_122::associate(std::vector<IGES_ENTITY *> *entities)
 }
 
 
+void IGES_ENTITY_122::getRefIndices( std::vector<int>& aList )
+{
+    if( iDE > 0 )
+        aList.push_back( iDE >> 1 );
+
+    IGES_ENTITY::getRefIndices( aList );
+    return;
+}
+
+
 bool IGES_ENTITY_122::format( int &index )
 {
     pdout.clear();
@@ -208,6 +219,14 @@ bool IGES_ENTITY_122::rescale( double sf )
 }
 
 
+void IGES_ENTITY_122::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+    return;
+}
+
+
 bool IGES_ENTITY_122::unlink(IGES_ENTITY *aChildEntity)
 {
     if( !aChildEntity )
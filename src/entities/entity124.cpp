@@ -44,6 +44,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/entity124.h>
 
 
@@ -226,6 +227,14 @@ bool IGES_ENTITY_124::rescale( double sf )
 }
 
 
+void IGES_ENTITY_124::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+    return;
+}
+
+
 bool IGES_ENTITY_124::unlink(IGES_ENTITY *aChildEntity)
 {
     if( !aChildEntity )
@@ -378,6 +387,7 @@ bool IGES_ENTITY_124::SetEntityForm( int aForm )
     }
 
     form = aForm;
+    updateDE();
     return true;
 }
 
@@ -28,6 +28,8 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
+#include <core/iges_bezier.h>
 #include <geom/mcad_helpers.h>
 #include <core/entity124.h>
 #include <core/entity126.h>
@@ -57,6 +59,7 @@ IGES_ENTITY_126::IGES_ENTITY_126( IGES* aParent ) : IGES_CURVE( aParent )
     scurve = NULL;
 #endif
 
+    bcurve = NULL;
     return;
 }
 
@@ -64,10 +67,11 @@ IGES_ENTITY_126::IGES_ENTITY_126( IGES* aParent ) : IGES_CURVE( aParent )
 IGES_ENTITY_126::~IGES_ENTITY_126()
 {
 #ifdef USE_SISL
-    if( NULL != scurve )
-        freeCurve( scurve );
+    freeSISLCurve();
 #endif
 
+    freeBezierCurve();
+
     if( knots )
         delete [] knots;
 
@@ -358,6 +362,12 @@ bool IGES_ENTITY_126::rescale( double sf )
     if( NULL == coeffs )
         return true;
 
+#ifdef USE_SISL
+    freeSISLCurve();
+#endif
+
+    freeBezierCurve();
+
     for( int i = 0, j = 0; i < nCoeffs; ++i )
     {
         if( scaleXY )
@@ -383,6 +393,40 @@ bool IGES_ENTITY_126::rescale( double sf )
 }
 
 
+void IGES_ENTITY_126::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+
+    if( knots )
+        aHeapBytes += nKnots * sizeof( double );
+
+    if( coeffs )
+        aHeapBytes += nCoeffs * ( PROP3 ? 3 : 4 ) * sizeof( double );
+
+#ifdef USE_SISL
+    SISLCurve* sc = scurve.load( std::memory_order_acquire );
+
+    if( sc )
+    {
+        // the knots and coefficients are shared with this entity; SISL
+        // only allocates the projected coefficients of rational curves
+        aHeapBytes += sizeof( SISLCurve );
+
+        if( 2 == sc->ikind || 4 == sc->ikind )
+            aHeapBytes += sc->in * sc->idim * sizeof( double );
+    }
+#endif
+
+    IGES_BEZIER_CURVE* bc = bcurve.load( std::memory_order_acquire );
+
+    if( bc )
+        aHeapBytes += bc->GetMemoryUsage();
+
+    return;
+}
+
+
 bool IGES_ENTITY_126::unlink(IGES_ENTITY *aChild)
 {
     return IGES_ENTITY::unlink(aChild);
@@ -757,6 +801,7 @@ bool IGES_ENTITY_126::SetEntityForm( int aForm )
     }
 
     form = aForm;
+    updateDE();
     return true;
 }
 
@@ -811,6 +856,74 @@ bool IGES_ENTITY_126::GetNormal( MCAD_POINT& aNorm )
 }
 
 
+bool IGES_ENTITY_126::EvalPoints( int aNPoints, const double* aParams,
+    MCAD_POINT* aPoints, bool xform )
+{
+    if( aNPoints < 1 || NULL == aParams || NULL == aPoints )
+    {
+        ERRMSG << "\n + [BUG] invalid argument\n";
+        return false;
+    }
+
+    IGES_BEZIER_CURVE* bc = getBezierCurve();
+
+    if( NULL == bc )
+        return false;
+
+    // permit round-off in parameter values computed by the caller;
+    // such values are clamped to the range of the curve
+    double tol = 1e-9 * ( V1 - V0 );
+
+    for( int i = 0; i < aNPoints; ++i )
+    {
+        if( aParams[i] < V0 - tol || aParams[i] > V1 + tol )
+        {
+            ERRMSG << "\n + [INFO] parameter value (" << aParams[i];
+            cerr << ") is outside the curve's range [" << V0 << ", " << V1 << "]\n";
+            return false;
+        }
+
+        bc->Evaluate( aParams[i], aPoints[i] );
+    }
+
+    if( xform && pTransform )
+    {
+        MCAD_TRANSFORM T = pTransform->GetTransformMatrix();
+
+        for( int i = 0; i < aNPoints; ++i )
+            aPoints[i] = T * aPoints[i];
+    }
+
+    return true;
+}
+
+
+bool IGES_ENTITY_126::GetBoundingBox( MCAD_POINT& aMin, MCAD_POINT& aMax, bool xform )
+{
+    IGES_BEZIER_CURVE* bc = getBezierCurve();
+
+    if( NULL == bc )
+        return false;
+
+    double tol = 1e-8;
+
+    if( parent )
+        tol = parent->globalData.minResolution;
+
+    if( xform && pTransform )
+    {
+        MCAD_TRANSFORM T = pTransform->GetTransformMatrix();
+        bc->GetBounds( &T, tol, aMin, aMax );
+    }
+    else
+    {
+        bc->GetBounds( NULL, tol, aMin, aMax );
+    }
+
+    return true;
+}
+
+
 int IGES_ENTITY_126::GetNCurves( void )
 {
     return 1;
@@ -831,23 +944,17 @@ bool IGES_ENTITY_126::GetStartPoint( MCAD_POINT& pt, bool xform )
 
     // XXX - To be reimplemented with self-contained de Boors - Cox algorithm
 #ifdef USE_SISL
-    if( !scurve )
-    {
-        scurve = newCurve( nCoeffs, M + 1, knots, coeffs, PROP3 ? 1 : 2, 3, 0 );
+    SISLCurve* sc = getSISLCurve();
 
-        if( !scurve )
-        {
-            ERRMSG << "\n + [INFO] memory allocation failed in SISL newCurve()\n";
-            return false;
-        }
-    }
+    if( !sc )
+        return false;
 
     double vals[6];
     int kt = 0;
     double r = 0;
     int stat = 0;
 
-    s1225( scurve, 0, V0, &kt, vals, &vals[3], &r, &stat );
+    s1225( sc, 0, V0, &kt, vals, &vals[3], &r, &stat );
 
     switch( stat )
     {
@@ -889,23 +996,17 @@ bool IGES_ENTITY_126::GetEndPoint( MCAD_POINT& pt, bool xform )
 
     // XXX - To be reimplemented with self-contained de Boors - Cox algorithm
 #ifdef USE_SISL
-    if( !scurve )
-    {
-        scurve = newCurve( nCoeffs, M + 1, knots, coeffs, PROP3 ? 1 : 2, 3, 0 );
+    SISLCurve* sc = getSISLCurve();
 
-        if( !scurve )
-        {
-            ERRMSG << "\n + [INFO] memory allocation failed in SISL newCurve()\n";
-            return false;
-        }
-    }
+    if( !sc )
+        return false;
 
     double vals[6];
     int kt = 0;
     double r = 0;
     int stat = 0;
 
-    s1225( scurve, 0, V1, &kt, vals, &vals[3], &r, &stat );
+    s1225( sc, 0, V1, &kt, vals, &vals[3], &r, &stat );
 
     switch( stat )
     {
@@ -951,6 +1052,95 @@ bool IGES_ENTITY_126::GetEndPoint( MCAD_POINT& pt, bool xform )
 }
 
 
+#ifdef USE_SISL
+SISLCurve* IGES_ENTITY_126::getSISLCurve( void )
+{
+    SISLCurve* sc = scurve.load( std::memory_order_acquire );
+
+    if( sc )
+        return sc;
+
+    if( nCoeffs < 2 || !knots || !coeffs )
+        return NULL;
+
+    sc = newCurve( nCoeffs, M + 1, knots, coeffs, PROP3 ? 1 : 2, 3, 0 );
+
+    if( !sc )
+    {
+        ERRMSG << "\n + [INFO] memory allocation failed in SISL newCurve()\n";
+        return NULL;
+    }
+
+    // publish the curve; if another thread got there first
+    // then discard ours and use the published curve
+    SISLCurve* prev = NULL;
+
+    if( !scurve.compare_exchange_strong( prev, sc, std::memory_order_acq_rel ) )
+    {
+        freeCurve( sc );
+        sc = prev;
+    }
+
+    return sc;
+}
+
+
+void IGES_ENTITY_126::freeSISLCurve( void )
+{
+    SISLCurve* sc = scurve.exchange( NULL );
+
+    if( NULL != sc )
+        freeCurve( sc );
+
+    return;
+}
+#endif
+
+
+IGES_BEZIER_CURVE* IGES_ENTITY_126::getBezierCurve( void )
+{
+    IGES_BEZIER_CURVE* bc = bcurve.load( std::memory_order_acquire );
+
+    if( bc )
+        return bc;
+
+    if( nCoeffs < 2 || !knots || !coeffs )
+        return NULL;
+
+    bc = new IGES_BEZIER_CURVE;
+
+    if( !bc->Build( nCoeffs, M + 1, knots, coeffs, 0 == PROP3, V0, V1 ) )
+    {
+        ERRMSG << "\n + [INFO] could not create the Bezier representation of the curve\n";
+        delete bc;
+        return NULL;
+    }
+
+    // publish the representation; if another thread got there
+    // first then discard ours and use the published one
+    IGES_BEZIER_CURVE* prev = NULL;
+
+    if( !bcurve.compare_exchange_strong( prev, bc, std::memory_order_acq_rel ) )
+    {
+        delete bc;
+        bc = prev;
+    }
+
+    return bc;
+}
+
+
+void IGES_ENTITY_126::freeBezierCurve( void )
+{
+    IGES_BEZIER_CURVE* bc = bcurve.exchange( NULL );
+
+    if( NULL != bc )
+        delete bc;
+
+    return;
+}
+
+
 int IGES_ENTITY_126::GetNSegments( void )
 {
     // return the number of coefficients; this allows the user
@@ -959,14 +1149,42 @@ int IGES_ENTITY_126::GetNSegments( void )
 }
 
 
+bool IGES_ENTITY_126::GetPolyline( double aTolerance, std::vector<MCAD_POINT>& aPoints,
+                                   bool xform )
+{
+    if( aTolerance <= 0.0 )
+    {
+        ERRMSG << "\n + [INFO] invalid tolerance (" << aTolerance << ")\n";
+        return false;
+    }
+
+    IGES_BEZIER_CURVE* bc = getBezierCurve();
+
+    if( NULL == bc )
+        return false;
+
+    if( xform && pTransform )
+    {
+        MCAD_TRANSFORM T = pTransform->GetTransformMatrix();
+        bc->Flatten( &T, aTolerance, aPoints );
+    }
+    else
+    {
+        bc->Flatten( NULL, aTolerance, aPoints );
+    }
+
+    return true;
+}
+
+
 bool IGES_ENTITY_126::GetNURBSData( int& nCoeff, int& order, double** knot,
     double** coeff, bool& isRational, bool& isClosed, bool& isPeriodic,
     double& v0, double& v1 )
 {
     nCoeff = 0;
     order =0 ;
-    knot = NULL;
-    coeff = NULL;
+    *knot = NULL;
+    *coeff = NULL;
 
     if( !knots )
         return false;
@@ -1001,10 +1219,11 @@ bool IGES_ENTITY_126::SetNURBSData( int nCoeff, int order, const double* knot,
     const double* coeff, bool isRational, double v0, double v1 )
 {
 #ifdef USE_SISL
-    if( NULL != scurve )
-        freeCurve( scurve );
+    freeSISLCurve();
 #endif
 
+    freeBezierCurve();
+
     if( !knot || !coeff )
     {
         ERRMSG << "\n + [INFO] invalid NURBS parameter pointer (NULL)\n";
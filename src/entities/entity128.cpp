@@ -28,6 +28,8 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
+#include <core/iges_bezier.h>
 #include <geom/mcad_helpers.h>
 #include <core/entity124.h>
 #include <core/entity128.h>
@@ -59,6 +61,7 @@ IGES_ENTITY_128::IGES_ENTITY_128( IGES* aParent ) : IGES_ENTITY( aParent )
     knots1 = NULL;
     knots2 = NULL;
     coeffs = NULL;
+    bsurf = NULL;
 
     return;
 }
@@ -66,6 +69,8 @@ IGES_ENTITY_128::IGES_ENTITY_128( IGES* aParent ) : IGES_ENTITY( aParent )
 
 IGES_ENTITY_128::~IGES_ENTITY_128()
 {
+    freeBezierSurface();
+
     if( knots1 )
         delete [] knots1;
 
@@ -358,6 +363,8 @@ bool IGES_ENTITY_128::rescale( double sf )
     if( !coeffs )
         return true;
 
+    freeBezierSurface();
+
     int C = nCoeffs1 * nCoeffs2;
 
     if( 0 == PROP3 )
@@ -389,6 +396,29 @@ bool IGES_ENTITY_128::rescale( double sf )
 }
 
 
+void IGES_ENTITY_128::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+
+    if( knots1 )
+        aHeapBytes += nKnots1 * sizeof( double );
+
+    if( knots2 )
+        aHeapBytes += nKnots2 * sizeof( double );
+
+    if( coeffs )
+        aHeapBytes += nCoeffs1 * nCoeffs2 * ( PROP3 ? 3 : 4 ) * sizeof( double );
+
+    IGES_BEZIER_SURFACE* bs = bsurf.load( std::memory_order_acquire );
+
+    if( bs )
+        aHeapBytes += bs->GetMemoryUsage();
+
+    return;
+}
+
+
 bool IGES_ENTITY_128::unlink(IGES_ENTITY *aChild)
 {
     return IGES_ENTITY::unlink(aChild);
@@ -823,6 +853,7 @@ bool IGES_ENTITY_128::SetEntityForm( int aForm )
     }
 
     form = aForm;
+    updateDE();
     return true;
 }
 
@@ -889,9 +920,9 @@ bool IGES_ENTITY_128::GetNURBSData( int& nCoeff1, int& nCoeff2,
     nCoeff2 = 0;
     order1 = 0 ;
     order2 = 0 ;
-    knot1 = NULL;
-    knot2 = NULL;
-    coeff = NULL;
+    *knot1 = NULL;
+    *knot2 = NULL;
+    *coeff = NULL;
 
     if( !knots1 )
         return false;
@@ -942,6 +973,8 @@ bool IGES_ENTITY_128::SetNURBSData( int nCoeff1, int nCoeff2, int order1, int or
     const double* knot1, const double* knot2, const double* coeff, bool isRational,
     bool isPeriodic1, bool isPeriodic2, double u0, double u1, double v0, double v1 )
 {
+    freeBezierSurface();
+
     if( !knot1 || !knot2 || !coeff )
     {
         ERRMSG << "\n + [INFO] invalid NURBS parameter pointer (NULL)\n";
@@ -1111,3 +1144,506 @@ bool IGES_ENTITY_128::SetNURBSData( int nCoeff1, int nCoeff2, int order1, int or
 
     return true;
 }
+
+
+IGES_BEZIER_SURFACE* IGES_ENTITY_128::getBezierSurface( void )
+{
+    IGES_BEZIER_SURFACE* bs = bsurf.load( std::memory_order_acquire );
+
+    if( bs )
+        return bs;
+
+    if( !knots1 || !knots2 || !coeffs )
+        return NULL;
+
+    bs = new IGES_BEZIER_SURFACE;
+
+    if( !bs->Build( nCoeffs1, nCoeffs2, M1 + 1, M2 + 1, knots1, knots2, coeffs,
+        0 == PROP3, U0, U1, V0, V1 ) )
+    {
+        ERRMSG << "\n + [INFO] could not create the Bezier representation of the surface\n";
+        delete bs;
+        return NULL;
+    }
+
+    // publish the representation; if another thread got there
+    // first then discard ours and use the published one
+    IGES_BEZIER_SURFACE* prev = NULL;
+
+    if( !bsurf.compare_exchange_strong( prev, bs, std::memory_order_acq_rel ) )
+    {
+        delete bs;
+        bs = prev;
+    }
+
+    return bs;
+}
+
+
+void IGES_ENTITY_128::freeBezierSurface( void )
+{
+    IGES_BEZIER_SURFACE* bs = bsurf.exchange( NULL );
+
+    if( NULL != bs )
+        delete bs;
+
+    return;
+}
+
+
+bool IGES_ENTITY_128::EvalPoints( int aNPoints, const double* aUParams,
+    const double* aVParams, MCAD_POINT* aPoints, bool xform )
+{
+    if( aNPoints < 1 || NULL == aUParams || NULL == aVParams || NULL == aPoints )
+    {
+        ERRMSG << "\n + [BUG] invalid argument\n";
+        return false;
+    }
+
+    IGES_BEZIER_SURFACE* bs = getBezierSurface();
+
+    if( NULL == bs )
+        return false;
+
+    // permit round-off in parameter values computed by the caller;
+    // such values are clamped to the range of the surface
+    double tolU = 1e-9 * ( U1 - U0 );
+    double tolV = 1e-9 * ( V1 - V0 );
+
+    for( int i = 0; i < aNPoints; ++i )
+    {
+        if( aUParams[i] < U0 - tolU || aUParams[i] > U1 + tolU
+            || aVParams[i] < V0 - tolV || aVParams[i] > V1 + tolV )
+        {
+            ERRMSG << "\n + [INFO] parameter values (" << aUParams[i] << ", ";
+            cerr << aVParams[i] << ") are outside the surface's range [";
+            cerr << U0 << ", " << U1 << "] x [" << V0 << ", " << V1 << "]\n";
+            return false;
+        }
+
+        bs->Evaluate( aUParams[i], aVParams[i], aPoints[i] );
+    }
+
+    if( xform && pTransform )
+    {
+        MCAD_TRANSFORM T = pTransform->GetTransformMatrix();
+
+        for( int i = 0; i < aNPoints; ++i )
+            aPoints[i] = T * aPoints[i];
+    }
+
+    return true;
+}
+
+
+bool IGES_ENTITY_128::GetBoundingBox( MCAD_POINT& aMin, MCAD_POINT& aMax, bool xform )
+{
+    IGES_BEZIER_SURFACE* bs = getBezierSurface();
+
+    if( NULL == bs )
+        return false;
+
+    if( xform && pTransform )
+    {
+        MCAD_TRANSFORM T = pTransform->GetTransformMatrix();
+        bs->GetBounds( &T, aMin, aMax );
+    }
+    else
+    {
+        bs->GetBounds( NULL, aMin, aMax );
+    }
+
+    return true;
+}
+
+
+// find the knot span [aKnots[s], aKnots[s+1]) within the domain of the
+// B-Spline which contains aParam; at the end of the domain the last
+// nonempty span is returned
+static int findKnotSpan( int aNCoeffs, int aOrder, const double* aKnots, double aParam )
+{
+    int lo = aOrder - 1;
+    int hi = aNCoeffs - 1;
+
+    while( lo < hi )
+    {
+        int mid = ( lo + hi + 1 ) / 2;
+
+        if( aParam < aKnots[mid] )
+            hi = mid - 1;
+        else
+            lo = mid;
+    }
+
+    while( lo > aOrder - 1 && aKnots[lo] >= aKnots[lo + 1] )
+        --lo;
+
+    return lo;
+}
+
+
+// compute the aOrder nonzero basis functions at aParam within knot span
+// aSpan and their first derivatives; aWork must hold 3 * aOrder doubles
+static void basisFuncs( int aOrder, const double* aKnots, int aSpan, double aParam,
+                        double* aN, double* aDN, double* aWork )
+{
+    int p = aOrder - 1;
+    double* left = aWork;
+    double* right = aWork + aOrder;
+    double* nm1 = aWork + 2 * aOrder;   // basis functions of degree p - 1
+
+    aN[0] = 1.0;
+
+    for( int j = 1; j <= p; ++j )
+    {
+        if( j == p )
+        {
+            for( int r = 0; r < p; ++r )
+                nm1[r] = aN[r];
+        }
+
+        left[j] = aParam - aKnots[aSpan + 1 - j];
+        right[j] = aKnots[aSpan + j] - aParam;
+        double saved = 0.0;
+
+        for( int r = 0; r < j; ++r )
+        {
+            double tmp = aN[r] / ( right[r + 1] + left[j - r] );
+            aN[r] = saved + right[r + 1] * tmp;
+            saved = left[j - r] * tmp;
+        }
+
+        aN[j] = saved;
+    }
+
+    for( int r = 0; r <= p; ++r )
+    {
+        double d = 0.0;
+
+        if( r > 0 )
+        {
+            double dk = aKnots[aSpan + r] - aKnots[aSpan - p + r];
+
+            if( dk > 0.0 )
+                d += nm1[r - 1] / dk;
+        }
+
+        if( r < p )
+        {
+            double dk = aKnots[aSpan + r + 1] - aKnots[aSpan - p + r + 1];
+
+            if( dk > 0.0 )
+                d -= nm1[r] / dk;
+        }
+
+        aDN[r] = p * d;
+    }
+
+    return;
+}
+
+
+// evaluate the basis functions for a list of parameter values; the results
+// are stored by function index so that aN[k * aNParams + i] is the value of
+// the k-th nonzero function at aParams[i]
+static bool gridBasis( int aNCoeffs, int aOrder, const double* aKnots,
+                       double aP0, double aP1, int aNParams, const double* aParams,
+                       std::vector<int>& aSpans, std::vector<double>& aN,
+                       std::vector<double>& aDN )
+{
+    // permit round-off in parameter values computed by the caller;
+    // such values are clamped to the range of the surface
+    double tol = 1e-9 * ( aP1 - aP0 );
+    std::vector<double> n( aOrder );
+    std::vector<double> dn( aOrder );
+    std::vector<double> work( 3 * aOrder );
+
+    aSpans.resize( aNParams );
+    aN.resize( aOrder * aNParams );
+    aDN.resize( aOrder * aNParams );
+
+    for( int i = 0; i < aNParams; ++i )
+    {
+        double u = aParams[i];
+
+        if( u < aP0 - tol || u > aP1 + tol )
+        {
+            ERRMSG << "\n + [INFO] parameter value (" << u;
+            cerr << ") is outside the surface's range [" << aP0 << ", " << aP1 << "]\n";
+            return false;
+        }
+
+        if( u < aP0 )
+            u = aP0;
+        else if( u > aP1 )
+            u = aP1;
+
+        int span = findKnotSpan( aNCoeffs, aOrder, aKnots, u );
+        basisFuncs( aOrder, aKnots, span, u, &n[0], &dn[0], &work[0] );
+        aSpans[i] = span;
+
+        for( int k = 0; k < aOrder; ++k )
+        {
+            aN[k * aNParams + i] = n[k];
+            aDN[k * aNParams + i] = dn[k];
+        }
+    }
+
+    return true;
+}
+
+
+bool IGES_ENTITY_128::EvalGrid( int aNU, const double* aUParams, int aNV,
+    const double* aVParams, MCAD_POINT* aPoints, MCAD_POINT* aDerivU,
+    MCAD_POINT* aDerivV, bool xform )
+{
+    if( aNU < 1 || aNV < 1 || NULL == aUParams || NULL == aVParams || NULL == aPoints )
+    {
+        ERRMSG << "\n + [BUG] invalid argument\n";
+        return false;
+    }
+
+    if( !knots1 || !knots2 || !coeffs )
+    {
+        ERRMSG << "\n + [INFO] no surface data\n";
+        return false;
+    }
+
+    // The surface is S(u,v) = sum_i sum_j Nu_i(u) Nv_j(v) P_ij in homogeneous
+    // coordinates. The basis functions are evaluated once per grid line and
+    // the sum is separated into a contraction along V for each row of the
+    // grid followed by a contraction along U. All inner loops run over
+    // contiguous arrays of coordinates (structure of arrays) so that the
+    // compiler can vectorize them.
+    int order1 = M1 + 1;
+    int order2 = M2 + 1;
+    bool derivs = ( NULL != aDerivU || NULL != aDerivV );
+    std::vector<int> spanU;
+    std::vector<int> spanV;
+    std::vector<double> nu;
+    std::vector<double> dnu;
+    std::vector<double> nv;
+    std::vector<double> dnv;
+
+    if( !gridBasis( nCoeffs1, order1, knots1, U0, U1, aNU, aUParams, spanU, nu, dnu )
+        || !gridBasis( nCoeffs2, order2, knots2, V0, V1, aNV, aVParams, spanV, nv, dnv ) )
+        return false;
+
+    // homogeneous control points, one array per coordinate
+    int nc = nCoeffs1 * nCoeffs2;
+    int stride = ( 0 == PROP3 ) ? 4 : 3;
+    std::vector<double> ctl( 4 * nc );
+    double* px = &ctl[0];
+    double* py = px + nc;
+    double* pz = py + nc;
+    double* pw = pz + nc;
+
+    for( int i = 0; i < nc; ++i )
+    {
+        const double* src = &coeffs[i * stride];
+        double w = ( 0 == PROP3 ) ? src[3] : 1.0;
+
+        px[i] = src[0] * w;
+        py[i] = src[1] * w;
+        pz[i] = src[2] * w;
+        pw[i] = w;
+    }
+
+    // columns of control points which contribute to the grid
+    int iMin = spanU[0];
+    int iMax = spanU[0];
+
+    for( int i = 1; i < aNU; ++i )
+    {
+        if( spanU[i] < iMin )
+            iMin = spanU[i];
+        else if( spanU[i] > iMax )
+            iMax = spanU[i];
+    }
+
+    iMin -= order1 - 1;
+    ++iMax;
+
+    // contractions along V of one grid row: C = sum Nv_j P_ij, D = sum Nv'_j P_ij
+    std::vector<double> rowC( 8 * nCoeffs1 );
+    double* cx = &rowC[0];
+    double* cy = cx + nCoeffs1;
+    double* cz = cy + nCoeffs1;
+    double* cw = cz + nCoeffs1;
+    double* dx = cw + nCoeffs1;
+    double* dy = dx + nCoeffs1;
+    double* dz = dy + nCoeffs1;
+    double* dw = dz + nCoeffs1;
+
+    // accumulated values of S, dS/du and dS/dv along one grid row
+    std::vector<double> acc( 12 * aNU );
+    double* sx = &acc[0];
+    double* sy = sx + aNU;
+    double* sz = sy + aNU;
+    double* sw = sz + aNU;
+    double* ux = sw + aNU;
+    double* uy = ux + aNU;
+    double* uz = uy + aNU;
+    double* uw = uz + aNU;
+    double* vx = uw + aNU;
+    double* vy = vx + aNU;
+    double* vz = vy + aNU;
+    double* vw = vz + aNU;
+
+    MCAD_TRANSFORM T;
+    bool doXform = xform && pTransform;
+
+    if( doXform )
+        T = pTransform->GetTransformMatrix();
+
+    for( int j = 0; j < aNV; ++j )
+    {
+        for( int i = iMin; i < iMax; ++i )
+        {
+            cx[i] = 0.0;
+            cy[i] = 0.0;
+            cz[i] = 0.0;
+            cw[i] = 0.0;
+            dx[i] = 0.0;
+            dy[i] = 0.0;
+            dz[i] = 0.0;
+            dw[i] = 0.0;
+        }
+
+        for( int k = 0; k < order2; ++k )
+        {
+            int row = ( spanV[j] - order2 + 1 + k ) * nCoeffs1;
+            double b = nv[k * aNV + j];
+
+            for( int i = iMin; i < iMax; ++i )
+            {
+                cx[i] += b * px[row + i];
+                cy[i] += b * py[row + i];
+                cz[i] += b * pz[row + i];
+                cw[i] += b * pw[row + i];
+            }
+
+            if( !derivs )
+                continue;
+
+            b = dnv[k * aNV + j];
+
+            for( int i = iMin; i < iMax; ++i )
+            {
+                dx[i] += b * px[row + i];
+                dy[i] += b * py[row + i];
+                dz[i] += b * pz[row + i];
+                dw[i] += b * pw[row + i];
+            }
+        }
+
+        int nAcc = derivs ? 12 * aNU : 4 * aNU;
+
+        for( int i = 0; i < nAcc; ++i )
+            acc[i] = 0.0;
+
+        // process runs of U values which lie within the same knot span
+        int r0 = 0;
+
+        while( r0 < aNU )
+        {
+            int r1 = r0 + 1;
+
+            while( r1 < aNU && spanU[r1] == spanU[r0] )
+                ++r1;
+
+            for( int k = 0; k < order1; ++k )
+            {
+                int col = spanU[r0] - order1 + 1 + k;
+                const double* b = &nu[k * aNU];
+                double x = cx[col];
+                double y = cy[col];
+                double z = cz[col];
+                double w = cw[col];
+
+                for( int i = r0; i < r1; ++i )
+                {
+                    sx[i] += b[i] * x;
+                    sy[i] += b[i] * y;
+                    sz[i] += b[i] * z;
+                    sw[i] += b[i] * w;
+                }
+
+                if( !derivs )
+                    continue;
+
+                const double* db = &dnu[k * aNU];
+
+                for( int i = r0; i < r1; ++i )
+                {
+                    ux[i] += db[i] * x;
+                    uy[i] += db[i] * y;
+                    uz[i] += db[i] * z;
+                    uw[i] += db[i] * w;
+                }
+
+                x = dx[col];
+                y = dy[col];
+                z = dz[col];
+                w = dw[col];
+
+                for( int i = r0; i < r1; ++i )
+                {
+                    vx[i] += b[i] * x;
+                    vy[i] += b[i] * y;
+                    vz[i] += b[i] * z;
+                    vw[i] += b[i] * w;
+                }
+            }
+
+            r0 = r1;
+        }
+
+        // project to Euclidean space; for a rational surface the
+        // derivatives follow from the quotient rule
+        MCAD_POINT* pp = &aPoints[j * aNU];
+
+        for( int i = 0; i < aNU; ++i )
+        {
+            double w = 1.0 / sw[i];
+            MCAD_POINT& pt = pp[i];
+            pt.x = sx[i] * w;
+            pt.y = sy[i] * w;
+            pt.z = sz[i] * w;
+
+            if( aDerivU )
+            {
+                MCAD_POINT& du = aDerivU[j * aNU + i];
+                du.x = ( ux[i] - pt.x * uw[i] ) * w;
+                du.y = ( uy[i] - pt.y * uw[i] ) * w;
+                du.z = ( uz[i] - pt.z * uw[i] ) * w;
+            }
+
+            if( aDerivV )
+            {
+                MCAD_POINT& dv = aDerivV[j * aNU + i];
+                dv.x = ( vx[i] - pt.x * vw[i] ) * w;
+                dv.y = ( vy[i] - pt.y * vw[i] ) * w;
+                dv.z = ( vz[i] - pt.z * vw[i] ) * w;
+            }
+        }
+    }
+
+    if( doXform )
+    {
+        int np = aNU * aNV;
+
+        for( int i = 0; i < np; ++i )
+        {
+            aPoints[i] = T * aPoints[i];
+
+            if( aDerivU )
+                aDerivU[i] = T.R * aDerivU[i];
+
+            if( aDerivV )
+                aDerivV[i] = T.R * aDerivV[i];
+        }
+    }
+
+    return true;
+}
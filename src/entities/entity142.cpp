@@ -28,6 +28,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/entity124.h>
 #include <core/entity142.h>
 
@@ -180,6 +181,22 @@ bool IGES_ENTITY_142::associate(std::vector<IGES_ENTITY *> *entities)
 }
 
 
+void IGES_ENTITY_142::getRefIndices( std::vector<int>& aList )
+{
+    if( iSPTR > 0 )
+        aList.push_back( iSPTR >> 1 );
+
+    if( iBPTR > 0 )
+        aList.push_back( iBPTR >> 1 );
+
+    if( iCPTR > 0 )
+        aList.push_back( iCPTR >> 1 );
+
+    IGES_ENTITY::getRefIndices( aList );
+    return;
+}
+
+
 bool IGES_ENTITY_142::format( int &index )
 {
     pdout.clear();
@@ -294,6 +311,14 @@ bool IGES_ENTITY_142::rescale( double sf )
 }
 
 
+void IGES_ENTITY_142::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+    return;
+}
+
+
 bool IGES_ENTITY_142::unlink(IGES_ENTITY *aChild)
 {
     if(IGES_ENTITY::unlink(aChild) )
@@ -25,10 +25,15 @@
  */
 
 #include <sstream>
+#include <algorithm>
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
+#include <core/iges_curve.h>
+#include <core/iges_trim.h>
 #include <core/entity124.h>
+#include <core/entity128.h>
 #include <core/entity142.h>
 #include <core/entity144.h>
 
@@ -90,6 +95,8 @@ IGES_ENTITY_144::IGES_ENTITY_144( IGES* aParent ) : IGES_ENTITY( aParent )
     iPTO = 0;
     PTS = NULL;
     PTO = NULL;
+    trimIndex = NULL;
+    trimTol = 0.0;
 
     return;
 }
@@ -97,14 +104,16 @@ IGES_ENTITY_144::IGES_ENTITY_144( IGES* aParent ) : IGES_ENTITY( aParent )
 
 IGES_ENTITY_144::~IGES_ENTITY_144()
 {
+    freeTrimIndex();
+
     if( PTS )
         PTS->delReference(this);
 
     if( PTO )
         PTO->delReference(this);
 
-    std::list<IGES_ENTITY_142*>::iterator sPTI = PTI.begin();
-    std::list<IGES_ENTITY_142*>::iterator ePTI = PTI.end();
+    IGES_CHILDREN<IGES_ENTITY_142>::iterator sPTI = PTI.begin();
+    IGES_CHILDREN<IGES_ENTITY_142>::iterator ePTI = PTI.end();
 
     while( sPTI != ePTI )
     {
@@ -116,14 +125,6 @@ IGES_ENTITY_144::~IGES_ENTITY_144()
 }
 
 
-void IGES_ENTITY_144::Compact( void )
-{
-    IGES_ENTITY::Compact();
-    vPTI.clear();
-    return;
-}
-
-
 bool IGES_ENTITY_144::associate(std::vector<IGES_ENTITY *> *entities)
 {
     if( !IGES_ENTITY::associate(entities) )
@@ -282,6 +283,30 @@ bool IGES_ENTITY_144::associate(std::vector<IGES_ENTITY *> *entities)
 }
 
 
+void IGES_ENTITY_144::getRefIndices( std::vector<int>& aList )
+{
+    if( iPTS > 0 )
+        aList.push_back( iPTS >> 1 );
+
+    if( iPTO > 0 )
+        aList.push_back( iPTO >> 1 );
+
+    std::list<int>::const_iterator sPTI = iPTI.begin();
+    std::list<int>::const_iterator ePTI = iPTI.end();
+
+    while( sPTI != ePTI )
+    {
+        if( *sPTI > 0 )
+            aList.push_back( *sPTI >> 1 );
+
+        ++sPTI;
+    }
+
+    IGES_ENTITY::getRefIndices( aList );
+    return;
+}
+
+
 bool IGES_ENTITY_144::format( int &index )
 {
     pdout.clear();
@@ -345,8 +370,8 @@ bool IGES_ENTITY_144::format( int &index )
 
     if( !PTI.empty() )
     {
-        std::list<IGES_ENTITY_142*>::iterator sPTI = PTI.begin();
-        std::list<IGES_ENTITY_142*>::iterator ePTI = PTI.end();
+        IGES_CHILDREN<IGES_ENTITY_142>::iterator sPTI = PTI.begin();
+        IGES_CHILDREN<IGES_ENTITY_142>::iterator ePTI = PTI.end();
 
         while( sPTI != ePTI )
         {
@@ -393,11 +418,27 @@ bool IGES_ENTITY_144::rescale( double sf )
 }
 
 
+void IGES_ENTITY_144::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize() + HeapSize( iPTI ) + PTI.GetHeapSize();
+
+    IGES_TRIM_INDEX* ti = trimIndex.load( std::memory_order_acquire );
+
+    if( ti )
+        aHeapBytes += ti->GetMemoryUsage();
+
+    return;
+}
+
+
 bool IGES_ENTITY_144::unlink(IGES_ENTITY *aChild)
 {
     if(IGES_ENTITY::unlink(aChild) )
         return true;
 
+    freeTrimIndex();
+
     if( aChild == PTS )
     {
         PTS = NULL;
@@ -412,14 +453,14 @@ bool IGES_ENTITY_144::unlink(IGES_ENTITY *aChild)
 
     if( !PTI.empty() )
     {
-        std::list<IGES_ENTITY_142*>::iterator sPTI = PTI.begin();
-        std::list<IGES_ENTITY_142*>::iterator ePTI = PTI.end();
+        IGES_CHILDREN<IGES_ENTITY_142>::iterator sPTI = PTI.begin();
+        IGES_CHILDREN<IGES_ENTITY_142>::iterator ePTI = PTI.end();
 
         while( sPTI != ePTI )
         {
             if( aChild == *sPTI )
             {
-                PTI.erase( sPTI );
+                PTI.erase( *sPTI );
                 N2 = (int)PTI.size();
                 return true;
             }
@@ -458,8 +499,8 @@ bool IGES_ENTITY_144::addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate
 
     if( !PTI.empty() )
     {
-        std::list<IGES_ENTITY_142*>::iterator sPTI = PTI.begin();
-        std::list<IGES_ENTITY_142*>::iterator ePTI = PTI.end();
+        IGES_CHILDREN<IGES_ENTITY_142>::iterator sPTI = PTI.begin();
+        IGES_CHILDREN<IGES_ENTITY_142>::iterator ePTI = PTI.end();
 
         while( sPTI != ePTI )
         {
@@ -729,6 +770,8 @@ bool IGES_ENTITY_144::GetPTO( IGES_ENTITY_142*& aPtr )
 
 bool IGES_ENTITY_144::SetPTO( IGES_ENTITY_142* aPtr )
 {
+    freeTrimIndex();
+
     if( PTO )
         PTO->delReference(this);
 
@@ -778,21 +821,8 @@ bool IGES_ENTITY_144::GetPTIList( size_t& aListSize, IGES_ENTITY_142**& aPTIList
         return false;
     }
 
-    if( PTI.size() != vPTI.size() )
-    {
-        vPTI.clear();
-        std::list<IGES_ENTITY_142*>::iterator sL = PTI.begin();
-        std::list<IGES_ENTITY_142*>::iterator eL = PTI.end();
-
-        while( sL != eL )
-        {
-            vPTI.push_back( *sL );
-            ++sL;
-        }
-    }
-
-    aListSize = vPTI.size();
-    aPTIList = &vPTI[0];
+    aListSize = PTI.size();
+    aPTIList = PTI.data();
     return true;
 }
 
@@ -804,12 +834,7 @@ IGES_ENTITY_142* IGES_ENTITY_144::GetPTI( int aIndex )
     if( aIndex < 0 || aIndex >= ne )
         return NULL;
 
-    std::list< IGES_ENTITY_142* >::iterator sI = PTI.begin();
-
-    for( int i = 0; i < aIndex; ++i )
-        ++sI;
-
-    return *sI;
+    return PTI[aIndex];
 }
 
 
@@ -821,21 +846,10 @@ bool IGES_ENTITY_144::AddPTI( IGES_ENTITY_142* aPtr )
         return false;
     }
 
-    std::list<IGES_ENTITY_142*>::iterator bref = PTI.begin();
-    std::list<IGES_ENTITY_142*>::iterator eref = PTI.end();
-
-    while( bref != eref )
-    {
-        // while this is a bug, we can do the right thing and simply ignore the
-        // additional reference
-        if( aPtr == *bref )
-        {
-            vPTI.clear();
-            return true;
-        }
-
-        ++bref;
-    }
+    // while this is a bug, we can do the right thing and simply ignore the
+    // additional reference
+    if( PTI.contains( aPtr ) )
+        return true;
 
     bool dup = false;
 
@@ -853,11 +867,10 @@ bool IGES_ENTITY_144::AddPTI( IGES_ENTITY_142* aPtr )
 
     aPtr->SetDependency( STAT_DEP_PHY );
 
+    freeTrimIndex();
     PTI.push_back( aPtr );
     N2 = (int)PTI.size();
 
-    vPTI.clear();
-
     if( NULL != parent && parent != aPtr->GetParentIGES() )
         parent->AddEntity( aPtr );
 
@@ -867,20 +880,178 @@ bool IGES_ENTITY_144::AddPTI( IGES_ENTITY_142* aPtr )
 
 bool IGES_ENTITY_144::DelPTI( IGES_ENTITY_142* aPtr )
 {
-    std::list<IGES_ENTITY_142*>::iterator bref = PTI.begin();
-    std::list<IGES_ENTITY_142*>::iterator eref = PTI.end();
+    if( !PTI.contains( aPtr ) )
+        return false;
+
+    freeTrimIndex();
+    PTI.erase( aPtr );
+    aPtr->delReference( this );
+    N2 = (int)PTI.size();
+    return true;
+}
+
+
+// flatten the parameter space curve of a boundary into a closed polyline
+static bool flattenBoundary( IGES_ENTITY_142* aBound, double aTolerance,
+                             std::vector<MCAD_POINT>& aPoints )
+{
+    IGES_ENTITY* ep = NULL;
 
-    while( bref != eref )
+    if( !aBound->GetBPTR( &ep ) )
     {
-        if( aPtr == *bref )
-        {
-            PTI.erase( bref );
-            N2 = (int)PTI.size();
-            return true;
-        }
+        ERRMSG << "\n + [INFO] boundary has no parameter space curve\n";
+        return false;
+    }
+
+    IGES_CURVE* cp = dynamic_cast<IGES_CURVE*>( ep );
 
-        ++bref;
+    if( NULL == cp )
+    {
+        ERRMSG << "\n + [INFO] parameter space boundary is not a curve\n";
+        return false;
     }
 
-    return false;
+    // the parameter space curve is defined in the (u, v) plane so
+    // no transform is applied
+    if( !cp->GetPolyline( aTolerance, aPoints, false ) )
+    {
+        ERRMSG << "\n + [INFO] could not flatten parameter space boundary\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+IGES_TRIM_INDEX* IGES_ENTITY_144::getTrimIndex( void )
+{
+    IGES_TRIM_INDEX* ti = trimIndex.load( std::memory_order_acquire );
+
+    if( ti )
+        return ti;
+
+    if( NULL == PTS )
+    {
+        ERRMSG << "\n + [INFO] unspecified surface entity\n";
+        return NULL;
+    }
+
+    double tol = trimTol;
+
+    if( tol <= 0.0 )
+    {
+        // the extent of the parameter space is only known for NURBS
+        // surfaces; other surfaces are parameterized in model units
+        IGES_ENTITY_128* sp = dynamic_cast<IGES_ENTITY_128*>( PTS );
+        int nc1, nc2, o1, o2;
+        double* k1;
+        double* k2;
+        double* cf;
+        bool rat, cl1, cl2, per1, per2;
+        double u0, u1, v0, v1;
+
+        if( NULL != sp && sp->GetNURBSData( nc1, nc2, o1, o2, &k1, &k2, &cf,
+            rat, cl1, cl2, per1, per2, u0, u1, v0, v1 ) )
+            tol = 1e-6 * std::max( u1 - u0, v1 - v0 );
+        else if( NULL != parent )
+            tol = parent->globalData.minResolution;
+        else
+            tol = 1e-8;
+    }
+
+    std::vector< std::vector<MCAD_POINT> > loops;
+
+    if( NULL != PTO )
+    {
+        loops.push_back( std::vector<MCAD_POINT>() );
+
+        if( !flattenBoundary( PTO, tol, loops.back() ) )
+            return NULL;
+    }
+
+    IGES_CHILDREN<IGES_ENTITY_142>::iterator sPTI = PTI.begin();
+    IGES_CHILDREN<IGES_ENTITY_142>::iterator ePTI = PTI.end();
+
+    while( sPTI != ePTI )
+    {
+        loops.push_back( std::vector<MCAD_POINT>() );
+
+        if( !flattenBoundary( *sPTI, tol, loops.back() ) )
+            return NULL;
+
+        ++sPTI;
+    }
+
+    ti = new IGES_TRIM_INDEX;
+
+    if( !ti->Build( loops, NULL != PTO ) )
+    {
+        ERRMSG << "\n + [INFO] could not index the trimming boundaries\n";
+        delete ti;
+        return NULL;
+    }
+
+    // publish the index; if another thread got there
+    // first then discard ours and use the published one
+    IGES_TRIM_INDEX* prev = NULL;
+
+    if( !trimIndex.compare_exchange_strong( prev, ti, std::memory_order_acq_rel ) )
+    {
+        delete ti;
+        ti = prev;
+    }
+
+    return ti;
+}
+
+
+void IGES_ENTITY_144::freeTrimIndex( void )
+{
+    IGES_TRIM_INDEX* ti = trimIndex.exchange( NULL );
+
+    if( NULL != ti )
+        delete ti;
+
+    return;
+}
+
+
+bool IGES_ENTITY_144::SetTrimTolerance( double aTolerance )
+{
+    if( aTolerance < 0.0 )
+    {
+        ERRMSG << "\n + [INFO] invalid tolerance (" << aTolerance << ")\n";
+        return false;
+    }
+
+    freeTrimIndex();
+    trimTol = aTolerance;
+    return true;
+}
+
+
+bool IGES_ENTITY_144::ClassifyPoint( double aU, double aV, bool& aInside )
+{
+    return ClassifyPoints( 1, &aU, &aV, &aInside );
+}
+
+
+bool IGES_ENTITY_144::ClassifyPoints( int aNPoints, const double* aUParams,
+                                      const double* aVParams, bool* aResult )
+{
+    if( aNPoints < 1 || NULL == aUParams || NULL == aVParams || NULL == aResult )
+    {
+        ERRMSG << "\n + [BUG] invalid argument\n";
+        return false;
+    }
+
+    IGES_TRIM_INDEX* ti = getTrimIndex();
+
+    if( NULL == ti )
+        return false;
+
+    for( int i = 0; i < aNPoints; ++i )
+        aResult[i] = ti->IsInside( aUParams[i], aVParams[i] );
+
+    return true;
 }
@@ -29,6 +29,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <geom/mcad_helpers.h>
 #include <core/entity124.h>
 #include <core/entity154.h>
@@ -169,6 +170,14 @@ bool IGES_ENTITY_154::rescale( double sf )
 }
 
 
+void IGES_ENTITY_154::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+    return;
+}
+
+
 bool IGES_ENTITY_154::unlink(IGES_ENTITY *aChildEntity)
 {
     return IGES_ENTITY::unlink(aChildEntity);
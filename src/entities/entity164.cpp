@@ -29,6 +29,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <geom/mcad_helpers.h>
 #include <core/entity164.h>
 
@@ -130,6 +131,16 @@ bool IGES_ENTITY_164::associate(std::vector<IGES_ENTITY *> *entities)
 }
 
 
+void IGES_ENTITY_164::getRefIndices( std::vector<int>& aList )
+{
+    if( iPtr > 0 )
+        aList.push_back( iPtr >> 1 );
+
+    IGES_ENTITY::getRefIndices( aList );
+    return;
+}
+
+
 bool IGES_ENTITY_164::format( int &index )
 {
     pdout.clear();
@@ -224,6 +235,14 @@ bool IGES_ENTITY_164::rescale( double sf )
 }
 
 
+void IGES_ENTITY_164::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+    return;
+}
+
+
 bool IGES_ENTITY_164::unlink(IGES_ENTITY *aChildEntity)
 {
     if(IGES_ENTITY::unlink(aChildEntity) )
@@ -29,8 +29,10 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/entity124.h>
 #include <core/entity180.h>
+#include <core/iges_csg.h>
 
 using namespace std;
 
@@ -38,12 +40,14 @@ IGES_ENTITY_180::IGES_ENTITY_180( IGES* aParent ) : IGES_ENTITY( aParent )
 {
     entityType = 180;
     form = 0;
+    csgProgram = NULL;
     return;
 }
 
 
 IGES_ENTITY_180::~IGES_ENTITY_180()
 {
+    freeCSGProgram();
     ClearNodes();
     return;
 }
@@ -88,6 +92,8 @@ bool IGES_ENTITY_180::typeOK( int aTypeNum )
 
 void IGES_ENTITY_180::ClearNodes( void )
 {
+    freeCSGProgram();
+
     if( !nodes.empty() )
     {
         std::list<BTREE_NODE*>::iterator rbeg = nodes.begin();
@@ -185,6 +191,24 @@ bool IGES_ENTITY_180::associate(std::vector<IGES_ENTITY *> *entities)
 }
 
 
+void IGES_ENTITY_180::getRefIndices( std::vector<int>& aList )
+{
+    std::list<BTREE_NODE*>::const_iterator sn = nodes.begin();
+    std::list<BTREE_NODE*>::const_iterator en = nodes.end();
+
+    while( sn != en )
+    {
+        if( !(*sn)->op && (*sn)->val > 0 )
+            aList.push_back( (*sn)->val >> 1 );
+
+        ++sn;
+    }
+
+    IGES_ENTITY::getRefIndices( aList );
+    return;
+}
+
+
 bool IGES_ENTITY_180::format( int &index )
 {
     pdout.clear();
@@ -289,11 +313,26 @@ bool IGES_ENTITY_180::format( int &index )
 
 bool IGES_ENTITY_180::rescale( double sf )
 {
-    // there is nothing to scale
+    // there is nothing to scale but the operands have changed
+    freeCSGProgram();
     return true;
 }
 
 
+void IGES_ENTITY_180::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize() + HeapSize( nodes ) + nodes.size() * sizeof( BTREE_NODE );
+
+    IGES_CSG_PROGRAM* cp = csgProgram.load( std::memory_order_acquire );
+
+    if( cp )
+        aHeapBytes += cp->GetMemoryUsage();
+
+    return;
+}
+
+
 bool IGES_ENTITY_180::unlink(IGES_ENTITY *aChildEntity)
 {
     if(IGES_ENTITY::unlink(aChildEntity) )
@@ -301,6 +340,7 @@ bool IGES_ENTITY_180::unlink(IGES_ENTITY *aChildEntity)
 
     // if one node is unlinked then we must relinquish
     // links to all entities
+    freeCSGProgram();
 
     std::list<BTREE_NODE*>::iterator rbeg = nodes.begin();
     std::list<BTREE_NODE*>::iterator rend = nodes.end();
@@ -313,6 +353,7 @@ bool IGES_ENTITY_180::unlink(IGES_ENTITY *aChildEntity)
         if( aChildEntity == ip )
         {
             clear_all = true;
+            delete *rbeg;
             nodes.erase( rbeg );
             break;
         }
@@ -320,8 +361,9 @@ bool IGES_ENTITY_180::unlink(IGES_ENTITY *aChildEntity)
         ++rbeg;
     }
 
+    // the remaining operands must not retain a reference to this tree
     if( clear_all )
-        nodes.clear();
+        ClearNodes();
 
     return true;
 }
@@ -521,6 +563,7 @@ bool IGES_ENTITY_180::SetEntityForm( int aForm )
     }
 
     form = aForm;
+    updateDE();
     return true;
 }
 
@@ -572,6 +615,7 @@ bool IGES_ENTITY_180::AddOp( BTREE_OPERATOR op )
         return false;
     }
 
+    freeCSGProgram();
     np->op = true;
     np->val = op;
     nodes.push_back( np );
@@ -613,6 +657,7 @@ bool IGES_ENTITY_180::AddArg( IGES_ENTITY* aOperand )
         return false;
     }
 
+    freeCSGProgram();
     np->pEnt = aOperand;
     nodes.push_back( np );
 
@@ -647,3 +692,80 @@ BTREE_NODE* IGES_ENTITY_180::GetNode( int aIndex )
 
     return *sI;
 }
+
+
+IGES_CSG_PROGRAM* IGES_ENTITY_180::getCSGProgram( void )
+{
+    IGES_CSG_PROGRAM* cp = csgProgram.load( std::memory_order_acquire );
+
+    if( cp )
+        return cp;
+
+    double tol = 1e-8;
+
+    if( NULL != parent )
+        tol = parent->globalData.minResolution;
+
+    cp = new IGES_CSG_PROGRAM;
+
+    if( !cp->Compile( this, tol ) )
+    {
+        ERRMSG << "\n + [INFO] could not compile the Boolean Tree\n";
+        delete cp;
+        return NULL;
+    }
+
+    // publish the program; if another thread got there
+    // first then discard ours and use the published one
+    IGES_CSG_PROGRAM* prev = NULL;
+
+    if( !csgProgram.compare_exchange_strong( prev, cp, std::memory_order_acq_rel ) )
+    {
+        delete cp;
+        cp = prev;
+    }
+
+    return cp;
+}
+
+
+void IGES_ENTITY_180::freeCSGProgram( void )
+{
+    IGES_CSG_PROGRAM* cp = csgProgram.exchange( NULL );
+
+    if( NULL != cp )
+        delete cp;
+
+    return;
+}
+
+
+void IGES_ENTITY_180::ResetClassifier( void )
+{
+    freeCSGProgram();
+    return;
+}
+
+
+bool IGES_ENTITY_180::ClassifyPoint( const MCAD_POINT& aPoint, bool& aInside )
+{
+    return ClassifyPoints( 1, &aPoint, &aInside );
+}
+
+
+bool IGES_ENTITY_180::ClassifyPoints( int aNPoints, const MCAD_POINT* aPoints, bool* aResult )
+{
+    if( aNPoints < 1 || NULL == aPoints || NULL == aResult )
+    {
+        ERRMSG << "\n + [BUG] invalid argument\n";
+        return false;
+    }
+
+    IGES_CSG_PROGRAM* cp = getCSGProgram();
+
+    if( NULL == cp )
+        return false;
+
+    cp->Classify( aNPoints, aPoints, aResult );
+    return true;
+}
@@ -29,6 +29,7 @@
 #include <sstream>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/entity124.h>
 #include <core/entity502.h>
 #include <core/entity504.h>
@@ -176,6 +177,27 @@ bool IGES_ENTITY_186::associate(std::vector<IGES_ENTITY *> *entities)
 }
 
 
+void IGES_ENTITY_186::getRefIndices( std::vector<int>& aList )
+{
+    if( mDEshell > 0 )
+        aList.push_back( mDEshell >> 1 );
+
+    std::list<std::pair<int, bool> >::const_iterator sV = ivoids.begin();
+    std::list<std::pair<int, bool> >::const_iterator eV = ivoids.end();
+
+    while( sV != eV )
+    {
+        if( sV->first > 0 )
+            aList.push_back( sV->first >> 1 );
+
+        ++sV;
+    }
+
+    IGES_ENTITY::getRefIndices( aList );
+    return;
+}
+
+
 bool IGES_ENTITY_186::format( int &index )
 {
     pdout.clear();
@@ -285,6 +307,14 @@ bool IGES_ENTITY_186::rescale( double sf )
 }
 
 
+void IGES_ENTITY_186::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize() + HeapSize( ivoids ) + HeapSize( mvoids );
+    return;
+}
+
+
 bool IGES_ENTITY_186::unlink(IGES_ENTITY *aChildEntity)
 {
     if(IGES_ENTITY::unlink(aChildEntity) )
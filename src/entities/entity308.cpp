@@ -28,6 +28,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/entity124.h>
 #include <core/entity408.h>
 #include <core/entity308.h>
@@ -49,9 +50,8 @@ IGES_ENTITY_308::IGES_ENTITY_308( IGES* aParent ) : IGES_ENTITY( aParent )
 
 IGES_ENTITY_308::~IGES_ENTITY_308()
 {
-    m_DE.clear();
-    std::list<IGES_ENTITY*>::iterator sDE = DE.begin();
-    std::list<IGES_ENTITY*>::iterator eDE = DE.end();
+    IGES_CHILDREN<IGES_ENTITY>::iterator sDE = DE.begin();
+    IGES_CHILDREN<IGES_ENTITY>::iterator eDE = DE.end();
 
     while( sDE != eDE )
     {
@@ -63,14 +63,6 @@ IGES_ENTITY_308::~IGES_ENTITY_308()
 }
 
 
-void IGES_ENTITY_308::Compact( void )
-{
-    IGES_ENTITY::Compact();
-    m_DE.clear();
-    return;
-}
-
-
 bool IGES_ENTITY_308::associate(std::vector<IGES_ENTITY *> *entities)
 {
     if( !IGES_ENTITY::associate(entities) )
@@ -135,6 +127,24 @@ bool IGES_ENTITY_308::associate(std::vector<IGES_ENTITY *> *entities)
 }
 
 
+void IGES_ENTITY_308::getRefIndices( std::vector<int>& aList )
+{
+    std::list<int>::const_iterator sDE = iDE.begin();
+    std::list<int>::const_iterator eDE = iDE.end();
+
+    while( sDE != eDE )
+    {
+        if( *sDE > 0 )
+            aList.push_back( *sDE >> 1 );
+
+        ++sDE;
+    }
+
+    IGES_ENTITY::getRefIndices( aList );
+    return;
+}
+
+
 bool IGES_ENTITY_308::format( int &index )
 {
     pdout.clear();
@@ -187,8 +197,8 @@ bool IGES_ENTITY_308::format( int &index )
 
     int tEnt;
 
-    std::list<IGES_ENTITY*>::iterator sDE = DE.begin();
-    std::list<IGES_ENTITY*>::iterator eDE = DE.end();
+    IGES_CHILDREN<IGES_ENTITY>::iterator sDE = DE.begin();
+    IGES_CHILDREN<IGES_ENTITY>::iterator eDE = DE.end();
 
     while( sDE != eDE )
     {
@@ -234,30 +244,24 @@ bool IGES_ENTITY_308::rescale( double sf )
 }
 
 
+void IGES_ENTITY_308::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize() + HeapSize( iDE ) + DE.GetHeapSize();
+    return;
+}
+
+
 bool IGES_ENTITY_308::unlink(IGES_ENTITY *aChild)
 {
     if(IGES_ENTITY::unlink(aChild) )
         return true;
 
-    if( DE.empty() )
+    if( !DE.erase( aChild ) )
         return false;
 
-    std::list<IGES_ENTITY*>::iterator sDE = DE.begin();
-    std::list<IGES_ENTITY*>::iterator eDE = DE.end();
-
-    while( sDE != eDE )
-    {
-        if( aChild == *sDE )
-        {
-            DE.erase( sDE );
-            N = (int)DE.size();
-            return true;
-        }
-
-        ++sDE;
-    }
-
-    return false;
+    N = (int)DE.size();
+    return true;
 }
 
 
@@ -279,21 +283,10 @@ bool IGES_ENTITY_308::addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate
         return false;
     }
 
-    if( !DE.empty() )
+    if( DE.contains( aParentEntity ) )
     {
-        std::list<IGES_ENTITY*>::iterator sDE = DE.begin();
-        std::list<IGES_ENTITY*>::iterator eDE = DE.end();
-
-        while( sDE != eDE )
-        {
-            if( aParentEntity == *sDE )
-            {
-                ERRMSG << "\n + [BUG] circular reference requested\n";
-                return false;
-            }
-
-            ++sDE;
-        }
+        ERRMSG << "\n + [BUG] circular reference requested\n";
+        return false;
     }
 
     return IGES_ENTITY::addReference(aParentEntity, isDuplicate);
@@ -468,10 +461,24 @@ bool IGES_ENTITY_308::SetEntityUse( IGES_STAT_USE aUseCase )
 bool IGES_ENTITY_308::SetHierarchy( IGES_STAT_HIER aHierarchy )
 {
     hierarchy = aHierarchy;
+    updateDE();
     return true;
 }
 
 
+const std::string& IGES_ENTITY_308::GetName( void ) const
+{
+    return NAME;
+}
+
+
+void IGES_ENTITY_308::SetName( const std::string& aName )
+{
+    setName( NAME, aName );
+    return;
+}
+
+
 bool IGES_ENTITY_308::GetDEList( size_t& aDESize, IGES_ENTITY**& aDEList )
 {
     if( DE.empty() )
@@ -481,21 +488,8 @@ bool IGES_ENTITY_308::GetDEList( size_t& aDESize, IGES_ENTITY**& aDEList )
         return false;
     }
 
-    if( DE.size() != m_DE.size() )
-    {
-        m_DE.clear();
-        std::list< IGES_ENTITY* >::iterator sL = DE.begin();
-        std::list< IGES_ENTITY* >::iterator eL = DE.end();
-
-        while( sL != eL )
-        {
-            m_DE.push_back( *sL );
-            ++sL;
-        }
-    }
-
-    aDESize = m_DE.size();
-    aDEList = &m_DE[0];
+    aDESize = DE.size();
+    aDEList = DE.data();
     return true;
 }
 
@@ -547,21 +541,10 @@ bool IGES_ENTITY_308::AddDE(IGES_ENTITY *aPtr)
         ++bExt;
     }
 
-    bref = DE.begin();
-    eref = DE.end();
-
-    while( bref != eref )
-    {
-        // while this is a bug, we can do the right thing and simply ignore the
-        // additional reference
-        if( aPtr == *bref )
-        {
-            m_DE.clear();
-            return true;
-        }
-
-        ++bref;
-    }
+    // while this is a bug, we can do the right thing and simply ignore the
+    // additional reference
+    if( DE.contains( aPtr ) )
+        return true;
 
     bool dup = false;
 
@@ -580,7 +563,6 @@ bool IGES_ENTITY_308::AddDE(IGES_ENTITY *aPtr)
     aPtr->SetDependency( STAT_DEP_PHY );
     DE.push_back( aPtr );
     N = (int)DE.size();
-    m_DE.clear();
 
     if( NULL != parent && parent != aPtr->GetParentIGES() )
         parent->AddEntity( aPtr );
@@ -591,22 +573,12 @@ bool IGES_ENTITY_308::AddDE(IGES_ENTITY *aPtr)
 
 bool IGES_ENTITY_308::DelDE( IGES_ENTITY* aPtr )
 {
-    std::list<IGES_ENTITY*>::iterator bref = DE.begin();
-    std::list<IGES_ENTITY*>::iterator eref = DE.end();
-
-    while( bref != eref )
-    {
-        if( aPtr == *bref )
-        {
-            DE.erase( bref );
-            N = (int)DE.size();
-            return true;
-        }
-
-        ++bref;
-    }
+    if( !DE.erase( aPtr ) )
+        return false;
 
-    return false;
+    aPtr->delReference( this );
+    N = (int)DE.size();
+    return true;
 }
 
 
@@ -618,8 +590,8 @@ int IGES_ENTITY_308::getDepthLevel( void )
     int nd = 0; // minimum depth level
     int tm = 0;
 
-    std::list<IGES_ENTITY*>::iterator bref = DE.begin();
-    std::list<IGES_ENTITY*>::iterator eref = DE.end();
+    IGES_CHILDREN<IGES_ENTITY>::iterator bref = DE.begin();
+    IGES_CHILDREN<IGES_ENTITY>::iterator eref = DE.end();
 
     while( bref != eref )
     {
@@ -28,6 +28,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/entity314.h>
 #include <core/entity124.h>
 
@@ -250,6 +251,14 @@ bool IGES_ENTITY_314::rescale( double sf )
 }
 
 
+void IGES_ENTITY_314::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize() + HeapSize( cname );
+    return;
+}
+
+
 bool IGES_ENTITY_314::unlink(IGES_ENTITY *aChild)
 {
     // check if there are any extra entities to unlink
@@ -495,6 +504,7 @@ bool IGES_ENTITY_314::SetColor( IGES_COLOR aColor )
     if( aColor > COLOR_NONE && aColor < COLOR_END )
     {
         colorNum = aColor;
+        updateDE();
         return true;
     }
 
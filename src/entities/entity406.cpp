@@ -29,6 +29,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/entity124.h>
 #include <core/entity406.h>
 
@@ -98,7 +99,7 @@ bool IGES_ENTITY_406::SetData(const void *Data)
     {
         const char *cp = (const char *)Data;
         std::string* sp = (std::string*)data;
-        *sp = cp;
+        setName( *sp, cp );
         return true;
     }
 
@@ -273,6 +274,18 @@ bool IGES_ENTITY_406::rescale( double sf )
 }
 
 
+void IGES_ENTITY_406::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+
+    if( 15 == form && data )
+        aHeapBytes += sizeof( std::string ) + HeapSize( *(std::string*)data );
+
+    return;
+}
+
+
 bool IGES_ENTITY_406::isOrphaned( void )
 {
     if((0 == form) || ( refs.empty() && depends != STAT_INDEPENDENT ))
@@ -427,6 +440,7 @@ bool IGES_ENTITY_406::SetEntityForm( int aForm )
     }
 
     form = aForm;
+    updateDE();
 
     // Note: when forms other than Form 15 are supported, we must
     // instantiate the data structure here.
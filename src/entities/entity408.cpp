@@ -30,10 +30,12 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <geom/mcad_helpers.h>
 #include <core/entity124.h>
 #include <core/entity308.h>
 #include <core/entity408.h>
+#include <core/entity416.h>
 
 using namespace std;
 
@@ -44,6 +46,8 @@ IGES_ENTITY_408::IGES_ENTITY_408( IGES* aParent ) : IGES_ENTITY( aParent )
     form = 0;
 
     DE = NULL;
+    extDE = NULL;
+    linkDE = NULL;
     X = 0.0;
     Y = 0.0;
     Z = 0.0;
@@ -58,6 +62,9 @@ IGES_ENTITY_408::~IGES_ENTITY_408()
     if( DE )
         DE->delReference(this);
 
+    if( extDE )
+        extDE->delReference(this);
+
     return;
 }
 
@@ -97,7 +104,37 @@ bool IGES_ENTITY_408::associate(std::vector<IGES_ENTITY *> *entities)
             return false;
         }
 
-        DE = dynamic_cast<IGES_ENTITY_308*>((*entities)[iEnt]);
+        IGES_ENTITY* ep = (*entities)[iEnt];
+
+        if( ep->GetEntityType() == ENT_EXTERNAL_REFERENCE )
+        {
+            int eForm = ep->GetEntityForm();
+
+            if( eForm != 0 && eForm != 2 && eForm != 3 )
+            {
+                ERRMSG << "\n + [CORRUPT FILE] External Reference is not a file reference (" << iDE << ")\n";
+                return false;
+            }
+
+            extDE = (IGES_ENTITY_416*)ep;
+
+            if( !extDE->addReference(this, dup) )
+            {
+                extDE = NULL;
+                ERRMSG << "\n + [INFO] could not add reference to External Reference (" << iDE << ")\n";
+                return false;
+            }
+
+            if( dup )
+            {
+                ERRMSG << "\n + [CORRUPT FILE]: adding duplicate entry\n";
+                return false;
+            }
+
+            return true;
+        }
+
+        DE = dynamic_cast<IGES_ENTITY_308*>(ep);
 
         if( NULL == DE )
         {
@@ -124,6 +161,16 @@ bool IGES_ENTITY_408::associate(std::vector<IGES_ENTITY *> *entities)
 }
 
 
+void IGES_ENTITY_408::getRefIndices( std::vector<int>& aList )
+{
+    if( iDE > 0 )
+        aList.push_back( iDE >> 1 );
+
+    IGES_ENTITY::getRefIndices( aList );
+    return;
+}
+
+
 bool IGES_ENTITY_408::format( int &index )
 {
     pdout.clear();
@@ -135,7 +182,14 @@ bool IGES_ENTITY_408::format( int &index )
         return false;
     }
 
-    if( NULL == DE )
+    IGES_ENTITY* pDef = DE;
+
+    if( linkDE )
+        pDef = linkDE;
+    else if( extDE )
+        pDef = extDE;
+
+    if( NULL == pDef )
     {
         ERRMSG << "\n + [INFO] unassigned Subfigure Definition\n";
         return false;
@@ -155,7 +209,7 @@ bool IGES_ENTITY_408::format( int &index )
 
     ostringstream ostr;
     ostr << entityType << pd;
-    ostr << DE->getDESequence() << pd;
+    ostr << pDef->getDESequence() << pd;
     string lstr = ostr.str();
     string tstr;
 
@@ -216,6 +270,14 @@ bool IGES_ENTITY_408::rescale( double sf )
 }
 
 
+void IGES_ENTITY_408::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+    return;
+}
+
+
 bool IGES_ENTITY_408::unlink(IGES_ENTITY *aChildEntity)
 {
     if( !aChildEntity )
@@ -233,13 +295,19 @@ bool IGES_ENTITY_408::unlink(IGES_ENTITY *aChildEntity)
         return true;
     }
 
+    if( aChildEntity == extDE )
+    {
+        extDE = NULL;
+        return true;
+    }
+
     return false;
 }
 
 
 bool IGES_ENTITY_408::isOrphaned( void )
 {
-    if( (refs.empty() && depends != STAT_INDEPENDENT) || NULL == DE )
+    if( (refs.empty() && depends != STAT_INDEPENDENT) || ( NULL == DE && NULL == extDE ) )
         return true;
 
     return false;
@@ -254,7 +322,7 @@ bool IGES_ENTITY_408::addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate
         return false;
     }
 
-    if( aParentEntity == DE )
+    if( aParentEntity == DE || aParentEntity == extDE )
     {
         ERRMSG << "\n + [INFO] requesting circular reference\n";
         return false;
@@ -402,6 +470,7 @@ bool IGES_ENTITY_408::SetEntityForm( int aForm )
 bool IGES_ENTITY_408::SetHierarchy( IGES_STAT_HIER aHierarchy )
 {
     hierarchy = aHierarchy;
+    updateDE();
     return true;
 }
 
@@ -453,6 +522,12 @@ bool IGES_ENTITY_408::SetDE( IGES_ENTITY_308* aPtr )
         return false;
     }
 
+    if( extDE )
+    {
+        extDE->delReference(this);
+        extDE = NULL;
+    }
+
     if( NULL != parent && parent != aPtr->GetParentIGES() )
         parent->AddEntity( aPtr );
 
@@ -474,3 +549,64 @@ int IGES_ENTITY_408::getDepthLevel( void )
 
     return 0;
 }
+
+
+bool IGES_ENTITY_408::GetExternalRef( IGES_ENTITY_416*& aPtr )
+{
+    aPtr = extDE;
+
+    if( !extDE )
+        return false;
+
+    return true;
+}
+
+
+bool IGES_ENTITY_408::SetExternalRef( IGES_ENTITY_416* aPtr )
+{
+    if( extDE )
+        extDE->delReference(this);
+
+    extDE = aPtr;
+
+    if( NULL == aPtr )
+        return true;
+
+    int eT = aPtr->GetEntityType();
+    int eF = aPtr->GetEntityForm();
+
+    if( eT != ENT_EXTERNAL_REFERENCE || ( eF != 0 && eF != 2 && eF != 3 ) )
+    {
+        extDE = NULL;
+        ERRMSG << "\n + [ERROR] invalid entity (type " << eT << ", form " << eF;
+        cerr << "); only type 416 forms 0, 2, 3 are allowed\n";
+        return false;
+    }
+
+    bool dup = false;
+
+    if( !extDE->addReference(this, dup) )
+    {
+        extDE = NULL;
+        ERRMSG << "\n + [INFO] could not add child entity reference\n";
+        return false;
+    }
+
+    if( dup )
+    {
+        ERRMSG << "\n + [BUG]: adding duplicate entry\n";
+        extDE = NULL;
+        return false;
+    }
+
+    if( DE )
+    {
+        DE->delReference(this);
+        DE = NULL;
+    }
+
+    if( NULL != parent && parent != aPtr->GetParentIGES() )
+        parent->AddEntity( aPtr );
+
+    return true;
+}
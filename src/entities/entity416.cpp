@@ -0,0 +1,435 @@
+/*
+ * file: entity416.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: IGES Entity 416: External Reference Entity, Section 4.149
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <sstream>
+#include <cstring>
+#include <error_macros.h>
+#include <core/iges.h>
+#include <core/iges_io.h>
+#include <core/iges_memory.h>
+#include <core/iges_detable.h>
+#include <core/entity308.h>
+#include <core/entity416.h>
+#include <geom/mcad_utils.h>
+
+using namespace std;
+
+
+IGES_ENTITY_416::IGES_ENTITY_416( IGES* aParent ) : IGES_ENTITY( aParent )
+{
+    entityType = 416;
+    form = 0;
+    m_model = NULL;
+
+    return;
+}
+
+
+IGES_ENTITY_416::~IGES_ENTITY_416()
+{
+    Unload();
+    return;
+}
+
+
+bool IGES_ENTITY_416::associate(std::vector<IGES_ENTITY *> *entities)
+{
+    if( !IGES_ENTITY::associate(entities) )
+    {
+        ERRMSG << "\n + [INFO] failed to establish associations\n";
+        return false;
+    }
+
+    structure = 0;
+
+    if( pStructure )
+    {
+        ERRMSG << "\n + [VIOLATION] Structure entity is set\n";
+        pStructure->delReference(this);
+        pStructure = NULL;
+    }
+
+    return true;
+}
+
+
+bool IGES_ENTITY_416::format( int &index )
+{
+    pdout.clear();
+    iExtras.clear();
+
+    if( index < 1 || index > 9999999 )
+    {
+        ERRMSG << "\n + [INFO] invalid Parameter Data Sequence Number\n";
+        return false;
+    }
+
+    if( ( form == 1 && EXTNAM.empty() ) || ( form != 1 && FN.empty() )
+        || ( form != 1 && form != 3 && EXTNAM.empty() ) )
+    {
+        ERRMSG << "\n + [INFO] missing file or entity name for External Reference (Form ";
+        cerr << form << ")\n";
+        return false;
+    }
+
+    parameterData = index;
+
+    if( !parent )
+    {
+        ERRMSG << "\n + [INFO] method invoked with no parent IGES object\n";
+        return false;
+    }
+
+    char pd = parent->globalData.pdelim;
+    char rd = parent->globalData.rdelim;
+
+    ostringstream ostr;
+    ostr << entityType << pd;
+    string lstr = ostr.str();
+
+    // Form 1 carries only EXTNAM, Form 3 only FN
+    if( form != 1 )
+    {
+        char delim = ( form == 3 && extras.empty() ) ? rd : pd;
+
+        if( !AddPDHStr( FN, lstr, pdout, index, sequenceNumber, pd, rd, delim ) )
+        {
+            ERRMSG << "\n + [INFO] could not add external file name\n";
+            return false;
+        }
+    }
+
+    if( form != 3 )
+    {
+        char delim = extras.empty() ? rd : pd;
+
+        if( !AddPDHStr( EXTNAM, lstr, pdout, index, sequenceNumber, pd, rd, delim ) )
+        {
+            ERRMSG << "\n + [INFO] could not add external entity name\n";
+            return false;
+        }
+    }
+
+    if( !extras.empty() && !formatExtraParams( lstr, index, pd, rd ) )
+    {
+        ERRMSG << "\n + [INFO] could not format optional parameters\n";
+        pdout.clear();
+        iExtras.clear();
+        return false;
+    }
+
+    if( !formatComments( index ) )
+    {
+        ERRMSG << "\n + [INFO] could not format comments\n";
+        pdout.clear();
+        return false;
+    }
+
+    paramLineCount = index - parameterData;
+
+    return true;
+}
+
+
+bool IGES_ENTITY_416::rescale( double sf )
+{
+    // there is nothing to scale so this function always succeeds
+    return true;
+}
+
+
+void IGES_ENTITY_416::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    // the contents of a loaded external file belong to a separate model
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize() + HeapSize( FN ) + HeapSize( EXTNAM );
+    return;
+}
+
+
+bool IGES_ENTITY_416::unlink(IGES_ENTITY *aChild)
+{
+    return IGES_ENTITY::unlink(aChild);
+}
+
+
+bool IGES_ENTITY_416::isOrphaned( void )
+{
+    if( refs.empty() && depends != STAT_INDEPENDENT )
+        return true;
+
+    return false;
+}
+
+
+bool IGES_ENTITY_416::addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate)
+{
+    return IGES_ENTITY::addReference(aParentEntity, isDuplicate);
+}
+
+
+bool IGES_ENTITY_416::delReference(IGES_ENTITY *aParentEntity)
+{
+    return IGES_ENTITY::delReference(aParentEntity);
+}
+
+
+bool IGES_ENTITY_416::readDE(IGES_RECORD *aRecord, std::ifstream &aFile, int &aSequenceVar)
+{
+    if( !IGES_ENTITY::readDE(aRecord, aFile, aSequenceVar) )
+    {
+        ERRMSG << "\n + [INFO] failed to read Directory Entry\n";
+        return false;
+    }
+
+    structure = 0;                  // N.A.
+
+    if( form < 0 || form > 4 )
+    {
+        ERRMSG << "\n + [CORRUPT FILE] invalid Form Number (" << form;
+        cerr << ") in External Reference Entity\n";
+        cerr << " + DE: " << aRecord->index << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+bool IGES_ENTITY_416::readPD(std::ifstream &aFile, int &aSequenceVar)
+{
+    if( !IGES_ENTITY::readPD(aFile, aSequenceVar) )
+    {
+        ERRMSG << "\n + [INFO] could not read data for External Reference Entity\n";
+        pdout.clear();
+        return false;
+    }
+
+    int idx;
+    bool eor = false;
+    char pd = parent->globalData.pdelim;
+    char rd = parent->globalData.rdelim;
+
+    idx = (int)pdout.find(pd);
+
+    if( idx < 1 || idx > 8 )
+    {
+        ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
+        cerr << idx << ")\n";
+        pdout.clear();
+        return false;
+    }
+
+    ++idx;
+    FN.clear();
+    EXTNAM.clear();
+
+    if( form != 1 && !ParseHString( pdout, idx, FN, eor, pd, rd ) )
+    {
+        ERRMSG << "\n + [BAD FILE] no external file name in DE ";
+        cerr << sequenceNumber << "\n";
+        pdout.clear();
+        return false;
+    }
+
+    if( form != 3 && !eor && !ParseHString( pdout, idx, EXTNAM, eor, pd, rd ) )
+    {
+        ERRMSG << "\n + [BAD FILE] no external entity name in DE ";
+        cerr << sequenceNumber << "\n";
+        pdout.clear();
+        return false;
+    }
+
+    if( !eor && !readExtraParams( idx ) )
+    {
+        ERRMSG << "\n + [BAD FILE] could not read optional pointers\n";
+        pdout.clear();
+        return false;
+    }
+
+    if( !readComments( idx ) )
+    {
+        ERRMSG << "\n + [BAD FILE] could not read extra comments\n";
+        pdout.clear();
+        return false;
+    }
+
+    pdout.clear();
+    return true;
+}
+
+
+bool IGES_ENTITY_416::SetEntityForm( int aForm )
+{
+    if( aForm < 0 || aForm > 4 )
+    {
+        ERRMSG << "\n + [BUG] External Reference Entity only supports Forms 0..4 (requested form: ";
+        cerr << aForm << ")\n";
+        return false;
+    }
+
+    if( aForm != form )
+        Unload();
+
+    form = aForm;
+    updateDE();
+    return true;
+}
+
+
+bool IGES_ENTITY_416::SetHierarchy( IGES_STAT_HIER aHierarchy )
+{
+    // hierarchy is ignored
+    return true;
+}
+
+
+IGES* IGES_ENTITY_416::GetModel( void )
+{
+    if( m_model )
+        return m_model;
+
+    if( form == 1 || form == 4 )
+    {
+        ERRMSG << "\n + [INFO] external references of Form " << form;
+        cerr << " cannot be resolved\n";
+        return NULL;
+    }
+
+    if( FN.empty() )
+    {
+        ERRMSG << "\n + [INFO] no external file name\n";
+        return NULL;
+    }
+
+    // a file name without a directory is sought beside the referring file
+    std::string path = FN;
+
+    if( NULL != parent && NULL == strchr( FN.c_str(), '/' )
+        && NULL == strchr( FN.c_str(), '\\' ) )
+    {
+        MCAD_FILEPATH fp( parent->GetFilePath() );
+        const char* fullp = fp.GetFullPath();
+        const char* fname = fp.GetFileName();
+
+        if( NULL != fullp && NULL != fname )
+        {
+            std::string dir = fullp;
+            dir.erase( dir.size() - strlen( fname ) );
+            path = dir + FN;
+        }
+    }
+
+    IGES* model = new IGES;
+
+    if( NULL != parent )
+    {
+        model->SetNThreads( parent->GetNThreads() );
+        model->SetPipelinedRead( parent->GetPipelinedRead() );
+    }
+
+    if( !model->Read( path.c_str() ) )
+    {
+        ERRMSG << "\n + [INFO] could not read external file '" << path << "'\n";
+        delete model;
+        return NULL;
+    }
+
+    m_model = model;
+    return m_model;
+}
+
+
+bool IGES_ENTITY_416::GetDefinition( IGES_ENTITY_308*& aPtr )
+{
+    aPtr = NULL;
+
+    if( form != 0 && form != 2 && form != 3 )
+    {
+        ERRMSG << "\n + [INFO] external references of Form " << form;
+        cerr << " do not refer to a Subfigure Definition in a file\n";
+        return false;
+    }
+
+    IGES* model = GetModel();
+
+    if( NULL == model )
+        return false;
+
+    std::vector<IGES_ENTITY*> eList;
+    IGES_ENTITY_308* found = NULL;
+    int nFound = 0;
+
+    model->GetDETable()->SelectType( ENT_SUBFIGURE_DEFINITION, -1, eList );
+    model->FreeDETable();
+
+    for( size_t i = 0; i < eList.size(); ++i )
+    {
+        IGES_ENTITY_308* ep = (IGES_ENTITY_308*)eList[i];
+
+        if( form == 3 )
+        {
+            if( 0 == ep->getNRefs() )
+            {
+                found = ep;
+                ++nFound;
+            }
+        }
+        else if( 0 == ep->GetName().compare( EXTNAM ) )
+        {
+            found = ep;
+            ++nFound;
+            break;
+        }
+    }
+
+    if( 1 != nFound )
+    {
+        ERRMSG << "\n + [INFO] external file '" << FN << "' does not contain ";
+
+        if( form == 3 )
+            cerr << "exactly one top level Subfigure Definition\n";
+        else
+            cerr << "a Subfigure Definition named '" << EXTNAM << "'\n";
+
+        return false;
+    }
+
+    aPtr = found;
+    return true;
+}
+
+
+void IGES_ENTITY_416::Unload( void )
+{
+    if( m_model )
+    {
+        delete m_model;
+        m_model = NULL;
+    }
+
+    return;
+}
@@ -28,6 +28,7 @@
 #include <sstream>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/entity124.h>
 #include <core/entity502.h>
 
@@ -181,6 +182,14 @@ bool IGES_ENTITY_502::rescale( double sf )
 }
 
 
+void IGES_ENTITY_502::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize() + HeapSize( vertices );
+    return;
+}
+
+
 bool IGES_ENTITY_502::unlink(IGES_ENTITY *aChildEntity)
 {
     return IGES_ENTITY::unlink(aChildEntity);
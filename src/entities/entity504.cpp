@@ -28,6 +28,8 @@
 #include <sstream>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
+#include <core/iges_parallel.h>
 #include <core/entity124.h>
 #include <core/entity502.h>
 #include <core/entity504.h>
@@ -166,6 +168,30 @@ bool IGES_ENTITY_504::associate(std::vector<IGES_ENTITY *> *entities)
 }
 
 
+void IGES_ENTITY_504::getRefIndices( std::vector<int>& aList )
+{
+    std::list<EDGE_DEIDX>::const_iterator sI = deItems.begin();
+    std::list<EDGE_DEIDX>::const_iterator eI = deItems.end();
+
+    while( sI != eI )
+    {
+        if( sI->curv > 0 )
+            aList.push_back( sI->curv >> 1 );
+
+        if( sI->svp > 0 )
+            aList.push_back( sI->svp >> 1 );
+
+        if( sI->tvp > 0 )
+            aList.push_back( sI->tvp >> 1 );
+
+        ++sI;
+    }
+
+    IGES_ENTITY::getRefIndices( aList );
+    return;
+}
+
+
 bool IGES_ENTITY_504::format( int &index )
 {
     pdout.clear();
@@ -277,6 +303,15 @@ bool IGES_ENTITY_504::rescale( double sf )
 }
 
 
+void IGES_ENTITY_504::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize() + HeapSize( deItems ) + HeapSize( edges )
+                 + HeapSize( vedges ) + HeapSize( vertices );
+    return;
+}
+
+
 bool IGES_ENTITY_504::unlink(IGES_ENTITY *aChildEntity)
 {
     if(IGES_ENTITY::unlink(aChildEntity) )
@@ -559,6 +594,8 @@ bool IGES_ENTITY_504::SetHierarchy( IGES_STAT_HIER aHierarchy )
 bool
 IGES_ENTITY_504::GetEdges( size_t aListSize, EDGE_DATA const*& aEdgeList )
 {
+    IGES_CACHE_LOCK lock;
+
     if( edges.empty() )
     {
         vedges.clear();
@@ -29,6 +29,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/entity124.h>
 #include <core/entity508.h>
 
@@ -205,6 +206,35 @@ bool IGES_ENTITY_508::associate(std::vector<IGES_ENTITY *> *entities)
 }
 
 
+void IGES_ENTITY_508::getRefIndices( std::vector<int>& aList )
+{
+    std::list<LOOP_DEIDX>::const_iterator sI = deItems.begin();
+    std::list<LOOP_DEIDX>::const_iterator eI = deItems.end();
+
+    while( sI != eI )
+    {
+        if( sI->data > 0 )
+            aList.push_back( sI->data >> 1 );
+
+        std::list< std::pair<bool, int> >::const_iterator sP = sI->pcurves.begin();
+        std::list< std::pair<bool, int> >::const_iterator eP = sI->pcurves.end();
+
+        while( sP != eP )
+        {
+            if( sP->second > 0 )
+                aList.push_back( sP->second >> 1 );
+
+            ++sP;
+        }
+
+        ++sI;
+    }
+
+    IGES_ENTITY::getRefIndices( aList );
+    return;
+}
+
+
 bool IGES_ENTITY_508::format( int &index )
 {
     pdout.clear();
@@ -355,6 +385,30 @@ bool IGES_ENTITY_508::rescale( double sf )
 }
 
 
+void IGES_ENTITY_508::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize() + HeapSize( deItems ) + HeapSize( redges ) + HeapSize( edges );
+
+    std::list< LOOP_DEIDX >::const_iterator sD = deItems.begin();
+    std::list< LOOP_DEIDX >::const_iterator eD = deItems.end();
+
+    while( sD != eD )
+    {
+        aHeapBytes += HeapSize( sD->pcurves );
+        ++sD;
+    }
+
+    for( size_t i = 0; i < edges.size(); ++i )
+    {
+        aHeapBytes += sizeof( LOOP_DATA ) + HeapSize( edges[i]->pcurves )
+                      + edges[i]->pcurves.size() * sizeof( LOOP_PAIR );
+    }
+
+    return;
+}
+
+
 bool IGES_ENTITY_508::unlink(IGES_ENTITY *aChildEntity)
 {
     if(IGES_ENTITY::unlink(aChildEntity) )
@@ -692,6 +746,7 @@ bool IGES_ENTITY_508::SetDependency( IGES_STAT_DEPENDS aDependency )
 bool IGES_ENTITY_508::SetHierarchy( IGES_STAT_HIER aHierarchy )
 {
     hierarchy = aHierarchy;
+    updateDE();
     return true;
 }
 
@@ -29,6 +29,7 @@
 #include <sstream>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/entity124.h>
 #include <core/entity502.h>
 #include <core/entity504.h>
@@ -154,6 +155,27 @@ bool IGES_ENTITY_510::associate(std::vector<IGES_ENTITY *> *entities)
 }
 
 
+void IGES_ENTITY_510::getRefIndices( std::vector<int>& aList )
+{
+    if( mDEsurf > 0 )
+        aList.push_back( mDEsurf >> 1 );
+
+    std::list<int>::const_iterator sL = iloops.begin();
+    std::list<int>::const_iterator eL = iloops.end();
+
+    while( sL != eL )
+    {
+        if( *sL > 0 )
+            aList.push_back( *sL >> 1 );
+
+        ++sL;
+    }
+
+    IGES_ENTITY::getRefIndices( aList );
+    return;
+}
+
+
 bool IGES_ENTITY_510::format( int &index )
 {
     pdout.clear();
@@ -247,6 +269,14 @@ bool IGES_ENTITY_510::rescale( double sf )
 }
 
 
+void IGES_ENTITY_510::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize() + HeapSize( iloops ) + HeapSize( mloops );
+    return;
+}
+
+
 bool IGES_ENTITY_510::unlink(IGES_ENTITY *aChildEntity)
 {
     if(IGES_ENTITY::unlink(aChildEntity) )
@@ -28,6 +28,7 @@
 #include <sstream>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/entity124.h>
 #include <core/entity502.h>
 #include <core/entity504.h>
@@ -124,6 +125,24 @@ bool IGES_ENTITY_514::associate(std::vector<IGES_ENTITY *> *entities)
 }
 
 
+void IGES_ENTITY_514::getRefIndices( std::vector<int>& aList )
+{
+    std::list<std::pair<int, bool> >::const_iterator sF = ifaces.begin();
+    std::list<std::pair<int, bool> >::const_iterator eF = ifaces.end();
+
+    while( sF != eF )
+    {
+        if( sF->first > 0 )
+            aList.push_back( sF->first >> 1 );
+
+        ++sF;
+    }
+
+    IGES_ENTITY::getRefIndices( aList );
+    return;
+}
+
+
 bool IGES_ENTITY_514::format( int &index )
 {
     pdout.clear();
@@ -230,6 +249,14 @@ bool IGES_ENTITY_514::rescale( double sf )
 }
 
 
+void IGES_ENTITY_514::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize() + HeapSize( ifaces ) + HeapSize( mfaces );
+    return;
+}
+
+
 bool IGES_ENTITY_514::unlink(IGES_ENTITY *aChildEntity)
 {
     if(IGES_ENTITY::unlink(aChildEntity) )
@@ -423,6 +450,7 @@ bool IGES_ENTITY_514::SetEntityForm( int aForm )
     if( 1 == aForm || 2 == aForm )
     {
         form = aForm;
+        updateDE();
         return true;
     }
 
@@ -27,6 +27,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/entityNULL.h>
 
 using namespace std;
@@ -301,14 +302,14 @@ bool IGES_ENTITY_NULL::format( int &index )
 }
 
 
-bool IGES_ENTITY_NULL::writeDE(std::ofstream &aFile)
+bool IGES_ENTITY_NULL::writeDE(std::ostream &aFile)
 {
     ERRMSG << "\n + [BUG] invoking function in NULL Entity\n";
     return false;
 }
 
 
-bool IGES_ENTITY_NULL::writePD(std::ofstream &aFile)
+bool IGES_ENTITY_NULL::writePD(std::ostream &aFile)
 {
     ERRMSG << "\n + [BUG] invoking function in NULL Entity\n";
     return true;    // do not interfere with other write operations
@@ -418,3 +419,11 @@ bool IGES_ENTITY_NULL::rescale( double sf )
     ERRMSG << "\n + [BUG] invoking function in NULL Entity\n";
     return false;
 }
+
+
+void IGES_ENTITY_NULL::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+    return;
+}
@@ -29,6 +29,7 @@
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
 #include <core/entity124.h>
 #include <entity_template.h>
 
@@ -59,6 +60,14 @@ bool IGES_ENTITY_TEMP::rescale( double sf )
 }
 
 
+void IGES_ENTITY_TEMP::getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes )
+{
+    aObjectBytes = sizeof( *this );
+    aHeapBytes = getBaseHeapSize();
+    return;
+}
+
+
 bool IGES_ENTITY_TEMP::Unlink( IGES_ENTITY* aChildEntity )
 {
     // XXX - TO BE IMPLEMENTED
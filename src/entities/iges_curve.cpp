@@ -44,3 +44,12 @@ IGES_CURVE::~IGES_CURVE()
 {
     return;
 }
+
+
+bool IGES_CURVE::GetPolyline( double aTolerance, std::vector<MCAD_POINT>& aPoints,
+                              bool xform )
+{
+    ERRMSG << "\n + [INFO] polyline approximation is not supported for entity type ";
+    std::cerr << entityType << "\n";
+    return false;
+}
@@ -30,13 +30,30 @@
 #include <sstream>
 #include <error_macros.h>
 #include <core/iges.h>
+#include <core/iges_detable.h>
+#include <core/iges_names.h>
 #include <core/all_entities.h>
 #include <core/iges_io.h>
+#include <core/iges_memory.h>
+#include <core/iges_parallel.h>
 
 
 using namespace std;
 
 
+// refreshes the entity's row in the parent's DE table when the
+// enclosing function returns, regardless of the return path
+class IGES_ENTITY::DE_UPDATE
+{
+private:
+    IGES_ENTITY* m_entity;
+
+public:
+    DE_UPDATE( IGES_ENTITY* aEntity ) : m_entity( aEntity ) {}
+    ~DE_UPDATE() { m_entity->updateDE(); }
+};
+
+
 IGES_ENTITY::IGES_ENTITY(IGES* aParent)
 {
     // master IGES object; contains globals and manages entity I/O
@@ -101,6 +118,9 @@ IGES_ENTITY::IGES_ENTITY(IGES* aParent)
     // 1..8 digit unsigned int associated with the label
     entitySubscript = 0;
 
+    // row within the parent's DE table (none until the table is built)
+    deRow = -1;
+
     // pointers which may be linked to other entities:
     pStructure = NULL;
     pLineFontPattern = NULL;
@@ -116,17 +136,23 @@ IGES_ENTITY::IGES_ENTITY(IGES* aParent)
 
 IGES_ENTITY::~IGES_ENTITY()
 {
-    list< bool* >::iterator sVF = m_validFlags.begin();
-    list< bool* >::iterator eVF = m_validFlags.end();
-
-    while( sVF != eVF )
+    do
     {
-        **sVF = false;
-        ++sVF;
-    }
+        IGES_CACHE_LOCK lock;
+        list< bool* >::iterator sVF = m_validFlags.begin();
+        list< bool* >::iterator eVF = m_validFlags.end();
+
+        while( sVF != eVF )
+        {
+            **sVF = false;
+            ++sVF;
+        }
+
+        m_validFlags.clear();
+    } while( 0 );
 
-    m_validFlags.clear();
     comments.clear();
+    vcomments.clear();
 
     if( !refs.empty() )
     {
@@ -226,6 +252,8 @@ void IGES_ENTITY::AttachValidFlag( bool* aFlag )
     if( NULL == aFlag )
         return;
 
+    IGES_CACHE_LOCK lock;
+
     list< bool* >::iterator sVF = m_validFlags.begin();
     list< bool* >::iterator eVF = m_validFlags.end();
 
@@ -252,6 +280,8 @@ void IGES_ENTITY::DetachValidFlag( bool* aFlag )
     if( NULL == aFlag )
         return;
 
+    IGES_CACHE_LOCK lock;
+
     list< bool* >::iterator sVF = m_validFlags.begin();
     list< bool* >::iterator eVF = m_validFlags.end();
 
@@ -273,12 +303,14 @@ void IGES_ENTITY::DetachValidFlag( bool* aFlag )
 
 void IGES_ENTITY::Compact( void )
 {
-    vcomments.clear();
+    return;
 }
 
 
 bool IGES_ENTITY::unlink(IGES_ENTITY *aChild)
 {
+    DE_UPDATE deUpdate( this );
+
     // unlink and return true if the child matches
     // one of:
     // pStructure;
@@ -361,6 +393,8 @@ bool IGES_ENTITY::unlink(IGES_ENTITY *aChild)
 
 bool IGES_ENTITY::addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate)
 {
+    DE_UPDATE deUpdate( this );
+
     isDuplicate = false;
 
     if( !aParentEntity )
@@ -415,6 +449,8 @@ bool IGES_ENTITY::addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate)
 
 bool IGES_ENTITY::delReference(IGES_ENTITY *aParentEntity)
 {
+    DE_UPDATE deUpdate( this );
+
     if( NULL == aParentEntity )
     {
         ERRMSG << "\n + [BUG] parent entity is a NULL pointer\n";
@@ -1053,12 +1089,91 @@ bool IGES_ENTITY::associate(std::vector<IGES_ENTITY *> *entities)
 }   // associate()
 
 
+void IGES_ENTITY::getRefIndices( std::vector<int>& aList )
+{
+    if( structure > 0 )
+        aList.push_back( structure >> 1 );
+
+    if( lineFontPattern < 0 )
+        aList.push_back( ( -lineFontPattern ) >> 1 );
+
+    if( level < 0 )
+        aList.push_back( ( -level ) >> 1 );
+
+    if( view > 0 )
+        aList.push_back( view >> 1 );
+
+    if( transform > 0 )
+        aList.push_back( transform >> 1 );
+
+    if( labelAssoc > 0 )
+        aList.push_back( labelAssoc >> 1 );
+
+    if( colorNum < 0 )
+        aList.push_back( ( -colorNum ) >> 1 );
+
+    std::list<int>::const_iterator sExt = iExtras.begin();
+    std::list<int>::const_iterator eExt = iExtras.end();
+
+    while( sExt != eExt )
+    {
+        if( *sExt > 0 )
+            aList.push_back( *sExt >> 1 );
+
+        ++sExt;
+    }
+
+    return;
+}
+
+
 void IGES_ENTITY::unformat( void )
 {
     pdout.clear();
 }
 
 
+bool IGES_ENTITY::relocatePD( int aIndex )
+{
+    if( pdout.empty() || 0 != (pdout.length() % 81) )
+    {
+        ERRMSG << "\n + [BUG] improperly formatted PD output (length=";
+        cerr << pdout.length() << ")\n";
+        return false;
+    }
+
+    int nLines = (int)(pdout.length() / 81);
+
+    if( aIndex < 1 || aIndex + nLines - 1 > 9999999 )
+    {
+        ERRMSG << "\n + [ERROR] PD Sequence Number exceeds limitations of IGES specification\n";
+        return false;
+    }
+
+    // each line is 64 columns of data, an 8 column DE Sequence Number,
+    // 'P' and a 7 column right-justified PD Sequence Number
+    char* lp = &pdout[0];
+
+    for( int i = 0; i < nLines; ++i, lp += 81 )
+    {
+        int num = aIndex + i;
+        int col = 79;
+
+        do
+        {
+            lp[col--] = (char)('0' + num % 10);
+            num /= 10;
+        } while( num > 0 );
+
+        while( col > 72 )
+            lp[col--] = ' ';
+    }
+
+    parameterData = aIndex;
+    return true;
+}
+
+
 bool IGES_ENTITY::readDE(IGES_RECORD *aRecord, std::ifstream &aFile, int &aSequenceVar)
 {
     // Read in the basic DE data only; it is the responsibility of
@@ -1578,7 +1693,7 @@ bool IGES_ENTITY::readPD(std::ifstream &aFile, int &aSequenceVar)
 }   // readPD()
 
 
-bool IGES_ENTITY::writeDE(std::ofstream &aFile)
+bool IGES_ENTITY::writeDE(std::ostream &aFile)
 {
     std::string oln1;   // DE Line 1
     std::string oln2;   // DE Line 2
@@ -1842,7 +1957,7 @@ bool IGES_ENTITY::writeDE(std::ofstream &aFile)
 }
 
 
-bool IGES_ENTITY::writePD(std::ofstream &aFile)
+bool IGES_ENTITY::writePD(std::ostream &aFile)
 {
     if( pdout.empty() || 0 != (pdout.length() % 81) )
     {
@@ -1958,6 +2073,8 @@ bool IGES_ENTITY::GetLineFontPatternEntity(IGES_ENTITY** aPattern)
 
 bool IGES_ENTITY::SetLineFontPattern( IGES_LINEFONT_PATTERN aPattern )
 {
+    DE_UPDATE deUpdate( this );
+
     if( pLineFontPattern )
     {
         pLineFontPattern->delReference(this);
@@ -1978,6 +2095,8 @@ bool IGES_ENTITY::SetLineFontPattern( IGES_LINEFONT_PATTERN aPattern )
 
 bool IGES_ENTITY::SetLineFontPattern( IGES_ENTITY* aPattern )
 {
+    DE_UPDATE deUpdate( this );
+
     lineFontPattern = 0;
 
     if( pLineFontPattern )
@@ -2060,6 +2179,8 @@ bool IGES_ENTITY::GetLevelEntity(IGES_ENTITY** aLevel)
 
 bool IGES_ENTITY::SetLevel( int aLevel )
 {
+    DE_UPDATE deUpdate( this );
+
     if( pLevel )
     {
         pLevel->delReference(this);
@@ -2080,6 +2201,8 @@ bool IGES_ENTITY::SetLevel( int aLevel )
 
 bool IGES_ENTITY::SetLevel( IGES_ENTITY* aLevel )
 {
+    DE_UPDATE deUpdate( this );
+
     level = 0;
 
     if( pLevel )
@@ -2364,6 +2487,8 @@ bool IGES_ENTITY::GetColorEntity(IGES_ENTITY** aColor)
 
 bool IGES_ENTITY::SetColor( IGES_COLOR aColor )
 {
+    DE_UPDATE deUpdate( this );
+
     if( pColor )
     {
         pColor->delReference(this);
@@ -2385,6 +2510,8 @@ bool IGES_ENTITY::SetColor( IGES_COLOR aColor )
 
 bool IGES_ENTITY::SetColor( IGES_ENTITY* aColor )
 {
+    DE_UPDATE deUpdate( this );
+
     colorNum = 0;
 
     if( pColor )
@@ -2439,6 +2566,8 @@ bool IGES_ENTITY::GetLineWeightNum(int& aLineWeight)
 
 bool IGES_ENTITY::SetLineWeightNum( int aLineWeight )
 {
+    DE_UPDATE deUpdate( this );
+
     if( aLineWeight < 0 )
     {
         ERRMSG << "\n + [WARNING] [BUG] negative line weight number\n";
@@ -2470,6 +2599,8 @@ bool IGES_ENTITY::SetLineWeightNum( int aLineWeight )
 
 bool IGES_ENTITY::SetLabel(const std::string aLabel)
 {
+    DE_UPDATE deUpdate( this );
+
     label = aLabel.substr(0, 8);
 
     if( aLabel.length() > 8 )
@@ -2497,6 +2628,8 @@ const char* IGES_ENTITY::GetLabel()
 
 bool IGES_ENTITY::SetEntitySubscript(int aSubscript)
 {
+    DE_UPDATE deUpdate( this );
+
     if( aSubscript >= 0 && aSubscript <= 99999999 )
     {
         entitySubscript = aSubscript;
@@ -2516,6 +2649,8 @@ bool IGES_ENTITY::GetEntitySubscript(int& aSubscript)
 
 bool IGES_ENTITY::SetVisibility(bool isVisible)
 {
+    DE_UPDATE deUpdate( this );
+
     visible = isVisible;
     return true;
 }
@@ -2649,6 +2784,8 @@ bool IGES_ENTITY::readComments( int& index )
         index += 64;
     }
 
+    syncComments( 0 );
+
     if( index != (int)pdout.length() )
     {
         ERRMSG << "\n + [WARNING] comment block does not seem to be a multiple of 64 bytes\n";
@@ -2787,8 +2924,8 @@ bool IGES_ENTITY::formatComments( int& pdSeq )
     if( comments.empty() )
         return true;
 
-    std::list<std::string>::iterator sCom = comments.begin();
-    std::list<std::string>::iterator eCom = comments.end();
+    std::vector<std::string>::iterator sCom = comments.begin();
+    std::vector<std::string>::iterator eCom = comments.end();
     std::string tmp;
     std::string tmp1;
 
@@ -2954,12 +3091,7 @@ const char* IGES_ENTITY::GetComment( int aIndex )
     if( aIndex < 0 || aIndex >= ne )
         return NULL;
 
-    std::list< std::string >::iterator sI = comments.begin();
-
-    for( int i = 0; i < aIndex; ++i )
-        ++sI;
-
-    return sI->c_str();
+    return vcomments[aIndex];
 }
 
 
@@ -2972,20 +3104,6 @@ bool IGES_ENTITY::GetComments( size_t& aListSize, char const**& aCommentList )
         return false;
     }
 
-    if( comments.size() != vcomments.size() )
-    {
-        vcomments.clear();
-
-        list< string >::iterator sCL = comments.begin();
-        list< string >::iterator eCL = comments.end();
-
-        while( sCL != eCL )
-        {
-            vcomments.push_back( sCL->c_str() );
-            ++sCL;
-        }
-    }
-
     aListSize = vcomments.size();
     aCommentList = &vcomments[0];
     return true;
@@ -2999,8 +3117,15 @@ bool IGES_ENTITY::AddComment( const std::string& aComment )
         ERRMSG << "\n + [INFO] empty comment string\n";
     }
 
+    size_t cap = comments.capacity();
     comments.push_back( aComment );
-    vcomments.clear();
+
+    // a reallocation moves all strings
+    if( cap != comments.capacity() )
+        syncComments( 0 );
+    else
+        syncComments( comments.size() - 1 );
+
     return true;
 }
 
@@ -3014,16 +3139,8 @@ bool IGES_ENTITY::DelComment( int index )
         return false;
     }
 
-    list<string>::iterator bs = comments.begin();
-
-    int i = 0;
-    while( i < index )
-    {
-        ++i;
-        ++bs;
-    }
-
-    comments.erase( bs );
+    comments.erase( comments.begin() + index );
+    syncComments( index );
     return true;
 }
 
@@ -3031,12 +3148,60 @@ bool IGES_ENTITY::DelComment( int index )
 bool IGES_ENTITY::ClearComments( void )
 {
     comments.clear();
+    vcomments.clear();
     return true;
 }
 
 
+size_t IGES_ENTITY::getBaseHeapSize( void )
+{
+    return HeapSize( label ) + HeapSize( comments ) + HeapSize( vcomments )
+           + HeapSize( pdout ) + HeapSize( m_validFlags );
+}
+
+
+size_t IGES_ENTITY::getRefSize( void )
+{
+    return HeapSize( refs ) + HeapSize( extras ) + HeapSize( iExtras );
+}
+
+
+void IGES_ENTITY::updateDE( void )
+{
+    if( NULL != parent && NULL != parent->deTable )
+        parent->deTable->Update( this );
+
+    return;
+}
+
+
+void IGES_ENTITY::setName( std::string& aField, const std::string& aNewName )
+{
+    if( NULL != parent )
+        parent->nameIndex->Rename( this, aField, aNewName );
+    else
+        aField = aNewName;
+
+    return;
+}
+
+
+void IGES_ENTITY::syncComments( size_t aFirst )
+{
+    size_t nc = comments.size();
+    vcomments.resize( nc );
+
+    for( size_t i = aFirst; i < nc; ++i )
+        vcomments[i] = comments[i].c_str();
+
+    return;
+}
+
+
 bool IGES_ENTITY::SetDependency( IGES_STAT_DEPENDS aDependency )
 {
+    DE_UPDATE deUpdate( this );
+
     depends = aDependency;
     return true;
 }
@@ -3044,6 +3209,8 @@ bool IGES_ENTITY::SetDependency( IGES_STAT_DEPENDS aDependency )
 
 bool IGES_ENTITY::SetEntityUse( IGES_STAT_USE aUseCase )
 {
+    DE_UPDATE deUpdate( this );
+
     use = aUseCase;
     return true;
 }
@@ -3051,6 +3218,8 @@ bool IGES_ENTITY::SetEntityUse( IGES_STAT_USE aUseCase )
 
 bool IGES_ENTITY::SetHierarchy( IGES_STAT_HIER aHierarchy )
 {
+    DE_UPDATE deUpdate( this );
+
     if( aHierarchy == STAT_HIER_USE_PROP
         || hierarchy == STAT_HIER_USE_PROP )
     {
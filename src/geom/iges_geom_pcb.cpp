@@ -39,11 +39,13 @@
 #include <core/entity100.h>
 #include <core/entity102.h>
 #include <core/entity110.h>
+#include <core/entity122.h>
 #include <core/entity124.h>
 #include <core/entity126.h>
 #include <core/entity128.h>
 #include <core/entity142.h>
 #include <core/entity144.h>
+#include <core/iges_bezier.h>
 #include <sisl.h>
 
 
@@ -54,6 +56,9 @@ using namespace std;
     msg << __FILE__ << ":" << __LINE__ << ":" << __FUNCTION__ << ": "; \
 } while( 0 )
 
+// maximum gap (in parameter space) between the ends of curves to be joined
+#define JOIN_TOL (1e-6)
+
 
 static bool newEnt102( IGES* aModel, IGES_ENTITY_102** cp )
 {
@@ -150,8 +155,300 @@ static bool newArc126( IGES* aModel, IGES_ENTITY_126** ap )
 }
 
 
+static bool newLine110( IGES* aModel, IGES_ENTITY_110** lp )
+{
+    IGES_ENTITY* ep;
+
+    if( !aModel->NewEntity( ENT_LINE, &ep ) )
+        return false;
+
+    *lp = dynamic_cast<IGES_ENTITY_110*>( ep );
+
+    if( !(*lp) )
+    {
+        aModel->DelEntity( ep );
+        return false;
+    }
+
+    return true;
+}
+
+
+static bool newEnt122( IGES* aModel, IGES_ENTITY_122** sp )
+{
+    IGES_ENTITY* ep;
+
+    if( !aModel->NewEntity( ENT_TABULATED_CYLINDER, &ep ) )
+        return false;
+
+    *sp = dynamic_cast<IGES_ENTITY_122*>( ep );
+
+    if( !(*sp) )
+    {
+        aModel->DelEntity( ep );
+        return false;
+    }
+
+    return true;
+}
+
+
+static bool newEnt144( IGES* aModel, IGES_ENTITY_144** sp )
+{
+    IGES_ENTITY* ep;
+
+    if( !aModel->NewEntity( ENT_TRIMMED_PARAMETRIC_SURFACE, &ep ) )
+        return false;
+
+    *sp = dynamic_cast<IGES_ENTITY_144*>( ep );
+
+    if( !(*sp) )
+    {
+        aModel->DelEntity( ep );
+        return false;
+    }
+
+    return true;
+}
+
+
+// create a NURBS curve which exactly represents a segment of an outline
+// at the given height in the direction of travel; arcs are rational
+// quadratic curves with one piece per quarter circle or part thereof
+static bool newSegment126( IGES* aModel, MCAD_SEGMENT* aSegment, double zHeight,
+                           IGES_ENTITY_126** ap )
+{
+    *ap = NULL;
+
+    std::vector<double> knots;
+    std::vector<double> coeffs;
+    int order;
+    bool isRational;
+
+    if( MCAD_SEGTYPE_LINE == aSegment->GetSegType() )
+    {
+        MCAD_POINT p0 = aSegment->GetMStart();
+        MCAD_POINT p1 = aSegment->GetMEnd();
+        double k[4] = { 0.0, 0.0, 1.0, 1.0 };
+        double c[6] = { p0.x, p0.y, zHeight, p1.x, p1.y, zHeight };
+
+        order = 2;
+        isRational = false;
+        knots.assign( k, k + 4 );
+        coeffs.assign( c, c + 6 );
+    }
+    else
+    {
+        MCAD_POINT pc = aSegment->GetCenter();
+        double rad = aSegment->GetRadius();
+        double a0 = aSegment->GetMSAngle();
+        double da = aSegment->GetMEAngle() - a0;
+
+        // a circle is traversed counterclockwise from angle 0
+        if( MCAD_SEGTYPE_CIRCLE == aSegment->GetSegType() )
+        {
+            a0 = 0.0;
+            da = 2.0 * M_PI;
+        }
+
+        int np = (int)ceil( fabs( da ) / ( 0.5 * M_PI ) - 1e-9 );
+
+        if( np < 1 )
+            np = 1;
+
+        da /= np;
+
+        double w = cos( 0.5 * da );
+        double rm = rad / w;
+
+        order = 3;
+        isRational = true;
+        knots.assign( 3, 0.0 );
+
+        for( int i = 0; i < np; ++i )
+        {
+            double ang = a0 + i * da;
+            double c[8] = { pc.x + rad * cos( ang ), pc.y + rad * sin( ang ), zHeight, 1.0,
+                            pc.x + rm * cos( ang + 0.5 * da ),
+                            pc.y + rm * sin( ang + 0.5 * da ), zHeight, w };
+
+            coeffs.insert( coeffs.end(), c, c + 8 );
+            knots.insert( knots.end(), ( i + 1 < np ) ? 2 : 3, (double)( i + 1 ) );
+        }
+
+        double c[4] = { pc.x + rad * cos( a0 + np * da ), pc.y + rad * sin( a0 + np * da ),
+                        zHeight, 1.0 };
+
+        coeffs.insert( coeffs.end(), c, c + 4 );
+    }
+
+    int nCoeff = (int)( coeffs.size() / ( isRational ? 4 : 3 ) );
+
+    if( !newArc126( aModel, ap ) )
+        return false;
+
+    if( !(*ap)->SetNURBSData( nCoeff, order, &knots[0], &coeffs[0], isRational,
+                              knots.front(), knots.back() ) )
+    {
+        aModel->DelEntity( (IGES_ENTITY*)(*ap) );
+        *ap = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+
+// join a sequence of B-Splines, each of which begins where the previous
+// one ends, into a single B-Spline which is C0 continuous at the joints.
+// The B-Splines are split into Bezier pieces which are raised to the
+// highest degree among them and stitched together with knots of full
+// multiplicity. aCoeffs receives homogeneous points (wx, wy, wz, w).
+static bool joinNURBS( std::list<IGES_ENTITY_126*>& aCurves, int& aOrder,
+                       std::vector<double>& aKnots, std::vector<double>& aCoeffs )
+{
+    std::vector<IGES_BEZIER_CURVE> bez( aCurves.size() );
+    std::list<IGES_ENTITY_126*>::iterator sC = aCurves.begin();
+    std::list<IGES_ENTITY_126*>::iterator eC = aCurves.end();
+    size_t idx = 0;
+
+    aOrder = 0;
+    aKnots.clear();
+    aCoeffs.clear();
+
+    while( sC != eC )
+    {
+        int nCoeff;
+        int order;
+        double* knot;
+        double* coeff;
+        bool isRational;
+        bool isClosed;
+        bool isPeriodic;
+        double v0;
+        double v1;
+
+        if( !(*sC)->GetNURBSData( nCoeff, order, &knot, &coeff, isRational,
+                                  isClosed, isPeriodic, v0, v1 )
+            || !bez[idx].Build( nCoeff, order, knot, coeff, isRational, v0, v1 ) )
+            return false;
+
+        if( order > aOrder )
+            aOrder = order;
+
+        ++idx;
+        ++sC;
+    }
+
+    if( 0 == aOrder )
+        return false;
+
+    int p = aOrder - 1;
+    double t = 0.0;
+    std::vector<double> seg( aOrder * 4 );
+
+    aKnots.assign( aOrder, 0.0 );
+
+    for( size_t i = 0; i < bez.size(); ++i )
+    {
+        int nSegs = bez[i].GetNSegments();
+
+        for( int j = 0; j < nSegs; ++j )
+        {
+            double a;
+            double b;
+            const double* bp = bez[i].GetSegment( j, a, b );
+            int k = bez[i].GetOrder();
+
+            for( int n = 0; n < k * 4; ++n )
+                seg[n] = bp[n];
+
+            // raise the degree of the piece from k - 1 to k
+            for( ; k < aOrder; ++k )
+            {
+                for( int n = 0; n < 4; ++n )
+                    seg[k * 4 + n] = seg[( k - 1 ) * 4 + n];
+
+                for( int m = k - 1; m > 0; --m )
+                {
+                    double alpha = (double)m / (double)k;
+
+                    for( int n = 0; n < 4; ++n )
+                        seg[m * 4 + n] = alpha * seg[( m - 1 ) * 4 + n]
+                                         + ( 1.0 - alpha ) * seg[m * 4 + n];
+                }
+            }
+
+            int first = 0;
+
+            if( !aCoeffs.empty() )
+            {
+                // scale the piece so that the weights agree at the joint
+                const double* lp = &aCoeffs[aCoeffs.size() - 4];
+                double sf = lp[3] / seg[3];
+
+                for( int n = 0; n < aOrder * 4; ++n )
+                    seg[n] *= sf;
+
+                for( int n = 0; n < 3; ++n )
+                {
+                    if( fabs( lp[n] / lp[3] - seg[n] / seg[3] ) > JOIN_TOL )
+                        return false;
+                }
+
+                first = 1;
+            }
+
+            aCoeffs.insert( aCoeffs.end(), seg.begin() + first * 4, seg.end() );
+            t += b - a;
+            aKnots.insert( aKnots.end(), p, t );
+        }
+    }
+
+    aKnots.push_back( t );
+    return true;
+}
+
+
+// transfer homogeneous points to a NURBS curve entity
+static bool setJoinedData( IGES_ENTITY_126* aCurve, int aOrder,
+                           const std::vector<double>& aKnots,
+                           const std::vector<double>& aCoeffs )
+{
+    int nCoeff = (int)( aCoeffs.size() / 4 );
+    bool isRational = false;
+
+    for( int i = 0; i < nCoeff && !isRational; ++i )
+    {
+        if( fabs( aCoeffs[i * 4 + 3] - 1.0 ) > 1e-12 )
+            isRational = true;
+    }
+
+    int stride = isRational ? 4 : 3;
+    std::vector<double> coeff( nCoeff * stride );
+
+    for( int i = 0; i < nCoeff; ++i )
+    {
+        const double* hp = &aCoeffs[i * 4];
+        double* cp = &coeff[i * stride];
+
+        cp[0] = hp[0] / hp[3];
+        cp[1] = hp[1] / hp[3];
+        cp[2] = hp[2] / hp[3];
+
+        if( isRational )
+            cp[3] = hp[3];
+    }
+
+    return aCurve->SetNURBSData( nCoeff, aOrder, &aKnots[0], &coeff[0], isRational,
+                                 aKnots.front(), aKnots.back() );
+}
+
+
 IGES_GEOM_PCB::IGES_GEOM_PCB()
 {
+    mJoinCurves = false;
+    mExtrudeLoops = false;
     mIsClosed = false;
     mWinding = 0.0;
     mBBisOK = false;
@@ -184,6 +481,20 @@ IGES_GEOM_PCB::~IGES_GEOM_PCB()
 }
 
 
+void IGES_GEOM_PCB::SetJoinCurves( bool aJoin )
+{
+    mJoinCurves = aJoin;
+    return;
+}
+
+
+void IGES_GEOM_PCB::SetExtrudeLoops( bool aExtrude )
+{
+    mExtrudeLoops = aExtrude;
+    return;
+}
+
+
 // retrieve trimmed parametric surfaces representing vertical sides
 // of the main outline and all cutouts
 bool IGES_GEOM_PCB::GetVerticalSurface( IGES* aModel, bool& error,
@@ -214,6 +525,17 @@ bool IGES_GEOM_PCB::GetVerticalSurface( IGES* aModel, bool& error,
         return false;
     }
 
+    if( mExtrudeLoops )
+    {
+        if( !extrudeLoops( aModel, aSurface, aTopZ, aBotZ ) )
+        {
+            error = true;
+            return false;
+        }
+
+        return true;
+    }
+
     list<MCAD_SEGMENT*>::iterator sSeg = msegments.begin();
     list<MCAD_SEGMENT*>::iterator eSeg = msegments.end();
 
@@ -338,6 +660,19 @@ bool IGES_GEOM_PCB::GetTrimmedPlane( IGES* aModel, bool& error,
         return false;
     }
 
+    // Steps 2 .. 4 with the BREP representation of each bound as a single curve
+    if( mJoinCurves )
+    {
+        if( !trimJoined( aModel, plane, aHeight, aReverse ) )
+        {
+            error = true;
+            return false;
+        }
+
+        aSurface.push_back( plane );
+        return true;
+    }
+
     // Step 2: create the outer bound (PTO); this is a Curve on Parametric Surface
     list<MCAD_SEGMENT*>::iterator sSeg = msegments.begin();
     list<MCAD_SEGMENT*>::iterator eSeg = msegments.end();
@@ -734,6 +1069,435 @@ bool IGES_GEOM_PCB::GetTrimmedPlane( IGES* aModel, bool& error,
 }
 
 
+// add the outer bound (PTO) and the bounds of all cutouts and drill
+// holes (PTI) to the plane; each bound is a Curve on Parametric Surface
+// whose BREP representation is a single NURBS curve
+bool IGES_GEOM_PCB::trimJoined( IGES* aModel, IGES_ENTITY_144* aPlane,
+                                double aHeight, bool aReverse )
+{
+    IGES_ENTITY* pts;
+    IGES_ENTITY_142* scurve;
+    aPlane->GetPTS( pts );
+
+    if( !getJoinedBound( aModel, msegments, pts, aHeight, aReverse, &scurve ) )
+        return false;
+
+    if( !aPlane->SetPTO( scurve ) )
+    {
+        ostringstream msg;
+        GEOM_ERR( msg );
+        msg << "[ERROR] could not add curve on surface to trimmed surface";
+        ERRMSG << msg.str() << "\n";
+        errors.push_back( msg.str() );
+        return false;
+    }
+
+    list<MCAD_OUTLINE*>::iterator sCO = mcutouts.begin();
+    list<MCAD_OUTLINE*>::iterator eCO = mcutouts.end();
+    list<MCAD_SEGMENT*>::iterator sDH = mholes.begin();
+    list<MCAD_SEGMENT*>::iterator eDH = mholes.end();
+    list<MCAD_SEGMENT*> hole;
+
+    while( sCO != eCO || sDH != eDH )
+    {
+        bool ok;
+
+        if( sCO != eCO )
+        {
+            ok = getJoinedBound( aModel, *(*sCO)->GetSegments(), pts, aHeight,
+                                 aReverse, &scurve );
+            ++sCO;
+        }
+        else
+        {
+            hole.assign( 1, *sDH );
+            ok = getJoinedBound( aModel, hole, pts, aHeight, aReverse, &scurve );
+            ++sDH;
+        }
+
+        if( !ok )
+            return false;
+
+        if( !aPlane->AddPTI( scurve ) )
+        {
+            ostringstream msg;
+            GEOM_ERR( msg );
+            msg << "[ERROR] could not add curve on surface to trimmed surface PTI list";
+            ERRMSG << msg.str() << "\n";
+            errors.push_back( msg.str() );
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+// create a Curve on Parametric Surface representing a closed loop of
+// segments; the BREP curve is the concatenation of the curves produced by
+// GetCurveOnPlane() while the geometric representation remains a composite
+// of the exact lines and arcs produced by GetCurves()
+bool IGES_GEOM_PCB::getJoinedBound( IGES* aModel, std::list<MCAD_SEGMENT*>& aSegments,
+                                    IGES_ENTITY* aPTS, double aHeight, bool aReverse,
+                                    IGES_ENTITY_142** aBound )
+{
+    *aBound = NULL;
+
+    list<MCAD_SEGMENT*>::iterator sSeg = aSegments.begin();
+    list<MCAD_SEGMENT*>::iterator eSeg = aSegments.end();
+    list<IGES_ENTITY_126*> bcurves;
+    bool ok = true;
+
+    while( ok && sSeg != eSeg )
+    {
+        ok = GetCurveOnPlane( aModel, bcurves, mBottomLeft.x, mTopRight.x,
+                              mBottomLeft.y, mTopRight.y, aHeight, *sSeg, aReverse );
+        ++sSeg;
+    }
+
+    int order = 0;
+    vector<double> knots;
+    vector<double> coeffs;
+
+    if( ok )
+        ok = joinNURBS( bcurves, order, knots, coeffs );
+
+    while( !bcurves.empty() )
+    {
+        aModel->DelEntity( (IGES_ENTITY*)bcurves.back() );
+        bcurves.pop_back();
+    }
+
+    IGES_ENTITY_126* bcurve = NULL;
+
+    if( !ok || !newArc126( aModel, &bcurve )
+        || !setJoinedData( bcurve, order, knots, coeffs ) )
+    {
+        if( bcurve )
+            aModel->DelEntity( (IGES_ENTITY*)bcurve );
+
+        ostringstream msg;
+        GEOM_ERR( msg );
+        msg << "[ERROR] could not render BREP curve on surface";
+        ERRMSG << msg.str() << "\n";
+        errors.push_back( msg.str() );
+        return false;
+    }
+
+    list<IGES_CURVE*> ncurves;
+    IGES_ENTITY_102* ccurve = NULL;
+    IGES_ENTITY_142* scurve = NULL;
+
+    ok = newEnt102( aModel, &ccurve );
+    sSeg = aSegments.begin();
+
+    while( ok && sSeg != eSeg )
+    {
+        ok = GetCurves( aModel, ncurves, aHeight, *sSeg );
+        ++sSeg;
+    }
+
+    list<IGES_CURVE*>::iterator sNC = ncurves.begin();
+    list<IGES_CURVE*>::iterator eNC = ncurves.end();
+
+    while( ok && sNC != eNC )
+    {
+        ok = ccurve->AddSegment( *sNC );
+        ++sNC;
+    }
+
+    if( ok )
+        ok = newEnt142( aModel, &scurve );
+
+    if( ok )
+    {
+        scurve->SetSPTR( aPTS );
+        scurve->CRTN = 1;
+        scurve->PREF = 1;
+        ok = scurve->SetBPTR( (IGES_ENTITY*)bcurve )
+             && scurve->SetCPTR( (IGES_ENTITY*)ccurve );
+    }
+
+    if( !ok )
+    {
+        if( scurve )
+            aModel->DelEntity( (IGES_ENTITY*)scurve );
+
+        if( ccurve )
+            aModel->DelEntity( (IGES_ENTITY*)ccurve );
+
+        aModel->DelEntity( (IGES_ENTITY*)bcurve );
+
+        ostringstream msg;
+        GEOM_ERR( msg );
+        msg << "[ERROR] could not render geometric curve on surface";
+        ERRMSG << msg.str() << "\n";
+        errors.push_back( msg.str() );
+        return false;
+    }
+
+    *aBound = scurve;
+    return true;
+}
+
+
+// render the vertical sides of the main outline, all drill holes and
+// all cutouts with one Tabulated Cylinder per closed loop
+bool IGES_GEOM_PCB::extrudeLoops( IGES* aModel, std::vector<IGES_ENTITY_144*>& aSurface,
+                                  double aTopZ, double aBotZ )
+{
+    if( !getLoopWall( aModel, aSurface, aTopZ, aBotZ, msegments, false ) )
+    {
+        ostringstream msg;
+        GEOM_ERR( msg );
+        msg << "[ERROR] could not render the vertical surface of the outline";
+        ERRMSG << msg.str() << "\n";
+        errors.push_back( msg.str() );
+        return false;
+    }
+
+    list<MCAD_SEGMENT*>::iterator sDH = mholes.begin();
+    list<MCAD_SEGMENT*>::iterator eDH = mholes.end();
+    list<MCAD_SEGMENT*> hole;
+
+    while( sDH != eDH )
+    {
+        hole.assign( 1, *sDH );
+
+        if( !getLoopWall( aModel, aSurface, aTopZ, aBotZ, hole, true ) )
+        {
+            ostringstream msg;
+            GEOM_ERR( msg );
+            msg << "[ERROR] could not render the vertical surface of a hole";
+            ERRMSG << msg.str() << "\n";
+            errors.push_back( msg.str() );
+            return false;
+        }
+
+        ++sDH;
+    }
+
+    list<MCAD_OUTLINE*>::iterator sCO = mcutouts.begin();
+    list<MCAD_OUTLINE*>::iterator eCO = mcutouts.end();
+
+    while( sCO != eCO )
+    {
+        if( !getLoopWall( aModel, aSurface, aTopZ, aBotZ, *(*sCO)->GetSegments(), true ) )
+        {
+            ostringstream msg;
+            GEOM_ERR( msg );
+            msg << "[ERROR] could not render the vertical surface of a cutout";
+            ERRMSG << msg.str() << "\n";
+            errors.push_back( msg.str() );
+            return false;
+        }
+
+        ++sCO;
+    }
+
+    return true;
+}
+
+
+// create a Trimmed Parametric Surface whose PTS is a Tabulated Cylinder;
+// the directrix is the closed loop at the bottom (at the top if aReverse
+// is true, which reverses the surface normal) joined into a single exact
+// NURBS curve with parameter range 0..1 and the generatrix spans the
+// height of the loop. The outer bound is the unit square in parameter space; its
+// geometric representation is the directrix, a seam, the directrix
+// reversed at the opposite height and the seam reversed.
+bool IGES_GEOM_PCB::getLoopWall( IGES* aModel, std::vector<IGES_ENTITY_144*>& aSurface,
+                                 double aTopZ, double aBotZ,
+                                 std::list<MCAD_SEGMENT*>& aSegments, bool aReverse )
+{
+    if( !aModel )
+    {
+        ERRMSG << "\n + [ERROR] null pointer passed for IGES model\n";
+        return false;
+    }
+
+    if( fabs( aTopZ - aBotZ ) < 1e-6 )
+    {
+        ERRMSG << "\n + [ERROR] degenerate surface\n";
+        return false;
+    }
+
+    double z0 = aReverse ? aTopZ : aBotZ;
+    double z1 = aReverse ? aBotZ : aTopZ;
+
+    list<MCAD_SEGMENT*>::iterator sSeg = aSegments.begin();
+    list<MCAD_SEGMENT*>::iterator eSeg = aSegments.end();
+    list<IGES_ENTITY_126*> dcurves;
+    bool ok = true;
+
+    while( ok && sSeg != eSeg )
+    {
+        IGES_ENTITY_126* cp = NULL;
+        ok = newSegment126( aModel, *sSeg, z0, &cp );
+
+        if( ok )
+            dcurves.push_back( cp );
+
+        ++sSeg;
+    }
+
+    int order = 0;
+    vector<double> knots;
+    vector<double> coeffs;
+
+    if( ok )
+        ok = joinNURBS( dcurves, order, knots, coeffs );
+
+    while( !dcurves.empty() )
+    {
+        aModel->DelEntity( (IGES_ENTITY*)dcurves.back() );
+        dcurves.pop_back();
+    }
+
+    if( !ok || knots.back() <= 0.0 )
+    {
+        ERRMSG << "\n + [ERROR] could not create the directrix of a loop\n";
+        return false;
+    }
+
+    int nKnots = (int)knots.size();
+    int nCoeff = (int)( coeffs.size() / 4 );
+    double tEnd = knots.back();
+
+    for( int i = 0; i < nKnots; ++i )
+        knots[i] /= tEnd;
+
+    // the directrix reversed and moved to the opposite height
+    vector<double> rknots( nKnots );
+    vector<double> rcoeffs( coeffs.size() );
+
+    for( int i = 0; i < nKnots; ++i )
+        rknots[i] = 1.0 - knots[nKnots - 1 - i];
+
+    for( int i = 0; i < nCoeff; ++i )
+    {
+        const double* hp = &coeffs[( nCoeff - 1 - i ) * 4];
+        double* rp = &rcoeffs[i * 4];
+
+        rp[0] = hp[0];
+        rp[1] = hp[1];
+        rp[2] = z1 * hp[3];
+        rp[3] = hp[3];
+    }
+
+    // the bound in parameter space: the unit square traversed counterclockwise
+    static const double sq[5][2] = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 1.0, 1.0 },
+                                     { 0.0, 1.0 }, { 0.0, 0.0 } };
+    vector<double> bknots( 7 );
+    vector<double> bcoeffs( 20 );
+
+    bknots[0] = 0.0;
+
+    for( int i = 0; i < 5; ++i )
+    {
+        bknots[i + 1] = i;
+        bcoeffs[i * 4] = sq[i][0];
+        bcoeffs[i * 4 + 1] = sq[i][1];
+        bcoeffs[i * 4 + 2] = 0.0;
+        bcoeffs[i * 4 + 3] = 1.0;
+    }
+
+    bknots[6] = 4.0;
+
+    double px = coeffs[0] / coeffs[3];
+    double py = coeffs[1] / coeffs[3];
+
+    IGES_ENTITY_126* dcurve = NULL;     // directrix
+    IGES_ENTITY_126* tcurve = NULL;     // reversed directrix at the opposite height
+    IGES_ENTITY_126* bcurve = NULL;     // bound in parameter space
+    IGES_ENTITY_110* seam[2] = { NULL, NULL };
+    IGES_ENTITY_102* ccurve = NULL;
+    IGES_ENTITY_142* scurve = NULL;
+    IGES_ENTITY_122* isurf = NULL;
+    IGES_ENTITY_144* itps = NULL;
+
+    ok = newArc126( aModel, &dcurve ) && setJoinedData( dcurve, order, knots, coeffs )
+         && newArc126( aModel, &tcurve ) && setJoinedData( tcurve, order, rknots, rcoeffs )
+         && newArc126( aModel, &bcurve ) && setJoinedData( bcurve, 2, bknots, bcoeffs )
+         && newLine110( aModel, &seam[0] ) && newLine110( aModel, &seam[1] );
+
+    if( ok )
+    {
+        seam[0]->X1 = px;
+        seam[0]->Y1 = py;
+        seam[0]->Z1 = z0;
+        seam[0]->X2 = px;
+        seam[0]->Y2 = py;
+        seam[0]->Z2 = z1;
+        seam[1]->X1 = px;
+        seam[1]->Y1 = py;
+        seam[1]->Z1 = z1;
+        seam[1]->X2 = px;
+        seam[1]->Y2 = py;
+        seam[1]->Z2 = z0;
+
+        ok = newEnt102( aModel, &ccurve )
+             && ccurve->AddSegment( dcurve ) && ccurve->AddSegment( seam[0] )
+             && ccurve->AddSegment( tcurve ) && ccurve->AddSegment( seam[1] );
+    }
+
+    if( ok )
+    {
+        ok = newEnt122( aModel, &isurf ) && isurf->SetDE( dcurve );
+
+        if( ok )
+        {
+            isurf->LX = px;
+            isurf->LY = py;
+            isurf->LZ = z1;
+        }
+    }
+
+    if( ok && newEnt142( aModel, &scurve ) )
+    {
+        scurve->CRTN = 1;
+        scurve->PREF = 1;
+        ok = scurve->SetSPTR( (IGES_ENTITY*)isurf )
+             && scurve->SetBPTR( (IGES_ENTITY*)bcurve )
+             && scurve->SetCPTR( (IGES_ENTITY*)ccurve );
+    }
+    else
+    {
+        ok = false;
+    }
+
+    if( ok && newEnt144( aModel, &itps ) )
+    {
+        itps->N2 = 0;
+        ok = itps->SetPTS( (IGES_ENTITY*)isurf ) && itps->SetPTO( scurve );
+    }
+    else
+    {
+        ok = false;
+    }
+
+    if( !ok )
+    {
+        IGES_ENTITY* ents[9] = { (IGES_ENTITY*)itps, (IGES_ENTITY*)scurve,
+            (IGES_ENTITY*)isurf, (IGES_ENTITY*)ccurve, (IGES_ENTITY*)seam[1],
+            (IGES_ENTITY*)seam[0], (IGES_ENTITY*)bcurve, (IGES_ENTITY*)tcurve,
+            (IGES_ENTITY*)dcurve };
+
+        for( int i = 0; i < 9; ++i )
+        {
+            if( ents[i] )
+                aModel->DelEntity( ents[i] );
+        }
+
+        ERRMSG << "\n + [ERROR] could not create the tabulated cylinder of a loop\n";
+        return false;
+    }
+
+    aSurface.push_back( itps );
+    return true;
+}
+
+
 // create a Trimmed Parametric Surface entity with only the PTS member instantiated
 IGES_ENTITY_144* IGES_GEOM_PCB::getUntrimmedPlane( IGES* aModel, double aHeight, bool aReverse )
 {
@@ -0,0 +1,429 @@
+/*
+ * file: mcad_ofstream.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: buffered output file stream which overlaps the
+ * formatting of data with writes to disk and only replaces the
+ * target file once all data has been written successfully.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <cstdio>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <streambuf>
+
+#if defined( _WIN32 )
+    #include <windows.h>
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+#include <error_macros.h>
+#include <geom/mcad_ofstream.h>
+
+
+// size of each of the two output buffers
+#define OFS_BUFSIZE (1 << 20)
+// alignment of the output buffers
+#define OFS_ALIGN (4096)
+
+
+class MCAD_OFSTREAM_BUF : public std::streambuf
+{
+private:
+    FILE*       m_file;
+    char*       m_mem;          // storage for both buffers
+    char*       m_buf[2];       // aligned output buffers
+    int         m_cur;          // index of the buffer being filled
+
+    std::thread             m_thread;
+    std::mutex              m_mutex;
+    std::condition_variable m_cv;
+    const char* m_pending;      // data to be written by the flush thread
+    size_t      m_pendingLen;
+    bool        m_busy;         // true while the flush thread owns m_pending
+    bool        m_quit;         // true to terminate the flush thread
+    bool        m_error;        // true if any write failed
+
+    // flush thread: writes out each buffer handed over by submit()
+    void run( void )
+    {
+        std::unique_lock< std::mutex > lock( m_mutex );
+
+        while( true )
+        {
+            while( !m_busy && !m_quit )
+                m_cv.wait( lock );
+
+            if( !m_busy )
+                break;
+
+            const char* data = m_pending;
+            size_t len = m_pendingLen;
+
+            lock.unlock();
+            bool ok = ( fwrite( data, 1, len, m_file ) == len );
+            lock.lock();
+
+            if( !ok )
+                m_error = true;
+
+            m_busy = false;
+            m_cv.notify_all();
+        }
+
+        return;
+    }
+
+    static void runThread( MCAD_OFSTREAM_BUF* aBuf )
+    {
+        aBuf->run();
+        return;
+    }
+
+    // wait for the flush thread to finish with the pending buffer
+    void waitIdle( void )
+    {
+        std::unique_lock< std::mutex > lock( m_mutex );
+
+        while( m_busy )
+            m_cv.wait( lock );
+
+        return;
+    }
+
+    // hand the data in the current buffer over for writing and
+    // switch to the other buffer; returns false if a write failed
+    bool submit( void )
+    {
+        size_t len = (size_t)( pptr() - pbase() );
+
+        if( 0 == len )
+            return !m_error;
+
+        if( !m_thread.joinable() )
+        {
+            // no flush thread; write the data directly
+            if( fwrite( pbase(), 1, len, m_file ) != len )
+                m_error = true;
+
+            setp( m_buf[m_cur], m_buf[m_cur] + OFS_BUFSIZE );
+            return !m_error;
+        }
+
+        do
+        {
+            std::unique_lock< std::mutex > lock( m_mutex );
+
+            while( m_busy )
+                m_cv.wait( lock );
+
+            if( m_error )
+                return false;
+
+            m_pending = pbase();
+            m_pendingLen = len;
+            m_busy = true;
+            m_cv.notify_all();
+        } while( 0 );
+
+        m_cur ^= 1;
+        setp( m_buf[m_cur], m_buf[m_cur] + OFS_BUFSIZE );
+        return true;
+    }
+
+    // stop the flush thread once all pending data is written
+    void stopThread( void )
+    {
+        if( !m_thread.joinable() )
+            return;
+
+        do
+        {
+            std::unique_lock< std::mutex > lock( m_mutex );
+            m_quit = true;
+            m_cv.notify_all();
+        } while( 0 );
+
+        m_thread.join();
+        return;
+    }
+
+protected:
+    int_type overflow( int_type c )
+    {
+        if( NULL == m_file || !submit() )
+            return traits_type::eof();
+
+        if( !traits_type::eq_int_type( c, traits_type::eof() ) )
+        {
+            *pptr() = traits_type::to_char_type( c );
+            pbump( 1 );
+        }
+
+        return traits_type::not_eof( c );
+    }
+
+    int sync( void )
+    {
+        if( NULL == m_file || !submit() )
+            return -1;
+
+        waitIdle();
+
+        if( m_error || 0 != fflush( m_file ) )
+            return -1;
+
+        return 0;
+    }
+
+public:
+    MCAD_OFSTREAM_BUF()
+    {
+        m_file = NULL;
+        m_mem = NULL;
+        m_buf[0] = NULL;
+        m_buf[1] = NULL;
+        m_cur = 0;
+        m_pending = NULL;
+        m_pendingLen = 0;
+        m_busy = false;
+        m_quit = false;
+        m_error = false;
+        return;
+    }
+
+    ~MCAD_OFSTREAM_BUF()
+    {
+        close( false );
+        return;
+    }
+
+    bool isOpen( void )
+    {
+        return NULL != m_file;
+    }
+
+    bool open( const char* aFileName )
+    {
+        if( NULL != m_file )
+        {
+            ERRMSG << "\n + [BUG] stream is already open\n";
+            return false;
+        }
+
+        if( NULL == m_mem )
+        {
+            m_mem = new char[2 * OFS_BUFSIZE + OFS_ALIGN];
+            size_t off = (size_t)m_mem % OFS_ALIGN;
+
+            if( 0 == off )
+                m_buf[0] = m_mem;
+            else
+                m_buf[0] = m_mem + OFS_ALIGN - off;
+
+            m_buf[1] = m_buf[0] + OFS_BUFSIZE;
+        }
+
+        m_file = fopen( aFileName, "wb" );
+
+        if( NULL == m_file )
+            return false;
+
+        // all writes are made in large blocks; no further buffering is required
+        setvbuf( m_file, NULL, _IONBF, 0 );
+
+        m_cur = 0;
+        m_busy = false;
+        m_quit = false;
+        m_error = false;
+        setp( m_buf[0], m_buf[0] + OFS_BUFSIZE );
+
+        try
+        {
+            m_thread = std::thread( runThread, this );
+        }
+        catch( ... )
+        {
+            // carry on without a flush thread
+            ERRMSG << "\n + [WARNING] could not start output thread\n";
+        }
+
+        return true;
+    }
+
+    // write out all data and close the file; returns false on failure
+    bool close( bool aSync )
+    {
+        if( NULL == m_file )
+            return false;
+
+        submit();
+        stopThread();
+        setp( NULL, NULL );
+
+        bool ok = !m_error && 0 == fflush( m_file );
+
+        if( ok && aSync )
+        {
+#if defined( _WIN32 )
+            ok = ( 0 == _commit( _fileno( m_file ) ) );
+#else
+            ok = ( 0 == fsync( fileno( m_file ) ) );
+#endif
+        }
+
+        if( 0 != fclose( m_file ) )
+            ok = false;
+
+        m_file = NULL;
+
+        if( m_mem )
+        {
+            delete [] m_mem;
+            m_mem = NULL;
+            m_buf[0] = NULL;
+            m_buf[1] = NULL;
+        }
+
+        return ok;
+    }
+};
+
+
+MCAD_OFSTREAM::MCAD_OFSTREAM() : std::ostream( NULL )
+{
+    m_buf = new MCAD_OFSTREAM_BUF;
+    m_filename = new std::string;
+    m_tmpname = new std::string;
+    m_sync = false;
+    rdbuf( m_buf );
+    return;
+}
+
+
+MCAD_OFSTREAM::~MCAD_OFSTREAM()
+{
+    Abort();
+    delete m_buf;
+    delete m_filename;
+    delete m_tmpname;
+    return;
+}
+
+
+bool MCAD_OFSTREAM::Open( const char* aFileName, bool aSync )
+{
+    if( NULL == aFileName || 0 == *aFileName )
+    {
+        ERRMSG << "\n + [BUG] invalid file name\n";
+        setstate( std::ios_base::failbit );
+        return false;
+    }
+
+    if( m_buf->isOpen() )
+    {
+        ERRMSG << "\n + [BUG] stream is already open\n";
+        setstate( std::ios_base::failbit );
+        return false;
+    }
+
+    *m_filename = aFileName;
+    *m_tmpname = *m_filename + ".tmp";
+    m_sync = aSync;
+    clear();
+
+    if( !m_buf->open( m_tmpname->c_str() ) )
+    {
+        m_filename->clear();
+        m_tmpname->clear();
+        setstate( std::ios_base::failbit );
+        return false;
+    }
+
+    return true;
+}
+
+
+bool MCAD_OFSTREAM::IsOpen( void )
+{
+    return m_buf->isOpen();
+}
+
+
+bool MCAD_OFSTREAM::Close( void )
+{
+    if( !m_buf->isOpen() )
+    {
+        setstate( std::ios_base::failbit );
+        return false;
+    }
+
+    bool ok = m_buf->close( m_sync ) && !bad() && !fail();
+
+    if( ok )
+    {
+#if defined( _WIN32 )
+        ok = ( 0 != MoveFileExA( m_tmpname->c_str(), m_filename->c_str(),
+            MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH ) );
+#else
+        ok = ( 0 == std::rename( m_tmpname->c_str(), m_filename->c_str() ) );
+#endif
+
+        if( !ok )
+        {
+            ERRMSG << "\n + [INFO] could not rename temporary file\n";
+            std::cerr << " + filename: '" << *m_filename << "'\n";
+        }
+    }
+    else
+    {
+        ERRMSG << "\n + [INFO] could not write data to file\n";
+        std::cerr << " + filename: '" << *m_filename << "'\n";
+    }
+
+    if( !ok )
+        std::remove( m_tmpname->c_str() );
+
+    m_filename->clear();
+    m_tmpname->clear();
+
+    if( !ok )
+        setstate( std::ios_base::failbit );
+
+    return ok;
+}
+
+
+void MCAD_OFSTREAM::Abort( void )
+{
+    if( !m_buf->isOpen() )
+        return;
+
+    m_buf->close( false );
+    std::remove( m_tmpname->c_str() );
+    m_filename->clear();
+    m_tmpname->clear();
+    return;
+}
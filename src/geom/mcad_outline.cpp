@@ -30,6 +30,8 @@
 #include <sstream>
 #include <cmath>
 #include <algorithm>
+#include <vector>
+#include <unordered_map>
 #include <error_macros.h>
 #include <geom/mcad_helpers.h>
 #include <geom/mcad_segment.h>
@@ -43,6 +45,229 @@ using namespace std;
 } while( 0 )
 
 
+// NOTE:
+// The segment index is a uniform grid over the bounding boxes of the
+// segments of a closed outline; it allows a circular cutout to be tested
+// against the few segments in its vicinity rather than against the entire
+// outline. Segments which span too many cells are held in a separate list
+// which is searched on every query. Coordinates beyond the extent of the
+// grid are clamped to the border cells so that segments created after the
+// grid was built remain searchable.
+
+// maximum number of cells spanned by a segment in the grid
+#define SEGINDEX_MAX_SPAN (64)
+// padding of a query box; this exceeds the tolerance of the tangent tests
+#define SEGINDEX_PAD (0.01)
+
+struct MCAD_SEGMENT_INDEX
+{
+    struct ENTRY
+    {
+        list<MCAD_SEGMENT*>::iterator iSeg;
+        int x0;     // range of cells; x0 < 0 for an oversize segment
+        int y0;
+        int x1;
+        int y1;
+    };
+
+    double ox;      // origin of the grid
+    double oy;
+    double cell;    // edge length of a cell
+    int nx;         // number of cells in X
+    int ny;         // number of cells in Y
+    size_t nBuilt;  // number of segments when the grid was built
+    vector< vector<MCAD_SEGMENT*> > cells;
+    vector<MCAD_SEGMENT*> large;
+    unordered_map<MCAD_SEGMENT*, ENTRY> entries;
+
+    void cellRange( const MCAD_POINT& aBL, const MCAD_POINT& aTR,
+                    int& x0, int& y0, int& x1, int& y1 ) const
+    {
+        x0 = clampCell( aBL.x - ox, nx );
+        y0 = clampCell( aBL.y - oy, ny );
+        x1 = clampCell( aTR.x - ox, nx );
+        y1 = clampCell( aTR.y - oy, ny );
+    }
+
+    int clampCell( double aOffset, int aNCells ) const
+    {
+        double c = floor( aOffset / cell );
+
+        if( c < 0.0 )
+            return 0;
+
+        if( c >= (double)aNCells )
+            return aNCells - 1;
+
+        return (int)c;
+    }
+
+    void Build( list<MCAD_SEGMENT*>& aSegList )
+    {
+        cells.clear();
+        large.clear();
+        entries.clear();
+        nBuilt = aSegList.size();
+
+        list<MCAD_SEGMENT*>::iterator sSeg = aSegList.begin();
+        list<MCAD_SEGMENT*>::iterator eSeg = aSegList.end();
+        MCAD_POINT bl;
+        MCAD_POINT tr;
+        MCAD_POINT bb0;
+        MCAD_POINT bb1;
+        double sumExtent = 0.0;
+
+        while( sSeg != eSeg )
+        {
+            (*sSeg)->GetBoundingBox( bb0, bb1 );
+
+            if( sSeg == aSegList.begin() )
+            {
+                bl = bb0;
+                tr = bb1;
+            }
+            else
+            {
+                bl.x = min( bl.x, bb0.x );
+                bl.y = min( bl.y, bb0.y );
+                tr.x = max( tr.x, bb1.x );
+                tr.y = max( tr.y, bb1.y );
+            }
+
+            sumExtent += max( bb1.x - bb0.x, bb1.y - bb0.y );
+            ++sSeg;
+        }
+
+        // the cells are about the size of an average segment but
+        // there are never many more cells than segments
+        double n = (double)( nBuilt > 0 ? nBuilt : 1 );
+        double w = tr.x - bl.x;
+        double h = tr.y - bl.y;
+
+        cell = max( sumExtent / n, sqrt( w * h / n ) );
+
+        if( cell < 1e-3 )
+            cell = 1e-3;
+
+        nx = (int)( w / cell ) + 1;
+        ny = (int)( h / cell ) + 1;
+
+        while( (double)nx * (double)ny > 4.0 * n + 64.0 )
+        {
+            cell *= 2.0;
+            nx = (int)( w / cell ) + 1;
+            ny = (int)( h / cell ) + 1;
+        }
+
+        ox = bl.x;
+        oy = bl.y;
+        cells.resize( (size_t)nx * (size_t)ny );
+
+        for( sSeg = aSegList.begin(); sSeg != eSeg; ++sSeg )
+            Add( sSeg );
+
+        return;
+    }
+
+    void Add( list<MCAD_SEGMENT*>::iterator aSeg )
+    {
+        MCAD_POINT bb0;
+        MCAD_POINT bb1;
+        ENTRY ent;
+
+        (*aSeg)->GetBoundingBox( bb0, bb1 );
+        ent.iSeg = aSeg;
+        cellRange( bb0, bb1, ent.x0, ent.y0, ent.x1, ent.y1 );
+
+        if( ( ent.x1 - ent.x0 + 1 ) * ( ent.y1 - ent.y0 + 1 ) > SEGINDEX_MAX_SPAN )
+        {
+            ent.x0 = -1;
+            large.push_back( *aSeg );
+        }
+        else
+        {
+            for( int j = ent.y0; j <= ent.y1; ++j )
+            {
+                for( int i = ent.x0; i <= ent.x1; ++i )
+                    cells[(size_t)j * nx + i].push_back( *aSeg );
+            }
+        }
+
+        entries[*aSeg] = ent;
+        return;
+    }
+
+    void Remove( MCAD_SEGMENT* aSeg )
+    {
+        unordered_map<MCAD_SEGMENT*, ENTRY>::iterator it = entries.find( aSeg );
+
+        if( entries.end() == it )
+            return;
+
+        ENTRY& ent = it->second;
+
+        if( ent.x0 < 0 )
+        {
+            removeFrom( large, aSeg );
+        }
+        else
+        {
+            for( int j = ent.y0; j <= ent.y1; ++j )
+            {
+                for( int i = ent.x0; i <= ent.x1; ++i )
+                    removeFrom( cells[(size_t)j * nx + i], aSeg );
+            }
+        }
+
+        entries.erase( it );
+        return;
+    }
+
+    static void removeFrom( vector<MCAD_SEGMENT*>& aList, MCAD_SEGMENT* aSeg )
+    {
+        vector<MCAD_SEGMENT*>::iterator it = find( aList.begin(), aList.end(), aSeg );
+
+        if( aList.end() != it )
+        {
+            *it = aList.back();
+            aList.pop_back();
+        }
+    }
+
+    ENTRY* Find( MCAD_SEGMENT* aSeg )
+    {
+        unordered_map<MCAD_SEGMENT*, ENTRY>::iterator it = entries.find( aSeg );
+
+        if( entries.end() == it )
+            return NULL;
+
+        return &it->second;
+    }
+
+    // retrieve all segments whose cells overlap the given box
+    void Query( const MCAD_POINT& aBL, const MCAD_POINT& aTR, vector<MCAD_SEGMENT*>& aList ) const
+    {
+        int x0, y0, x1, y1;
+
+        cellRange( aBL, aTR, x0, y0, x1, y1 );
+        aList.assign( large.begin(), large.end() );
+
+        for( int j = y0; j <= y1; ++j )
+        {
+            for( int i = x0; i <= x1; ++i )
+            {
+                const vector<MCAD_SEGMENT*>& c = cells[(size_t)j * nx + i];
+                aList.insert( aList.end(), c.begin(), c.end() );
+            }
+        }
+
+        sort( aList.begin(), aList.end() );
+        aList.erase( unique( aList.begin(), aList.end() ), aList.end() );
+        return;
+    }
+};
+
+
 void MCAD_OUTLINE::PrintPoint( MCAD_POINT p0 )
 {
     cout << "(" << p0.x << ", " << p0.y << ")\n";
@@ -116,12 +341,16 @@ MCAD_OUTLINE::MCAD_OUTLINE()
     mWinding = 0.0;
     mBBisOK = false;
     m_OutlineType = MCAD_OT_BASE;
+    mSegIndex = NULL;
+    mFastCutouts = true;
     return;
 }
 
 
 MCAD_OUTLINE::~MCAD_OUTLINE()
 {
+    invalidateIndex();
+
     while( !msegments.empty() )
     {
         delete msegments.back();
@@ -323,17 +552,16 @@ bool MCAD_OUTLINE::IsInside( MCAD_POINT aPoint, bool& error )
 
     list<MCAD_SEGMENT*>::iterator sSegs = msegments.begin();
     list<MCAD_SEGMENT*>::iterator eSegs = msegments.end();
-    list<MCAD_POINT> iList;
-    MCAD_INTERSECT_FLAG flag;
+    MCAD_INTERSECTIONS iList;
 
     int acc = 0;
 
     while( sSegs != eSegs )
     {
-        if( (*sSegs)->GetIntersections( ls0, iList, flag ) )
+        if( (*sSegs)->GetIntersections( ls0, iList ) )
         {
-            list<MCAD_POINT>::iterator sL = iList.begin();
-            list<MCAD_POINT>::iterator eL = iList.end();
+            MCAD_POINT* sL = iList.points;
+            MCAD_POINT* eL = iList.points + iList.npoints;
 
             while( sL != eL )
             {
@@ -400,8 +628,6 @@ bool MCAD_OUTLINE::IsInside( MCAD_POINT aPoint, bool& error )
 
                 ++sL;
             }
-
-            iList.clear();
         }
 
         ++sSegs;
@@ -420,6 +646,8 @@ bool MCAD_OUTLINE::IsInside( MCAD_POINT aPoint, bool& error )
 // of operation.
 bool MCAD_OUTLINE::AddSegment( MCAD_SEGMENT* aSegment, bool& error )
 {
+    invalidateIndex();
+
     if( NULL == aSegment )
     {
         ostringstream msg;
@@ -611,6 +839,7 @@ bool MCAD_OUTLINE::AddSegment( MCAD_SEGMENT* aSegment, bool& error )
 bool MCAD_OUTLINE::opOutline( MCAD_SEGMENT* aCircle, bool& error, bool opsub )
 {
     mBBisOK = false;
+    invalidateIndex();
 
     if( !mIsClosed )
     {
@@ -647,7 +876,7 @@ bool MCAD_OUTLINE::opOutline( MCAD_SEGMENT* aCircle, bool& error, bool opsub )
 
     error = false;
     list<MCAD_INTERSECT> intersects;
-    list<MCAD_POINT> iList;
+    MCAD_INTERSECTIONS iRes;
     list<MCAD_SEGMENT*>::iterator iSeg = msegments.begin();
     list<MCAD_SEGMENT*>::iterator eSeg = msegments.end();
     MCAD_INTERSECT_FLAG flag;
@@ -655,10 +884,10 @@ bool MCAD_OUTLINE::opOutline( MCAD_SEGMENT* aCircle, bool& error, bool opsub )
     int acc = 1;    // XXX - DEBUG
     while( iSeg != eSeg )
     {
-        flag = MCAD_IFLAG_NONE;
-        iList.clear();
+        bool hit = (*iSeg)->GetIntersections( *aCircle, iRes );
+        flag = iRes.flags;
 
-        if( (*iSeg)->GetIntersections( *aCircle, iList, flag ) )
+        if( hit )
         {
             if( MCAD_IFLAG_NONE != flag && MCAD_IFLAG_ENDPOINT != flag
                 && MCAD_IFLAG_TANGENT != flag )
@@ -672,19 +901,15 @@ bool MCAD_OUTLINE::opOutline( MCAD_SEGMENT* aCircle, bool& error, bool opsub )
                 return false;
             }
 
-            std::list<MCAD_POINT>::iterator iPts = iList.begin();
-            std::list<MCAD_POINT>::iterator ePts = iList.end();
-
-            while( iPts != ePts )
+            for( int i = 0; i < iRes.npoints; ++i )
             {
                 MCAD_INTERSECT gi;
-                gi.vertex = *iPts;
+                gi.vertex = iRes.points[i];
                 gi.segA = *iSeg;
                 gi.segB = aCircle;
                 gi.iSegA = iSeg;
                 gi.iSegB = iSeg;
                 intersects.push_back( gi );
-                ++iPts;
             }
         }
         else
@@ -724,7 +949,7 @@ bool MCAD_OUTLINE::opOutline( MCAD_SEGMENT* aCircle, bool& error, bool opsub )
     if( intersects.empty() )
         return false;
 
-    iList.clear();
+    list<MCAD_POINT> iList;
     list<list<MCAD_SEGMENT*>::iterator> lSegs;
 
     // compute the number of unique intersecting points:
@@ -1139,6 +1364,294 @@ bool MCAD_OUTLINE::opOutline( MCAD_SEGMENT* aCircle, bool& error, bool opsub )
 }   // opOutline( MCAD_SEGMENT* aCircle, bool& error, bool opsub )
 
 
+// Subtract a circle from the outline using the segment index. The method
+// handles the common cases of a drill hole which is clear of the edge and
+// a hole (such as a castellation) which crosses the edge at 2 points which
+// are not endpoints of a segment; the entry and exit points are identified
+// from the direction of the outline rather than by testing points of the
+// circle against the entire outline. All other cases, including tangents,
+// endpoints and coincident edges, are declined before the outline is
+// modified so that the general method may deal with them.
+bool MCAD_OUTLINE::subCircleFast( MCAD_SEGMENT* aCircle, bool& aResult )
+{
+    aResult = false;
+
+    if( !mFastCutouts || !mIsClosed || NULL == aCircle
+        || MCAD_SEGTYPE_CIRCLE != aCircle->GetSegType()
+        || msegments.size() < 2 )
+        return false;
+
+    if( NULL == mSegIndex )
+    {
+        mSegIndex = new MCAD_SEGMENT_INDEX;
+        mSegIndex->Build( msegments );
+    }
+    else if( msegments.size() > 2 * mSegIndex->nBuilt )
+    {
+        // the segments have become much smaller than the cells
+        mSegIndex->Build( msegments );
+    }
+
+    MCAD_POINT c = aCircle->mcenter;
+    double r = aCircle->mradius;
+    MCAD_POINT bl = c;
+    MCAD_POINT tr = c;
+
+    bl.x -= r + SEGINDEX_PAD;
+    bl.y -= r + SEGINDEX_PAD;
+    tr.x += r + SEGINDEX_PAD;
+    tr.y += r + SEGINDEX_PAD;
+
+    vector<MCAD_SEGMENT*> cand;
+    mSegIndex->Query( bl, tr, cand );
+
+    MCAD_POINT pt[2];       // points of intersection
+    MCAD_SEGMENT* ps[2];    // segment containing each point
+    int np = 0;
+    MCAD_INTERSECTIONS iRes;
+
+    for( size_t i = 0; i < cand.size(); ++i )
+    {
+        bool hit = cand[i]->GetIntersections( *aCircle, iRes );
+
+        if( MCAD_IFLAG_NONE != iRes.flags )
+            return false;
+
+        if( !hit )
+            continue;
+
+        for( int j = 0; j < iRes.npoints; ++j )
+        {
+            if( 2 == np || PointMatches( iRes.points[j], cand[i]->mstart, 1e-8 )
+                || PointMatches( iRes.points[j], cand[i]->mend, 1e-8 ) )
+                return false;
+
+            pt[np] = iRes.points[j];
+            ps[np] = cand[i];
+            ++np;
+        }
+    }
+
+    mBBisOK = false;
+
+    // the hole does not touch the outline
+    if( 0 == np )
+        return true;
+
+    if( 2 != np || PointMatches( pt[0], pt[1], 1e-8 ) )
+        return false;
+
+    // The outline is CCW; where it enters the circle its direction has a
+    // positive component towards the center and where it exits the component
+    // is negative. A component near zero indicates a near-tangent crossing.
+    double cs[2];
+
+    for( int k = 0; k < 2; ++k )
+    {
+        double tx;
+        double ty;
+
+        if( MCAD_SEGTYPE_LINE == ps[k]->msegtype )
+        {
+            tx = ps[k]->mend.x - ps[k]->mstart.x;
+            ty = ps[k]->mend.y - ps[k]->mstart.y;
+        }
+        else
+        {
+            tx = ps[k]->mcenter.y - pt[k].y;
+            ty = pt[k].x - ps[k]->mcenter.x;
+
+            if( ps[k]->mCWArc )
+            {
+                tx = -tx;
+                ty = -ty;
+            }
+        }
+
+        double tl = sqrt( tx * tx + ty * ty );
+
+        if( tl < 1e-12 )
+            return false;
+
+        cs[k] = ( tx * ( c.x - pt[k].x ) + ty * ( c.y - pt[k].y ) ) / ( tl * r );
+
+        if( fabs( cs[k] ) < 1e-6 )
+            return false;
+    }
+
+    if( ( cs[0] > 0.0 ) == ( cs[1] > 0.0 ) )
+        return false;
+
+    int kIn = cs[0] > 0.0 ? 0 : 1;
+    int kOut = 1 - kIn;
+
+    MCAD_SEGMENT_INDEX::ENTRY* eIn = mSegIndex->Find( ps[kIn] );
+    MCAD_SEGMENT_INDEX::ENTRY* eOut = mSegIndex->Find( ps[kOut] );
+
+    if( NULL == eIn || NULL == eOut )
+        return false;
+
+    list<MCAD_SEGMENT*>::iterator iIn = eIn->iSeg;
+    list<MCAD_SEGMENT*>::iterator iOut = eOut->iSeg;
+    MCAD_SEGMENT* sIn = *iIn;
+
+    if( iIn == iOut )
+    {
+        // the exit must follow the entry along the segment, otherwise
+        // almost the entire outline lies within the circle
+        double u[2];
+
+        for( int k = 0; k < 2; ++k )
+        {
+            if( MCAD_SEGTYPE_LINE == sIn->msegtype )
+            {
+                u[k] = ( pt[k].x - sIn->mstart.x ) * ( sIn->mend.x - sIn->mstart.x )
+                       + ( pt[k].y - sIn->mstart.y ) * ( sIn->mend.y - sIn->mstart.y );
+            }
+            else
+            {
+                u[k] = atan2( pt[k].y - sIn->mcenter.y, pt[k].x - sIn->mcenter.x )
+                       - atan2( sIn->mstart.y - sIn->mcenter.y, sIn->mstart.x - sIn->mcenter.x );
+
+                if( sIn->mCWArc )
+                    u[k] = -u[k];
+
+                if( u[k] < 0.0 )
+                    u[k] += 2.0 * M_PI;
+            }
+        }
+
+        if( u[kIn] >= u[kOut] )
+            return false;
+    }
+
+    MCAD_SEGMENT* sp = new MCAD_SEGMENT;
+
+    if( !sp->SetParams( c, pt[kIn], pt[kOut], true ) )
+    {
+        delete sp;
+        return false;
+    }
+
+    list<MCAD_POINT> pList;
+    list<MCAD_SEGMENT*> sList;
+
+    if( iIn == iOut )
+    {
+        // replace the middle of the 3 pieces with the arc
+        pList.push_back( pt[kIn] );
+        pList.push_back( pt[kOut] );
+
+        if( !sIn->Split( pList, sList ) || sList.size() != 2 )
+        {
+            // the segment is only modified on success
+            while( !sList.empty() )
+            {
+                delete sList.back();
+                sList.pop_back();
+            }
+
+            delete sp;
+            invalidateIndex();
+            return false;
+        }
+
+        delete sList.front();
+        sList.pop_front();
+
+        list<MCAD_SEGMENT*>::iterator iPos = iIn;
+        ++iPos;
+        list<MCAD_SEGMENT*>::iterator iArc = msegments.insert( iPos, sp );
+        list<MCAD_SEGMENT*>::iterator iRest = msegments.insert( iPos, sList.front() );
+
+        mSegIndex->Remove( sIn );
+        mSegIndex->Add( iIn );
+        mSegIndex->Add( iArc );
+        mSegIndex->Add( iRest );
+        aResult = true;
+        return true;
+    }
+
+    // split the entry and exit segments; the entry segment is restored
+    // if the exit segment cannot be split
+    MCAD_POINT oldEnd = sIn->mend;
+    double oldEndAng = sIn->meang;
+    list<MCAD_SEGMENT*> sOut;
+
+    pList.push_back( pt[kIn] );
+
+    if( !sIn->Split( pList, sList ) || sList.size() != 1 )
+    {
+        while( !sList.empty() )
+        {
+            delete sList.back();
+            sList.pop_back();
+        }
+
+        delete sp;
+        invalidateIndex();
+        return false;
+    }
+
+    pList.clear();
+    pList.push_back( pt[kOut] );
+
+    if( !(*iOut)->Split( pList, sOut ) || sOut.size() != 1 )
+    {
+        sIn->mend = oldEnd;
+        sIn->meang = oldEndAng;
+
+        while( !sList.empty() )
+        {
+            delete sList.back();
+            sList.pop_back();
+        }
+
+        while( !sOut.empty() )
+        {
+            delete sOut.back();
+            sOut.pop_back();
+        }
+
+        delete sp;
+        invalidateIndex();
+        return false;
+    }
+
+    // the remainder of the exit segment follows the arc
+    list<MCAD_SEGMENT*>::iterator iRest = iOut;
+    ++iRest;
+    iRest = msegments.insert( iRest, sOut.front() );
+
+    // eradicate everything from the entry point to the exit point
+    list<MCAD_SEGMENT*>::iterator iPos = iIn;
+    ++iPos;
+    iPos = msegments.insert( iPos, sList.front() );
+
+    while( iPos != iRest )
+    {
+        if( msegments.end() == iPos )
+        {
+            iPos = msegments.begin();
+            continue;
+        }
+
+        mSegIndex->Remove( *iPos );
+        delete *iPos;
+        iPos = msegments.erase( iPos );
+    }
+
+    list<MCAD_SEGMENT*>::iterator iArc = msegments.insert( iRest, sp );
+
+    mSegIndex->Remove( sIn );
+    mSegIndex->Add( iIn );
+    mSegIndex->Add( iArc );
+    mSegIndex->Add( iRest );
+    aResult = true;
+    return true;
+}   // subCircleFast( MCAD_SEGMENT* aCircle, bool& aResult )
+
+
 // operate on the generic outline (add/subtract)
 bool MCAD_OUTLINE::opOutline( MCAD_OUTLINE* aOutline, bool& error, bool opsub )
 {
@@ -1178,6 +1691,10 @@ bool MCAD_OUTLINE::opOutline( MCAD_OUTLINE* aOutline, bool& error, bool opsub )
     //
 
     mBBisOK = false;
+    invalidateIndex();
+
+    if( NULL != aOutline )
+        aOutline->invalidateIndex();
 
     if( !mIsClosed )
     {
@@ -1219,7 +1736,7 @@ bool MCAD_OUTLINE::opOutline( MCAD_OUTLINE* aOutline, bool& error, bool opsub )
 
     error = false;
     list<MCAD_INTERSECT> intersects;
-    list<MCAD_POINT> iList;
+    MCAD_INTERSECTIONS iRes;
     list<MCAD_SEGMENT*>::iterator iSeg = msegments.begin();
     list<MCAD_SEGMENT*>::iterator eSeg = msegments.end();
     MCAD_INTERSECT_FLAG flag;
@@ -1227,15 +1744,17 @@ bool MCAD_OUTLINE::opOutline( MCAD_OUTLINE* aOutline, bool& error, bool opsub )
     int acc = 1;    // XXX - DEBUG
     while( iSeg != eSeg )
     {
-        flag = MCAD_IFLAG_NONE;
-        iList.clear();
-
         list<MCAD_SEGMENT*>::iterator sO = aOutline->msegments.begin();
         list<MCAD_SEGMENT*>::iterator eO = aOutline->msegments.end();
 
         while( sO != eO )
         {
-            if( (*iSeg)->GetIntersections( **sO, iList, flag ) )
+            // each segment pair is tested with its own result list so that
+            // every intersection is reported once
+            bool hit = (*iSeg)->GetIntersections( **sO, iRes );
+            flag = iRes.flags;
+
+            if( hit )
             {
                 if( MCAD_IFLAG_NONE != flag && MCAD_IFLAG_ENDPOINT != flag
                     && MCAD_IFLAG_TANGENT != flag )
@@ -1249,19 +1768,15 @@ bool MCAD_OUTLINE::opOutline( MCAD_OUTLINE* aOutline, bool& error, bool opsub )
                     return false;
                 }
 
-                std::list<MCAD_POINT>::iterator iPts = iList.begin();
-                std::list<MCAD_POINT>::iterator ePts = iList.end();
-
-                while( iPts != ePts )
+                for( int i = 0; i < iRes.npoints; ++i )
                 {
                     MCAD_INTERSECT gi;
-                    gi.vertex = *iPts;
+                    gi.vertex = iRes.points[i];
                     gi.segA = *iSeg;
                     gi.segB = *sO;
                     gi.iSegA = iSeg;
                     gi.iSegB = sO;
                     intersects.push_back( gi );
-                    ++iPts;
                 }
             }
             else
@@ -1304,7 +1819,7 @@ bool MCAD_OUTLINE::opOutline( MCAD_OUTLINE* aOutline, bool& error, bool opsub )
     if( intersects.empty() )
         return false;
 
-    iList.clear();
+    list<MCAD_POINT> iList;
     list<list<MCAD_SEGMENT*>::iterator> lSegs;
     list<list<MCAD_SEGMENT*>::iterator> oSegs;
 
@@ -1813,7 +2328,9 @@ bool MCAD_OUTLINE::opOutline( MCAD_OUTLINE* aOutline, bool& error, bool opsub )
         }
 
         aOutline->msegments = tSegs;
-        oSegs.front() = --aOutline->msegments.end();
+        // the retained segments now start at the list head; the last
+        // one (ending at the second split point) precedes it
+        oSegs.front() = aOutline->msegments.begin();
         eSegO = --aOutline->msegments.end();
     }
 
@@ -1964,7 +2481,12 @@ bool MCAD_OUTLINE::AddOutline( MCAD_SEGMENT* aCircle, bool& error )
 // the two outlines may only intersect at 2 points.
 bool MCAD_OUTLINE::SubOutline( MCAD_SEGMENT* aCircle, bool& error )
 {
-    bool res = opOutline( aCircle, error, true );
+    bool res = false;
+
+    if( subCircleFast( aCircle, res ) )
+        error = false;
+    else
+        res = opOutline( aCircle, error, true );
 
     if( error )
     {
@@ -2004,6 +2526,358 @@ bool MCAD_OUTLINE::SubOutline( MCAD_OUTLINE* aOutline, bool& error )
 }
 
 
+// NOTE:
+// Simplification works on the vertices of a run of line segments. From
+// each vertex the longest arc of at least SIMPLIFY_MIN_ARC segments and
+// the longest line which stay within tolerance are sought and whichever
+// covers more segments is taken. An arc is accepted only if all vertices
+// and the midpoints of all chords lie within tolerance of it and the
+// vertices advance monotonically about its center; this keeps genuine
+// polygon corners from being rounded off.
+
+// minimum number of line segments replaced by an arc
+#define SIMPLIFY_MIN_ARC (3)
+
+
+// calculate the circle through 3 points; returns false if the points are collinear
+static bool circleFrom3( const MCAD_POINT& p0, const MCAD_POINT& p1,
+                         const MCAD_POINT& p2, MCAD_POINT& aCenter, double& aRadius )
+{
+    double ax = p1.x - p0.x;
+    double ay = p1.y - p0.y;
+    double bx = p2.x - p0.x;
+    double by = p2.y - p0.y;
+    double a2 = ax * ax + ay * ay;
+    double b2 = bx * bx + by * by;
+    double d = 2.0 * ( ax * by - ay * bx );
+
+    if( fabs( d ) <= 1e-12 * ( a2 + b2 ) )
+        return false;
+
+    double ux = ( by * a2 - ay * b2 ) / d;
+    double uy = ( ax * b2 - bx * a2 ) / d;
+
+    aCenter.x = p0.x + ux;
+    aCenter.y = p0.y + uy;
+    aCenter.z = 0.0;
+    aRadius = sqrt( ux * ux + uy * uy );
+    return true;
+}
+
+
+// test whether the vertices aPts[i0 .. i1] lie within aTol of a circular
+// arc or, if aClosed is true, of a full circle
+static bool fitArc( const vector<MCAD_POINT>& aPts, size_t i0, size_t i1, double aTol,
+                    bool aClosed, MCAD_POINT& aCenter, double& aRadius, bool& aCW )
+{
+    size_t n = i1 - i0;
+    bool ok;
+
+    if( aClosed )
+        ok = circleFrom3( aPts[i0], aPts[i0 + n / 3], aPts[i0 + 2 * n / 3], aCenter, aRadius );
+    else
+        ok = circleFrom3( aPts[i0], aPts[i0 + n / 2], aPts[i1], aCenter, aRadius );
+
+    if( !ok )
+        return false;
+
+    double sweep = 0.0;
+    int dir = 0;
+
+    for( size_t k = i0; k <= i1; ++k )
+    {
+        double x0 = aPts[k].x - aCenter.x;
+        double y0 = aPts[k].y - aCenter.y;
+
+        if( fabs( sqrt( x0 * x0 + y0 * y0 ) - aRadius ) > aTol )
+            return false;
+
+        if( k == i1 )
+            break;
+
+        double x1 = aPts[k + 1].x - aCenter.x;
+        double y1 = aPts[k + 1].y - aCenter.y;
+        double mx = 0.5 * ( x0 + x1 );
+        double my = 0.5 * ( y0 + y1 );
+
+        // deviation of the chord from the arc
+        if( aRadius - sqrt( mx * mx + my * my ) > aTol )
+            return false;
+
+        double da = atan2( x0 * y1 - y0 * x1, x0 * x1 + y0 * y1 );
+        int sd = da > 0.0 ? 1 : -1;
+
+        if( 0.0 == da || fabs( da ) > M_PI * 0.5 || ( 0 != dir && sd != dir ) )
+            return false;
+
+        dir = sd;
+        sweep += fabs( da );
+    }
+
+    if( aClosed )
+    {
+        if( fabs( sweep - 2.0 * M_PI ) > 1e-6 )
+            return false;
+    }
+    else if( sweep > 2.0 * M_PI - 1e-3 )
+    {
+        return false;
+    }
+
+    aCW = dir < 0;
+    return true;
+}
+
+
+// test whether the vertices aPts[i0 .. i1] lie within aTol of
+// the line from aPts[i0] to aPts[i1] and advance along it
+static bool fitLine( const vector<MCAD_POINT>& aPts, size_t i0, size_t i1, double aTol )
+{
+    double dx = aPts[i1].x - aPts[i0].x;
+    double dy = aPts[i1].y - aPts[i0].y;
+    double l2 = dx * dx + dy * dy;
+
+    if( l2 < 1e-16 )
+        return false;
+
+    double l = sqrt( l2 );
+    double tp = 0.0;
+
+    for( size_t k = i0 + 1; k < i1; ++k )
+    {
+        double px = aPts[k].x - aPts[i0].x;
+        double py = aPts[k].y - aPts[i0].y;
+
+        if( fabs( dx * py - dy * px ) > aTol * l )
+            return false;
+
+        double t = ( dx * px + dy * py ) / l2;
+
+        if( t <= tp || t >= 1.0 )
+            return false;
+
+        tp = t;
+    }
+
+    return true;
+}
+
+
+size_t MCAD_OUTLINE::simplifyRun( const vector<MCAD_POINT>& aPts, double aTolerance,
+                                  list<MCAD_SEGMENT*>& aSegList )
+{
+    size_t m = aPts.size() - 1;     // number of line segments in the run
+    size_t i = 0;
+    size_t iLast = 0;
+
+    while( i < m )
+    {
+        size_t jl = i + 1;
+
+        while( jl < m && fitLine( aPts, i, jl + 1, aTolerance ) )
+            ++jl;
+
+        size_t ja = i;
+        MCAD_POINT c;
+        MCAD_POINT cArc;
+        double r;
+        bool cw;
+        bool cwArc = false;
+
+        for( size_t j = i + SIMPLIFY_MIN_ARC; j <= m
+             && fitArc( aPts, i, j, aTolerance, false, c, r, cw ); ++j )
+        {
+            ja = j;
+            cArc = c;
+            cwArc = cw;
+        }
+
+        MCAD_SEGMENT* sp = new MCAD_SEGMENT;
+        iLast = i;
+
+        if( ja > jl && sp->SetParams( cArc, aPts[i], aPts[ja], cwArc ) )
+        {
+            i = ja;
+        }
+        else
+        {
+            sp->SetParams( aPts[i], aPts[jl] );
+            i = jl;
+        }
+
+        aSegList.push_back( sp );
+    }
+
+    return iLast;
+}
+
+
+bool MCAD_OUTLINE::Simplify( double aTolerance, bool& error )
+{
+    error = false;
+
+    if( !mIsClosed )
+    {
+        ostringstream msg;
+        GEOM_ERR( msg );
+        msg << "[BUG] outline is not closed";
+        ERRMSG << msg.str() << "\n";
+        errors.push_back( msg.str() );
+        error = true;
+        return false;
+    }
+
+    if( aTolerance <= 0.0 )
+    {
+        ostringstream msg;
+        GEOM_ERR( msg );
+        msg << "[BUG] invalid tolerance (" << aTolerance << ")";
+        ERRMSG << msg.str() << "\n";
+        errors.push_back( msg.str() );
+        error = true;
+        return false;
+    }
+
+    list<MCAD_OUTLINE*>::iterator sC = mcutouts.begin();
+    list<MCAD_OUTLINE*>::iterator eC = mcutouts.end();
+
+    while( sC != eC )
+    {
+        if( !(*sC)->Simplify( aTolerance, error ) )
+        {
+            ostringstream msg;
+            GEOM_ERR( msg );
+            msg << "[INFO] could not simplify cutout";
+            ERRMSG << msg.str() << "\n";
+            errors.push_back( msg.str() );
+            return false;
+        }
+
+        ++sC;
+    }
+
+    vector<MCAD_SEGMENT*> segs( msegments.begin(), msegments.end() );
+    size_t n = segs.size();
+    size_t nLines = 0;
+    size_t start = 0;   // first segment after an arc
+
+    for( size_t i = 0; i < n; ++i )
+    {
+        if( MCAD_SEGTYPE_LINE == segs[i]->msegtype )
+            ++nLines;
+        else
+            start = ( i + 1 ) % n;
+    }
+
+    if( nLines < 2 )
+        return true;
+
+    list<MCAD_SEGMENT*> newSegs;
+    vector<MCAD_POINT> pts;
+
+    if( nLines == n )
+    {
+        MCAD_POINT c;
+        double r;
+        bool cw;
+
+        for( size_t i = 0; i <= n; ++i )
+            pts.push_back( segs[i % n]->mstart );
+
+        if( n > SIMPLIFY_MIN_ARC && fitArc( pts, 0, n, aTolerance, true, c, r, cw ) )
+        {
+            MCAD_SEGMENT* sp = new MCAD_SEGMENT;
+            MCAD_POINT p1 = c;
+
+            p1.x += r;
+            sp->SetParams( c, p1, p1, false );
+            newSegs.push_back( sp );
+        }
+        else
+        {
+            // Start at the sharpest corner of the polygon, then start
+            // again at the beginning of the last segment produced so
+            // that a line or arc which spans the start is not broken.
+            double maxTurn = -1.0;
+
+            for( size_t i = 0; i < n; ++i )
+            {
+                MCAD_SEGMENT* s0 = segs[( i + n - 1 ) % n];
+                MCAD_SEGMENT* s1 = segs[i];
+                double x0 = s0->mend.x - s0->mstart.x;
+                double y0 = s0->mend.y - s0->mstart.y;
+                double x1 = s1->mend.x - s1->mstart.x;
+                double y1 = s1->mend.y - s1->mstart.y;
+                double turn = fabs( atan2( x0 * y1 - y0 * x1, x0 * x1 + y0 * y1 ) );
+
+                if( turn > maxTurn )
+                {
+                    maxTurn = turn;
+                    start = i;
+                }
+            }
+
+            for( int pass = 0; pass < 2; ++pass )
+            {
+                for( size_t i = 0; i <= n; ++i )
+                    pts[i] = segs[( start + i ) % n]->mstart;
+
+                size_t iLast = simplifyRun( pts, aTolerance, newSegs );
+
+                if( pass > 0 || 0 == iLast )
+                    break;
+
+                while( !newSegs.empty() )
+                {
+                    delete newSegs.back();
+                    newSegs.pop_back();
+                }
+
+                start = ( start + iLast ) % n;
+            }
+        }
+    }
+    else
+    {
+        for( size_t k = 0; k < n; ++k )
+        {
+            MCAD_SEGMENT* sp = segs[( start + k ) % n];
+
+            if( MCAD_SEGTYPE_LINE == sp->msegtype )
+            {
+                if( pts.empty() )
+                    pts.push_back( sp->mstart );
+
+                pts.push_back( sp->mend );
+                continue;
+            }
+
+            if( !pts.empty() )
+            {
+                simplifyRun( pts, aTolerance, newSegs );
+                pts.clear();
+            }
+
+            newSegs.push_back( sp );
+        }
+
+        if( !pts.empty() )
+            simplifyRun( pts, aTolerance, newSegs );
+    }
+
+    for( size_t i = 0; i < n; ++i )
+    {
+        if( MCAD_SEGTYPE_LINE == segs[i]->msegtype )
+            delete segs[i];
+    }
+
+    msegments.swap( newSegs );
+    invalidateIndex();
+    calcBoundingBox();
+    return true;
+}   // Simplify( double aTolerance, bool& error )
+
+
 // Add the given cutout in preparation for exporting a solid model.
 // If the cutout is known to be non-overlapping then the 'overlaps'
 // flag may be set to 'false' to skip overlap tests. If the user
@@ -2226,8 +3100,33 @@ void MCAD_OUTLINE::adjustBoundingBox( void )
 }
 
 
+void MCAD_OUTLINE::SetFastCutouts( bool aEnable )
+{
+    mFastCutouts = aEnable;
+
+    if( !aEnable )
+        invalidateIndex();
+
+    return;
+}
+
+
+void MCAD_OUTLINE::invalidateIndex( void )
+{
+    if( NULL != mSegIndex )
+    {
+        delete mSegIndex;
+        mSegIndex = NULL;
+    }
+
+    return;
+}
+
+
 std::list<MCAD_SEGMENT*>* MCAD_OUTLINE::GetSegments( void )
 {
+    // the caller may modify the list
+    invalidateIndex();
     return &msegments;
 }
 
@@ -287,7 +287,24 @@ bool MCAD_SEGMENT::GetIntersections( const MCAD_SEGMENT& aSegment,
                                           std::list<MCAD_POINT>& aIntersectList,
                                           MCAD_INTERSECT_FLAG& flags )
 {
-    flags = MCAD_IFLAG_NONE;
+    MCAD_INTERSECTIONS result;
+    bool ok = GetIntersections( aSegment, result );
+
+    for( int i = 0; i < result.npoints; ++i )
+        aIntersectList.push_back( result.points[i] );
+
+    flags = result.flags;
+    return ok;
+}
+
+
+// calculate intersections with another segment (fixed size result)
+bool MCAD_SEGMENT::GetIntersections( const MCAD_SEGMENT& aSegment,
+                                     MCAD_INTERSECTIONS& aResult )
+{
+    aResult.npoints = 0;
+    aResult.flags = MCAD_IFLAG_NONE;
+    MCAD_INTERSECT_FLAG& flags = aResult.flags;
 
     if( MCAD_SEGTYPE_NONE == msegtype )
     {
@@ -323,28 +340,28 @@ bool MCAD_SEGMENT::GetIntersections( const MCAD_SEGMENT& aSegment,
     if( MCAD_SEGTYPE_CIRCLE == msegtype )
     {
         if( MCAD_SEGTYPE_CIRCLE == oSegType )
-            return checkCircles( aSegment, aIntersectList, flags );
+            return checkCircles( aSegment, aResult, flags );
 
         if( MCAD_SEGTYPE_ARC == oSegType )
-            return checkArcs(  aSegment, aIntersectList, flags );
+            return checkArcs(  aSegment, aResult, flags );
 
-        return checkArcLine(  aSegment, aIntersectList, flags );
+        return checkArcLine(  aSegment, aResult, flags );
     }
 
     // *this is an arc and it may intersect with a line, arc, or circle
     if( MCAD_SEGTYPE_ARC == msegtype )
     {
         if( MCAD_SEGTYPE_LINE == oSegType )
-            return checkArcLine(  aSegment, aIntersectList, flags );
+            return checkArcLine(  aSegment, aResult, flags );
 
-        return checkArcs(  aSegment, aIntersectList, flags );
+        return checkArcs(  aSegment, aResult, flags );
     }
 
     // *this is a line and it may intersect with a line, arc or circle
     if( MCAD_SEGTYPE_LINE == oSegType )
-        return checkLines(  aSegment, aIntersectList, flags );
+        return checkLines(  aSegment, aResult, flags );
 
-    return checkArcLine( aSegment, aIntersectList, flags );
+    return checkArcLine( aSegment, aResult, flags );
 }
 
 
@@ -488,7 +505,7 @@ void MCAD_SEGMENT::calcCircleIntercepts( MCAD_POINT c2, double r2, double d,
 
 // check case where both segments are circles
 bool MCAD_SEGMENT::checkCircles( const MCAD_SEGMENT& aSegment,
-                                 std::list<MCAD_POINT>& aIntersectList,
+                                 MCAD_INTERSECTIONS& aResult,
                                  MCAD_INTERSECT_FLAG& flags )
 {
     MCAD_POINT c2 = aSegment.GetCenter();
@@ -538,8 +555,8 @@ bool MCAD_SEGMENT::checkCircles( const MCAD_SEGMENT& aSegment,
     MCAD_POINT p1;
     MCAD_POINT p2;
     calcCircleIntercepts( c2, r2, d, p1, p2 );
-    aIntersectList.push_back( p1 );
-    aIntersectList.push_back( p2 );
+    aResult.Add( p1 );
+    aResult.Add( p2 );
 
     return true;
 }
@@ -547,7 +564,7 @@ bool MCAD_SEGMENT::checkCircles( const MCAD_SEGMENT& aSegment,
 
 // check case where both segments are arcs (one may be a circle)
 bool MCAD_SEGMENT::checkArcs( const MCAD_SEGMENT& aSegment,
-                              std::list<MCAD_POINT>& aIntersectList,
+                              MCAD_INTERSECTIONS& aResult,
                               MCAD_INTERSECT_FLAG& flags )
 {
     MCAD_POINT c2 = aSegment.GetCenter();
@@ -606,16 +623,16 @@ bool MCAD_SEGMENT::checkArcs( const MCAD_SEGMENT& aSegment,
         // there may be an intersection along an edge
         if( MCAD_SEGTYPE_CIRCLE == msegtype )
         {
-            aIntersectList.push_back( aSegment.GetStart() );
-            aIntersectList.push_back( aSegment.GetEnd() );
+            aResult.Add( aSegment.GetStart() );
+            aResult.Add( aSegment.GetEnd() );
             flags = MCAD_IFLAG_EDGE;
             return true;
         }
 
         if( MCAD_SEGTYPE_CIRCLE == aSegment.GetSegType() )
         {
-            aIntersectList.push_back( GetStart() );
-            aIntersectList.push_back( GetEnd() );
+            aResult.Add( GetStart() );
+            aResult.Add( GetEnd() );
             flags = MCAD_IFLAG_EDGE;
             return true;
         }
@@ -632,8 +649,8 @@ bool MCAD_SEGMENT::checkArcs( const MCAD_SEGMENT& aSegment,
             || (abs(b0 - a1) < 1e-8 && abs(b1 -a0 - 2.0*M_PI) < 1e-8)
             || (abs(a0 - b1) < 1e-8 && abs(a1 -b0 - 2.0*M_PI) < 1e-8) )
         {
-            aIntersectList.push_back( GetStart() );
-            aIntersectList.push_back( GetEnd() );
+            aResult.Add( GetStart() );
+            aResult.Add( GetEnd() );
             flags = MCAD_IFLAG_ENDPOINT;
             return true;
         }
@@ -646,8 +663,8 @@ bool MCAD_SEGMENT::checkArcs( const MCAD_SEGMENT& aSegment,
             || ((b0 + 2.0*M_PI) >= a0 && (b1 + 2.0*M_PI) <= a1)
             || ((b0 - 2.0*M_PI) >= a0 && (b1 - 2.0*M_PI) <= a1) )
         {
-            aIntersectList.push_back( aSegment.GetStart() );
-            aIntersectList.push_back( aSegment.GetEnd() );
+            aResult.Add( aSegment.GetStart() );
+            aResult.Add( aSegment.GetEnd() );
             flags = MCAD_IFLAG_EDGE;
             return true;
         }
@@ -656,8 +673,8 @@ bool MCAD_SEGMENT::checkArcs( const MCAD_SEGMENT& aSegment,
             || (a0 >= (b0 + 2.0*M_PI) && a1 <= (b1 + 2.0*M_PI))
             || (a0 >= (b0 - 2.0*M_PI) && a1 <= (b1 - 2.0*M_PI)) )
         {
-            aIntersectList.push_back( GetStart() );
-            aIntersectList.push_back( GetEnd() );
+            aResult.Add( GetStart() );
+            aResult.Add( GetEnd() );
             flags = MCAD_IFLAG_EDGE;
             return true;
         }
@@ -666,8 +683,8 @@ bool MCAD_SEGMENT::checkArcs( const MCAD_SEGMENT& aSegment,
         if( (b0 <= a0 && b1 >= a0 && b1 <= a1)
             || ((b0 - 2.0*M_PI) <= a0 && (b1 - 2.0*M_PI) >= a0 && (b1 - 2.0*M_PI) <= a1) )
         {
-            aIntersectList.push_back( GetStart() );
-            aIntersectList.push_back( aSegment.GetEnd() );
+            aResult.Add( GetStart() );
+            aResult.Add( aSegment.GetEnd() );
             flags = MCAD_IFLAG_EDGE;
             return true;
         }
@@ -677,8 +694,8 @@ bool MCAD_SEGMENT::checkArcs( const MCAD_SEGMENT& aSegment,
             || ((b0 + 2.0*M_PI) >= a0 && (b0 + 2.0*M_PI) <= a1 && (b1 + 2.0*M_PI) >= a1)
             || ((b0 - 2.0*M_PI) >= a0 && (b0 - 2.0*M_PI) <= a1 && (b1 - 2.0*M_PI) >= a1) )
         {
-            aIntersectList.push_back( GetStart() );
-            aIntersectList.push_back( aSegment.GetEnd() );
+            aResult.Add( GetStart() );
+            aResult.Add( aSegment.GetEnd() );
             flags = MCAD_IFLAG_EDGE;
             return true;
         }
@@ -710,8 +727,8 @@ bool MCAD_SEGMENT::checkArcs( const MCAD_SEGMENT& aSegment,
             || (PointMatches( GetStart(), aSegment.GetEnd(), 1e-3 )
             && PointMatches( GetEnd(), aSegment.GetStart(), 1e-3 ) ) )
         {
-            aIntersectList.push_back( GetStart() );
-            aIntersectList.push_back( GetEnd() );
+            aResult.Add( GetStart() );
+            aResult.Add( GetEnd() );
 
             if( r2 > mradius )
             {
@@ -853,7 +870,7 @@ bool MCAD_SEGMENT::checkArcs( const MCAD_SEGMENT& aSegment,
 
     if( 1 == np )
     {
-        aIntersectList.push_back( p0[0] );
+        aResult.Add( p0[0] );
         return true;
     }
 
@@ -868,13 +885,13 @@ bool MCAD_SEGMENT::checkArcs( const MCAD_SEGMENT& aSegment,
 
     if( ang0[0] > ang0[1] )
     {
-        aIntersectList.push_back( p0[1] );
-        aIntersectList.push_back( p0[0] );
+        aResult.Add( p0[1] );
+        aResult.Add( p0[0] );
     }
     else
     {
-        aIntersectList.push_back( p0[0] );
-        aIntersectList.push_back( p0[1] );
+        aResult.Add( p0[0] );
+        aResult.Add( p0[1] );
     }
 
     return true;
@@ -883,7 +900,7 @@ bool MCAD_SEGMENT::checkArcs( const MCAD_SEGMENT& aSegment,
 
 // check case where one segment is an arc and one a line
 bool MCAD_SEGMENT::checkArcLine( const MCAD_SEGMENT& aSegment,
-                                 std::list<MCAD_POINT>& aIntersectList,
+                                 MCAD_INTERSECTIONS& aResult,
                                  MCAD_INTERSECT_FLAG& flags )
 {
     flags = MCAD_IFLAG_NONE;
@@ -987,7 +1004,7 @@ bool MCAD_SEGMENT::checkArcLine( const MCAD_SEGMENT& aSegment,
             MCAD_POINT p;
             p.x = t * lS.x + (1.0 - t) * lE.x;
             p.y = t * lS.y + (1.0 - t) * lE.y;
-            aIntersectList.push_back( p );
+            aResult.Add( p );
             return true;
         }
 
@@ -1057,7 +1074,7 @@ bool MCAD_SEGMENT::checkArcLine( const MCAD_SEGMENT& aSegment,
     {
         if( 1 == np )
         {
-            aIntersectList.push_back( p[0] );
+            aResult.Add( p[0] );
             flags = f[0];
             return true;
         }
@@ -1080,13 +1097,13 @@ bool MCAD_SEGMENT::checkArcLine( const MCAD_SEGMENT& aSegment,
 
         if( swap )
         {
-            aIntersectList.push_back( p[1] );
-            aIntersectList.push_back( p[0] );
+            aResult.Add( p[1] );
+            aResult.Add( p[0] );
         }
         else
         {
-            aIntersectList.push_back( p[0] );
-            aIntersectList.push_back( p[1] );
+            aResult.Add( p[0] );
+            aResult.Add( p[1] );
         }
 
         return true;
@@ -1116,14 +1133,14 @@ bool MCAD_SEGMENT::checkArcLine( const MCAD_SEGMENT& aSegment,
     if( tangent )
     {
         flags = MCAD_IFLAG_TANGENT;
-        aIntersectList.push_back( pt[0] );
+        aResult.Add( pt[0] );
         return true;
     }
 
     if( 1 == np2 )
     {
         flags = f[0];
-        aIntersectList.push_back( pt[0] );
+        aResult.Add( pt[0] );
         return true;
     }
 
@@ -1139,13 +1156,13 @@ bool MCAD_SEGMENT::checkArcLine( const MCAD_SEGMENT& aSegment,
 
     if( ang[1] > ang[0] )
     {
-        aIntersectList.push_back( pt[0] );
-        aIntersectList.push_back( pt[1] );
+        aResult.Add( pt[0] );
+        aResult.Add( pt[1] );
     }
     else
     {
-        aIntersectList.push_back( pt[1] );
-        aIntersectList.push_back( pt[0] );
+        aResult.Add( pt[1] );
+        aResult.Add( pt[0] );
     }
 
     return true;
@@ -1154,7 +1171,7 @@ bool MCAD_SEGMENT::checkArcLine( const MCAD_SEGMENT& aSegment,
 
 // check case where both segments are lines
 bool MCAD_SEGMENT::checkLines( const MCAD_SEGMENT& aSegment,
-                               std::list<MCAD_POINT>& aIntersectList,
+                               MCAD_INTERSECTIONS& aResult,
                                MCAD_INTERSECT_FLAG& flags )
 {
     if( MCAD_SEGTYPE_NONE == msegtype || MCAD_SEGTYPE_NONE == aSegment.GetSegType() )
@@ -1269,8 +1286,8 @@ bool MCAD_SEGMENT::checkLines( const MCAD_SEGMENT& aSegment,
 
         if( s0i && e0i )
         {
-            aIntersectList.push_back( mstart );
-            aIntersectList.push_back( mend );
+            aResult.Add( mstart );
+            aResult.Add( mend );
             return true;
         }
 
@@ -1289,13 +1306,13 @@ bool MCAD_SEGMENT::checkLines( const MCAD_SEGMENT& aSegment,
 
             if( t1 < t2 )
             {
-                aIntersectList.push_back( p0 );
-                aIntersectList.push_back( p1 );
+                aResult.Add( p0 );
+                aResult.Add( p1 );
             }
             else
             {
-                aIntersectList.push_back( p1 );
-                aIntersectList.push_back( p0 );
+                aResult.Add( p1 );
+                aResult.Add( p0 );
             }
 
             return true;
@@ -1303,15 +1320,15 @@ bool MCAD_SEGMENT::checkLines( const MCAD_SEGMENT& aSegment,
 
         if( s0i && s1i )
         {
-            aIntersectList.push_back( mstart );
-            aIntersectList.push_back( p0 );
+            aResult.Add( mstart );
+            aResult.Add( p0 );
             return true;
         }
 
         if( s0i && e1i )
         {
-            aIntersectList.push_back( mstart );
-            aIntersectList.push_back( p1 );
+            aResult.Add( mstart );
+            aResult.Add( p1 );
             return true;
         }
 
@@ -1319,14 +1336,14 @@ bool MCAD_SEGMENT::checkLines( const MCAD_SEGMENT& aSegment,
 
         if( s1i )
         {
-            aIntersectList.push_back( p0 );
-            aIntersectList.push_back( mend );
+            aResult.Add( p0 );
+            aResult.Add( mend );
             return true;
         }
 
         // must be e0i && e1i
-        aIntersectList.push_back( p1 );
-        aIntersectList.push_back( mend );
+        aResult.Add( p1 );
+        aResult.Add( mend );
         return true;
     }
 
@@ -1342,7 +1359,7 @@ bool MCAD_SEGMENT::checkLines( const MCAD_SEGMENT& aSegment,
     {
         p0.x = t2 * XA2 + XB2;
         p0.y = t2 * YA2 + YB2;
-        aIntersectList.push_back( p0 );
+        aResult.Add( p0 );
 
         if( abs( t1 ) < 1e-8 || abs( t1 - 1.0 ) < 1e-8
             || abs( t2 ) < 1e-8 || abs( t2 - 1.0 ) < 1e-8 )
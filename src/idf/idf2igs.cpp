@@ -39,7 +39,29 @@
 #include <list>
 #include <utility>
 #include <clocale>
+#include <cstdio>
+#include <sstream>
+#include <stdint.h>
 #include <vector>
+#include <set>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <cerrno>
+#include <cstdlib>
+
+#ifdef _WIN32
+    #include <direct.h>
+    #include <windows.h>
+#else
+    #include <dirent.h>
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <unistd.h>
+#endif
 
 #include <idf_helpers.h>
 #include <idf_common.h>
@@ -65,12 +87,46 @@ using namespace std;
 // colors to be used in the output assembly model
 #define NCOLORS 9
 
-static struct
+// version of the component model cache; this must be incremented whenever
+// a change to the code alters the models generated from an outline
+#define COMP_CACHE_VERSION (1)
+// coordinate tolerance (mm) and angle tolerance (degrees) used to
+// identify component outlines with identical geometry
+#define OUTLINE_TOL (1e-4)
+#define OUTLINE_ANG_TOL (1e-4)
+
+// data for the board being converted; in batch mode each worker
+// thread converts one board at a time and has its own instance
+static thread_local struct
 {
     string basename;
     IGES_ENTITY_314* colors[NCOLORS];
+    int colorIndex;     // next component color
 } globs;
 
+// component model cache directory; empty = no cache
+static string cacheDir;
+
+// tolerance (mm) for simplifying outlines; 0 = outlines are used as given
+static double simplifyTol = 0.0;
+
+// true if the BREP representation of each boundary of a plane is
+// rendered as a single NURBS curve
+static bool joinCurves = false;
+
+// true if the sides of each closed loop are rendered as a single
+// Tabulated Cylinder
+static bool extrudeLoops = false;
+
+// cache files which are being created; other boards which require
+// the same component wait for the file rather than building it again
+static struct
+{
+    std::mutex lock;
+    std::condition_variable done;
+    std::set< string > pending;
+} cacheSync;
+
 bool initColors( DLL_IGES& model, IGES_ENTITY_314** colors );
 
 // convert IDF outline to IGS outline
@@ -91,6 +147,15 @@ bool MakeComponents( IDF3_BOARD& board, DLL_IGES& model );
 bool MakeOtherOutlines( IDF3_BOARD& board, DLL_IGES& model );
 // build a component part model from the given outline data
 bool buildComponent( DLL_IGES& model, const IDF3_COMP_OUTLINE* idf, IGES_ENTITY_308** subfig );
+// create the surfaces of a component body
+bool buildComponentBody( DLL_IGES& model, IDF_OUTLINE* op, double th,
+                         IGES_ENTITY_144**& surfs, int& nSurfs );
+// compute the key of a component outline within the model cache
+string hashComponent( const IDF3_COMP_OUTLINE* idf, IDF_OUTLINE* op, double th );
+// retrieve a component model from the cache; returns true if the model was found
+bool loadCachedComponent( DLL_IGES& model, const string& fname, IGES_ENTITY_308** subfig );
+// compute a key which is identical for outlines with the same geometry
+string canonicalOutlineKey( const IDF3_COMP_OUTLINE* idf );
 
 // routines to make IGES model creation easier
 bool newSubfigure( DLL_IGES& model, IGES_ENTITY_308** aNewSubfig );
@@ -99,36 +164,124 @@ IGES_ENTITY_124* calcTransform( DLL_IGES& model, double dX, double dY, double dZ
 // retrieve an index to the next color in the sequence
 int GetComponentColor( void );
 
+// convert a single board and return true on success
+bool convertBoard( const string& inputFilename, bool restoreLocale );
+// retrieve the list of boards to convert in batch mode
+bool getBatchList( const string& aSource, vector< string >& aList );
+// convert a list of boards concurrently
+int convertBatch( const vector< string >& aList, int aNThreads );
+// create or validate the default per-user cache directory
+bool getDefaultCacheDir( string& aDir );
+
 
 void PrintUsage( void )
 {
-    cout << "-\nUsage: idfigs input_file.emn\n";
+    cout << "-\nUsage: idfigs [-c cache_dir] [-s tolerance] [-m] [-e] input_file.emn\n";
+    cout << "       idfigs [-c cache_dir] [-s tolerance] [-m] [-e] [-j nthreads] -b list_file|directory\n";
+    cout << "  -c cache_dir: directory in which component models are cached\n";
+    cout << "     so that unchanged components are not rebuilt on the next run\n";
+    cout << "  -s tolerance: merge runs of outline segments which lie within the\n";
+    cout << "     given distance (mm) of a single line, arc or circle; this greatly\n";
+    cout << "     reduces the size of models whose outlines are tessellated\n";
+    cout << "  -m: render the parameter space curve of each boundary of a top\n";
+    cout << "     or bottom plane as a single NURBS curve rather than a composite\n";
+    cout << "     curve with one NURBS curve per segment\n";
+    cout << "  -e: render the sides of each outline, cutout and hole as a single\n";
+    cout << "     tabulated cylinder rather than one or more surfaces per segment\n";
+    cout << "  -b: convert all boards listed in a file (one per line) or all\n";
+    cout << "     *.emn files within a directory; the boards share a component\n";
+    cout << "     model cache which defaults to idf2igs_cache-<uid> in the\n";
+    cout << "     temporary directory; the directory must be owned by the user\n";
+    cout << "     and must not be writable by others\n";
+    cout << "  -j nthreads: number of boards to convert concurrently (default:\n";
+    cout << "     number of processors)\n";
     return;
 }
 
 
 int main( int argc, char **argv )
 {
-    if( argc != 2 )
+    string inputFilename;
+    string batchSource;
+    int nThreads = 0;
+
+    for( int i = 1; i < argc; ++i )
     {
+        string arg = argv[i];
+
+        if( ( arg == "-c" || arg == "-b" || arg == "-j" || arg == "-s" ) && i + 1 < argc )
+        {
+            ++i;
+
+            if( arg == "-c" )
+                cacheDir = argv[i];
+            else if( arg == "-b" )
+                batchSource = argv[i];
+            else if( arg == "-s" )
+                simplifyTol = atof( argv[i] );
+            else
+                nThreads = atoi( argv[i] );
+        }
+        else if( arg == "-m" )
+        {
+            joinCurves = true;
+        }
+        else if( arg == "-e" )
+        {
+            extrudeLoops = true;
+        }
+        else if( inputFilename.empty() && arg[0] != '-' )
+        {
+            inputFilename = arg;
+        }
+        else
+        {
+            PrintUsage();
+            return -1;
+        }
+    }
+
+    if( batchSource.empty() == inputFilename.empty() )
+    {
+        if( inputFilename.empty() )
+            cerr << "* no IDF filename supplied\n";
+
         PrintUsage();
         return -1;
     }
 
+    if( !batchSource.empty() )
+    {
+        vector< string > boards;
+
+        if( !getBatchList( batchSource, boards ) )
+            return -1;
+
+        if( cacheDir.empty() && !getDefaultCacheDir( cacheDir ) )
+            return -1;
+
+        // IDF implicitly requires the C locale; the locale is shared
+        // by all threads so it is only restored once all boards are done
+        setlocale( LC_ALL, "C" );
+        int res = convertBatch( boards, nThreads );
+        setlocale( LC_ALL, "" );
+        return res;
+    }
+
     // IDF implicitly requires the C locale
     setlocale( LC_ALL, "C" );
 
-    // Essential inputs:
-    // 1. IDF file
+    if( !convertBoard( inputFilename, true ) )
+        return -1;
 
-    std::string inputFilename = argv[1];
+    return 0;
+}
 
-    if( inputFilename.empty() )
-    {
-        cerr << "* no IDF filename supplied\n";
-        PrintUsage();
-        return -1;
-    }
+
+bool convertBoard( const string& inputFilename, bool restoreLocale )
+{
+    // Essential inputs:
+    // 1. IDF file
 
     IDF3_BOARD pcb( IDF3::CAD_ELEC );
 
@@ -139,11 +292,12 @@ int main( int argc, char **argv )
         cerr << "** Failed to read IDF data:\n";
         cerr << pcb.GetError() << "\n\n";
 
-        return -1;
+        return false;
     }
 
     // restore the locale
-    setlocale( LC_ALL, "" );
+    if( restoreLocale )
+        setlocale( LC_ALL, "" );
 
     // create an IGES model and set its parameters
     DLL_IGES model;
@@ -152,11 +306,12 @@ int main( int argc, char **argv )
     // model.globalData.nativeSystemID = "libIGES";
     model.SetUnitsFlag( UNIT_MM );
     model.SetMinResolution( 1e-8 );
+    globs.colorIndex = 1;   // index starts at 1 since 0 is the PCB color
 
     if( !initColors( model, globs.colors ) )
     {
         cerr << "** Failed to create IGES color entities\n";
-        return -1;
+        return false;
     }
 
     // Create the VRML file and write the header
@@ -179,10 +334,199 @@ int main( int argc, char **argv )
 
     model.Write( fname.c_str(), true );
 
-    return 0;
+    return true;
 }
 
 
+bool getBatchList( const string& aSource, vector< string >& aList )
+{
+    aList.clear();
+
+    #ifdef _WIN32
+    WIN32_FIND_DATAA fd;
+    HANDLE hd = FindFirstFileA( ( aSource + "\\*.emn" ).c_str(), &fd );
+
+    if( INVALID_HANDLE_VALUE != hd )
+    {
+        do
+        {
+            if( !( fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) )
+                aList.push_back( aSource + "\\" + fd.cFileName );
+        } while( FindNextFileA( hd, &fd ) );
+
+        FindClose( hd );
+        sort( aList.begin(), aList.end() );
+        return true;
+    }
+    #else
+    DIR* dp = opendir( aSource.c_str() );
+
+    if( NULL != dp )
+    {
+        struct dirent* ep;
+
+        while( NULL != ( ep = readdir( dp ) ) )
+        {
+            string name = ep->d_name;
+
+            if( name.size() > 4 && name.compare( name.size() - 4, 4, ".emn" ) == 0 )
+                aList.push_back( aSource + "/" + name );
+        }
+
+        closedir( dp );
+        sort( aList.begin(), aList.end() );
+        return true;
+    }
+    #endif
+
+    // not a directory; read the list of files
+    ifstream lf( aSource.c_str() );
+
+    if( !lf.is_open() )
+    {
+        cerr << "* could not open batch list '" << aSource << "'\n";
+        return false;
+    }
+
+    string line;
+
+    while( getline( lf, line ) )
+    {
+        size_t p0 = line.find_first_not_of( " \t\r" );
+
+        if( string::npos == p0 )
+            continue;
+
+        size_t p1 = line.find_last_not_of( " \t\r" );
+        aList.push_back( line.substr( p0, p1 - p0 + 1 ) );
+    }
+
+    return true;
+}
+
+
+// the default cache directory is shared by all batch runs of the same
+// user; since cache files are loaded without further checks the directory
+// is rejected if it is not owned by the user or if others may write to it
+bool getDefaultCacheDir( string& aDir )
+{
+    const char* tmp = getenv( "TMPDIR" );
+
+    if( NULL == tmp )
+        tmp = getenv( "TEMP" );
+
+    #ifdef _WIN32
+    // the temporary directory is private to the user
+    aDir = ( NULL == tmp ) ? "." : tmp;
+    aDir += "/idf2igs_cache";
+
+    if( 0 != _mkdir( aDir.c_str() ) && EEXIST != errno )
+    {
+        cerr << "* could not create cache directory '" << aDir << "'\n";
+        aDir.clear();
+        return false;
+    }
+    #else
+    ostringstream ostr;
+    ostr << ( ( NULL == tmp ) ? "/tmp" : tmp ) << "/idf2igs_cache-" << getuid();
+    aDir = ostr.str();
+
+    if( 0 != mkdir( aDir.c_str(), 0700 ) && EEXIST != errno )
+    {
+        cerr << "* could not create cache directory '" << aDir << "'\n";
+        aDir.clear();
+        return false;
+    }
+
+    // lstat() ensures that a symbolic link planted by another user is rejected
+    struct stat sb;
+
+    if( 0 != lstat( aDir.c_str(), &sb ) || !S_ISDIR( sb.st_mode )
+        || sb.st_uid != getuid() || 0 != ( sb.st_mode & ( S_IWGRP | S_IWOTH ) ) )
+    {
+        cerr << "* refusing to use cache directory '" << aDir << "'; it must be a\n";
+        cerr << "  directory owned by the user and not writable by others; use -c\n";
+        cerr << "  to specify a different directory\n";
+        aDir.clear();
+        return false;
+    }
+    #endif
+
+    return true;
+}
+
+
+// worker for batch conversions; each thread takes the next board in
+// the list until all boards have been converted
+static void batchWorker( const vector< string >* aList, std::atomic<size_t>* aNext,
+                         vector< double >* aTimes, vector< char >* aResults )
+{
+    size_t idx;
+
+    while( ( idx = aNext->fetch_add( 1 ) ) < aList->size() )
+    {
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        (*aResults)[idx] = convertBoard( (*aList)[idx], false );
+        chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+        (*aTimes)[idx] = chrono::duration< double >( t1 - t0 ).count();
+    }
+
+    return;
+}
+
+
+int convertBatch( const vector< string >& aList, int aNThreads )
+{
+    if( aList.empty() )
+    {
+        cerr << "* no boards to convert\n";
+        return -1;
+    }
+
+    if( aNThreads <= 0 )
+        aNThreads = (int)thread::hardware_concurrency();
+
+    if( aNThreads <= 0 )
+        aNThreads = 1;
+
+    if( aNThreads > (int)aList.size() )
+        aNThreads = (int)aList.size();
+
+    vector< double > times( aList.size(), 0.0 );
+    vector< char > results( aList.size(), 0 );
+    std::atomic<size_t> next( 0 );
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+    vector< thread > workers;
+
+    for( int i = 1; i < aNThreads; ++i )
+        workers.push_back( thread( batchWorker, &aList, &next, &times, &results ) );
+
+    batchWorker( &aList, &next, &times, &results );
+
+    for( size_t i = 0; i < workers.size(); ++i )
+        workers[i].join();
+
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    int nFail = 0;
+
+    cout << "** Batch summary (" << aNThreads << " threads):\n";
+
+    for( size_t i = 0; i < aList.size(); ++i )
+    {
+        cout << "   " << fixed << setprecision( 3 ) << setw( 9 ) << times[i] << " s  "
+            << aList[i] << ( results[i] ? "" : "  [FAILED]" ) << "\n";
+
+        if( !results[i] )
+            ++nFail;
+    }
+
+    cout << "** " << aList.size() - nFail << " of " << aList.size() << " boards converted in "
+        << chrono::duration< double >( t1 - t0 ).count() << " s\n";
+
+    return nFail ? -1 : 0;
+}
+
 
 bool MakeBoard( IDF3_BOARD& board, DLL_IGES& model )
 {
@@ -348,6 +692,8 @@ bool MakeBoard( IDF3_BOARD& board, DLL_IGES& model )
     IGES_ENTITY_144** surfs = NULL;
     int nSurfs = 0;
     double th = 0.5 * board.GetBoardThickness();
+    otln.SetJoinCurves( joinCurves );
+    otln.SetExtrudeLoops( extrudeLoops );
     otln.GetVerticalSurface( model.GetRawPtr(), dud, surfs, nSurfs, th, -th );
     otln.GetTrimmedPlane( model.GetRawPtr(), dud, surfs, nSurfs, th, false );
     otln.GetTrimmedPlane( model.GetRawPtr(), dud, surfs, nSurfs, -th, true );
@@ -478,6 +824,13 @@ bool convertOln( MCAD_OUTLINE* olnIGS, IDF_OUTLINE* olnIDF )
         ++sseg;
     }
 
+    if( simplifyTol > 0.0 && ( !oIGS.Simplify( simplifyTol, dud ) || dud ) )
+    {
+        oIGS.Detach();
+        ERROR_IDF << "could not simplify outline\n";
+        return false;
+    }
+
     oIGS.Detach();
     return true;
 }
@@ -527,14 +880,7 @@ bool mergeDrills( list< MCAD_SEGMENT* >& drills, list< MCAD_OUTLINE* >& cutouts,
     list< MCAD_SEGMENT* >::iterator sD = drills.begin();
     list< MCAD_SEGMENT* >::iterator eD = drills.end();
     list< MCAD_SEGMENT* >::iterator iD;
-    MCAD_POINT* ilist = NULL;
-    int nPoints = 0;
-    MCAD_INTERSECT_FLAG flag = MCAD_IFLAG_NONE;
-
-#define CLEAR_ILIST() do {\
-    if( NULL != ilist ) delete [] ilist; \
-    ilist = NULL; \
-    nPoints = 0; } while( 0 )
+    MCAD_INTERSECTIONS ilist;
 
     list< list< MCAD_SEGMENT* >* >bundles;
     list< MCAD_SEGMENT* >* sp;
@@ -553,10 +899,9 @@ bool mergeDrills( list< MCAD_SEGMENT* >& drills, list< MCAD_OUTLINE* >& cutouts,
 
         while( iD != eD )
         {
-            if( seg2.GetIntersections( *iD, ilist, nPoints, flag ) )
+            if( seg2.GetIntersections( *iD, ilist ) )
             {
                 skip = true;
-                CLEAR_ILIST();
                 sp = new list< MCAD_SEGMENT* >;
                 bundles.push_back( sp );
                 sp->push_back( *sD );
@@ -585,10 +930,8 @@ bool mergeDrills( list< MCAD_SEGMENT* >& drills, list< MCAD_OUTLINE* >& cutouts,
                     {
                         seg1.Attach( *sD1 );
 
-                        if( seg0.GetIntersections( seg1, ilist, nPoints, flag ) )
+                        if( seg0.GetIntersections( seg1, ilist ) )
                         {
-                            CLEAR_ILIST();
-
                             sp->push_back( *sD1 );
 
                             if( sD == sD1 )
@@ -607,9 +950,9 @@ bool mergeDrills( list< MCAD_SEGMENT* >& drills, list< MCAD_OUTLINE* >& cutouts,
 
                         seg1.Detach();
 
-                        if( flag )
+                        if( ilist.flags )
                         {
-                            ERROR_IDF << "\n + [INFO] geometry error (flag = " << flag << ")\n";
+                            ERROR_IDF << "\n + [INFO] geometry error (flag = " << ilist.flags << ")\n";
                             seg0.Detach();
                             seg2.Detach();
                             return false;
@@ -626,10 +969,10 @@ bool mergeDrills( list< MCAD_SEGMENT* >& drills, list< MCAD_OUTLINE* >& cutouts,
                 continue;
             }
 
-            if( flag )
+            if( ilist.flags )
             {
                 seg2.Detach();
-                ERROR_IDF << "\n + [INFO] geometry error (flag = " << flag << ")\n";
+                ERROR_IDF << "\n + [INFO] geometry error (flag = " << ilist.flags << ")\n";
                 return false;
             }
 
@@ -857,6 +1200,9 @@ bool initColors( DLL_IGES& model, IGES_ENTITY_314** colors )
 bool MakeComponents( IDF3_BOARD& board, DLL_IGES& model )
 {
     map< string, IGES_ENTITY_308*> componentList; // the IGES component models
+    // models keyed by outline geometry; outlines with different names but
+    // identical geometry share a single model
+    map< string, IGES_ENTITY_308*> geometryList;
     double th = 0.5 * board.GetBoardThickness();
 
     const map< string, IDF3_COMP_OUTLINE*>* cop = &board.GetComponentOutlines();
@@ -864,15 +1210,30 @@ bool MakeComponents( IDF3_BOARD& board, DLL_IGES& model )
     map< string, IDF3_COMP_OUTLINE*>::const_iterator eOP = cop->end();
 
     IGES_ENTITY_308* subfig;
+    string gkey;
 
     while( sOP != eOP )
     {
+        gkey = canonicalOutlineKey( sOP->second );
+        map< string, IGES_ENTITY_308*>::iterator sG = geometryList.find( gkey );
+
+        if( sG != geometryList.end() )
+        {
+            if( sG->second )
+                componentList.insert( pair<string, IGES_ENTITY_308*>( sOP->first, sG->second ) );
+
+            ++sOP;
+            continue;
+        }
+
         if( !buildComponent( model, sOP->second, &subfig ) )
         {
             ERRMSG << "+ [INFO] could not build a component model\n";
             return false;
         }
 
+        geometryList.insert( pair<string, IGES_ENTITY_308*>( gkey, subfig ) );
+
         if( !subfig )
         {
             // there was no outline to render but we do not
@@ -1034,6 +1395,8 @@ bool MakeOtherOutlines( IDF3_BOARD& board, DLL_IGES& model )
         IGES_ENTITY_144** surfs = NULL;
         int nSurfs = 0;
         double th = sc->second->GetThickness();
+        otln.SetJoinCurves( joinCurves );
+        otln.SetExtrudeLoops( extrudeLoops );
 
         if( bottom )
         {
@@ -1131,41 +1494,103 @@ bool buildComponent( DLL_IGES& model, const IDF3_COMP_OUTLINE* idf, IGES_ENTITY_
         return true;
     }
 
-    DLL_IGES_GEOM_PCB otln( true ); // component outline
+    IGES_ENTITY_144** surfs = NULL;
+    int nSurfs = 0;
 
-    if( !convertOln( otln.GetRawPtr(), op ) )
+    if( cacheDir.empty() )
     {
-        ERRMSG << "\n + [INFO] could not convert component outline\n";
-        return true;
-    }
+        if( !buildComponentBody( model, op, th, surfs, nSurfs ) )
+            return true;
 
-    // put in part definition, names, color and create the component model
-    bool dud = false;
-    IGES_ENTITY_144** surfs = NULL;
-    int nSurfs = 0;
+        if( !newSubfigure( model, subfig ) )
+        {
+            ERROR_IDF << "\n + could not create a subfigure entity\n";
+            return false;
+        }
 
-    otln.GetVerticalSurface( model.GetRawPtr(), dud, surfs, nSurfs, th, 0.0 );
-    otln.GetTrimmedPlane( model.GetRawPtr(), dud, surfs, nSurfs, th, false );
-    otln.GetTrimmedPlane( model.GetRawPtr(), dud, surfs, nSurfs, 0.0, true );
-    otln.Detach();
+        DLL_IGES_ENTITY_308 e308( model, false );
+        e308.Attach( (IGES_ENTITY*)*subfig );
+
+        for( int i = 0; i < nSurfs; ++ i )
+            e308.AddDE((IGES_ENTITY *) surfs[i] );
 
-    if( !newSubfigure( model, subfig ) )
+        e308.Detach();
+    }
+    else
     {
-        ERROR_IDF << "\n + could not create a subfigure entity\n";
-        return false;
+        string fname = cacheDir + "/" + hashComponent( idf, op, th ) + ".igs";
+        bool claimed = false;
+
+        // wait while another board creates the same cache file, then
+        // either load the file or claim the right to create it
+        while( !claimed )
+        {
+            do
+            {
+                std::unique_lock<std::mutex> lock( cacheSync.lock );
+
+                while( cacheSync.pending.count( fname ) )
+                    cacheSync.done.wait( lock );
+
+            } while( 0 );
+
+            if( loadCachedComponent( model, fname, subfig ) )
+                break;
+
+            std::lock_guard<std::mutex> lock( cacheSync.lock );
+
+            if( !cacheSync.pending.count( fname ) )
+            {
+                cacheSync.pending.insert( fname );
+                claimed = true;
+            }
+        }
+
+        if( claimed )
+        {
+            // build the body in a separate model which is saved to the
+            // cache and then merged into the assembly
+            DLL_IGES part;
+            part.SetUnitsFlag( UNIT_MM );
+            part.SetMinResolution( 1e-8 );
+            bool ok = buildComponentBody( part, op, th, surfs, nSurfs );
+
+            if( ok && !part.Write( fname.c_str(), true ) )
+                ERRMSG << "\n + [WARNING] could not write cache file '" << fname << "'\n";
+
+            do
+            {
+                std::lock_guard<std::mutex> lock( cacheSync.lock );
+                cacheSync.pending.erase( fname );
+                cacheSync.done.notify_all();
+            } while( 0 );
+
+            if( !ok )
+                return true;
+
+            if( !part.Export( &model, subfig ) || NULL == *subfig )
+            {
+                ERROR_IDF << "\n + could not create a subfigure entity\n";
+                return false;
+            }
+        }
     }
 
+    // add the names and colors
     int cidx = GetComponentColor();
     DLL_IGES_ENTITY_144 e144( model, false );
     DLL_IGES_ENTITY_308 e308( model, false );
     e308.Attach( (IGES_ENTITY*)*subfig );
 
-    for( int i = 0; i < nSurfs; ++ i )
+    size_t nDE = 0;
+    IGES_ENTITY** deList = NULL;
+    e308.GetDEList( nDE, deList );
+
+    for( size_t i = 0; i < nDE; ++ i )
     {
-        e144.Attach( (IGES_ENTITY*)surfs[i] );
+        e144.Attach( deList[i] );
         e144.SetColor( (IGES_ENTITY*) globs.colors[cidx] );
         e144.Detach();
-        e308.AddDE((IGES_ENTITY *) surfs[i] );
     }
 
     // add the name; note this dirty trick to work around retrieval of the UID
@@ -1183,13 +1608,257 @@ bool buildComponent( DLL_IGES& model, const IDF3_COMP_OUTLINE* idf, IGES_ENTITY_
 }
 
 
+// create the surfaces of a component body
+bool buildComponentBody( DLL_IGES& model, IDF_OUTLINE* op, double th,
+                         IGES_ENTITY_144**& surfs, int& nSurfs )
+{
+    DLL_IGES_GEOM_PCB otln( true ); // component outline
+
+    if( !convertOln( otln.GetRawPtr(), op ) )
+    {
+        ERRMSG << "\n + [INFO] could not convert component outline\n";
+        return false;
+    }
+
+    bool dud = false;
+    surfs = NULL;
+    nSurfs = 0;
+
+    otln.SetJoinCurves( joinCurves );
+    otln.SetExtrudeLoops( extrudeLoops );
+    otln.GetVerticalSurface( model.GetRawPtr(), dud, surfs, nSurfs, th, 0.0 );
+    otln.GetTrimmedPlane( model.GetRawPtr(), dud, surfs, nSurfs, th, false );
+    otln.GetTrimmedPlane( model.GetRawPtr(), dud, surfs, nSurfs, 0.0, true );
+    otln.Detach();
+
+    return true;
+}
+
+
+// 64-bit FNV-1a hash
+static void hashBytes( uint64_t& aHash, const void* aData, size_t aSize )
+{
+    const unsigned char* dp = (const unsigned char*)aData;
+
+    for( size_t i = 0; i < aSize; ++i )
+    {
+        aHash ^= dp[i];
+        aHash *= 1099511628211ULL;
+    }
+
+    return;
+}
+
+
+static void hashDouble( uint64_t& aHash, double aValue )
+{
+    // ensure that 0 and -0 produce the same key
+    if( aValue == 0.0 )
+        aValue = 0.0;
+
+    hashBytes( aHash, &aValue, sizeof( aValue ) );
+    return;
+}
+
+
+// compute the key of a component outline within the model cache; the key
+// covers all data which affect the generated model but not the name of
+// the outline, so identical bodies with different names share an entry
+string hashComponent( const IDF3_COMP_OUTLINE* idf, IDF_OUTLINE* op, double th )
+{
+    uint64_t hash = 14695981039346656037ULL;
+    int ival = COMP_CACHE_VERSION;
+    hashBytes( hash, &ival, sizeof( ival ) );
+    ival = (int)idf->GetUnit();
+    hashBytes( hash, &ival, sizeof( ival ) );
+    hashDouble( hash, th );
+
+    // models built with the default options keep their original keys
+    if( simplifyTol > 0.0 )
+        hashDouble( hash, simplifyTol );
+
+    if( joinCurves )
+    {
+        ival = 1;
+        hashBytes( hash, &ival, sizeof( ival ) );
+    }
+
+    if( extrudeLoops )
+    {
+        ival = 2;
+        hashBytes( hash, &ival, sizeof( ival ) );
+    }
+
+    std::list<IDF_SEGMENT*>::iterator sseg = op->begin();
+    std::list<IDF_SEGMENT*>::iterator eseg = op->end();
+
+    while( sseg != eseg )
+    {
+        hashDouble( hash, (*sseg)->startPoint.x );
+        hashDouble( hash, (*sseg)->startPoint.y );
+        hashDouble( hash, (*sseg)->endPoint.x );
+        hashDouble( hash, (*sseg)->endPoint.y );
+        hashDouble( hash, (*sseg)->angle );
+        ++sseg;
+    }
+
+    char buf[17];
+    snprintf( buf, sizeof( buf ), "%016llx", (unsigned long long)hash );
+    return string( buf );
+}
+
+
+// retrieve a component model from the cache; returns true if the model was found
+bool loadCachedComponent( DLL_IGES& model, const string& fname, IGES_ENTITY_308** subfig )
+{
+    *subfig = NULL;
+    FILE* fp = fopen( fname.c_str(), "r" );
+
+    if( NULL == fp )
+        return false;
+
+    fclose( fp );
+
+    DLL_IGES part;
+
+    if( !part.Read( fname.c_str() ) || !part.Export( &model, subfig ) || NULL == *subfig )
+    {
+        ERRMSG << "\n + [WARNING] ignoring invalid cache file '" << fname << "'\n";
+        *subfig = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+
+// a vertex of an outline: quantized start point and included angle
+// of the segment starting at that point
+struct OUTLINE_VERTEX
+{
+    long long x;
+    long long y;
+    long long a;
+
+    bool operator<( const OUTLINE_VERTEX& aVertex ) const
+    {
+        if( x != aVertex.x )
+            return x < aVertex.x;
+
+        if( y != aVertex.y )
+            return y < aVertex.y;
+
+        return a < aVertex.a;
+    }
+
+    bool operator==( const OUTLINE_VERTEX& aVertex ) const
+    {
+        return x == aVertex.x && y == aVertex.y && a == aVertex.a;
+    }
+};
+
+
+static long long quantize( double aValue, double aTolerance )
+{
+    return (long long)floor( aValue / aTolerance + 0.5 );
+}
+
+
+// compute a key which is identical for outlines with the same geometry;
+// the outline is traversed counterclockwise from its least vertex so the
+// key does not depend on the starting point or winding of the outline,
+// and coordinates are quantized to OUTLINE_TOL
+string canonicalOutlineKey( const IDF3_COMP_OUTLINE* idf )
+{
+    // note we defeat the 'const' attribute here
+    IDF_OUTLINE* op = ((IDF3_COMP_OUTLINE*)idf)->GetOutline( 0 );
+    ostringstream key;
+
+    key << quantize( idf->GetThickness(), OUTLINE_TOL ) << ":";
+
+    if( NULL == op || op->empty() )
+        return key.str();
+
+    if( op->IsCircle() )
+    {
+        IDF_SEGMENT* sp = op->front();
+        key << "C" << quantize( sp->center.x, OUTLINE_TOL ) << ","
+            << quantize( sp->center.y, OUTLINE_TOL ) << ","
+            << quantize( sp->radius, OUTLINE_TOL );
+        return key.str();
+    }
+
+    vector< OUTLINE_VERTEX > verts;
+    OUTLINE_VERTEX vtx;
+
+    if( op->IsCCW() )
+    {
+        std::list<IDF_SEGMENT*>::iterator sseg = op->begin();
+        std::list<IDF_SEGMENT*>::iterator eseg = op->end();
+
+        while( sseg != eseg )
+        {
+            vtx.x = quantize( (*sseg)->startPoint.x, OUTLINE_TOL );
+            vtx.y = quantize( (*sseg)->startPoint.y, OUTLINE_TOL );
+            vtx.a = quantize( (*sseg)->angle, OUTLINE_ANG_TOL );
+            verts.push_back( vtx );
+            ++sseg;
+        }
+    }
+    else
+    {
+        // traverse the segments in reverse; each arc is then swept
+        // in the opposite direction
+        std::list<IDF_SEGMENT*>::iterator sseg = op->end();
+        std::list<IDF_SEGMENT*>::iterator eseg = op->begin();
+
+        while( sseg != eseg )
+        {
+            --sseg;
+            vtx.x = quantize( (*sseg)->endPoint.x, OUTLINE_TOL );
+            vtx.y = quantize( (*sseg)->endPoint.y, OUTLINE_TOL );
+            vtx.a = quantize( -(*sseg)->angle, OUTLINE_ANG_TOL );
+            verts.push_back( vtx );
+        }
+    }
+
+    // find the rotation of the vertex list which sorts first
+    size_t nv = verts.size();
+    size_t start = 0;
+
+    for( size_t i = 1; i < nv; ++i )
+    {
+        for( size_t j = 0; j < nv; ++j )
+        {
+            const OUTLINE_VERTEX& vi = verts[( i + j ) % nv];
+            const OUTLINE_VERTEX& vs = verts[( start + j ) % nv];
+
+            if( vi == vs )
+                continue;
+
+            if( vi < vs )
+                start = i;
+
+            break;
+        }
+    }
+
+    for( size_t i = 0; i < nv; ++i )
+    {
+        const OUTLINE_VERTEX& vi = verts[( start + i ) % nv];
+        key << vi.x << "," << vi.y << "," << vi.a << ";";
+    }
+
+    return key.str();
+}
+
+
 int GetComponentColor( void )
 {
-    static int cidx = 1;    // index starts at 1 since 0 is the PCB color
-    int tc = cidx;
+    int tc = globs.colorIndex;
 
-    if( ++cidx == NCOLORS )
-        cidx = 1;
+    if( ++globs.colorIndex == NCOLORS )
+        globs.colorIndex = 1;
 
     return tc;
 }
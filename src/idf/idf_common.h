@@ -291,7 +291,7 @@ private:
      * @return bool: true if the item was successfully written, false otherwise. In case of
      * unrecoverable errors an exception is thrown
      */
-    bool writeNote( std::ofstream& aBoardFile, IDF3::IDF_UNIT aBoardUnit );
+    bool writeNote( std::ostream& aBoardFile, IDF3::IDF_UNIT aBoardUnit );
 
 public:
     IDF_NOTE();
@@ -376,7 +376,7 @@ private:
      * @param aBoardFile is an open BOARD file
      * @param aBoardUnit is the native unit of the output file
      */
-    void write( std::ofstream& aBoardFile, IDF3::IDF_UNIT aBoardUnit );
+    void write( std::ostream& aBoardFile, IDF3::IDF_UNIT aBoardUnit );
 
 public:
     /**
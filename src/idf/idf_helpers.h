@@ -119,7 +119,7 @@ bool ParseIDFLayer( const std::string& aToken, IDF3::IDF_LAYER& aLayer );
  *
  * @return bool: true if the data was successfully written, otherwise false
  */
-bool WriteLayersText( std::ofstream& aBoardFile, IDF3::IDF_LAYER aLayer );
+bool WriteLayersText( std::ostream& aBoardFile, IDF3::IDF_LAYER aLayer );
 
 
 /**
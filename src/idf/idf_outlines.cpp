@@ -654,7 +654,7 @@ void BOARD_OUTLINE::readOutlines( std::ifstream& aBoardFile, IDF3::IDF_VERSION a
     return;
 }
 
-bool BOARD_OUTLINE::writeComments( std::ofstream& aBoardFile )
+bool BOARD_OUTLINE::writeComments( std::ostream& aBoardFile )
 {
     if( comments.empty() )
         return true;
@@ -671,7 +671,7 @@ bool BOARD_OUTLINE::writeComments( std::ofstream& aBoardFile )
     return !aBoardFile.fail();
 }
 
-bool BOARD_OUTLINE::writeOwner( std::ofstream& aBoardFile )
+bool BOARD_OUTLINE::writeOwner( std::ostream& aBoardFile )
 {
     switch( owner )
     {
@@ -691,7 +691,7 @@ bool BOARD_OUTLINE::writeOwner( std::ofstream& aBoardFile )
     return !aBoardFile.fail();
 }
 
-void BOARD_OUTLINE::writeOutline( std::ofstream& aBoardFile, IDF_OUTLINE* aOutline, size_t aIndex )
+void BOARD_OUTLINE::writeOutline( std::ostream& aBoardFile, IDF_OUTLINE* aOutline, size_t aIndex )
 {
     std::list<IDF_SEGMENT*>::iterator bo;
     std::list<IDF_SEGMENT*>::iterator eo;
@@ -955,7 +955,7 @@ void BOARD_OUTLINE::writeOutline( std::ofstream& aBoardFile, IDF_OUTLINE* aOutli
     return;
 }
 
-void BOARD_OUTLINE::writeOutlines( std::ofstream& aBoardFile )
+void BOARD_OUTLINE::writeOutlines( std::ostream& aBoardFile )
 {
     if( outlines.empty() )
         return;
@@ -1223,7 +1223,7 @@ void BOARD_OUTLINE::readData( std::ifstream& aBoardFile, const std::string& aHea
 }
 
 
-void BOARD_OUTLINE::writeData( std::ofstream& aBoardFile )
+void BOARD_OUTLINE::writeData( std::ostream& aBoardFile )
 {
     writeComments( aBoardFile );
 
@@ -1869,7 +1869,7 @@ void OTHER_OUTLINE::readData( std::ifstream& aBoardFile, const std::string& aHea
     return;
 }
 
-void OTHER_OUTLINE::writeData( std::ofstream& aBoardFile )
+void OTHER_OUTLINE::writeData( std::ostream& aBoardFile )
 {
     // this section is optional; do not write if not required
     if( outlines.empty() )
@@ -2183,7 +2183,7 @@ void ROUTE_OUTLINE::readData( std::ifstream& aBoardFile, const std::string& aHea
 }
 
 
-void ROUTE_OUTLINE::writeData( std::ofstream& aBoardFile )
+void ROUTE_OUTLINE::writeData( std::ostream& aBoardFile )
 {
     // this section is optional; do not write if not required
     if( outlines.empty() )
@@ -2558,7 +2558,7 @@ void PLACE_OUTLINE::readData( std::ifstream& aBoardFile, const std::string& aHea
     return;
 }
 
-void PLACE_OUTLINE::writeData( std::ofstream& aBoardFile )
+void PLACE_OUTLINE::writeData( std::ostream& aBoardFile )
 {
     // this section is optional; do not write if not required
     if( outlines.empty() )
@@ -2901,7 +2901,7 @@ void GROUP_OUTLINE::readData( std::ifstream& aBoardFile, const std::string& aHea
 }
 
 
-void GROUP_OUTLINE::writeData( std::ofstream& aBoardFile )
+void GROUP_OUTLINE::writeData( std::ostream& aBoardFile )
 {
     // this section is optional; do not write if not required
     if( outlines.empty() )
@@ -3094,7 +3094,7 @@ void IDF3_COMP_OUTLINE::readProperties( std::ifstream& aLibFile )
 }
 
 
-bool IDF3_COMP_OUTLINE::writeProperties( std::ofstream& aLibFile )
+bool IDF3_COMP_OUTLINE::writeProperties( std::ostream& aLibFile )
 {
     if( props.empty() )
         return true;
@@ -3377,7 +3377,7 @@ void IDF3_COMP_OUTLINE::readData( std::ifstream& aLibFile, const std::string& aH
 }
 
 
-void IDF3_COMP_OUTLINE::writeData( std::ofstream& aLibFile )
+void IDF3_COMP_OUTLINE::writeData( std::ostream& aLibFile )
 {
     if( refNum == 0 )
         return;    // nothing to do
@@ -104,13 +104,13 @@ protected:
     // Read outline data from a BOARD or LIBRARY file's outline section
     void readOutlines( std::ifstream& aBoardFile, IDF3::IDF_VERSION aIdfVersion );
     // Write comments to a BOARD or LIBRARY file (must not be within a SECTION as per IDFv3 spec)
-    bool writeComments( std::ofstream& aBoardFile );
+    bool writeComments( std::ostream& aBoardFile );
     // Write the outline owner to a BOARD file
-    bool writeOwner( std::ofstream& aBoardFile );
+    bool writeOwner( std::ostream& aBoardFile );
     // Write the data of a single outline object
-    void writeOutline( std::ofstream& aBoardFile, IDF_OUTLINE* aOutline, size_t aIndex );
+    void writeOutline( std::ostream& aBoardFile, IDF_OUTLINE* aOutline, size_t aIndex );
     // Iterate through the outlines and write out all data
-    void writeOutlines( std::ofstream& aBoardFile );  // write outline data (no headers)
+    void writeOutlines( std::ostream& aBoardFile );  // write outline data (no headers)
     // Clear internal list of outlines
     void clearOutlines( void );
     /**
@@ -143,7 +143,7 @@ protected:
      *
      * @param aBoardFile is an IDFv3 file opened for writing
      */
-    virtual void writeData( std::ofstream& aBoardFile );
+    virtual void writeData( std::ostream& aBoardFile );
 
 public:
     BOARD_OUTLINE();
@@ -372,7 +372,7 @@ private:
      *
      * @return bool: true if the data was successfully written, otherwise false.
      */
-    virtual void writeData( std::ofstream& aBoardFile );
+    virtual void writeData( std::ostream& aBoardFile );
 
 public:
     OTHER_OUTLINE( IDF3_BOARD* aParent );
@@ -436,7 +436,7 @@ private:
      * Function writeData
      * writes the ROUTE_OUTLINE data to an open IDFv3 file
      */
-    virtual void writeData( std::ofstream& aBoardFile );
+    virtual void writeData( std::ostream& aBoardFile );
 
 protected:
     IDF3::IDF_LAYER layers; // Routing layers (IDF spec)
@@ -492,7 +492,7 @@ private:
      *
      * @return bool: true if the data was successfully written, otherwise false
      */
-    virtual void writeData( std::ofstream& aBoardFile );
+    virtual void writeData( std::ostream& aBoardFile );
 
 protected:
     IDF3::IDF_LAYER side;   // Board Side [TOP/BOTTOM/BOTH ONLY] (IDF spec)
@@ -601,7 +601,7 @@ private:
      *
      * @return bool: true if the data is successfully written, otherwise false
      */
-    virtual void writeData( std::ofstream& aBoardFile );
+    virtual void writeData( std::ostream& aBoardFile );
 
 public:
     GROUP_OUTLINE( IDF3_BOARD* aParent );
@@ -660,7 +660,7 @@ private:
     std::map< std::string, std::string >    props;      // properties list
 
     void readProperties( std::ifstream& aLibFile );
-    bool writeProperties( std::ofstream& aLibFile );
+    bool writeProperties( std::ostream& aLibFile );
 
     /**
      * Function readData
@@ -681,7 +681,7 @@ private:
      *
      * @return bool: true if the data was successfully written, otherwise false
      */
-    virtual void writeData( std::ofstream& aLibFile );
+    virtual void writeData( std::ostream& aLibFile );
 
     /**
      * Function incrementRef
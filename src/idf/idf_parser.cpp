@@ -34,6 +34,7 @@
 #include <idf_parser.h>
 #include <idf_helpers.h>
 #include <geom/mcad_utils.h>
+#include <geom/mcad_ofstream.h>
 
 using namespace std;
 using namespace IDF3;
@@ -736,7 +737,7 @@ bool IDF3_COMP_OUTLINE_DATA::readPlaceData( std::ifstream &aBoardFile,
 }   // IDF3_COMP_OUTLINE_DATA::readPlaceData
 
 
-void IDF3_COMP_OUTLINE_DATA::writePlaceData( std::ofstream& aBoardFile,
+void IDF3_COMP_OUTLINE_DATA::writePlaceData( std::ostream& aBoardFile,
                                              double aXpos, double aYpos, double aAngle,
                                              const std::string aRefDes,
                                              IDF3::IDF_PLACEMENT aPlacement,
@@ -1314,7 +1315,7 @@ bool IDF3_COMPONENT::SetPlacement( IDF3::IDF_PLACEMENT aPlacementValue )
     return true;
 }
 
-bool IDF3_COMPONENT::writeDrillData( std::ofstream& aBoardFile )
+bool IDF3_COMPONENT::writeDrillData( std::ostream& aBoardFile )
 {
     if( drills.empty() )
         return true;
@@ -1332,7 +1333,7 @@ bool IDF3_COMPONENT::writeDrillData( std::ofstream& aBoardFile )
 }
 
 
-bool IDF3_COMPONENT::writePlaceData( std::ofstream& aBoardFile )
+bool IDF3_COMPONENT::writePlaceData( std::ostream& aBoardFile )
 {
     if( components.empty() )
         return true;
@@ -2794,12 +2795,12 @@ bool IDF3_BOARD::ReadFile( const std::string& aFullFileName, bool aNoSubstituteO
 // write the library file data
 bool IDF3_BOARD::writeLibFile( const std::string& aFileName )
 {
-    std::ofstream lib;
-    lib.exceptions( std::ofstream::failbit );
+    MCAD_OFSTREAM lib;
+    lib.exceptions( std::ios_base::failbit | std::ios_base::badbit );
 
     try
     {
-        lib.open( aFileName.c_str(), std::ios_base::out );
+        lib.Open( aFileName.c_str() );
 
         if( idfSource.empty() )
             idfSource = "KiCad-IDF Framework";
@@ -2823,14 +2824,20 @@ bool IDF3_BOARD::writeLibFile( const std::string& aFileName )
     catch( const std::exception& )
     {
         lib.exceptions( std::ios_base::goodbit );
-
-        if( lib.is_open() )
-            lib.close();
+        lib.Abort();
 
         throw;
     }
 
-    lib.close();
+    // a failure to flush or replace the file is only reported by Close()
+    lib.exceptions( std::ios_base::goodbit );
+
+    if( !lib.Close() )
+    {
+        ostringstream ostr;
+        ostr << "\n* could not write library file '" << aFileName << "'";
+        throw( IDF_ERROR( __FILE__, __FUNCTION__, __LINE__, ostr.str() ) );
+    }
 
     return true;
 }
@@ -2838,12 +2845,12 @@ bool IDF3_BOARD::writeLibFile( const std::string& aFileName )
 // write the board file data
 void IDF3_BOARD::writeBoardFile( const std::string& aFileName )
 {
-    std::ofstream brd;
-    brd.exceptions( std::ofstream::failbit );
+    MCAD_OFSTREAM brd;
+    brd.exceptions( std::ios_base::failbit | std::ios_base::badbit );
 
     try
     {
-        brd.open( aFileName.c_str(), std::ios_base::out );
+        brd.Open( aFileName.c_str() );
 
         if( idfSource.empty() )
             idfSource = "KiCad-IDF Framework";
@@ -3083,14 +3090,20 @@ void IDF3_BOARD::writeBoardFile( const std::string& aFileName )
     catch( const std::exception& )
     {
         brd.exceptions( std::ios_base::goodbit );
-
-        if( brd.is_open() )
-            brd.close();
+        brd.Abort();
 
         throw;
     }
 
-    brd.close();
+    // a failure to flush or replace the file is only reported by Close()
+    brd.exceptions( std::ios_base::goodbit );
+
+    if( !brd.Close() )
+    {
+        ostringstream ostr;
+        ostr << "\n* could not write board file '" << aFileName << "'";
+        throw( IDF_ERROR( __FILE__, __FUNCTION__, __LINE__, ostr.str() ) );
+    }
 
     return;
 }
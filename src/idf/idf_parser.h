@@ -109,7 +109,7 @@ private:
      *
      * @return bool: true if data was successfully written, otherwise false
      */
-    void writePlaceData( std::ofstream& aBoardFile, double aXpos, double aYpos, double aAngle,
+    void writePlaceData( std::ostream& aBoardFile, double aXpos, double aYpos, double aAngle,
                          const std::string aRefDes, IDF3::IDF_PLACEMENT aPlacement,
                          IDF3::IDF_LAYER aSide );
 
@@ -233,7 +233,7 @@ private:
      *
      * @return bool: true if the operation succeeded, otherwise false
      */
-    bool writeDrillData( std::ofstream& aBoardFile );
+    bool writeDrillData( std::ostream& aBoardFile );
 
     /**
      * Function WritePlaceData
@@ -243,7 +243,7 @@ private:
      *
      * @return bool: true if the operation succeeded, otherwise false
      */
-    bool writePlaceData( std::ofstream& aBoardFile );
+    bool writePlaceData( std::ostream& aBoardFile );
 
 #ifndef DISABLE_IDF_OWNERSHIP
     bool checkOwnership( int aSourceLine, const char* aSourceFunc );
@@ -26,14 +26,14 @@
  */
 
 // NOTE: Wishlist:
-// 1. To really ensure uniquely named parts and assemblies, all names
-// parsed from files must be checked against a partsName and assyName
-// register; if the desired name already exists then a '-n' must be
-// applied to the name where n = 1.. and is unique to each part name.
-// Note that the newly suffixed names shall not be added to the name
-// list but if the file is written and loaded again then the suffixed
-// names shall be valid base names and it is possible that we wind up
-// with names which have multiple suffixes.
+// 1. The names given to parts and assemblies by Export() are checked
+// against the model's name index (IGES_NAME_INDEX) and a '-n' suffix
+// is applied if the name already exists; however the names of nested
+// Subfigure Definitions parsed from files are transferred unchecked.
+// To really ensure uniquely named parts and assemblies those names must
+// be suffixed as well. Note that if the file is written and loaded again
+// then the suffixed names shall be valid base names and it is possible
+// that we wind up with names which have multiple suffixes.
 //
 
 #include <libigesconf.h>
@@ -45,12 +45,22 @@
 #include <iomanip>
 #include <ctime>
 #include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 #include <error_macros.h>
 #include <core/iges.h>
 #include <core/iges_io.h>
+#include <core/iges_detable.h>
+#include <core/iges_names.h>
+#include <core/iges_memory.h>
+#include <core/iges_parallel.h>
 #include <core/all_entities.h>
 #include <core/iges.h>
 #include <geom/mcad_utils.h>
+#include <geom/mcad_ofstream.h>
 
 
 using namespace std;
@@ -68,9 +78,10 @@ struct tm *gmtime_r(time_t const *timep, struct tm *tmp)
 // Note: a default of 11 = IGES5.3
 #define DEFAULT_IGES_VERSION (11)
 
+// Start section line which marks a file written in dependency order
+#define DEP_ORDER_MARK "# libIGES: entities follow the entities they refer to"
+
 
-int IGES::idxPartNum = 1;
-int IGES::idxAssyNum = 1;
 
 
 static std::string UNIT_NAMES[UNIT_END] =
@@ -235,14 +246,24 @@ static bool checkDate( const std::string aDate )
 
 
 // This class magically manages switching between the C locale and
-// the user's locale
+// the user's locale; the numerics locale is shared by all threads so
+// it is only switched by the first of any concurrent users and only
+// restored by the last.
 class IGES_LOCALE
 {
 private:
-    char locale[80];
+    static std::mutex lmutex;
+    static int nUsers;
+    static char locale[80];
+
 public:
     IGES_LOCALE()
     {
+        std::lock_guard< std::mutex > lock( lmutex );
+
+        if( nUsers++ > 0 )
+            return;
+
         const char *cp = setlocale( LC_NUMERIC, NULL );
         if (NULL != cp)
         {
@@ -258,13 +279,27 @@ public:
 
     ~IGES_LOCALE()
     {
+        std::lock_guard< std::mutex > lock( lmutex );
+
+        if( --nUsers > 0 )
+            return;
+
         setlocale( LC_NUMERIC, locale );  // revert to the current numerics default locale
     }
 };
 
+std::mutex IGES_LOCALE::lmutex;
+int IGES_LOCALE::nUsers = 0;
+char IGES_LOCALE::locale[80];
+
 
 IGES::IGES()
 {
+    nThreads = 0;
+    orderedWrite = false;
+    pipelinedRead = false;
+    deTable = NULL;
+    nameIndex = new IGES_NAME_INDEX( &entities );
     init();
     return;
 }   // IGES()
@@ -272,17 +307,24 @@ IGES::IGES()
 
 IGES::~IGES()
 {
-    list< bool* >::iterator sVF = m_validFlags.begin();
-    list< bool* >::iterator eVF = m_validFlags.end();
-
-    while( sVF != eVF )
+    do
     {
-        **sVF = false;
-        ++sVF;
-    }
+        IGES_CACHE_LOCK lock;
+        list< bool* >::iterator sVF = m_validFlags.begin();
+        list< bool* >::iterator eVF = m_validFlags.end();
+
+        while( sVF != eVF )
+        {
+            **sVF = false;
+            ++sVF;
+        }
+
+        m_validFlags.clear();
+    } while( 0 );
 
-    m_validFlags.clear();
     Clear();
+    FreeDETable();
+    delete nameIndex;
     return;
 }
 
@@ -292,6 +334,8 @@ void IGES::AttachValidFlag( bool* aFlag )
     if( NULL == aFlag )
         return;
 
+    IGES_CACHE_LOCK lock;
+
     list< bool* >::iterator sVF = m_validFlags.begin();
     list< bool* >::iterator eVF = m_validFlags.end();
 
@@ -318,6 +362,8 @@ void IGES::DetachValidFlag( bool* aFlag )
     if( NULL == aFlag )
         return;
 
+    IGES_CACHE_LOCK lock;
+
     list< bool* >::iterator sVF = m_validFlags.begin();
     list< bool* >::iterator eVF = m_validFlags.end();
 
@@ -392,6 +438,7 @@ bool IGES::init(void)
     globalData.convert = false;
 
     startSection.clear();
+    filePath.clear();
     nGlobSecLines = 0;
     nDESecLines = 0;
     nPDSecLines = 0;
@@ -403,6 +450,11 @@ bool IGES::init(void)
 // delete all entities and reinitialize global data
 bool IGES::Clear( void )
 {
+    if( deTable )
+        deTable->Invalidate();
+
+    nameIndex->Invalidate();
+
     if( !entities.empty() )
     {
         size_t maxe = entities.size();
@@ -418,6 +470,173 @@ bool IGES::Clear( void )
 }
 
 
+// Associates the entities strictly in the order of the entity list, as
+// IGES::Read() does after reading the whole file, while the Parameter Data
+// of the later entities is still being read. An entity is associated only
+// once every entity it can reach through its references (and hence every
+// entity its associate() may touch) has been read; on a forward reference
+// the worker waits for the reader to catch up.
+class IGES::ASSOCIATE_JOB
+{
+private:
+    std::vector<IGES_ENTITY*>* m_entities;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    size_t m_nRead;         // number of entities read; guarded by m_mutex
+    bool m_finished;        // the reader has stopped; guarded by m_mutex
+    bool m_ok;              // result of the association
+
+    // 0 = not known, 1 = all reachable entities have been read,
+    // 2 = visited by the current search
+    std::vector<char> m_state;
+    std::vector<size_t> m_stack;
+    std::vector<size_t> m_visited;
+    std::vector<int> m_refs;
+
+    // returns true if all entities reachable from aIndex are among the
+    // first aNRead entities, otherwise aMissing is set to the largest
+    // index which must still be read
+    bool isReady( size_t aIndex, size_t aNRead, size_t& aMissing )
+    {
+        if( 1 == m_state[aIndex] )
+            return true;
+
+        size_t nEnt = m_entities->size();
+        bool ready = true;
+
+        m_stack.clear();
+        m_visited.clear();
+        m_stack.push_back( aIndex );
+        m_visited.push_back( aIndex );
+        m_state[aIndex] = 2;
+        aMissing = 0;
+
+        while( !m_stack.empty() )
+        {
+            size_t idx = m_stack.back();
+            m_stack.pop_back();
+
+            if( idx >= aNRead )
+            {
+                ready = false;
+
+                if( idx > aMissing )
+                    aMissing = idx;
+
+                continue;
+            }
+
+            m_refs.clear();
+            (*m_entities)[idx]->getRefIndices( m_refs );
+
+            for( size_t i = 0; i < m_refs.size(); ++i )
+            {
+                // invalid indices are reported by associate()
+                if( m_refs[i] < 0 || (size_t)m_refs[i] >= nEnt || 0 != m_state[m_refs[i]] )
+                    continue;
+
+                m_state[m_refs[i]] = 2;
+                m_visited.push_back( m_refs[i] );
+                m_stack.push_back( m_refs[i] );
+            }
+        }
+
+        char state = ready ? 1 : 0;
+
+        for( size_t i = 0; i < m_visited.size(); ++i )
+            m_state[m_visited[i]] = state;
+
+        return ready;
+    }
+
+    // waits until at least aNRead entities have been read and returns
+    // the current count, or 0 if the reader stopped short of that count
+    size_t waitRead( size_t aNRead )
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+
+        while( m_nRead < aNRead && !m_finished )
+            m_cv.wait( lock );
+
+        if( m_nRead < aNRead )
+            return 0;
+
+        return m_nRead;
+    }
+
+public:
+    ASSOCIATE_JOB( std::vector<IGES_ENTITY*>* aEntities )
+    {
+        m_entities = aEntities;
+        m_nRead = 0;
+        m_finished = false;
+        m_ok = false;
+    }
+
+    // invoked by the reader after reading the first aNRead entities
+    void SetRead( size_t aNRead )
+    {
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            m_nRead = aNRead;
+        }
+
+        m_cv.notify_one();
+    }
+
+    // invoked by the reader when it stops for any reason
+    void Finish( void )
+    {
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            m_finished = true;
+        }
+
+        m_cv.notify_one();
+    }
+
+    bool IsOK( void ) const
+    {
+        return m_ok;
+    }
+
+    void Run( void )
+    {
+        size_t nEnt = m_entities->size();
+        size_t nRead = 0;
+        size_t missing;
+        m_state.assign( nEnt, 0 );
+
+        for( size_t i = 0; i < nEnt; ++i )
+        {
+            while( !isReady( i, nRead, missing ) )
+            {
+                // a failed search is repeated only after at least as many
+                // entities as it visited have been read; this bounds the
+                // total cost of the searches for files with many forward
+                // references
+                size_t target = std::max( missing + 1, nRead + m_visited.size() );
+
+                if( target > nEnt )
+                    target = nEnt;
+
+                nRead = waitRead( target );
+
+                // the reader failed; the file is discarded
+                if( 0 == nRead )
+                    return;
+            }
+
+            if( !(*m_entities)[i]->associate( m_entities ) )
+                return;
+        }
+
+        m_ok = true;
+        return;
+    }
+};
+
+
 // open and read the file with the given name
 bool IGES::Read( const char* aFileName )
 {
@@ -436,6 +655,9 @@ bool IGES::Read( const char* aFileName )
         return false;
     }
 
+    // names are assigned directly as the Parameter Data is read
+    nameIndex->Invalidate();
+
     ifstream file;
 
     file.open( aFileName, ios::in | ios::binary );
@@ -478,20 +700,27 @@ bool IGES::Read( const char* aFileName )
     }
 
     bool fOK = true;
+    bool ordered = false;   // the file is marked as dependency ordered
+    int nStart = 0;
 
     while( rec.section_type == 'S' && fOK )
     {
-        if( rec.index != (int)(startSection.size() + 1) )
+        if( rec.index != ++nStart )
         {
             ERRMSG << "\n + [CORRUPT FILE] sequence number (" << rec.index;
-            cerr << ") does not match expected (" << (startSection.size() + 1) << ")\n";
+            cerr << ") does not match expected (" << nStart << ")\n";
             cerr << " + filename: '" << aFileName << "'\n";
             file.close();
             Clear();
             return false;
         }
 
-        startSection.push_back( rec.data );
+        // the mark is not retained since it only describes this file
+        if( 0 == rec.data.compare( 0, rec.data.find_last_not_of( ' ' ) + 1, DEP_ORDER_MARK ) )
+            ordered = true;
+        else
+            startSection.push_back( rec.data );
+
         fOK = ReadIGESRecord( &rec, file );
     }
 
@@ -581,7 +810,37 @@ bool IGES::Read( const char* aFileName )
         return false;
     }
 
-    if( ! readPD( rec, file ) )
+    // the entities of a dependency ordered file are associated as their
+    // Parameter Data is read; otherwise, if a pipelined read was requested
+    // and more than one thread is available, the entities are associated
+    // by a worker while the remaining Parameter Data is being read
+    ASSOCIATE_JOB ajob( &entities );
+    std::thread aworker;
+    bool pipelined = false;
+    size_t nAssociated = 0;
+
+    if( pipelinedRead && !ordered && entities.size() > 1 && GetNWorkerThreads( nThreads ) > 1 )
+    {
+        try
+        {
+            aworker = std::thread( &ASSOCIATE_JOB::Run, &ajob );
+            pipelined = true;
+        }
+        catch( ... )
+        {
+            pipelined = false;
+        }
+    }
+
+    bool pdOK = readPD( rec, file, pipelined ? &ajob : NULL, ordered ? &nAssociated : NULL );
+
+    if( pipelined )
+    {
+        ajob.Finish();
+        aworker.join();
+    }
+
+    if( !pdOK )
     {
         ERRMSG << "\n + [INFO] problems reading file PARAMETER section\n";
         cerr << " + filename: '" << aFileName << "'\n";
@@ -591,7 +850,7 @@ bool IGES::Read( const char* aFileName )
     }
 
     // read the T section
-    if( ! readTS( rec, file ) )
+    if( ! readTS( rec, file, nStart ) )
     {
         ERRMSG << "\n + [CORRUPT FILE] could not read Terminate Section\n";
         cerr << " + filename: '" << aFileName << "'\n";
@@ -601,31 +860,40 @@ bool IGES::Read( const char* aFileName )
     }
 
     // Associate entities
-    size_t nEnt = entities.size();
-    size_t iEnt;
-
-    for( iEnt = 0; iEnt < nEnt; ++iEnt )
+    if( pipelined )
     {
-        if( !entities[iEnt]->associate(&entities) )
+        if( !ajob.IsOK() )
         {
             ERRMSG << "\n + [INFO] could not establish file associations\n";
             return false;
         }
     }
-
-    if( globalData.convert )
+    else
     {
-        for( iEnt = 0; iEnt < nEnt; ++iEnt )
-            entities[iEnt]->rescale( globalData.cf );
+        size_t nEnt = entities.size();
+        size_t iEnt;
+
+        for( iEnt = nAssociated; iEnt < nEnt; ++iEnt )
+        {
+            if( !entities[iEnt]->associate(&entities) )
+            {
+                ERRMSG << "\n + [INFO] could not establish file associations\n";
+                return false;
+            }
+        }
     }
 
+    if( globalData.convert )
+        rescale( globalData.cf );
+
     Cull();
+    filePath = aFileName;
     return true;
 }
 
 
 // open a file with the given name and write out all data
-bool IGES::Write( const char* aFileName, bool fOverwrite )
+bool IGES::Write( const char* aFileName, bool fOverwrite, bool fSync )
 {
     IGES_LOCALE igloc;
 
@@ -643,56 +911,168 @@ bool IGES::Write( const char* aFileName, bool fOverwrite )
         return false;
     }
 
-    // Assign Sequence numbers
+    bool tooLarge = false;
+
+    if( !writeFile( aFileName, fOverwrite, fSync, 9999999, tooLarge ) )
+    {
+        if( tooLarge )
+            ERRMSG << "\n + [INFO] the model does not fit within a single file; see WriteLinked()\n";
+
+        return false;
+    }
+
+    return true;
+}
+
+
+bool IGES::orderEntities( std::vector<IGES_ENTITY*>& aList )
+{
     size_t nEnt = entities.size();
-    size_t iEnt;
-    int index = 1;
+    std::map<IGES_ENTITY*, size_t> index;
 
-    for( iEnt = 0; iEnt < nEnt; ++iEnt )
-        entities[iEnt]->sequenceNumber = (int)(iEnt << 1) + 1;
+    for( size_t i = 0; i < nEnt; ++i )
+        index[entities[i]] = i;
 
-    nDESecLines = (int)(nEnt << 1);
+    // the children of each entity are the entities which list it as a parent
+    std::vector< std::vector<size_t> > children( nEnt );
 
-    // Format PD entries for output and update some DE items
-    for( iEnt = 0; iEnt < nEnt; ++iEnt )
+    for( size_t i = 0; i < nEnt; ++i )
     {
-        if( !entities[iEnt]->format( index ) )
+        std::list<IGES_ENTITY*>::iterator sR = entities[i]->refs.begin();
+        std::list<IGES_ENTITY*>::iterator eR = entities[i]->refs.end();
+
+        while( sR != eR )
         {
-            ERRMSG << "\n + [INFO] could not format entity for output\n";
+            std::map<IGES_ENTITY*, size_t>::iterator sI = index.find( *sR );
 
-            for( nEnt = 0; nEnt < iEnt; ++nEnt )
-                entities[iEnt]->unformat();
+            if( sI != index.end() )
+                children[sI->second].push_back( i );
 
-            return false;
+            ++sR;
         }
     }
 
-    nPDSecLines = index - 1;
-
-    ofstream file;
+    // depth first search in the order of the entity list; each entity is
+    // listed after all of its children. 0 = not visited, 1 = on the stack,
+    // 2 = listed
+    std::vector<char> state( nEnt, 0 );
+    std::vector< std::pair<size_t, size_t> > stack;
 
-    file.open( aFileName, ios::out | ios_base::in | ios::binary );
+    aList.clear();
+    aList.reserve( nEnt );
 
-    if( file.is_open() )
+    for( size_t i = 0; i < nEnt; ++i )
     {
-        if( !fOverwrite )
+        if( 0 != state[i] )
+            continue;
+
+        state[i] = 1;
+        stack.push_back( std::make_pair( i, (size_t)0 ) );
+
+        while( !stack.empty() )
         {
-            ERRMSG << "\n + [INFO] file already exists; not overwriting\n";
-            cerr << " + filename: '" << aFileName << "'\n";
-            file.close();
-            return false;
+            size_t idx = stack.back().first;
+            size_t& next = stack.back().second;
+
+            if( next < children[idx].size() )
+            {
+                size_t kid = children[idx][next++];
+
+                if( 1 == state[kid] )
+                {
+                    ERRMSG << "\n + [INFO] entity references form a cycle; ";
+                    cerr << "the file will not be dependency ordered\n";
+                    aList.clear();
+                    return false;
+                }
+
+                if( 0 == state[kid] )
+                {
+                    state[kid] = 1;
+                    stack.push_back( std::make_pair( kid, (size_t)0 ) );
+                }
+
+                continue;
+            }
+
+            state[idx] = 2;
+            aList.push_back( entities[idx] );
+            stack.pop_back();
         }
+    }
 
-        // reopen the file and truncate it
-        file.close();
-        file.open( aFileName, ios::out | ios_base::in | ios::binary | ios::trunc );
+    return true;
+}
+
+
+bool IGES::writeFile( const char* aFileName, bool fOverwrite, bool fSync,
+                      int aMaxLines, bool& aTooLarge )
+{
+    // the entities are written in dependency order by temporarily
+    // replacing the entity list with the ordered list
+    std::vector<IGES_ENTITY*> ordered;
+
+    if( !orderedWrite || !orderEntities( ordered ) )
+        return writeSections( aFileName, fOverwrite, fSync, aMaxLines, aTooLarge, false );
+
+    entities.swap( ordered );
+    bool ok = writeSections( aFileName, fOverwrite, fSync, aMaxLines, aTooLarge, true );
+    entities.swap( ordered );
+
+    return ok;
+}
+
+
+bool IGES::writeSections( const char* aFileName, bool fOverwrite, bool fSync,
+                          int aMaxLines, bool& aTooLarge, bool aOrdered )
+{
+    aTooLarge = false;
+
+    // Assign Sequence numbers
+    size_t nEnt = entities.size();
+    size_t iEnt;
+
+    if( nEnt > (size_t)( aMaxLines / 2 ) )
+    {
+        aTooLarge = true;
+        return false;
     }
-    else
+
+    for( iEnt = 0; iEnt < nEnt; ++iEnt )
+        entities[iEnt]->sequenceNumber = (int)(iEnt << 1) + 1;
+
+    nDESecLines = (int)(nEnt << 1);
+
+    // Format PD entries for output and update some DE items
+    if( !formatPD( aTooLarge ) )
+        return false;
+
+    if( nPDSecLines > aMaxLines )
     {
-        file.open( aFileName, ios::out | ios::binary );
+        for( iEnt = 0; iEnt < nEnt; ++iEnt )
+            entities[iEnt]->unformat();
+
+        aTooLarge = true;
+        return false;
     }
 
-    if( !file.is_open() )
+    MCAD_FILEPATH fp( aFileName );
+
+    if( !fOverwrite && fp.Exists() )
+    {
+        for( iEnt = 0; iEnt < nEnt; ++iEnt )
+            entities[iEnt]->unformat();
+
+        ERRMSG << "\n + [INFO] file already exists; not overwriting\n";
+        cerr << " + filename: '" << aFileName << "'\n";
+        return false;
+    }
+
+    // data is written to a temporary file which replaces any
+    // existing file only if all data was written successfully
+    MCAD_OFSTREAM file;
+
+    if( !file.Open( aFileName, fSync ) )
     {
         for( iEnt = 0; iEnt < nEnt; ++iEnt )
             entities[iEnt]->unformat();
@@ -716,10 +1096,10 @@ bool IGES::Write( const char* aFileName, bool fOverwrite )
     } while(0);
 
     // START SECTION
-    if( !writeStart( file ) )
+    if( !writeStart( file, aOrdered ) )
     {
         ERRMSG << "\n + [INFO] could not write START section\n";
-        file.close();
+        file.Abort();
         return false;
     }
 
@@ -727,7 +1107,7 @@ bool IGES::Write( const char* aFileName, bool fOverwrite )
     if( !writeGlobals( file ) )
     {
         ERRMSG << "\n + [INFO] could not write GLOBAL section\n";
-        file.close();
+        file.Abort();
         return false;
     }
 
@@ -737,30 +1117,32 @@ bool IGES::Write( const char* aFileName, bool fOverwrite )
         if( !entities[iEnt]->writeDE(file) )
         {
             ERRMSG << "\n + [INFO] could not write out Directory Entries\n";
-            file.close();
+            file.Abort();
             return false;
         }
     }
 
-    // PARAMETER DATA SECTION
+    // PARAMETER DATA SECTION; the formatted data is released as it is written
     for( iEnt = 0; iEnt < nEnt; ++iEnt )
     {
         if( !entities[iEnt]->writePD(file) )
         {
             ERRMSG << "\n + [INFO] could not write out Parameter Data\n";
-            file.close();
+            file.Abort();
             return false;
         }
+
+        entities[iEnt]->unformat();
     }
 
     // TERMINATE SECTION
     std::string oline;
     std::string tmp;
 
-    if( !FormatDEInt( tmp, (int)startSection.size() ) )
+    if( !FormatDEInt( tmp, (int)startSection.size() + ( aOrdered ? 1 : 0 ) ) )
     {
         ERRMSG << "\n + [INFO] could not format S* entry in terminal line\n";
-        file.close();
+        file.Abort();
         return false;
     }
 
@@ -770,7 +1152,7 @@ bool IGES::Write( const char* aFileName, bool fOverwrite )
     if( !FormatDEInt( tmp, nGlobSecLines ) )
     {
         ERRMSG << "\n + [INFO] could not format G* entry in terminal line\n";
-        file.close();
+        file.Abort();
         return false;
     }
 
@@ -780,7 +1162,7 @@ bool IGES::Write( const char* aFileName, bool fOverwrite )
     if( !FormatDEInt( tmp, nDESecLines) )
     {
         ERRMSG << "\n + [INFO] could not format D* entry in terminal line\n";
-        file.close();
+        file.Abort();
         return false;
     }
 
@@ -790,7 +1172,7 @@ bool IGES::Write( const char* aFileName, bool fOverwrite )
     if( !FormatDEInt( tmp, nPDSecLines ) )
     {
         ERRMSG << "\n + [INFO] could not format P* entry in terminal line\n";
-        file.close();
+        file.Abort();
         return false;
     }
 
@@ -801,7 +1183,7 @@ bool IGES::Write( const char* aFileName, bool fOverwrite )
     if( !FormatDEInt( tmp, 1 ) )
     {
         ERRMSG << "\n + [INFO] could not format T* entry in terminal line\n";
-        file.close();
+        file.Abort();
         return false;
     }
 
@@ -812,15 +1194,305 @@ bool IGES::Write( const char* aFileName, bool fOverwrite )
 
     if( file.fail() )
     {
-        file.close();
+        file.Abort();
         return false;
     }
 
-    file.close();
+    if( !file.Close() )
+        return false;
+
+    filePath = aFileName;
     return true;
 }
 
 
+// data shared by the files written by a single WriteLinked() invocation
+struct IGES::LINK_STATE
+{
+    std::vector< std::vector<size_t> > children;    // children of each entity
+    std::vector<bool> canLink;      // the entity is a 308 which may be written separately
+    std::map<size_t, std::string> files;    // 308 written separately -> file name
+    std::string dir;                // directory of the main file
+    std::string base;               // base name of the main file
+    std::string ext;                // extension of the main file
+    int nFiles;
+    int maxLines;
+    bool overwrite;
+};
+
+
+// collects the entities reachable from aRoots in the order of the entity list;
+// if aCuts is not NULL then Subfigure Definitions which may be written
+// separately are not followed (unless they are roots) and are listed in aCuts
+static void collectLinked( const std::vector< std::vector<size_t> >& aChildren,
+                           const std::vector<bool>& aCanLink,
+                           const std::vector<size_t>& aRoots,
+                           std::vector<size_t>& aItems, std::vector<size_t>* aCuts )
+{
+    std::vector<char> seen( aChildren.size(), 0 );
+    std::vector<size_t> stack( aRoots );
+
+    aItems.clear();
+
+    for( size_t i = 0; i < aRoots.size(); ++i )
+        seen[aRoots[i]] = 1;
+
+    while( !stack.empty() )
+    {
+        size_t idx = stack.back();
+        stack.pop_back();
+        aItems.push_back( idx );
+
+        const std::vector<size_t>& kids = aChildren[idx];
+
+        for( size_t i = 0; i < kids.size(); ++i )
+        {
+            size_t kid = kids[i];
+
+            if( seen[kid] )
+                continue;
+
+            seen[kid] = 1;
+
+            if( aCuts && aCanLink[kid] )
+            {
+                aCuts->push_back( kid );
+                continue;
+            }
+
+            stack.push_back( kid );
+        }
+    }
+
+    std::sort( aItems.begin(), aItems.end() );
+
+    if( aCuts )
+        std::sort( aCuts->begin(), aCuts->end() );
+
+    return;
+}
+
+
+bool IGES::writeLinked( LINK_STATE& aState, const std::vector<size_t>& aRoots,
+                        const std::string& aFileName )
+{
+    std::vector<size_t> items;
+    std::vector<IGES_ENTITY*> subset;
+    bool tooLarge = false;
+    bool ok;
+
+    collectLinked( aState.children, aState.canLink, aRoots, items, NULL );
+
+    for( size_t i = 0; i < items.size(); ++i )
+        subset.push_back( entities[items[i]] );
+
+    entities.swap( subset );
+    ok = writeFile( aFileName.c_str(), aState.overwrite, false, aState.maxLines, tooLarge );
+    entities.swap( subset );
+
+    if( ok || !tooLarge )
+        return ok;
+
+    // move the Subfigure Definitions below the roots into files of their own
+    std::vector<size_t> cuts;
+    collectLinked( aState.children, aState.canLink, aRoots, items, &cuts );
+
+    if( cuts.empty() )
+    {
+        ERRMSG << "\n + [INFO] the data cannot be split into files of at most ";
+        cerr << aState.maxLines << " lines\n";
+        cerr << " + filename: '" << aFileName << "'\n";
+        return false;
+    }
+
+    std::vector<IGES_ENTITY_416*> xrefs;
+    std::map<IGES_ENTITY*, IGES_ENTITY_416*> xmap;
+    ok = true;
+
+    for( size_t i = 0; i < cuts.size(); ++i )
+    {
+        IGES_ENTITY_308* def = (IGES_ENTITY_308*)entities[cuts[i]];
+        std::map<size_t, std::string>::iterator sF = aState.files.find( cuts[i] );
+
+        if( sF == aState.files.end() )
+        {
+            std::ostringstream ostr;
+            ostr << aState.base << "_" << ++aState.nFiles << aState.ext;
+            sF = aState.files.insert( std::make_pair( cuts[i], ostr.str() ) ).first;
+
+            // writeFile() names each file in its own Global section
+            std::vector<size_t> root( 1, cuts[i] );
+
+            if( !writeLinked( aState, root, aState.dir + sF->second ) )
+                ok = false;
+        }
+
+        IGES_ENTITY_416* xref = new IGES_ENTITY_416( this );
+        xref->FN = sF->second;
+        xref->EXTNAM = def->GetName();
+        xref->form = def->GetName().empty() ? 3 : 0;
+        xref->use = STAT_USE_DEFINITION;
+        xrefs.push_back( xref );
+        xmap[def] = xref;
+    }
+
+    if( ok )
+    {
+        // the External References precede the entities of this file and
+        // stand in for the Subfigure Definitions in their instances
+        subset.assign( xrefs.begin(), xrefs.end() );
+
+        for( size_t i = 0; i < items.size(); ++i )
+        {
+            IGES_ENTITY* ep = entities[items[i]];
+            subset.push_back( ep );
+
+            if( ep->GetEntityType() == ENT_SINGULAR_SUBFIGURE_INSTANCE )
+            {
+                IGES_ENTITY_408* ip = (IGES_ENTITY_408*)ep;
+                std::map<IGES_ENTITY*, IGES_ENTITY_416*>::iterator sX = xmap.find( ip->DE );
+
+                if( sX != xmap.end() )
+                    ip->linkDE = sX->second;
+            }
+        }
+
+        entities.swap( subset );
+        ok = writeFile( aFileName.c_str(), aState.overwrite, false, aState.maxLines, tooLarge );
+        entities.swap( subset );
+
+        for( size_t i = 0; i < items.size(); ++i )
+        {
+            IGES_ENTITY* ep = entities[items[i]];
+
+            if( ep->GetEntityType() == ENT_SINGULAR_SUBFIGURE_INSTANCE )
+                ((IGES_ENTITY_408*)ep)->linkDE = NULL;
+        }
+
+        if( !ok && tooLarge )
+        {
+            ERRMSG << "\n + [INFO] the data cannot be split into files of at most ";
+            cerr << aState.maxLines << " lines\n";
+            cerr << " + filename: '" << aFileName << "'\n";
+        }
+    }
+
+    for( size_t i = 0; i < xrefs.size(); ++i )
+        delete xrefs[i];
+
+    return ok;
+}
+
+
+bool IGES::WriteLinked( const char* aFileName, bool fOverwrite, int aMaxLines )
+{
+    IGES_LOCALE igloc;
+
+    if( !aFileName )
+    {
+        ERRMSG << "\n + [BUG] null pointer passed for filename\n";
+        return false;
+    }
+
+    Cull();
+
+    if( entities.empty() )
+    {
+        ERRMSG << "\n + [INFO ] no entities to save\n";
+        return false;
+    }
+
+    LINK_STATE state;
+    size_t nEnt = entities.size();
+
+    state.nFiles = 0;
+    state.maxLines = ( aMaxLines < 1 || aMaxLines > 9999999 ) ? 9999999 : aMaxLines;
+    state.overwrite = fOverwrite;
+
+    MCAD_FILEPATH fp( aFileName );
+    const char* cp = fp.GetFullPath();
+
+    if( NULL != cp )
+        state.dir = cp;
+
+    cp = fp.GetFileName();
+
+    if( NULL != cp )
+        state.dir.erase( state.dir.size() - strlen( cp ) );
+
+    cp = fp.GetBaseName();
+
+    if( NULL != cp )
+        state.base = cp;
+
+    cp = fp.GetExtension();
+
+    if( NULL != cp && *cp )
+    {
+        state.ext = ".";
+        state.ext += cp;
+    }
+
+    // the children of each entity are the entities which list it as a parent
+    std::map<IGES_ENTITY*, size_t> index;
+
+    for( size_t i = 0; i < nEnt; ++i )
+        index[entities[i]] = i;
+
+    state.children.resize( nEnt );
+    state.canLink.assign( nEnt, false );
+    std::vector<size_t> roots;
+
+    for( size_t i = 0; i < nEnt; ++i )
+    {
+        IGES_ENTITY* ep = entities[i];
+        std::list<IGES_ENTITY*>::iterator sR = ep->refs.begin();
+        std::list<IGES_ENTITY*>::iterator eR = ep->refs.end();
+        bool only408 = !ep->refs.empty();
+
+        if( ep->refs.empty() )
+            roots.push_back( i );
+
+        while( sR != eR )
+        {
+            std::map<IGES_ENTITY*, size_t>::iterator sI = index.find( *sR );
+
+            if( sI != index.end() )
+                state.children[sI->second].push_back( i );
+
+            if( (*sR)->GetEntityType() != ENT_SINGULAR_SUBFIGURE_INSTANCE )
+                only408 = false;
+
+            ++sR;
+        }
+
+        state.canLink[i] = only408 && ep->GetEntityType() == ENT_SUBFIGURE_DEFINITION;
+    }
+
+    bool ok = writeLinked( state, roots, std::string( aFileName ) );
+
+    // the Global Section describes the main file
+    MCAD_FILEPATH mp( aFileName );
+    cp = mp.GetFileName();
+
+    if( NULL != cp )
+        globalData.fileName = cp;
+    else
+        globalData.fileName.clear();
+
+    if( ok )
+        filePath = aFileName;
+
+    return ok;
+}
+
+
+const char* IGES::GetFilePath( void ) const
+{
+    return filePath.c_str();
+}
+
+
 // create an entity of the given type
 bool IGES::NewEntity( int aEntityType, IGES_ENTITY** aEntityPointer )
 {
@@ -841,6 +1513,10 @@ bool IGES::NewEntity( int aEntityType, IGES_ENTITY** aEntityPointer )
             ep = new IGES_ENTITY_104( this );
             break;
 
+        case ENT_COPIOUS_DATA:
+            ep = new IGES_ENTITY_106( this );
+            break;
+
         case ENT_LINE:
             ep = new IGES_ENTITY_110( this );
             break;
@@ -905,6 +1581,10 @@ bool IGES::NewEntity( int aEntityType, IGES_ENTITY** aEntityPointer )
             ep = new IGES_ENTITY_408( this );
             break;
 
+        case ENT_EXTERNAL_REFERENCE:
+            ep = new IGES_ENTITY_416( this );
+            break;
+
         case ENT_VERTEX:
             ep = new IGES_ENTITY_502( this );
             break;
@@ -940,6 +1620,12 @@ bool IGES::NewEntity( int aEntityType, IGES_ENTITY** aEntityPointer )
 
     *aEntityPointer = ep;
     entities.push_back( ep );
+
+    if( deTable )
+        deTable->Invalidate();
+
+    nameIndex->Add( ep );
+
     return true;
 }
 
@@ -967,6 +1653,11 @@ bool IGES::AddEntity( IGES_ENTITY* aEntity )
     entities.push_back( aEntity );
     aEntity->parent = this;
 
+    if( deTable )
+        deTable->Invalidate();
+
+    nameIndex->Add( aEntity );
+
     return true;
 }
 
@@ -987,6 +1678,10 @@ bool IGES::DelEntity( IGES_ENTITY* aEntity )
     {
         if( *sEnt == aEntity )
         {
+            if( deTable )
+                deTable->Invalidate();
+
+            nameIndex->Remove( *sEnt );
             delete *sEnt;
             entities.erase( sEnt );
             return true;
@@ -1015,6 +1710,10 @@ bool IGES::UnlinkEntity( IGES_ENTITY* aEntity )
     {
         if( *sEnt == aEntity )
         {
+            if( deTable )
+                deTable->Invalidate();
+
+            nameIndex->Remove( *sEnt );
             entities.erase( sEnt );
             return true;
         }
@@ -1605,7 +2304,8 @@ bool IGES::readDE( IGES_RECORD& rec, std::ifstream& file )
 }
 
 
-bool IGES::readPD( IGES_RECORD& rec, std::ifstream& file )
+bool IGES::readPD( IGES_RECORD& rec, std::ifstream& file, ASSOCIATE_JOB* aJob,
+                   size_t* aNAssociated )
 {
     // on entry the record contains the first PARAMETER DATA record
     // but the stream should have been rewound to the start of that
@@ -1614,6 +2314,10 @@ bool IGES::readPD( IGES_RECORD& rec, std::ifstream& file )
     std::vector<IGES_ENTITY*>::iterator sEnt = entities.begin();
     std::vector<IGES_ENTITY*>::iterator eEnt = entities.end();
     size_t i = 0;
+    std::vector<int> refs;
+
+    if( aNAssociated )
+        *aNAssociated = 0;
 
     while( sEnt != eEnt )
     {
@@ -1624,15 +2328,51 @@ bool IGES::readPD( IGES_RECORD& rec, std::ifstream& file )
             return false;
         }
 
+        // every entity preceding this one has been associated; if this
+        // entity refers only to preceding entities then everything its
+        // associate() may access has been read
+        if( aNAssociated && *aNAssociated == i )
+        {
+            bool backward = true;
+
+            refs.clear();
+            (*sEnt)->getRefIndices( refs );
+
+            for( size_t j = 0; j < refs.size() && backward; ++j )
+            {
+                if( refs[j] >= (int)i )
+                    backward = false;
+            }
+
+            if( backward )
+            {
+                if( !(*sEnt)->associate( &entities ) )
+                {
+                    ERRMSG << "\n + [INFO] could not establish file associations\n";
+                    return false;
+                }
+
+                ++(*aNAssociated);
+            }
+            else
+            {
+                ERRMSG << "\n + [VIOLATION] file is marked as dependency ordered but Entity[DE:";
+                cerr << (2 * i + 1) << "] refers to a subsequent entity\n";
+            }
+        }
+
         ++i;
         ++sEnt;
+
+        if( aJob )
+            aJob->SetRead( i );
     }
 
     return true;
 }
 
 
-bool IGES::readTS( IGES_RECORD& rec, std::ifstream& file )
+bool IGES::readTS( IGES_RECORD& rec, std::ifstream& file, int aNStartLines )
 {
     if( !ReadIGESRecord( &rec, file ) )
     {
@@ -1696,9 +2436,9 @@ bool IGES::readTS( IGES_RECORD& rec, std::ifstream& file )
         return false;
     }
 
-    if( tmpInt != (int)startSection.size() )
+    if( tmpInt != aNStartLines )
     {
-        ERRMSG << "\n + [INCONSISTENT FILE] file has " << startSection.size() << "lines ";
+        ERRMSG << "\n + [INCONSISTENT FILE] file has " << aNStartLines << "lines ";
         cerr << "in the Start Section; Terminate Section reports " << tmpInt << "\n";
     }
 
@@ -1742,6 +2482,96 @@ bool IGES::readTS( IGES_RECORD& rec, std::ifstream& file )
 }
 
 
+// build the DE table on first use or after the entity list has changed
+const IGES_DE_TABLE* IGES::GetDETable( void )
+{
+    if( NULL == deTable )
+        deTable = new IGES_DE_TABLE;
+
+    if( !deTable->IsValid() )
+        deTable->Build( entities );
+
+    return deTable;
+}
+
+
+void IGES::FreeDETable( void )
+{
+    if( deTable )
+    {
+        delete deTable;
+        deTable = NULL;
+    }
+
+    return;
+}
+
+
+bool IGES::GetMemoryStats( size_t& aNTypes, IGES_MEMORY_STATS const*& aStats,
+                           IGES_MEMORY_STATS& aTotal )
+{
+    std::map< int, IGES_MEMORY_STATS > types;
+    IGES_MEMORY_STATS total;
+
+    for( size_t i = 0; i < entities.size(); ++i )
+    {
+        IGES_ENTITY* ep = entities[i];
+        IGES_MEMORY_STATS& ts = types[ep->entityType];
+        size_t nObj = 0;
+        size_t nHeap = 0;
+
+        ep->getMemoryUsage( nObj, nHeap );
+
+        ts.entityType = ep->entityType;
+        ++ts.count;
+        ts.objectBytes += nObj;
+        ts.heapBytes += nHeap;
+        ts.refBytes += ep->getRefSize();
+    }
+
+    vMemStats.clear();
+    vMemStats.reserve( types.size() );
+
+    std::map< int, IGES_MEMORY_STATS >::const_iterator sT = types.begin();
+    std::map< int, IGES_MEMORY_STATS >::const_iterator eT = types.end();
+
+    while( sT != eT )
+    {
+        vMemStats.push_back( sT->second );
+        total.count += sT->second.count;
+        total.objectBytes += sT->second.objectBytes;
+        total.heapBytes += sT->second.heapBytes;
+        total.refBytes += sT->second.refBytes;
+        ++sT;
+    }
+
+    // overhead of the IGES object itself
+    total.objectBytes += sizeof( *this );
+    total.heapBytes += HeapSize( entities ) + HeapSize( startSection )
+                       + HeapSize( vStartSection ) + HeapSize( vMemStats );
+
+    std::list<std::string>::const_iterator sS = startSection.begin();
+    std::list<std::string>::const_iterator eS = startSection.end();
+
+    while( sS != eS )
+    {
+        total.heapBytes += HeapSize( *sS );
+        ++sS;
+    }
+
+    if( deTable )
+        total.heapBytes += deTable->GetMemoryUsage();
+
+    total.heapBytes += nameIndex->GetMemoryUsage();
+
+    aNTypes = vMemStats.size();
+    aStats = vMemStats.empty() ? NULL : &vMemStats[0];
+    aTotal = total;
+
+    return true;
+}
+
+
 // cull unsupported and orphaned entities
 void IGES::Cull( bool vicious )
 {
@@ -1750,6 +2580,11 @@ void IGES::Cull( bool vicious )
     int nCulled = 0;
     std::vector<IGES_ENTITY*> tmpEnts;
 
+    if( deTable )
+        deTable->Invalidate();
+
+    nameIndex->Invalidate();
+
     for( iEnt = 0; iEnt < nEnt; ++iEnt )
     {
         if( entities[iEnt]->isOrphaned() ||
@@ -1765,19 +2600,52 @@ void IGES::Cull( bool vicious )
         }
         else
         {
-            tmpEnts.push_back( entities[iEnt] );
+            tmpEnts.push_back( entities[iEnt] );
+        }
+    }
+
+    entities.clear();
+    entities = tmpEnts;
+
+#ifdef DEBUG
+    cout << " + [INFO] Entities culled: " << nCulled << "\n";
+    cout << " + [INFO] Entities remaining: " << entities.size() << "\n";
+#endif
+
+    return;
+}
+
+
+// Rescaling of the entities: since each entity scales only the data
+// which it owns, the entities may be processed in any order.
+class IGES::RESCALE_JOB : public IGES_PARALLEL_JOB
+{
+public:
+    std::vector<IGES_ENTITY*>* entities;
+    double sf;
+
+    bool Process( size_t aFirst, size_t aLast )
+    {
+        bool ok = true;
+
+        for( size_t i = aFirst; i < aLast; ++i )
+        {
+            if( !(*entities)[i]->rescale( sf ) )
+                ok = false;
         }
+
+        return ok;
     }
+};
 
-    entities.clear();
-    entities = tmpEnts;
 
-#ifdef DEBUG
-    cout << " + [INFO] Entities culled: " << nCulled << "\n";
-    cout << " + [INFO] Entities remaining: " << entities.size() << "\n";
-#endif
+bool IGES::rescale( double sf )
+{
+    RESCALE_JOB job;
+    job.entities = &entities;
+    job.sf = sf;
 
-    return;
+    return RunParallelJob( job, entities.size(), nThreads );
 }
 
 
@@ -1810,15 +2678,10 @@ bool IGES::ConvertUnits( IGES_UNIT newUnit )
     globalData.minResolution *= cf;
 
     // scale all existing entities
-    size_t nEnt = entities.size();
-
-    for( size_t i = 0; i < nEnt; ++ i )
+    if( !rescale( cf ) )
     {
-        if( !entities[i]->rescale(cf) )
-        {
-            ERRMSG << "\n + [BUG] cannot convert units\n";
-            return false;
-        }
+        ERRMSG << "\n + [BUG] cannot convert units\n";
+        return false;
     }
 
     globalData.unitsFlag = newUnit;
@@ -1846,15 +2709,10 @@ bool IGES::ChangeModelScale( double aScale )
     globalData.modelScale = aScale;
 
     // scale all existing entities
-    size_t nEnt = entities.size();
-
-    for( size_t i = 0; i < nEnt; ++ i )
+    if( !rescale( cf ) )
     {
-        if( !entities[i]->rescale(cf) )
-        {
-            ERRMSG << "\n + [BUG] cannot convert units\n";
-            return false;
-        }
+        ERRMSG << "\n + [BUG] cannot convert units\n";
+        return false;
     }
 
     return true;
@@ -1870,6 +2728,8 @@ bool IGES::GetHeaders( size_t aListSize, char const**& aHeaderList )
         return false;
     }
 
+    IGES_CACHE_LOCK lock;
+
     if( vStartSection.size() != startSection.size() )
     {
         vStartSection.clear();
@@ -1931,7 +2791,190 @@ bool IGES::AddToHeader( const char*& comments )
 }
 
 // write out the START SECTION
-bool IGES::writeStart( std::ofstream& file )
+// Phase 1 of the parallel PD formatting: each entity is formatted
+// as though its Parameter Data started on line 1 and the number of
+// lines produced is recorded.
+class IGES::FORMAT_JOB : public IGES_PARALLEL_JOB
+{
+public:
+    std::vector<IGES_ENTITY*>* entities;
+    std::vector<int>* nLines;
+
+    bool Process( size_t aFirst, size_t aLast )
+    {
+        for( size_t i = aFirst; i < aLast; ++i )
+        {
+            int index = 1;
+
+            if( !(*entities)[i]->format( index ) )
+            {
+                ERRMSG << "\n + [INFO] could not format entity for output\n";
+                return false;
+            }
+
+            (*nLines)[i] = index - 1;
+        }
+
+        return true;
+    }
+};
+
+
+// Phase 3 of the parallel PD formatting: each entity's Parameter Data
+// is stamped with its final PD Sequence Numbers.
+class IGES::RELOCATE_JOB : public IGES_PARALLEL_JOB
+{
+public:
+    std::vector<IGES_ENTITY*>* entities;
+    std::vector<int>* pdIndex;
+
+    bool Process( size_t aFirst, size_t aLast )
+    {
+        for( size_t i = aFirst; i < aLast; ++i )
+        {
+            if( !(*entities)[i]->relocatePD( (*pdIndex)[i] ) )
+                return false;
+        }
+
+        return true;
+    }
+};
+
+
+bool IGES::formatPD( bool& aTooLarge )
+{
+    size_t nEnt = entities.size();
+    size_t iEnt;
+    aTooLarge = false;
+
+    if( GetNWorkerThreads( nThreads ) < 2 )
+    {
+        int index = 1;
+
+        for( iEnt = 0; iEnt < nEnt; ++iEnt )
+        {
+            if( index > 9999999 )
+            {
+                aTooLarge = true;
+                break;
+            }
+
+            if( !entities[iEnt]->format( index ) )
+            {
+                ERRMSG << "\n + [INFO] could not format entity for output\n";
+
+                for( size_t i = 0; i < iEnt; ++i )
+                    entities[i]->unformat();
+
+                return false;
+            }
+        }
+
+        if( aTooLarge || index > 10000000 )
+        {
+            aTooLarge = true;
+
+            for( size_t i = 0; i < iEnt; ++i )
+                entities[i]->unformat();
+
+            return false;
+        }
+
+        nPDSecLines = index - 1;
+        return true;
+    }
+
+    // Since an entity's Parameter Data depends only on its own data
+    // and the DE Sequence Numbers of the entities it refers to, all
+    // entities may be formatted concurrently with relative PD line
+    // numbers; the final PD Sequence Numbers are then determined
+    // from the line counts and stamped onto each entity's output.
+    std::vector<int> pdIndex( nEnt, 0 );
+
+    FORMAT_JOB fjob;
+    fjob.entities = &entities;
+    fjob.nLines = &pdIndex;
+
+    bool ok = RunParallelJob( fjob, nEnt, nThreads );
+
+    // convert the line counts into PD Sequence Numbers
+    int index = 1;
+
+    for( iEnt = 0; iEnt < nEnt && ok; ++iEnt )
+    {
+        int nl = pdIndex[iEnt];
+        pdIndex[iEnt] = index;
+        index += nl;
+
+        if( index > 10000000 )
+        {
+            ERRMSG << "\n + [ERROR] PD Sequence Number exceeds limitations of IGES specification\n";
+            aTooLarge = true;
+            ok = false;
+        }
+    }
+
+    if( ok )
+    {
+        RELOCATE_JOB rjob;
+        rjob.entities = &entities;
+        rjob.pdIndex = &pdIndex;
+        ok = RunParallelJob( rjob, nEnt, nThreads );
+    }
+
+    if( !ok )
+    {
+        for( iEnt = 0; iEnt < nEnt; ++iEnt )
+            entities[iEnt]->unformat();
+
+        return false;
+    }
+
+    nPDSecLines = index - 1;
+    return true;
+}
+
+
+void IGES::SetNThreads( int aNThreads )
+{
+    nThreads = aNThreads;
+    return;
+}
+
+
+int IGES::GetNThreads( void )
+{
+    return nThreads;
+}
+
+
+void IGES::SetDependencyOrder( bool aOrdered )
+{
+    orderedWrite = aOrdered;
+    return;
+}
+
+
+bool IGES::GetDependencyOrder( void )
+{
+    return orderedWrite;
+}
+
+
+void IGES::SetPipelinedRead( bool aPipelined )
+{
+    pipelinedRead = aPipelined;
+    return;
+}
+
+
+bool IGES::GetPipelinedRead( void )
+{
+    return pipelinedRead;
+}
+
+
+bool IGES::writeStart( std::ostream& file, bool aOrdered )
 {
     if( startSection.empty() )
         startSection.push_back( "# Created via the free libIGES (https://github.com/cbernardo/libIGES)" );
@@ -1997,12 +3040,34 @@ bool IGES::writeStart( std::ofstream& file )
         ++ssc;
     }
 
+    // the mark is not part of the stored Start section
+    if( aOrdered )
+    {
+        tStr = DEP_ORDER_MARK;
+        tStr.append( 72 - tStr.length(), ' ' );
+
+        if( !FormatDEInt( tStr1, nsc ) )
+        {
+            ERRMSG << "\n + [INFO] could not format START section\n";
+            return false;
+        }
+
+        tStr1[0] = 'S';
+        file << tStr << tStr1 << "\n";
+
+        if( file.fail() )
+        {
+            ERRMSG << "\n + [INFO] could not write START section\n";
+            return false;
+        }
+    }
+
     return true;
 }
 
 
 // write out the GLOBAL SECTION
-bool IGES::writeGlobals( std::ofstream& file )
+bool IGES::writeGlobals( std::ostream& file )
 {
     std::string gstr;   // Global Section data as a single string
     std::string lstr;   // one line of Global Section Data being assembled
@@ -2595,71 +3660,255 @@ bool IGES::Export( IGES* newParent, IGES_ENTITY_308** packagedEntity )
     }
 
     *packagedEntity = p308;
+    string tname;
 
     if( globalData.fileName.empty() )
     {
         if( isAssy )
-            newParent->GetNewAssemblyName( p308->NAME );
+            newParent->GetNewAssemblyName( tname );
         else
-            newParent->GetNewPartName( p308->NAME );
+            newParent->GetNewPartName( tname );
     }
     else
     {
-        string tname = globalData.fileName;
+        tname = globalData.fileName;
         size_t pos = tname.find_last_of( '.' );
 
         if( string::npos != pos && pos > 0 )
             tname = tname.substr( 0, pos );
 
-        p308->NAME = tname;
+        // a different model of the same name may already be present
+        newParent->MakeUniqueName( tname );
     }
 
+    p308->SetName( tname );
     entities.clear();
 
+    if( deTable )
+        deTable->Invalidate();
+
+    nameIndex->Invalidate();
+
     return true;
 }
 
 
-void IGES::GetNewPartName( std::string& name )
+// reads each of a list of files into its own IGES object
+class IGES::ASSEMBLY_READ_JOB : public IGES_PARALLEL_JOB
 {
-    name.clear();
-    time_t now;
-    time( &now );
-    struct tm date;
-    gmtime_r( &now, &date );
+private:
+    const std::vector< std::string >* m_files;
+    std::vector< IGES* >* m_models;
+    int m_nThreads;
+    bool m_pipelined;
 
-    // to reduce likelihood of name clashes, use partYYYYDDDHHMMSSnnnn
-    ostringstream ostr;
-    ostr << "part" << setw(4) << setfill('0') << (date.tm_year + 1900);
-    ostr << setw(3) << (date.tm_yday + 1) << setw(2) << date.tm_hour;
-    ostr << setw(2) << date.tm_min << setw(2) << date.tm_sec;
-    ostr << setw(4) << idxPartNum;
+public:
+    ASSEMBLY_READ_JOB( const std::vector< std::string >* aFiles,
+                       std::vector< IGES* >* aModels, int aNThreads, bool aPipelined )
+    {
+        m_files = aFiles;
+        m_models = aModels;
+        m_nThreads = aNThreads;
+        m_pipelined = aPipelined;
+    }
+
+    bool Process( size_t aFirst, size_t aLast )
+    {
+        for( size_t i = aFirst; i < aLast; ++i )
+        {
+            IGES* model = new IGES;
+            model->SetNThreads( m_nThreads );
+            model->SetPipelinedRead( m_pipelined );
+
+            if( !model->Read( (*m_files)[i].c_str() ) )
+            {
+                ERRMSG << "\n + [INFO] could not read part file '" << (*m_files)[i] << "'\n";
+                delete model;
+                return false;
+            }
+
+            (*m_models)[i] = model;
+        }
+
+        return true;
+    }
+};
+
+
+bool IGES::BuildAssembly( const IGES_ASSEMBLY_PART* aParts, size_t aNParts )
+{
+    if( NULL == aParts && aNParts > 0 )
+    {
+        ERRMSG << "\n + [BUG] NULL pointer passed for part list\n";
+        return false;
+    }
+
+    // list the distinct files in order of first appearance; files
+    // without any placements are not needed
+    std::vector< std::string > files;
+    std::vector< size_t > fileIdx( aNParts );
+    std::map< std::string, size_t > fileMap;
+
+    for( size_t i = 0; i < aNParts; ++i )
+    {
+        if( NULL == aParts[i].fileName || 0 == aParts[i].fileName[0] )
+        {
+            ERRMSG << "\n + [INFO] no file name for part " << i << "\n";
+            return false;
+        }
+
+        if( aParts[i].nPlacements > 0 && NULL == aParts[i].placements )
+        {
+            ERRMSG << "\n + [BUG] NULL pointer passed for placements of part '";
+            cerr << aParts[i].fileName << "'\n";
+            return false;
+        }
+
+        if( 0 == aParts[i].nPlacements )
+            continue;
+
+        std::map< std::string, size_t >::iterator it = fileMap.find( aParts[i].fileName );
 
-    name = ostr.str();
+        if( it == fileMap.end() )
+        {
+            fileIdx[i] = files.size();
+            fileMap[aParts[i].fileName] = files.size();
+            files.push_back( aParts[i].fileName );
+        }
+        else
+        {
+            fileIdx[i] = it->second;
+        }
+    }
+
+    if( files.empty() )
+        return true;
+
+    // the files are independent of each other; when several are read at
+    // once each is read by a single thread
+    size_t nFiles = files.size();
+    int nWorkers = GetNWorkerThreads( nThreads );
+    std::vector< IGES* > models( nFiles, (IGES*)NULL );
+    ASSEMBLY_READ_JOB rjob( &files, &models, ( nWorkers > 1 && nFiles > 1 ) ? 1 : nThreads,
+                            pipelinedRead );
+
+    bool ok;
+
+    do
+    {
+        // hold the numerics locale for the duration of all reads
+        IGES_LOCALE igloc;
+        ok = RunParallelJob( rjob, nFiles, nWorkers, 1 );
+    } while( 0 );
+
+    if( !ok )
+    {
+        for( size_t i = 0; i < nFiles; ++i )
+            delete models[i];
+
+        ERRMSG << "\n + [INFO] could not read all parts of the assembly\n";
+        return false;
+    }
+
+    // export the parts and instantiate them in the order given
+    std::vector< IGES_ENTITY_308* > defs( nFiles, (IGES_ENTITY_308*)NULL );
+
+    for( size_t i = 0; i < aNParts && ok; ++i )
+    {
+        if( 0 == aParts[i].nPlacements )
+            continue;
+
+        size_t fi = fileIdx[i];
+
+        if( NULL != models[fi] )
+        {
+            models[fi]->SetNThreads( nThreads );
+
+            if( !models[fi]->Export( this, &defs[fi] ) || NULL == defs[fi] )
+            {
+                ERRMSG << "\n + [INFO] could not export part '" << files[fi] << "'\n";
+                ok = false;
+                break;
+            }
+
+            delete models[fi];
+            models[fi] = NULL;
+        }
+
+        for( size_t j = 0; j < aParts[i].nPlacements; ++j )
+        {
+            IGES_ENTITY* ep;
+            IGES_ENTITY_124* p124;
+            IGES_ENTITY_408* p408;
+
+            if( !NewEntity( ENT_TRANSFORMATION_MATRIX, &ep ) )
+            {
+                ERRMSG << "\n + [INFO] could not create Transformation Matrix Entity\n";
+                ok = false;
+                break;
+            }
+
+            p124 = (IGES_ENTITY_124*)ep;
+            p124->T = aParts[i].placements[j];
+
+            if( !NewEntity( ENT_SINGULAR_SUBFIGURE_INSTANCE, &ep ) )
+            {
+                ERRMSG << "\n + [INFO] could not create Singular Subfigure Instance Entity\n";
+                ok = false;
+                break;
+            }
+
+            p408 = (IGES_ENTITY_408*)ep;
+
+            if( !p408->SetTransform( p124 ) || !p408->SetDE( defs[fi] ) )
+            {
+                ERRMSG << "\n + [INFO] could not instantiate part '" << files[fi] << "'\n";
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    for( size_t i = 0; i < nFiles; ++i )
+        delete models[i];
+
+    return ok;
+}
 
+
+void IGES::GetNewPartName( std::string& name )
+{
+    nameIndex->NewName( false, name );
     return;
 }
 
+
 void IGES::GetNewAssemblyName( std::string& name )
 {
-    name.clear();
-    time_t now;
-    time( &now );
-    struct tm date;
-    gmtime_r( &now, &date );
+    nameIndex->NewName( true, name );
+    return;
+}
 
-    // to reduce likelihood of name clashes, use assyYYYYDDDHHMMSSnnnn
-    ostringstream ostr;
-    ostr << "assy" << setw(4) << setfill('0') << (date.tm_year + 1900);
-    ostr << setw(3) << (date.tm_yday + 1) << setw(2) << date.tm_hour;
-    ostr << setw(2) << date.tm_min << setw(2) << date.tm_sec;
-    ostr << setw(4) << idxPartNum;
 
-    name = ostr.str();
+size_t IGES::FindByName( const std::string& aName, std::vector<IGES_ENTITY*>& aList )
+{
+    return nameIndex->Find( aName, aList );
+}
+
+
+bool IGES::IsNameUsed( const std::string& aName )
+{
+    return nameIndex->IsUsed( aName );
+}
+
 
+void IGES::MakeUniqueName( std::string& aName )
+{
+    nameIndex->MakeUnique( aName );
     return;
 }
 
+
 const char* IGES::GetUnitName( void )
 {
     return UNIT_NAMES[globalData.unitsFlag].c_str();
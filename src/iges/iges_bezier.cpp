@@ -0,0 +1,831 @@
+/*
+ * file: iges_bezier.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: piecewise Bezier representation of NURBS curves and
+ * surfaces; this is a cache derived from the B-Spline data of
+ * Entities 126 and 128 to speed up repeated evaluation.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <cmath>
+#include <error_macros.h>
+#include <core/iges_bezier.h>
+#include <core/iges_memory.h>
+
+// number of doubles per homogeneous point
+#define HDIM (4)
+// maximum depth of subdivision when refining a bounding box
+#define MAX_SPLIT_DEPTH (24)
+
+
+// list the knot spans [aKnots[i], aKnots[i+1]] which overlap [aV0, aV1] within
+// the valid domain of the B-Spline; aBreaks receives the clipped bounds of each
+// span and aSpans the index i of each span
+static bool findSpans( int aNCoeffs, int aOrder, const double* aKnots,
+                       double aV0, double aV1, std::vector<double>& aBreaks,
+                       std::vector<int>& aSpans )
+{
+    aBreaks.clear();
+    aSpans.clear();
+
+    int p = aOrder - 1;
+
+    if( aV0 < aKnots[p] )
+        aV0 = aKnots[p];
+
+    if( aV1 > aKnots[aNCoeffs] )
+        aV1 = aKnots[aNCoeffs];
+
+    if( aV1 <= aV0 )
+        return false;
+
+    for( int i = p; i < aNCoeffs; ++i )
+    {
+        double a = aKnots[i];
+        double b = aKnots[i + 1];
+
+        if( b <= a || b <= aV0 || a >= aV1 )
+            continue;
+
+        if( a < aV0 )
+            a = aV0;
+
+        if( b > aV1 )
+            b = aV1;
+
+        if( aBreaks.empty() )
+            aBreaks.push_back( a );
+
+        aBreaks.push_back( b );
+        aSpans.push_back( i );
+    }
+
+    return !aSpans.empty();
+}
+
+
+// compute the Bezier control points of the piece of a B-Spline within
+// knot span aSpan restricted to [a, b]. The j-th Bezier point is the
+// blossom of the span evaluated at (a, .. a, b, .. b) with j instances
+// of b, which is equivalent to inserting a and b until each has full
+// multiplicity. aCtl holds points of aDim doubles; aWork must hold
+// aOrder * aDim doubles and aOut receives aOrder * aDim doubles.
+static void blossomSpan( int aOrder, const double* aKnots, int aSpan,
+                         const double* aCtl, int aDim, double a, double b,
+                         double* aWork, double* aOut )
+{
+    int p = aOrder - 1;
+
+    for( int j = 0; j <= p; ++j )
+    {
+        for( int l = 0; l <= p; ++l )
+        {
+            const double* src = &aCtl[( aSpan - p + l ) * aDim];
+
+            for( int k = 0; k < aDim; ++k )
+                aWork[l * aDim + k] = src[k];
+        }
+
+        for( int r = 1; r <= p; ++r )
+        {
+            // the first (p - j) arguments are 'a', the remainder are 'b'
+            double t = ( r <= p - j ) ? a : b;
+
+            for( int l = p; l >= r; --l )
+            {
+                double k0 = aKnots[aSpan - p + l];
+                double dk = aKnots[aSpan + l - r + 1] - k0;
+                double alpha = ( dk > 0.0 ) ? ( t - k0 ) / dk : 0.0;
+
+                for( int k = 0; k < aDim; ++k )
+                    aWork[l * aDim + k] = ( 1.0 - alpha ) * aWork[( l - 1 ) * aDim + k]
+                        + alpha * aWork[l * aDim + k];
+            }
+        }
+
+        for( int k = 0; k < aDim; ++k )
+            aOut[j * aDim + k] = aWork[p * aDim + k];
+    }
+
+    return;
+}
+
+
+// convert aOrder Bezier points (stride aStride doubles, HDIM values each)
+// to power basis coefficients in the local parameter t = [0, 1]
+static void bezierToPower( int aOrder, const double* aBez, int aStride, double* aPow )
+{
+    int p = aOrder - 1;
+    double binP = 1.0;  // C(p, k)
+
+    for( int k = 0; k <= p; ++k )
+    {
+        double sum[HDIM] = { 0.0, 0.0, 0.0, 0.0 };
+        double binK = 1.0;  // C(k, i)
+
+        for( int i = 0; i <= k; ++i )
+        {
+            double c = ( ( k - i ) % 2 ) ? -binK : binK;
+
+            for( int m = 0; m < HDIM; ++m )
+                sum[m] += c * aBez[i * aStride + m];
+
+            binK = binK * ( k - i ) / ( i + 1 );
+        }
+
+        for( int m = 0; m < HDIM; ++m )
+            aPow[k * aStride + m] = binP * sum[m];
+
+        binP = binP * ( p - k ) / ( k + 1 );
+    }
+
+    return;
+}
+
+
+// convert the control points to homogeneous form
+static void homogenize( int aNCoeffs, const double* aCoeffs, bool aRational,
+                        std::vector<double>& aHCoeffs )
+{
+    aHCoeffs.resize( aNCoeffs * HDIM );
+    int stride = aRational ? 4 : 3;
+
+    for( int i = 0; i < aNCoeffs; ++i )
+    {
+        const double* src = &aCoeffs[i * stride];
+        double w = aRational ? src[3] : 1.0;
+        double* dst = &aHCoeffs[i * HDIM];
+
+        dst[0] = src[0] * w;
+        dst[1] = src[1] * w;
+        dst[2] = src[2] * w;
+        dst[3] = w;
+    }
+
+    return;
+}
+
+
+// locate the piece containing aParam within the sorted list of breaks
+static int locate( const std::vector<double>& aBreaks, double aParam )
+{
+    int lo = 0;
+    int hi = (int)aBreaks.size() - 2;
+
+    while( lo < hi )
+    {
+        int mid = ( lo + hi + 1 ) / 2;
+
+        if( aParam < aBreaks[mid] )
+            hi = mid - 1;
+        else
+            lo = mid;
+    }
+
+    return lo;
+}
+
+
+// transform a homogeneous point and return its Euclidean coordinates
+static void project( const MCAD_TRANSFORM* aTransform, const double* aHPoint, double* aPoint )
+{
+    double w = aHPoint[3];
+    double x = aHPoint[0];
+    double y = aHPoint[1];
+    double z = aHPoint[2];
+
+    if( aTransform )
+    {
+        const MCAD_MATRIX& R = aTransform->R;
+        double tx = R.v[0][0] * x + R.v[0][1] * y + R.v[0][2] * z + aTransform->T.x * w;
+        double ty = R.v[1][0] * x + R.v[1][1] * y + R.v[1][2] * z + aTransform->T.y * w;
+        double tz = R.v[2][0] * x + R.v[2][1] * y + R.v[2][2] * z + aTransform->T.z * w;
+        x = tx;
+        y = ty;
+        z = tz;
+    }
+
+    aPoint[0] = x / w;
+    aPoint[1] = y / w;
+    aPoint[2] = z / w;
+    return;
+}
+
+
+// split a Bezier piece at t = 0.5 by de Casteljau subdivision
+static void splitPiece( int aOrder, const double* aBez, double* aLeft, double* aRight )
+{
+    int p = aOrder - 1;
+    std::vector<double> tri( aBez, aBez + aOrder * HDIM );
+
+    for( int m = 0; m < HDIM; ++m )
+    {
+        aLeft[m] = tri[m];
+        aRight[p * HDIM + m] = tri[p * HDIM + m];
+    }
+
+    for( int r = 1; r <= p; ++r )
+    {
+        for( int i = 0; i <= p - r; ++i )
+        {
+            for( int m = 0; m < HDIM; ++m )
+                tri[i * HDIM + m] = 0.5 * ( tri[i * HDIM + m] + tri[( i + 1 ) * HDIM + m] );
+        }
+
+        for( int m = 0; m < HDIM; ++m )
+        {
+            aLeft[r * HDIM + m] = tri[m];
+            aRight[( p - r ) * HDIM + m] = tri[( p - r ) * HDIM + m];
+        }
+    }
+
+    return;
+}
+
+
+// append the end point of a Bezier piece to the list of points, first
+// subdividing the piece until its control polygon lies within aTolerance
+// of the chord. The start point of the piece is assumed to be in the list.
+static void flattenPiece( int aOrder, const double* aBez, const MCAD_TRANSFORM* aTransform,
+                          double aTolerance, int aDepth, std::vector<MCAD_POINT>& aPoints )
+{
+    int p = aOrder - 1;
+    double p0[3];
+    double p1[3];
+    double pt[3];
+
+    project( aTransform, aBez, p0 );
+    project( aTransform, &aBez[p * HDIM], p1 );
+
+    double chord[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+    double len2 = chord[0] * chord[0] + chord[1] * chord[1] + chord[2] * chord[2];
+    double tol2 = aTolerance * aTolerance;
+    bool flat = true;
+
+    for( int i = 1; i < p && flat; ++i )
+    {
+        project( aTransform, &aBez[i * HDIM], pt );
+
+        double d[3] = { pt[0] - p0[0], pt[1] - p0[1], pt[2] - p0[2] };
+        double dd = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+        double dist2 = dd;
+
+        // distance from the chord; since the piece lies within the hull
+        // of its control points this bounds the deviation of the chord
+        if( len2 > 0.0 )
+        {
+            double t = ( d[0] * chord[0] + d[1] * chord[1] + d[2] * chord[2] ) / len2;
+
+            if( t > 1.0 )
+            {
+                double e[3] = { pt[0] - p1[0], pt[1] - p1[1], pt[2] - p1[2] };
+                dist2 = e[0] * e[0] + e[1] * e[1] + e[2] * e[2];
+            }
+            else if( t > 0.0 )
+            {
+                dist2 = dd - t * t * len2;
+            }
+        }
+
+        if( dist2 > tol2 )
+            flat = false;
+    }
+
+    if( !flat && aDepth < MAX_SPLIT_DEPTH )
+    {
+        std::vector<double> left( aOrder * HDIM );
+        std::vector<double> right( aOrder * HDIM );
+        splitPiece( aOrder, aBez, &left[0], &right[0] );
+        flattenPiece( aOrder, &left[0], aTransform, aTolerance, aDepth + 1, aPoints );
+        flattenPiece( aOrder, &right[0], aTransform, aTolerance, aDepth + 1, aPoints );
+        return;
+    }
+
+    aPoints.push_back( MCAD_POINT( p1[0], p1[1], p1[2] ) );
+    return;
+}
+
+
+// add the bounds of a Bezier piece to the box [aMin, aMax]; the piece is
+// subdivided while its control polygon extends beyond the box (which
+// includes the end points of the piece) by more than aTolerance
+static void boundPiece( int aOrder, const double* aBez, const MCAD_TRANSFORM* aTransform,
+                        double aTolerance, int aDepth, double* aMin, double* aMax )
+{
+    double pt[3];
+    double hMin[3];
+    double hMax[3];
+    double eMin[3];
+    double eMax[3];
+    int p = aOrder - 1;
+
+    project( aTransform, aBez, pt );
+
+    for( int k = 0; k < 3; ++k )
+    {
+        eMin[k] = pt[k];
+        eMax[k] = pt[k];
+    }
+
+    project( aTransform, &aBez[p * HDIM], pt );
+
+    for( int k = 0; k < 3; ++k )
+    {
+        if( pt[k] < eMin[k] )
+            eMin[k] = pt[k];
+
+        if( pt[k] > eMax[k] )
+            eMax[k] = pt[k];
+
+        hMin[k] = eMin[k];
+        hMax[k] = eMax[k];
+    }
+
+    for( int i = 1; i < p; ++i )
+    {
+        project( aTransform, &aBez[i * HDIM], pt );
+
+        for( int k = 0; k < 3; ++k )
+        {
+            if( pt[k] < hMin[k] )
+                hMin[k] = pt[k];
+
+            if( pt[k] > hMax[k] )
+                hMax[k] = pt[k];
+        }
+    }
+
+    // the end points lie on the curve
+    bool refine = false;
+
+    for( int k = 0; k < 3; ++k )
+    {
+        if( eMin[k] < aMin[k] )
+            aMin[k] = eMin[k];
+
+        if( eMax[k] > aMax[k] )
+            aMax[k] = eMax[k];
+
+        if( hMin[k] < aMin[k] - aTolerance || hMax[k] > aMax[k] + aTolerance )
+            refine = true;
+    }
+
+    // accept the control polygon's box if it is within tolerance
+    // of the box or if the piece cannot be subdivided further
+    if( !refine || aDepth >= MAX_SPLIT_DEPTH )
+    {
+        for( int k = 0; k < 3; ++k )
+        {
+            if( hMin[k] < aMin[k] )
+                aMin[k] = hMin[k];
+
+            if( hMax[k] > aMax[k] )
+                aMax[k] = hMax[k];
+        }
+
+        return;
+    }
+
+    std::vector<double> left( aOrder * HDIM );
+    std::vector<double> right( aOrder * HDIM );
+    splitPiece( aOrder, aBez, &left[0], &right[0] );
+
+    boundPiece( aOrder, &left[0], aTransform, aTolerance, aDepth + 1, aMin, aMax );
+    boundPiece( aOrder, &right[0], aTransform, aTolerance, aDepth + 1, aMin, aMax );
+    return;
+}
+
+
+IGES_BEZIER_CURVE::IGES_BEZIER_CURVE()
+{
+    m_order = 0;
+    m_nSegs = 0;
+    m_rational = false;
+    return;
+}
+
+
+bool IGES_BEZIER_CURVE::Build( int aNCoeffs, int aOrder, const double* aKnots,
+                               const double* aCoeffs, bool aRational,
+                               double aV0, double aV1 )
+{
+    m_order = 0;
+    m_nSegs = 0;
+    m_breaks.clear();
+    m_bezier.clear();
+    m_power.clear();
+
+    if( aOrder < 2 || aNCoeffs < aOrder || NULL == aKnots || NULL == aCoeffs )
+    {
+        ERRMSG << "\n + [BUG] invalid B-Spline data\n";
+        return false;
+    }
+
+    std::vector<int> spans;
+
+    if( !findSpans( aNCoeffs, aOrder, aKnots, aV0, aV1, m_breaks, spans ) )
+    {
+        ERRMSG << "\n + [INFO] curve has no valid parameter range\n";
+        return false;
+    }
+
+    std::vector<double> hc;
+    homogenize( aNCoeffs, aCoeffs, aRational, hc );
+
+    m_order = aOrder;
+    m_nSegs = (int)spans.size();
+    m_rational = aRational;
+    m_bezier.resize( m_nSegs * aOrder * HDIM );
+    m_power.resize( m_nSegs * aOrder * HDIM );
+
+    std::vector<double> work( aOrder * HDIM );
+
+    for( int i = 0; i < m_nSegs; ++i )
+    {
+        double* bez = &m_bezier[i * aOrder * HDIM];
+        blossomSpan( aOrder, aKnots, spans[i], &hc[0], HDIM, m_breaks[i],
+                     m_breaks[i + 1], &work[0], bez );
+        bezierToPower( aOrder, bez, HDIM, &m_power[i * aOrder * HDIM] );
+    }
+
+    return true;
+}
+
+
+int IGES_BEZIER_CURVE::GetNSegments( void ) const
+{
+    return m_nSegs;
+}
+
+
+int IGES_BEZIER_CURVE::GetOrder( void ) const
+{
+    return m_order;
+}
+
+
+const double* IGES_BEZIER_CURVE::GetSegment( int aIndex, double& aStart, double& aEnd ) const
+{
+    if( aIndex < 0 || aIndex >= m_nSegs )
+        return NULL;
+
+    aStart = m_breaks[aIndex];
+    aEnd = m_breaks[aIndex + 1];
+    return &m_bezier[aIndex * m_order * HDIM];
+}
+
+
+size_t IGES_BEZIER_CURVE::GetMemoryUsage( void ) const
+{
+    return sizeof( *this ) + HeapSize( m_breaks ) + HeapSize( m_bezier ) + HeapSize( m_power );
+}
+
+
+int IGES_BEZIER_CURVE::findSegment( double aParam ) const
+{
+    return locate( m_breaks, aParam );
+}
+
+
+void IGES_BEZIER_CURVE::Evaluate( double aParam, MCAD_POINT& aPoint ) const
+{
+    if( 0 == m_nSegs )
+        return;
+
+    int seg = findSegment( aParam );
+    double a = m_breaks[seg];
+    double b = m_breaks[seg + 1];
+
+    if( aParam < a )
+        aParam = a;
+    else if( aParam > b )
+        aParam = b;
+
+    double t = ( aParam - a ) / ( b - a );
+    const double* c = &m_power[( seg * m_order + m_order - 1 ) * HDIM];
+    double x = c[0];
+    double y = c[1];
+    double z = c[2];
+    double w = c[3];
+
+    for( int k = m_order - 2; k >= 0; --k )
+    {
+        c -= HDIM;
+        x = x * t + c[0];
+        y = y * t + c[1];
+        z = z * t + c[2];
+        w = w * t + c[3];
+    }
+
+    if( m_rational )
+    {
+        aPoint.x = x / w;
+        aPoint.y = y / w;
+        aPoint.z = z / w;
+    }
+    else
+    {
+        aPoint.x = x;
+        aPoint.y = y;
+        aPoint.z = z;
+    }
+
+    return;
+}
+
+
+void IGES_BEZIER_CURVE::GetBounds( const MCAD_TRANSFORM* aTransform, double aTolerance,
+                                   MCAD_POINT& aMin, MCAD_POINT& aMax ) const
+{
+    if( 0 == m_nSegs )
+        return;
+
+    double bMin[3];
+    double bMax[3];
+    double pt[3];
+
+    project( aTransform, &m_bezier[0], pt );
+
+    for( int k = 0; k < 3; ++k )
+    {
+        bMin[k] = pt[k];
+        bMax[k] = pt[k];
+    }
+
+    for( int i = 0; i < m_nSegs; ++i )
+        boundPiece( m_order, &m_bezier[i * m_order * HDIM], aTransform,
+                    aTolerance, 0, bMin, bMax );
+
+    aMin.x = bMin[0];
+    aMin.y = bMin[1];
+    aMin.z = bMin[2];
+    aMax.x = bMax[0];
+    aMax.y = bMax[1];
+    aMax.z = bMax[2];
+    return;
+}
+
+
+void IGES_BEZIER_CURVE::Flatten( const MCAD_TRANSFORM* aTransform, double aTolerance,
+                                 std::vector<MCAD_POINT>& aPoints ) const
+{
+    if( 0 == m_nSegs )
+        return;
+
+    double pt[3];
+    project( aTransform, &m_bezier[0], pt );
+    aPoints.push_back( MCAD_POINT( pt[0], pt[1], pt[2] ) );
+
+    for( int i = 0; i < m_nSegs; ++i )
+        flattenPiece( m_order, &m_bezier[i * m_order * HDIM], aTransform,
+                      aTolerance, 0, aPoints );
+
+    return;
+}
+
+
+IGES_BEZIER_SURFACE::IGES_BEZIER_SURFACE()
+{
+    m_order1 = 0;
+    m_order2 = 0;
+    m_nSegs1 = 0;
+    m_nSegs2 = 0;
+    m_rational = false;
+    return;
+}
+
+
+bool IGES_BEZIER_SURFACE::Build( int aNCoeffs1, int aNCoeffs2, int aOrder1, int aOrder2,
+                                 const double* aKnots1, const double* aKnots2,
+                                 const double* aCoeffs, bool aRational,
+                                 double aU0, double aU1, double aV0, double aV1 )
+{
+    m_order1 = 0;
+    m_order2 = 0;
+    m_nSegs1 = 0;
+    m_nSegs2 = 0;
+    m_breaks1.clear();
+    m_breaks2.clear();
+    m_bezier.clear();
+    m_power.clear();
+
+    if( aOrder1 < 2 || aOrder2 < 2 || aNCoeffs1 < aOrder1 || aNCoeffs2 < aOrder2
+        || NULL == aKnots1 || NULL == aKnots2 || NULL == aCoeffs )
+    {
+        ERRMSG << "\n + [BUG] invalid B-Spline data\n";
+        return false;
+    }
+
+    std::vector<int> spans1;
+    std::vector<int> spans2;
+
+    if( !findSpans( aNCoeffs1, aOrder1, aKnots1, aU0, aU1, m_breaks1, spans1 )
+        || !findSpans( aNCoeffs2, aOrder2, aKnots2, aV0, aV1, m_breaks2, spans2 ) )
+    {
+        ERRMSG << "\n + [INFO] surface has no valid parameter range\n";
+        return false;
+    }
+
+    std::vector<double> hc;
+    homogenize( aNCoeffs1 * aNCoeffs2, aCoeffs, aRational, hc );
+
+    m_order1 = aOrder1;
+    m_order2 = aOrder2;
+    m_nSegs1 = (int)spans1.size();
+    m_nSegs2 = (int)spans2.size();
+    m_rational = aRational;
+
+    // Step 1: decompose in V; each row of control points (constant V index)
+    // is treated as a single point of aNCoeffs1 * HDIM values.
+    int rowDim = aNCoeffs1 * HDIM;
+    std::vector<double> work( aOrder1 > aOrder2 ? aOrder1 * rowDim : aOrder2 * rowDim );
+    std::vector<double> vbez( m_nSegs2 * aOrder2 * rowDim );
+
+    for( int j = 0; j < m_nSegs2; ++j )
+        blossomSpan( aOrder2, aKnots2, spans2[j], &hc[0], rowDim, m_breaks2[j],
+                     m_breaks2[j + 1], &work[0], &vbez[j * aOrder2 * rowDim] );
+
+    // Step 2: decompose each resulting row in U; patch control points are
+    // stored with U varying fastest.
+    int patchSize = aOrder1 * aOrder2 * HDIM;
+    m_bezier.resize( m_nSegs1 * m_nSegs2 * patchSize );
+    m_power.resize( m_nSegs1 * m_nSegs2 * patchSize );
+    std::vector<double> ubez( aOrder1 * HDIM );
+
+    for( int j = 0; j < m_nSegs2; ++j )
+    {
+        for( int r = 0; r < aOrder2; ++r )
+        {
+            const double* row = &vbez[( j * aOrder2 + r ) * rowDim];
+
+            for( int i = 0; i < m_nSegs1; ++i )
+            {
+                blossomSpan( aOrder1, aKnots1, spans1[i], row, HDIM, m_breaks1[i],
+                             m_breaks1[i + 1], &work[0], &ubez[0] );
+
+                double* patch = &m_bezier[( j * m_nSegs1 + i ) * patchSize];
+
+                for( int k = 0; k < aOrder1 * HDIM; ++k )
+                    patch[r * aOrder1 * HDIM + k] = ubez[k];
+            }
+        }
+    }
+
+    // Step 3: power basis coefficients; convert along U then along V
+    std::vector<double> tmp( patchSize );
+
+    for( int n = 0; n < m_nSegs1 * m_nSegs2; ++n )
+    {
+        const double* patch = &m_bezier[n * patchSize];
+        double* pow = &m_power[n * patchSize];
+
+        for( int r = 0; r < aOrder2; ++r )
+            bezierToPower( aOrder1, &patch[r * aOrder1 * HDIM], HDIM,
+                           &tmp[r * aOrder1 * HDIM] );
+
+        for( int c = 0; c < aOrder1; ++c )
+            bezierToPower( aOrder2, &tmp[c * HDIM], aOrder1 * HDIM, &pow[c * HDIM] );
+    }
+
+    return true;
+}
+
+
+int IGES_BEZIER_SURFACE::GetNPatches( void ) const
+{
+    return m_nSegs1 * m_nSegs2;
+}
+
+
+size_t IGES_BEZIER_SURFACE::GetMemoryUsage( void ) const
+{
+    return sizeof( *this ) + HeapSize( m_breaks1 ) + HeapSize( m_breaks2 )
+           + HeapSize( m_bezier ) + HeapSize( m_power );
+}
+
+
+void IGES_BEZIER_SURFACE::Evaluate( double aU, double aV, MCAD_POINT& aPoint ) const
+{
+    if( 0 == m_nSegs1 || 0 == m_nSegs2 )
+        return;
+
+    int iu = locate( m_breaks1, aU );
+    int iv = locate( m_breaks2, aV );
+    double a = m_breaks1[iu];
+    double b = m_breaks1[iu + 1];
+
+    if( aU < a )
+        aU = a;
+    else if( aU > b )
+        aU = b;
+
+    double s = ( aU - a ) / ( b - a );
+
+    a = m_breaks2[iv];
+    b = m_breaks2[iv + 1];
+
+    if( aV < a )
+        aV = a;
+    else if( aV > b )
+        aV = b;
+
+    double t = ( aV - a ) / ( b - a );
+
+    const double* pow = &m_power[( iv * m_nSegs1 + iu ) * m_order1 * m_order2 * HDIM];
+    double res[HDIM] = { 0.0, 0.0, 0.0, 0.0 };
+
+    // Horner's rule in V on the polynomials in U
+    for( int r = m_order2 - 1; r >= 0; --r )
+    {
+        const double* c = &pow[( r * m_order1 + m_order1 - 1 ) * HDIM];
+        double row[HDIM] = { c[0], c[1], c[2], c[3] };
+
+        for( int k = m_order1 - 2; k >= 0; --k )
+        {
+            c -= HDIM;
+
+            for( int m = 0; m < HDIM; ++m )
+                row[m] = row[m] * s + c[m];
+        }
+
+        for( int m = 0; m < HDIM; ++m )
+            res[m] = res[m] * t + row[m];
+    }
+
+    if( m_rational )
+    {
+        aPoint.x = res[0] / res[3];
+        aPoint.y = res[1] / res[3];
+        aPoint.z = res[2] / res[3];
+    }
+    else
+    {
+        aPoint.x = res[0];
+        aPoint.y = res[1];
+        aPoint.z = res[2];
+    }
+
+    return;
+}
+
+
+void IGES_BEZIER_SURFACE::GetBounds( const MCAD_TRANSFORM* aTransform,
+                                     MCAD_POINT& aMin, MCAD_POINT& aMax ) const
+{
+    if( 0 == m_nSegs1 || 0 == m_nSegs2 )
+        return;
+
+    double bMin[3];
+    double bMax[3];
+    double pt[3];
+    size_t np = m_bezier.size() / HDIM;
+
+    project( aTransform, &m_bezier[0], pt );
+
+    for( int k = 0; k < 3; ++k )
+    {
+        bMin[k] = pt[k];
+        bMax[k] = pt[k];
+    }
+
+    for( size_t i = 1; i < np; ++i )
+    {
+        project( aTransform, &m_bezier[i * HDIM], pt );
+
+        for( int k = 0; k < 3; ++k )
+        {
+            if( pt[k] < bMin[k] )
+                bMin[k] = pt[k];
+
+            if( pt[k] > bMax[k] )
+                bMax[k] = pt[k];
+        }
+    }
+
+    aMin.x = bMin[0];
+    aMin.y = bMin[1];
+    aMin.z = bMin[2];
+    aMax.x = bMax[0];
+    aMax.y = bMax[1];
+    aMax.z = bMax[2];
+    return;
+}
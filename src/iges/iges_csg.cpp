@@ -0,0 +1,739 @@
+/*
+ * file: iges_csg.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: compiled form of a Boolean Tree (Entity 180) which
+ * classifies points as inside or outside of the solid.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <error_macros.h>
+#include <core/iges_csg.h>
+#include <core/iges_trim.h>
+#include <core/iges_memory.h>
+#include <core/iges_curve.h>
+#include <core/entity124.h>
+#include <core/entity154.h>
+#include <core/entity164.h>
+#include <core/entity180.h>
+
+// number of points classified together
+#define CSG_BLOCK (256)
+// maximum nesting depth of Boolean Trees
+#define MAX_TREE_DEPTH (64)
+
+
+// compute the inverse of an affine transform as a 3x4 matrix
+static bool invertTransform( const MCAD_TRANSFORM& aTransform, double aInv[3][4] )
+{
+    const double (*m)[3] = aTransform.R.v;
+    double c[3][3];
+
+    c[0][0] = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    c[0][1] = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+    c[0][2] = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+    c[1][0] = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    c[1][1] = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+    c[1][2] = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+    c[2][0] = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    c[2][1] = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+    c[2][2] = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+
+    double det = m[0][0] * c[0][0] + m[0][1] * c[1][0] + m[0][2] * c[2][0];
+
+    if( fabs( det ) < 1e-12 )
+        return false;
+
+    double t[3] = { aTransform.T.x, aTransform.T.y, aTransform.T.z };
+
+    for( int i = 0; i < 3; ++i )
+    {
+        for( int j = 0; j < 3; ++j )
+            aInv[i][j] = c[i][j] / det;
+
+        aInv[i][3] = -( aInv[i][0] * t[0] + aInv[i][1] * t[1] + aInv[i][2] * t[2] );
+    }
+
+    return true;
+}
+
+
+// retrieve the transform of an entity combined with the given transform
+static MCAD_TRANSFORM entityTransform( IGES_ENTITY* aEntity, const MCAD_TRANSFORM& aTransform )
+{
+    IGES_ENTITY_124* tp = NULL;
+
+    if( aEntity->GetTransform( (IGES_ENTITY**)&tp ) && NULL != tp )
+        return aTransform * tp->GetTransformMatrix();
+
+    return aTransform;
+}
+
+
+// compute the model space bounding box of a local bounding box
+static void transformBox( const MCAD_TRANSFORM& aTransform, const double* aMin,
+                          const double* aMax, double* aBMin, double* aBMax )
+{
+    for( int i = 0; i < 8; ++i )
+    {
+        MCAD_POINT p;
+        p.x = ( i & 1 ) ? aMax[0] : aMin[0];
+        p.y = ( i & 2 ) ? aMax[1] : aMin[1];
+        p.z = ( i & 4 ) ? aMax[2] : aMin[2];
+        p = aTransform * p;
+
+        double v[3] = { p.x, p.y, p.z };
+
+        for( int j = 0; j < 3; ++j )
+        {
+            if( 0 == i || v[j] < aBMin[j] )
+                aBMin[j] = v[j];
+
+            if( 0 == i || v[j] > aBMax[j] )
+                aBMax[j] = v[j];
+        }
+    }
+
+    return;
+}
+
+
+static void normalize( double* aVec )
+{
+    double d = sqrt( aVec[0] * aVec[0] + aVec[1] * aVec[1] + aVec[2] * aVec[2] );
+
+    if( d > 0.0 )
+    {
+        aVec[0] /= d;
+        aVec[1] /= d;
+        aVec[2] /= d;
+    }
+
+    return;
+}
+
+
+IGES_CSG_PROGRAM::IGES_CSG_PROGRAM()
+{
+    m_maxDepth = 0;
+    return;
+}
+
+
+IGES_CSG_PROGRAM::~IGES_CSG_PROGRAM()
+{
+    clear();
+    return;
+}
+
+
+void IGES_CSG_PROGRAM::clear( void )
+{
+    for( size_t i = 0; i < m_prims.size(); ++i )
+    {
+        if( NULL != m_prims[i].section )
+            delete m_prims[i].section;
+    }
+
+    m_prims.clear();
+    m_program.clear();
+    m_pruneStart.clear();
+    m_pruneEnd.clear();
+    m_maxDepth = 0;
+    return;
+}
+
+
+bool IGES_CSG_PROGRAM::Compile( IGES_ENTITY_180* aTree, double aTolerance )
+{
+    clear();
+
+    if( NULL == aTree )
+    {
+        ERRMSG << "\n + [BUG] NULL pointer passed for the Boolean Tree\n";
+        return false;
+    }
+
+    MCAD_TRANSFORM T;
+
+    if( !compileTree( aTree, T, aTolerance, 0 ) )
+    {
+        clear();
+        return false;
+    }
+
+    // determine the depth of the evaluation stack
+    int depth = 0;
+
+    for( size_t i = 0; i < m_program.size(); ++i )
+    {
+        if( 0 == m_program[i].code )
+            ++depth;
+        else
+            --depth;
+
+        if( depth > m_maxDepth )
+            m_maxDepth = depth;
+    }
+
+    // list the subtrees starting at each instruction, outermost first
+    int nInst = (int)m_program.size();
+    m_pruneStart.assign( nInst + 1, 0 );
+
+    for( int k = 0; k < nInst; ++k )
+        ++m_pruneStart[m_program[k].start + 1];
+
+    for( int i = 0; i < nInst; ++i )
+        m_pruneStart[i + 1] += m_pruneStart[i];
+
+    std::vector<int> fill( m_pruneStart.begin(), m_pruneStart.end() - 1 );
+    m_pruneEnd.resize( nInst );
+
+    for( int k = nInst - 1; k >= 0; --k )
+        m_pruneEnd[fill[m_program[k].start]++] = k;
+
+    return true;
+}
+
+
+bool IGES_CSG_PROGRAM::compileTree( IGES_ENTITY_180* aTree, const MCAD_TRANSFORM& aTransform,
+                                    double aTolerance, int aLevel )
+{
+    if( aLevel > MAX_TREE_DEPTH )
+    {
+        ERRMSG << "\n + [INFO] Boolean Trees are nested too deeply\n";
+        return false;
+    }
+
+    MCAD_TRANSFORM T = entityTransform( aTree, aTransform );
+
+    // subtree roots of the operands which have not yet been consumed
+    std::vector<int> roots;
+    std::list<BTREE_NODE*>::iterator sN = aTree->nodes.begin();
+    std::list<BTREE_NODE*>::iterator eN = aTree->nodes.end();
+
+    while( sN != eN )
+    {
+        BTREE_NODE* np = *sN;
+        ++sN;
+
+        if( !np->op )
+        {
+            if( NULL == np->pEnt )
+            {
+                ERRMSG << "\n + [INFO] unresolved operand in Boolean Tree\n";
+                return false;
+            }
+
+            if( !compileOperand( np->pEnt, T, aTolerance, aLevel ) )
+                return false;
+
+            roots.push_back( (int)m_program.size() - 1 );
+            continue;
+        }
+
+        if( roots.size() < 2 || np->val < OP_START || np->val >= OP_END )
+        {
+            ERRMSG << "\n + [INFO] invalid Boolean Tree\n";
+            return false;
+        }
+
+        const CSG_INSTRUCTION& right = m_program[roots.back()];
+        roots.pop_back();
+        const CSG_INSTRUCTION& left = m_program[roots.back()];
+        roots.pop_back();
+
+        CSG_INSTRUCTION inst;
+        inst.code = np->val;
+        inst.prim = -1;
+        inst.start = left.start;
+
+        for( int i = 0; i < 3; ++i )
+        {
+            switch( np->val )
+            {
+                case OP_UNION:
+                    inst.bmin[i] = std::min( left.bmin[i], right.bmin[i] );
+                    inst.bmax[i] = std::max( left.bmax[i], right.bmax[i] );
+                    break;
+
+                case OP_INTERSECT:
+                    // an empty intersection yields an empty box which
+                    // never overlaps any points
+                    inst.bmin[i] = std::max( left.bmin[i], right.bmin[i] );
+                    inst.bmax[i] = std::min( left.bmax[i], right.bmax[i] );
+                    break;
+
+                default:
+                    inst.bmin[i] = left.bmin[i];
+                    inst.bmax[i] = left.bmax[i];
+                    break;
+            }
+        }
+
+        m_program.push_back( inst );
+        roots.push_back( (int)m_program.size() - 1 );
+    }
+
+    if( roots.size() != 1 )
+    {
+        ERRMSG << "\n + [INFO] invalid Boolean Tree; " << roots.size() << " operands remain\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+bool IGES_CSG_PROGRAM::compileOperand( IGES_ENTITY* aEntity, const MCAD_TRANSFORM& aTransform,
+                                       double aTolerance, int aLevel )
+{
+    switch( aEntity->GetEntityType() )
+    {
+        case ENT_RIGHT_CIRCULAR_CYLINDER:
+            return addCylinder( aEntity, entityTransform( aEntity, aTransform ) );
+
+        case ENT_SOLID_OF_LINEAR_EXTRUSION:
+            return addExtrusion( aEntity, entityTransform( aEntity, aTransform ), aTolerance );
+
+        case ENT_BOOLEAN_TREE:
+            return compileTree( (IGES_ENTITY_180*)aEntity, aTransform, aTolerance, aLevel + 1 );
+
+        default:
+            break;
+    }
+
+    ERRMSG << "\n + [INFO] unsupported operand type in Boolean Tree: "
+           << aEntity->GetEntityType() << "\n";
+    return false;
+}
+
+
+bool IGES_CSG_PROGRAM::addCylinder( IGES_ENTITY* aEntity, const MCAD_TRANSFORM& aTransform )
+{
+    IGES_ENTITY_154* cp = (IGES_ENTITY_154*)aEntity;
+    double A[3] = { cp->I1, cp->J1, cp->K1 };
+    double C[3] = { cp->X1, cp->Y1, cp->Z1 };
+    double inv[3][4];
+
+    normalize( A );
+
+    if( cp->H <= 0.0 || cp->R <= 0.0 || ( A[0] == 0.0 && A[1] == 0.0 && A[2] == 0.0 ) )
+    {
+        ERRMSG << "\n + [INFO] invalid cylinder parameters\n";
+        return false;
+    }
+
+    if( !invertTransform( aTransform, inv ) )
+    {
+        ERRMSG << "\n + [INFO] singular transform on cylinder\n";
+        return false;
+    }
+
+    // w = local point - C; h = A.w; r = (I - A A^T) w
+    double W[3][4];
+
+    for( int i = 0; i < 3; ++i )
+    {
+        for( int j = 0; j < 4; ++j )
+            W[i][j] = inv[i][j];
+
+        W[i][3] -= C[i];
+    }
+
+    CSG_PRIMITIVE prim;
+    prim.type = ENT_RIGHT_CIRCULAR_CYLINDER;
+    prim.limit = cp->H;
+    prim.radius2 = cp->R * cp->R;
+    prim.section = NULL;
+
+    for( int j = 0; j < 4; ++j )
+    {
+        prim.rows[0][j] = A[0] * W[0][j] + A[1] * W[1][j] + A[2] * W[2][j];
+
+        for( int i = 0; i < 3; ++i )
+            prim.rows[i + 1][j] = W[i][j] - A[i] * prim.rows[0][j];
+    }
+
+    // bounding box of the end faces in local coordinates
+    CSG_INSTRUCTION inst;
+    double lmin[3];
+    double lmax[3];
+
+    for( int i = 0; i < 3; ++i )
+    {
+        double e = cp->R * sqrt( std::max( 0.0, 1.0 - A[i] * A[i] ) );
+        double c1 = C[i] + cp->H * A[i];
+        lmin[i] = std::min( C[i], c1 ) - e;
+        lmax[i] = std::max( C[i], c1 ) + e;
+    }
+
+    transformBox( aTransform, lmin, lmax, inst.bmin, inst.bmax );
+    inst.code = 0;
+    inst.prim = (int)m_prims.size();
+    inst.start = (int)m_program.size();
+    m_prims.push_back( prim );
+    m_program.push_back( inst );
+    return true;
+}
+
+
+bool IGES_CSG_PROGRAM::addExtrusion( IGES_ENTITY* aEntity, const MCAD_TRANSFORM& aTransform,
+                                     double aTolerance )
+{
+    IGES_ENTITY_164* ep = (IGES_ENTITY_164*)aEntity;
+    IGES_CURVE* curve = NULL;
+    double D[3] = { ep->I1, ep->J1, ep->K1 };
+    double inv[3][4];
+
+    normalize( D );
+
+    if( !ep->GetClosedCurve( &curve ) || ep->L <= 0.0
+        || ( D[0] == 0.0 && D[1] == 0.0 && D[2] == 0.0 ) )
+    {
+        ERRMSG << "\n + [INFO] invalid extrusion parameters\n";
+        return false;
+    }
+
+    if( !invertTransform( aTransform, inv ) )
+    {
+        ERRMSG << "\n + [INFO] singular transform on extrusion\n";
+        return false;
+    }
+
+    // flatten the curve coarsely to determine its size and then
+    // with a tolerance relative to that size
+    std::vector<MCAD_POINT> pts;
+    double lmin[3];
+    double lmax[3];
+
+    for( int pass = 0; pass < 2; ++pass )
+    {
+        double tol = aTolerance;
+
+        if( 0 == pass )
+        {
+            tol = aTolerance * 1e4;
+        }
+        else
+        {
+            double size = std::max( lmax[0] - lmin[0],
+                std::max( lmax[1] - lmin[1], lmax[2] - lmin[2] ) );
+            tol = std::max( aTolerance, 1e-6 * size );
+        }
+
+        pts.clear();
+
+        if( !curve->GetPolyline( tol, pts, true ) || pts.size() < 3 )
+        {
+            ERRMSG << "\n + [INFO] could not flatten the extrusion curve\n";
+            return false;
+        }
+
+        lmin[0] = lmax[0] = pts[0].x;
+        lmin[1] = lmax[1] = pts[0].y;
+        lmin[2] = lmax[2] = pts[0].z;
+
+        for( size_t i = 1; i < pts.size(); ++i )
+        {
+            double v[3] = { pts[i].x, pts[i].y, pts[i].z };
+
+            for( int j = 0; j < 3; ++j )
+            {
+                lmin[j] = std::min( lmin[j], v[j] );
+                lmax[j] = std::max( lmax[j], v[j] );
+            }
+        }
+    }
+
+    // plane of the curve (Newell's method)
+    double N[3] = { 0.0, 0.0, 0.0 };
+    size_t np = pts.size();
+
+    for( size_t i = 0; i < np; ++i )
+    {
+        const MCAD_POINT& p0 = pts[i];
+        const MCAD_POINT& p1 = pts[( i + 1 ) % np];
+        N[0] += ( p0.y - p1.y ) * ( p0.z + p1.z );
+        N[1] += ( p0.z - p1.z ) * ( p0.x + p1.x );
+        N[2] += ( p0.x - p1.x ) * ( p0.y + p1.y );
+    }
+
+    normalize( N );
+    double dn = N[0] * D[0] + N[1] * D[1] + N[2] * D[2];
+
+    if( fabs( dn ) < 1e-9 )
+    {
+        ERRMSG << "\n + [INFO] extrusion direction lies in the plane of the curve\n";
+        return false;
+    }
+
+    // in-plane axes
+    double E1[3];
+    double E2[3];
+
+    if( fabs( N[0] ) < 0.9 )
+    {
+        E1[0] = 0.0;
+        E1[1] = N[2];
+        E1[2] = -N[1];
+    }
+    else
+    {
+        E1[0] = -N[2];
+        E1[1] = 0.0;
+        E1[2] = N[0];
+    }
+
+    normalize( E1 );
+    E2[0] = N[1] * E1[2] - N[2] * E1[1];
+    E2[1] = N[2] * E1[0] - N[0] * E1[2];
+    E2[2] = N[0] * E1[1] - N[1] * E1[0];
+
+    double O[3] = { pts[0].x, pts[0].y, pts[0].z };
+    std::vector< std::vector<MCAD_POINT> > loops( 1 );
+    loops[0].resize( np );
+
+    for( size_t i = 0; i < np; ++i )
+    {
+        double g[3] = { pts[i].x - O[0], pts[i].y - O[1], pts[i].z - O[2] };
+        loops[0][i].x = E1[0] * g[0] + E1[1] * g[1] + E1[2] * g[2];
+        loops[0][i].y = E2[0] * g[0] + E2[1] * g[1] + E2[2] * g[2];
+        loops[0][i].z = 0.0;
+    }
+
+    CSG_PRIMITIVE prim;
+    prim.type = ENT_SOLID_OF_LINEAR_EXTRUSION;
+    prim.limit = ep->L;
+    prim.radius2 = 0.0;
+    prim.section = new IGES_TRIM_INDEX;
+
+    if( !prim.section->Build( loops, true ) )
+    {
+        ERRMSG << "\n + [INFO] could not index the extrusion curve\n";
+        delete prim.section;
+        return false;
+    }
+
+    // g = local point - O; t = N.g / (N.D); u = E1.(g - t D); v = E2.(g - t D)
+    double G[3][4];
+
+    for( int i = 0; i < 3; ++i )
+    {
+        for( int j = 0; j < 4; ++j )
+            G[i][j] = inv[i][j];
+
+        G[i][3] -= O[i];
+    }
+
+    double e1d = E1[0] * D[0] + E1[1] * D[1] + E1[2] * D[2];
+    double e2d = E2[0] * D[0] + E2[1] * D[1] + E2[2] * D[2];
+
+    for( int j = 0; j < 4; ++j )
+    {
+        prim.rows[0][j] = ( N[0] * G[0][j] + N[1] * G[1][j] + N[2] * G[2][j] ) / dn;
+        prim.rows[1][j] = E1[0] * G[0][j] + E1[1] * G[1][j] + E1[2] * G[2][j]
+                          - e1d * prim.rows[0][j];
+        prim.rows[2][j] = E2[0] * G[0][j] + E2[1] * G[1][j] + E2[2] * G[2][j]
+                          - e2d * prim.rows[0][j];
+        prim.rows[3][j] = 0.0;
+    }
+
+    // the solid lies between the curve and its copy displaced by L * D
+    CSG_INSTRUCTION inst;
+
+    for( int i = 0; i < 3; ++i )
+    {
+        double dl = ep->L * D[i];
+        lmin[i] = std::min( lmin[i], lmin[i] + dl );
+        lmax[i] = std::max( lmax[i], lmax[i] + dl );
+    }
+
+    transformBox( aTransform, lmin, lmax, inst.bmin, inst.bmax );
+    inst.code = 0;
+    inst.prim = (int)m_prims.size();
+    inst.start = (int)m_program.size();
+    m_prims.push_back( prim );
+    m_program.push_back( inst );
+    return true;
+}
+
+
+void IGES_CSG_PROGRAM::evalPrimitive( const CSG_PRIMITIVE& aPrim, int aNPoints,
+    const double* aX, const double* aY, const double* aZ, char* aResult ) const
+{
+    const double (*r)[4] = aPrim.rows;
+    double lim = aPrim.limit;
+
+    if( ENT_RIGHT_CIRCULAR_CYLINDER == aPrim.type )
+    {
+        double rr = aPrim.radius2;
+
+        for( int i = 0; i < aNPoints; ++i )
+        {
+            double h = r[0][0] * aX[i] + r[0][1] * aY[i] + r[0][2] * aZ[i] + r[0][3];
+            double rx = r[1][0] * aX[i] + r[1][1] * aY[i] + r[1][2] * aZ[i] + r[1][3];
+            double ry = r[2][0] * aX[i] + r[2][1] * aY[i] + r[2][2] * aZ[i] + r[2][3];
+            double rz = r[3][0] * aX[i] + r[3][1] * aY[i] + r[3][2] * aZ[i] + r[3][3];
+
+            aResult[i] = ( h >= 0.0 ) & ( h <= lim ) & ( rx * rx + ry * ry + rz * rz <= rr );
+        }
+
+        return;
+    }
+
+    for( int i = 0; i < aNPoints; ++i )
+    {
+        double t = r[0][0] * aX[i] + r[0][1] * aY[i] + r[0][2] * aZ[i] + r[0][3];
+
+        if( t < 0.0 || t > lim )
+        {
+            aResult[i] = 0;
+            continue;
+        }
+
+        double u = r[1][0] * aX[i] + r[1][1] * aY[i] + r[1][2] * aZ[i] + r[1][3];
+        double v = r[2][0] * aX[i] + r[2][1] * aY[i] + r[2][2] * aZ[i] + r[2][3];
+        aResult[i] = aPrim.section->IsInside( u, v );
+    }
+
+    return;
+}
+
+
+void IGES_CSG_PROGRAM::Classify( int aNPoints, const MCAD_POINT* aPoints, bool* aResult ) const
+{
+    double xs[CSG_BLOCK];
+    double ys[CSG_BLOCK];
+    double zs[CSG_BLOCK];
+    std::vector<char> stack( m_maxDepth * CSG_BLOCK );
+    int nInst = (int)m_program.size();
+
+    for( int b0 = 0; b0 < aNPoints; b0 += CSG_BLOCK )
+    {
+        int nb = std::min( CSG_BLOCK, aNPoints - b0 );
+        double bmin[3];
+        double bmax[3];
+
+        for( int i = 0; i < nb; ++i )
+        {
+            xs[i] = aPoints[b0 + i].x;
+            ys[i] = aPoints[b0 + i].y;
+            zs[i] = aPoints[b0 + i].z;
+        }
+
+        bmin[0] = *std::min_element( xs, xs + nb );
+        bmax[0] = *std::max_element( xs, xs + nb );
+        bmin[1] = *std::min_element( ys, ys + nb );
+        bmax[1] = *std::max_element( ys, ys + nb );
+        bmin[2] = *std::min_element( zs, zs + nb );
+        bmax[2] = *std::max_element( zs, zs + nb );
+
+        int sp = 0;
+        int pc = 0;
+
+        while( pc < nInst )
+        {
+            // skip a subtree whose bounding box misses the block
+            bool skip = false;
+
+            for( int k = m_pruneStart[pc]; k < m_pruneStart[pc + 1]; ++k )
+            {
+                const CSG_INSTRUCTION& st = m_program[m_pruneEnd[k]];
+
+                if( st.bmin[0] > bmax[0] || st.bmax[0] < bmin[0]
+                    || st.bmin[1] > bmax[1] || st.bmax[1] < bmin[1]
+                    || st.bmin[2] > bmax[2] || st.bmax[2] < bmin[2] )
+                {
+                    memset( &stack[sp * CSG_BLOCK], 0, nb );
+                    ++sp;
+                    pc = m_pruneEnd[k] + 1;
+                    skip = true;
+                    break;
+                }
+            }
+
+            if( skip )
+                continue;
+
+            const CSG_INSTRUCTION& inst = m_program[pc];
+            ++pc;
+
+            if( 0 == inst.code )
+            {
+                evalPrimitive( m_prims[inst.prim], nb, xs, ys, zs, &stack[sp * CSG_BLOCK] );
+                ++sp;
+                continue;
+            }
+
+            --sp;
+            char* a = &stack[( sp - 1 ) * CSG_BLOCK];
+            const char* b = &stack[sp * CSG_BLOCK];
+
+            switch( inst.code )
+            {
+                case OP_UNION:
+
+                    for( int i = 0; i < nb; ++i )
+                        a[i] |= b[i];
+
+                    break;
+
+                case OP_INTERSECT:
+
+                    for( int i = 0; i < nb; ++i )
+                        a[i] &= b[i];
+
+                    break;
+
+                default:
+
+                    for( int i = 0; i < nb; ++i )
+                        a[i] &= b[i] ^ 1;
+
+                    break;
+            }
+        }
+
+        for( int i = 0; i < nb; ++i )
+            aResult[b0 + i] = ( 0 != stack[i] );
+    }
+
+    return;
+}
+
+
+size_t IGES_CSG_PROGRAM::GetMemoryUsage( void ) const
+{
+    size_t nb = sizeof( *this ) + HeapSize( m_prims ) + HeapSize( m_program )
+                + HeapSize( m_pruneStart ) + HeapSize( m_pruneEnd );
+
+    for( size_t i = 0; i < m_prims.size(); ++i )
+    {
+        if( m_prims[i].section )
+            nb += m_prims[i].section->GetMemoryUsage();
+    }
+
+    return nb;
+}
@@ -0,0 +1,190 @@
+/*
+ * file: iges_detable.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: compact table of the Directory Entry attributes of
+ * all entities within an IGES object.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <cstring>
+#include <core/iges_detable.h>
+#include <core/iges_entity.h>
+#include <core/iges_memory.h>
+
+
+IGES_DE_TABLE::IGES_DE_TABLE()
+{
+    m_valid = false;
+    return;
+}
+
+
+void IGES_DE_TABLE::Build( const std::vector<IGES_ENTITY*>& aEntities )
+{
+    size_t n = aEntities.size();
+
+    m_entity.assign( aEntities.begin(), aEntities.end() );
+    m_type.resize( n );
+    m_form.resize( n );
+    m_level.resize( n );
+    m_color.resize( n );
+    m_lineFont.resize( n );
+    m_lineWeight.resize( n );
+    m_status.resize( n );
+    m_subscript.resize( n );
+    m_nRefs.resize( n );
+    m_label.resize( n * IGES_DE_LABEL_SIZE );
+
+    for( size_t i = 0; i < n; ++i )
+    {
+        aEntities[i]->deRow = (int)i;
+        setRow( i, aEntities[i] );
+    }
+
+    m_valid = true;
+    return;
+}
+
+
+void IGES_DE_TABLE::Update( IGES_ENTITY* aEntity )
+{
+    if( !m_valid || NULL == aEntity || aEntity->deRow < 0 )
+        return;
+
+    size_t row = (size_t)aEntity->deRow;
+
+    // the row number may be left over from another IGES object's table
+    if( row >= m_entity.size() || m_entity[row] != aEntity )
+        return;
+
+    setRow( row, aEntity );
+    return;
+}
+
+
+void IGES_DE_TABLE::setRow( size_t aRow, IGES_ENTITY* aEntity )
+{
+    m_type[aRow] = aEntity->entityType;
+    m_form[aRow] = aEntity->form;
+    m_level[aRow] = aEntity->pLevel ? -1 : aEntity->level;
+    m_color[aRow] = aEntity->pColor ? -1 : aEntity->colorNum;
+    m_lineFont[aRow] = aEntity->pLineFontPattern ? -1 : aEntity->lineFontPattern;
+    m_lineWeight[aRow] = aEntity->lineWeightNum;
+    m_subscript[aRow] = aEntity->entitySubscript;
+    m_nRefs[aRow] = (int)aEntity->refs.size();
+
+    unsigned char stat = aEntity->visible ? 0 : IGES_DE_STAT_BLANK;
+    stat |= (unsigned char)( ( aEntity->depends & 0x03 ) << 1 );
+    stat |= (unsigned char)( ( aEntity->use & 0x07 ) << 3 );
+    stat |= (unsigned char)( ( aEntity->hierarchy & 0x03 ) << 6 );
+    m_status[aRow] = stat;
+
+    char* lp = &m_label[aRow * IGES_DE_LABEL_SIZE];
+    size_t nc = aEntity->label.size();
+
+    if( nc >= IGES_DE_LABEL_SIZE )
+        nc = IGES_DE_LABEL_SIZE - 1;
+
+    memcpy( lp, aEntity->label.data(), nc );
+    memset( lp + nc, 0, IGES_DE_LABEL_SIZE - nc );
+
+    return;
+}
+
+
+size_t IGES_DE_TABLE::select( const std::vector<int>& aColumn, int aValue,
+                              std::vector<IGES_ENTITY*>& aList ) const
+{
+    size_t n = aColumn.size();
+    size_t nAdded = 0;
+
+    for( size_t i = 0; i < n; ++i )
+    {
+        if( aColumn[i] == aValue )
+        {
+            aList.push_back( m_entity[i] );
+            ++nAdded;
+        }
+    }
+
+    return nAdded;
+}
+
+
+size_t IGES_DE_TABLE::SelectType( int aType, int aForm, std::vector<IGES_ENTITY*>& aList ) const
+{
+    if( aForm < 0 )
+        return select( m_type, aType, aList );
+
+    size_t n = m_type.size();
+    size_t nAdded = 0;
+
+    for( size_t i = 0; i < n; ++i )
+    {
+        if( m_type[i] == aType && m_form[i] == aForm )
+        {
+            aList.push_back( m_entity[i] );
+            ++nAdded;
+        }
+    }
+
+    return nAdded;
+}
+
+
+size_t IGES_DE_TABLE::SelectLevel( int aLevel, std::vector<IGES_ENTITY*>& aList ) const
+{
+    return select( m_level, aLevel, aList );
+}
+
+
+size_t IGES_DE_TABLE::SelectColor( int aColor, std::vector<IGES_ENTITY*>& aList ) const
+{
+    return select( m_color, aColor, aList );
+}
+
+
+size_t IGES_DE_TABLE::SelectUnreferenced( std::vector<IGES_ENTITY*>& aList ) const
+{
+    size_t n = m_nRefs.size();
+    size_t nAdded = 0;
+
+    for( size_t i = 0; i < n; ++i )
+    {
+        if( 0 == m_nRefs[i] && STAT_INDEPENDENT == IGES_DE_STAT_DEPENDS( m_status[i] ) )
+        {
+            aList.push_back( m_entity[i] );
+            ++nAdded;
+        }
+    }
+
+    return nAdded;
+}
+
+
+size_t IGES_DE_TABLE::GetMemoryUsage( void ) const
+{
+    return sizeof( *this ) + HeapSize( m_entity ) + HeapSize( m_type ) + HeapSize( m_form )
+           + HeapSize( m_level ) + HeapSize( m_color ) + HeapSize( m_lineFont )
+           + HeapSize( m_lineWeight ) + HeapSize( m_status ) + HeapSize( m_subscript )
+           + HeapSize( m_nRefs ) + HeapSize( m_label );
+}
@@ -0,0 +1,295 @@
+/*
+ * file: iges_names.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: index of the names of the Subfigure Definitions
+ * and Name Properties within an IGES object.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <core/iges_names.h>
+#include <core/iges_memory.h>
+#include <core/entity308.h>
+#include <core/entity406.h>
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+struct tm *gmtime_r(time_t const *timep, struct tm *tmp);
+#endif
+
+typedef std::unordered_multimap< std::string, IGES_ENTITY* >::iterator NAME_ITER;
+
+
+IGES_NAME_INDEX::IGES_NAME_INDEX( const std::vector<IGES_ENTITY*>* aEntities )
+{
+    m_entities = aEntities;
+    m_valid = false;
+    m_partNum = 1;
+    m_assyNum = 1;
+    return;
+}
+
+
+bool IGES_NAME_INDEX::getName( IGES_ENTITY* aEntity, const std::string*& aName )
+{
+    aName = NULL;
+
+    if( NULL == aEntity )
+        return false;
+
+    int eType = aEntity->GetEntityType();
+
+    if( ENT_SUBFIGURE_DEFINITION == eType )
+        aName = &((IGES_ENTITY_308*)aEntity)->GetName();
+    else if( ENT_PROPERTY == eType && 15 == aEntity->GetEntityForm() )
+        aName = (const std::string*)((IGES_ENTITY_406*)aEntity)->GetData();
+
+    return NULL != aName && !aName->empty();
+}
+
+
+void IGES_NAME_INDEX::build( void )
+{
+    if( m_valid )
+        return;
+
+    m_names.clear();
+
+    size_t nEnt = m_entities->size();
+    const std::string* np;
+
+    for( size_t i = 0; i < nEnt; ++i )
+    {
+        if( getName( (*m_entities)[i], np ) )
+            m_names.insert( std::make_pair( *np, (*m_entities)[i] ) );
+    }
+
+    m_valid = true;
+    return;
+}
+
+
+void IGES_NAME_INDEX::erase( const std::string& aName, IGES_ENTITY* aEntity )
+{
+    std::pair< NAME_ITER, NAME_ITER > range = m_names.equal_range( aName );
+
+    while( range.first != range.second )
+    {
+        if( range.first->second == aEntity )
+        {
+            m_names.erase( range.first );
+            return;
+        }
+
+        ++range.first;
+    }
+
+    return;
+}
+
+
+bool IGES_NAME_INDEX::inUse( const std::string& aName )
+{
+    build();
+    return m_names.find( aName ) != m_names.end();
+}
+
+
+bool IGES_NAME_INDEX::isTaken( const std::string& aName )
+{
+    return m_reserved.find( aName ) != m_reserved.end() || inUse( aName );
+}
+
+
+void IGES_NAME_INDEX::Invalidate( void )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_valid = false;
+    m_names.clear();
+    return;
+}
+
+
+void IGES_NAME_INDEX::Add( IGES_ENTITY* aEntity )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    const std::string* np;
+
+    if( !getName( aEntity, np ) )
+        return;
+
+    m_reserved.erase( *np );
+
+    if( m_valid )
+        m_names.insert( std::make_pair( *np, aEntity ) );
+
+    return;
+}
+
+
+void IGES_NAME_INDEX::Remove( IGES_ENTITY* aEntity )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    const std::string* np;
+
+    if( m_valid && getName( aEntity, np ) )
+        erase( *np, aEntity );
+
+    return;
+}
+
+
+void IGES_NAME_INDEX::Rename( IGES_ENTITY* aEntity, std::string& aField,
+                              const std::string& aNewName )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    if( m_valid && !aField.empty() )
+        erase( aField, aEntity );
+
+    aField = aNewName;
+
+    if( aNewName.empty() )
+        return;
+
+    m_reserved.erase( aNewName );
+
+    if( m_valid )
+        m_names.insert( std::make_pair( aNewName, aEntity ) );
+
+    return;
+}
+
+
+size_t IGES_NAME_INDEX::Find( const std::string& aName, std::vector<IGES_ENTITY*>& aList )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    build();
+
+    std::pair< NAME_ITER, NAME_ITER > range = m_names.equal_range( aName );
+    size_t nAdded = 0;
+
+    while( range.first != range.second )
+    {
+        aList.push_back( range.first->second );
+        ++nAdded;
+        ++range.first;
+    }
+
+    return nAdded;
+}
+
+
+bool IGES_NAME_INDEX::IsUsed( const std::string& aName )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return inUse( aName );
+}
+
+
+void IGES_NAME_INDEX::MakeUnique( std::string& aName )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    if( isTaken( aName ) )
+    {
+        std::string base = aName;
+        std::ostringstream ostr;
+        int n = 1;
+
+        do
+        {
+            ostr.str( "" );
+            ostr << base << "-" << n++;
+            aName = ostr.str();
+        } while( isTaken( aName ) );
+    }
+
+    if( !aName.empty() )
+        m_reserved.insert( aName );
+
+    return;
+}
+
+
+void IGES_NAME_INDEX::NewName( bool aAssembly, std::string& aName )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    const char* prefix = aAssembly ? "assy" : "part";
+    int* idx = aAssembly ? &m_assyNum : &m_partNum;
+
+    time_t now;
+    time( &now );
+    struct tm date;
+    gmtime_r( &now, &date );
+
+    // to reduce likelihood of name clashes with other models, use
+    // prefixYYYYDDDHHMMSSnnnn; the index is never reused within a model
+    std::ostringstream ostr;
+
+    do
+    {
+        ostr.str( "" );
+        ostr << prefix << std::setw(4) << std::setfill('0') << (date.tm_year + 1900);
+        ostr << std::setw(3) << (date.tm_yday + 1) << std::setw(2) << date.tm_hour;
+        ostr << std::setw(2) << date.tm_min << std::setw(2) << date.tm_sec;
+        ostr << std::setw(4) << (*idx)++;
+        aName = ostr.str();
+    } while( isTaken( aName ) );
+
+    m_reserved.insert( aName );
+    return;
+}
+
+
+size_t IGES_NAME_INDEX::GetMemoryUsage( void ) const
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    // each node holds the key, the value and a link
+    size_t nb = sizeof( *this ) + m_names.bucket_count() * sizeof( void* )
+                + m_names.size() * ( sizeof( std::string ) + 2 * sizeof( void* ) );
+
+    std::unordered_multimap< std::string, IGES_ENTITY* >::const_iterator sN = m_names.begin();
+    std::unordered_multimap< std::string, IGES_ENTITY* >::const_iterator eN = m_names.end();
+
+    while( sN != eN )
+    {
+        nb += HeapSize( sN->first );
+        ++sN;
+    }
+
+    nb += m_reserved.bucket_count() * sizeof( void* )
+          + m_reserved.size() * ( sizeof( std::string ) + sizeof( void* ) );
+
+    std::unordered_set< std::string >::const_iterator sR = m_reserved.begin();
+    std::unordered_set< std::string >::const_iterator eR = m_reserved.end();
+
+    while( sR != eR )
+    {
+        nb += HeapSize( *sR );
+        ++sR;
+    }
+
+    return nb;
+}
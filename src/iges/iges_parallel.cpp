@@ -0,0 +1,168 @@
+/*
+ * file: iges_parallel.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: internal helpers for distributing independent work
+ * items among a set of worker threads.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <error_macros.h>
+#include <core/iges_parallel.h>
+
+
+// guards the on-demand DLL lists and validation flags of all models
+static std::mutex cacheMutex;
+
+
+// state shared by all workers of a single RunParallelJob() invocation
+struct PARALLEL_STATE
+{
+    IGES_PARALLEL_JOB*  job;
+    size_t              nItems;
+    size_t              chunk;
+    std::atomic<size_t> next;       // first item of the next unclaimed range
+    std::atomic<bool>   failed;     // set when any range fails
+};
+
+
+static void runWorker( PARALLEL_STATE* aState )
+{
+    size_t first;
+    size_t last;
+
+    while( !aState->failed.load() )
+    {
+        first = aState->next.fetch_add( aState->chunk );
+
+        if( first >= aState->nItems )
+            break;
+
+        last = first + aState->chunk;
+
+        if( last > aState->nItems )
+            last = aState->nItems;
+
+        bool ok = false;
+
+        try
+        {
+            ok = aState->job->Process( first, last );
+        }
+        catch( ... )
+        {
+            ERRMSG << "\n + [ERROR] exception while processing items ";
+            std::cerr << first << " .. " << (last - 1) << "\n";
+            ok = false;
+        }
+
+        if( !ok )
+            aState->failed.store( true );
+    }
+
+    return;
+}
+
+
+int GetNWorkerThreads( int aRequested )
+{
+    if( aRequested > 0 )
+        return aRequested;
+
+    int nHW = (int)std::thread::hardware_concurrency();
+
+    if( nHW < 1 )
+        nHW = 1;
+
+    return nHW;
+}
+
+
+bool RunParallelJob( IGES_PARALLEL_JOB& aJob, size_t aNItems, int aNThreads,
+                     size_t aMinChunk )
+{
+    if( 0 == aNItems )
+        return true;
+
+    if( aMinChunk < 1 )
+        aMinChunk = 1;
+
+    size_t nThreads = (size_t)GetNWorkerThreads( aNThreads );
+
+    // no point in starting threads which would have nothing to do
+    if( nThreads > aNItems / aMinChunk )
+        nThreads = aNItems / aMinChunk;
+
+    if( nThreads < 2 )
+        return aJob.Process( 0, aNItems );
+
+    // hand out ranges small enough to balance uneven item costs
+    // but large enough to keep the shared counter uncontended
+    size_t chunk = aNItems / ( nThreads * 8 );
+
+    if( chunk < aMinChunk )
+        chunk = aMinChunk;
+
+    PARALLEL_STATE state;
+    state.job = &aJob;
+    state.nItems = aNItems;
+    state.chunk = chunk;
+    state.next.store( 0 );
+    state.failed.store( false );
+
+    std::vector< std::thread > workers;
+
+    try
+    {
+        for( size_t i = 1; i < nThreads; ++i )
+            workers.push_back( std::thread( runWorker, &state ) );
+    }
+    catch( ... )
+    {
+        // unable to start more threads; carry on with what we have
+        ERRMSG << "\n + [WARNING] could not start all worker threads\n";
+    }
+
+    runWorker( &state );
+
+    for( size_t i = 0; i < workers.size(); ++i )
+        workers[i].join();
+
+    return !state.failed.load();
+}
+
+
+IGES_CACHE_LOCK::IGES_CACHE_LOCK()
+{
+    cacheMutex.lock();
+    return;
+}
+
+
+IGES_CACHE_LOCK::~IGES_CACHE_LOCK()
+{
+    cacheMutex.unlock();
+    return;
+}
@@ -0,0 +1,329 @@
+/*
+ * file: iges_trim.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: index of the parameter space boundaries of a
+ * Trimmed Parametric Surface (Entity 144) which classifies points
+ * as inside or outside of the trimmed region.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <error_macros.h>
+#include <core/iges_trim.h>
+#include <core/iges_memory.h>
+
+// maximum number of cells along each axis of the grid
+#define MAX_CELLS (1024)
+// fraction of a cell by which edges are extended when assigned to cells
+#define CELL_SLACK (1e-6)
+
+
+// returns true if the point (aX, aY) lies strictly to the left of the
+// directed line (aX0, aY0) -> (aX1, aY1). Points on the line are treated
+// as being on the right; since every edge sharing a vertex makes the same
+// decision the parity of crossings remains consistent.
+static inline bool leftOf( double aX0, double aY0, double aX1, double aY1,
+                           double aX, double aY )
+{
+    return ( aX1 - aX0 ) * ( aY - aY0 ) - ( aY1 - aY0 ) * ( aX - aX0 ) > 0.0;
+}
+
+
+// returns true if the segment intersects the box [aX0, aX1] x [aY0, aY1]
+static bool segmentInBox( const double* aSeg, double aX0, double aY0,
+                          double aX1, double aY1 )
+{
+    // the bounding boxes are known to overlap; the segment misses the
+    // box only if all corners lie strictly on one side of its line
+    double dx = aSeg[2] - aSeg[0];
+    double dy = aSeg[3] - aSeg[1];
+    double c[4];
+
+    c[0] = dx * ( aY0 - aSeg[1] ) - dy * ( aX0 - aSeg[0] );
+    c[1] = dx * ( aY0 - aSeg[1] ) - dy * ( aX1 - aSeg[0] );
+    c[2] = dx * ( aY1 - aSeg[1] ) - dy * ( aX0 - aSeg[0] );
+    c[3] = dx * ( aY1 - aSeg[1] ) - dy * ( aX1 - aSeg[0] );
+
+    if( c[0] > 0.0 && c[1] > 0.0 && c[2] > 0.0 && c[3] > 0.0 )
+        return false;
+
+    if( c[0] < 0.0 && c[1] < 0.0 && c[2] < 0.0 && c[3] < 0.0 )
+        return false;
+
+    return true;
+}
+
+
+IGES_TRIM_INDEX::IGES_TRIM_INDEX()
+{
+    m_invert = false;
+    m_nx = 0;
+    m_ny = 0;
+    m_x0 = 0.0;
+    m_y0 = 0.0;
+    m_dx = 1.0;
+    m_dy = 1.0;
+    return;
+}
+
+
+bool IGES_TRIM_INDEX::Build( const std::vector< std::vector<MCAD_POINT> >& aLoops,
+                             bool aHasOuter )
+{
+    m_invert = !aHasOuter;
+    m_nx = 0;
+    m_ny = 0;
+    m_edges.clear();
+    m_cellStart.clear();
+    m_cellEdges.clear();
+    m_cellInside.clear();
+
+    for( size_t i = 0; i < aLoops.size(); ++i )
+    {
+        const std::vector<MCAD_POINT>& loop = aLoops[i];
+        size_t np = loop.size();
+
+        if( np < 3 )
+        {
+            ERRMSG << "\n + [INFO] boundary has too few points (" << np << ")\n";
+            return false;
+        }
+
+        for( size_t j = 0; j < np; ++j )
+        {
+            const MCAD_POINT& p0 = loop[j];
+            const MCAD_POINT& p1 = loop[( j + 1 ) % np];
+
+            if( p0.x == p1.x && p0.y == p1.y )
+                continue;
+
+            m_edges.push_back( p0.x );
+            m_edges.push_back( p0.y );
+            m_edges.push_back( p1.x );
+            m_edges.push_back( p1.y );
+        }
+    }
+
+    int nEdges = (int)( m_edges.size() / 4 );
+
+    if( 0 == nEdges )
+    {
+        if( aHasOuter )
+        {
+            ERRMSG << "\n + [INFO] no boundary edges\n";
+            return false;
+        }
+
+        // untrimmed surface; all points are inside
+        return true;
+    }
+
+    double xMin = m_edges[0];
+    double xMax = m_edges[0];
+    double yMin = m_edges[1];
+    double yMax = m_edges[1];
+
+    for( size_t i = 0; i < m_edges.size(); i += 2 )
+    {
+        xMin = std::min( xMin, m_edges[i] );
+        xMax = std::max( xMax, m_edges[i] );
+        yMin = std::min( yMin, m_edges[i + 1] );
+        yMax = std::max( yMax, m_edges[i + 1] );
+    }
+
+    // pad the grid slightly so that points on the boundary fall within it
+    double w = xMax - xMin;
+    double h = yMax - yMin;
+    double pad = 1e-9 * std::max( w, h );
+
+    if( pad <= 0.0 )
+        pad = 1e-9;
+
+    xMin -= pad;
+    yMin -= pad;
+    w += 2.0 * pad;
+    h += 2.0 * pad;
+
+    // aim for roughly one edge per cell with cells of similar shape
+    double nx = sqrt( nEdges * w / h );
+    double ny = sqrt( nEdges * h / w );
+
+    m_nx = std::max( 1, std::min( MAX_CELLS, (int)ceil( nx ) ) );
+    m_ny = std::max( 1, std::min( MAX_CELLS, (int)ceil( ny ) ) );
+    m_x0 = xMin;
+    m_y0 = yMin;
+    m_dx = w / m_nx;
+    m_dy = h / m_ny;
+
+    // list the edges within each cell; the first pass counts them
+    int nCells = m_nx * m_ny;
+    m_cellStart.assign( nCells + 1, 0 );
+
+    for( int pass = 0; pass < 2; ++pass )
+    {
+        std::vector<int> fill;
+
+        if( 1 == pass )
+        {
+            for( int i = 0; i < nCells; ++i )
+                m_cellStart[i + 1] += m_cellStart[i];
+
+            m_cellEdges.resize( m_cellStart[nCells] );
+            fill.assign( m_cellStart.begin(), m_cellStart.end() - 1 );
+        }
+
+        for( int e = 0; e < nEdges; ++e )
+        {
+            const double* seg = &m_edges[e * 4];
+            // the cell range is widened slightly since an edge listed in
+            // an extra cell costs little while a missing edge is an error
+            int i0 = (int)floor( ( std::min( seg[0], seg[2] ) - m_x0 ) / m_dx - CELL_SLACK );
+            int i1 = (int)( ( std::max( seg[0], seg[2] ) - m_x0 ) / m_dx + CELL_SLACK );
+            int j0 = (int)floor( ( std::min( seg[1], seg[3] ) - m_y0 ) / m_dy - CELL_SLACK );
+            int j1 = (int)( ( std::max( seg[1], seg[3] ) - m_y0 ) / m_dy + CELL_SLACK );
+
+            i0 = std::max( 0, i0 );
+            j0 = std::max( 0, j0 );
+            i1 = std::min( m_nx - 1, i1 );
+            j1 = std::min( m_ny - 1, j1 );
+
+            for( int j = j0; j <= j1; ++j )
+            {
+                for( int i = i0; i <= i1; ++i )
+                {
+                    if( ( i0 != i1 && j0 != j1 )
+                        && !segmentInBox( seg, m_x0 + ( i - CELL_SLACK ) * m_dx,
+                                          m_y0 + ( j - CELL_SLACK ) * m_dy,
+                                          m_x0 + ( i + 1 + CELL_SLACK ) * m_dx,
+                                          m_y0 + ( j + 1 + CELL_SLACK ) * m_dy ) )
+                        continue;
+
+                    int cell = j * m_nx + i;
+
+                    if( 0 == pass )
+                        ++m_cellStart[cell + 1];
+                    else
+                        m_cellEdges[fill[cell]++] = e;
+                }
+            }
+        }
+    }
+
+    // classify the cell centers by casting a ray along each row of centers
+    m_cellInside.assign( nCells, 0 );
+    std::vector< std::vector<double> > rows( m_ny );
+
+    for( int e = 0; e < nEdges; ++e )
+    {
+        const double* seg = &m_edges[e * 4];
+        int j0 = (int)floor( ( std::min( seg[1], seg[3] ) - m_y0 ) / m_dy - 0.5 );
+        int j1 = (int)ceil( ( std::max( seg[1], seg[3] ) - m_y0 ) / m_dy - 0.5 );
+
+        j0 = std::max( 0, j0 );
+        j1 = std::min( m_ny - 1, j1 );
+
+        for( int j = j0; j <= j1; ++j )
+        {
+            double yc = m_y0 + ( j + 0.5 ) * m_dy;
+
+            if( ( seg[1] > yc ) == ( seg[3] > yc ) )
+                continue;
+
+            rows[j].push_back( seg[0] + ( yc - seg[1] ) * ( seg[2] - seg[0] )
+                               / ( seg[3] - seg[1] ) );
+        }
+    }
+
+    for( int j = 0; j < m_ny; ++j )
+    {
+        std::vector<double>& xs = rows[j];
+        std::sort( xs.begin(), xs.end() );
+        size_t k = 0;
+
+        for( int i = 0; i < m_nx; ++i )
+        {
+            double xc = m_x0 + ( i + 0.5 ) * m_dx;
+
+            while( k < xs.size() && xs[k] < xc )
+                ++k;
+
+            m_cellInside[j * m_nx + i] = (char)( k & 1 );
+        }
+    }
+
+    return true;
+}
+
+
+int IGES_TRIM_INDEX::countCrossings( int aCell, double aU, double aV ) const
+{
+    int i = aCell % m_nx;
+    int j = aCell / m_nx;
+    double xc = m_x0 + ( i + 0.5 ) * m_dx;
+    double yc = m_y0 + ( j + 0.5 ) * m_dy;
+    int nc = 0;
+
+    for( int k = m_cellStart[aCell]; k < m_cellStart[aCell + 1]; ++k )
+    {
+        const double* seg = &m_edges[m_cellEdges[k] * 4];
+
+        if( leftOf( xc, yc, aU, aV, seg[0], seg[1] )
+            == leftOf( xc, yc, aU, aV, seg[2], seg[3] ) )
+            continue;
+
+        if( leftOf( seg[0], seg[1], seg[2], seg[3], xc, yc )
+            != leftOf( seg[0], seg[1], seg[2], seg[3], aU, aV ) )
+            ++nc;
+    }
+
+    return nc;
+}
+
+
+bool IGES_TRIM_INDEX::IsInside( double aU, double aV ) const
+{
+    if( 0 == m_nx )
+        return m_invert;
+
+    double fx = ( aU - m_x0 ) / m_dx;
+    double fy = ( aV - m_y0 ) / m_dy;
+
+    // points beyond the grid are outside all boundaries
+    if( !( fx >= 0.0 && fx < m_nx && fy >= 0.0 && fy < m_ny ) )
+        return m_invert;
+
+    int cell = (int)fy * m_nx + (int)fx;
+    bool inside = ( 0 != m_cellInside[cell] );
+
+    if( countCrossings( cell, aU, aV ) & 1 )
+        inside = !inside;
+
+    return inside != m_invert;
+}
+
+
+size_t IGES_TRIM_INDEX::GetMemoryUsage( void ) const
+{
+    return sizeof( *this ) + HeapSize( m_edges ) + HeapSize( m_cellStart )
+           + HeapSize( m_cellEdges ) + HeapSize( m_cellInside );
+}
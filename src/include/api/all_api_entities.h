@@ -34,6 +34,7 @@ class IGES_ENTITY;
 class IGES_ENTITY_100;
 class IGES_ENTITY_102;
 class IGES_ENTITY_104;
+class IGES_ENTITY_106;
 class IGES_ENTITY_110;
 class IGES_ENTITY_120;
 class IGES_ENTITY_122;
@@ -50,6 +51,7 @@ class IGES_ENTITY_408;
 #include <api/dll_entity100.h>
 #include <api/dll_entity102.h>
 #include <api/dll_entity104.h>
+#include <api/dll_entity106.h>
 #include <api/dll_entity110.h>
 #include <api/dll_entity120.h>
 #include <api/dll_entity122.h>
@@ -44,6 +44,17 @@ public:
 
     bool AddSegment( IGES_CURVE* aSegment );
     bool AddSegment( DLL_IGES_CURVE& aSegment );
+
+    /**
+     * Function GetCurves
+     * retrieves the pointers to the segments of the curve without
+     * copying and returns true if the curve has any segments; the
+     * list is valid until the curve is next modified.
+     *
+     * @param aListSize = number of segments
+     * @param aCurveList = set to point to the first segment pointer
+     */
+    bool GetCurves( size_t& aListSize, IGES_CURVE**& aCurveList );
 };
 
 #endif  // DLL_ENTITY_102_H
@@ -0,0 +1,59 @@
+/*
+ * file: dll_entity106.h
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/*
+ * Description: IGES Entity 106: Copious Data, Sections 4.6, 4.7 and 4.11
+ */
+
+#ifndef DLL_ENTITY_106_H
+#define DLL_ENTITY_106_H
+
+#include <vector>
+#include <libigesconf.h>
+#include <api/dll_iges_curve.h>
+#include <geom/mcad_elements.h>
+
+class MCAD_API DLL_IGES_ENTITY_106 : public DLL_IGES_CURVE
+{
+public:
+    DLL_IGES_ENTITY_106( IGES* aParent, bool create );
+    DLL_IGES_ENTITY_106( DLL_IGES& aParent, bool create );
+    virtual ~DLL_IGES_ENTITY_106();
+
+    virtual bool NewEntity( void );
+
+    bool GetZT( double& aZT );
+    bool SetZT( double aZT );
+    bool GetTupleSize( int& aTupleSize );
+    bool GetNPoints( int& aNPoints );
+    // note: aData remains valid until the entity is modified or destroyed
+    bool GetData( int& aNPoints, const double*& aData );
+    bool SetData( int aNPoints, const double* aData );
+    bool GetPoints( std::vector<MCAD_POINT>& aPoints, bool xform = true );
+    bool SetPoints( const std::vector<MCAD_POINT>& aPoints );
+    bool GetPoint( int aIndex, MCAD_POINT& pt, bool xform = true );
+    bool GetVector( int aIndex, MCAD_POINT& aVec );
+};
+
+#endif  // DLL_ENTITY_106_H
@@ -46,6 +46,9 @@ public:
     bool IsRational( bool& aResult );
     bool isPeriodic( bool& aResult );
     bool GetNormal( MCAD_POINT& aNorm );
+    bool EvalPoints( int aNPoints, const double* aParams, MCAD_POINT* aPoints,
+                     bool xform = true );
+    bool GetBoundingBox( MCAD_POINT& aMin, MCAD_POINT& aMax, bool xform = true );
 };
 
 #endif  // DLL_ENTITY_126_H
@@ -60,6 +60,12 @@ public:
     bool isClosed2( bool& aResult );
     bool isPeriodic1( bool& aResult );
     bool isPeriodic2( bool& aResult );
+    bool EvalPoints( int aNPoints, const double* aUParams, const double* aVParams,
+                     MCAD_POINT* aPoints, bool xform = true );
+    bool GetBoundingBox( MCAD_POINT& aMin, MCAD_POINT& aMax, bool xform = true );
+    bool EvalGrid( int aNU, const double* aUParams, int aNV, const double* aVParams,
+                   MCAD_POINT* aPoints, MCAD_POINT* aDerivU = NULL,
+                   MCAD_POINT* aDerivV = NULL, bool xform = true );
 };
 
 #endif  // DLL_ENTITY_128_H
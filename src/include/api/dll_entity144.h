@@ -54,6 +54,10 @@ public:
     bool AddCutout( DLL_IGES_ENTITY_142& aPtr );
     bool DelCutout( IGES_ENTITY_142* aPtr );
     bool DelCutout( DLL_IGES_ENTITY_142& aPtr );
+    bool SetTrimTolerance( double aTolerance );
+    bool ClassifyPoint( double aU, double aV, bool& aInside );
+    bool ClassifyPoints( int aNPoints, const double* aUParams,
+                         const double* aVParams, bool* aResult );
 };
 
 #endif  // DLL_ENTITY_144_H
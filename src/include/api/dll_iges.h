@@ -95,8 +95,86 @@ public:
      *
      * @param aFileName = path to file to be written
      * @param fOverwrite = set to true if an existing file should be overwritten
+     * @param fSync = set to true to commit the data to the storage device
+     * before the file is replaced
      */
-    bool Write( const char* aFileName, bool fOverwrite = false );
+    bool Write( const char* aFileName, bool fOverwrite = false, bool fSync = false );
+
+    /**
+     * Function WriteLinked
+     * writes out IGES data, splitting a model which exceeds the line limits
+     * of a single file into a main file and files of Subfigure Definitions
+     * linked via External References; returns true on success
+     *
+     * @param aFileName = path to the main file to be written
+     * @param fOverwrite = set to true if existing files should be overwritten
+     * @param aMaxLines = maximum number of lines in the Directory Entry or
+     * Parameter Data section of any file
+     */
+    bool WriteLinked( const char* aFileName, bool fOverwrite = false, int aMaxLines = 9999999 );
+
+    /**
+     * Function SetNThreads
+     * sets the number of threads which may be used to process
+     * independent entities; see IGES::SetNThreads()
+     *
+     * @param aNThreads = number of threads (<= 0 = automatic)
+     */
+    bool SetNThreads( int aNThreads );
+
+    /**
+     * Function GetNThreads
+     * retrieves the number of threads set via SetNThreads()
+     *
+     * @param aNThreads = (O) number of threads (<= 0 = automatic)
+     */
+    bool GetNThreads( int& aNThreads );
+
+    /**
+     * Function SetDependencyOrder
+     * sets whether the entities are written in dependency order;
+     * see IGES::SetDependencyOrder()
+     *
+     * @param aOrdered = true to write in dependency order
+     */
+    bool SetDependencyOrder( bool aOrdered );
+
+    /**
+     * Function GetDependencyOrder
+     * retrieves the setting of SetDependencyOrder()
+     *
+     * @param aOrdered = (O) true if the entities are written in dependency order
+     */
+    bool GetDependencyOrder( bool& aOrdered );
+
+    /**
+     * Function SetPipelinedRead
+     * sets whether Read() may associate entities while reading;
+     * see IGES::SetPipelinedRead()
+     *
+     * @param aPipelined = true to associate entities while reading
+     */
+    bool SetPipelinedRead( bool aPipelined );
+
+    /**
+     * Function GetPipelinedRead
+     * retrieves the setting of SetPipelinedRead()
+     *
+     * @param aPipelined = (O) true if entities may be associated while reading
+     */
+    bool GetPipelinedRead( bool& aPipelined );
+
+    /**
+     * Function GetMemoryStats
+     * reports the memory used by the entities of each type;
+     * see IGES::GetMemoryStats()
+     *
+     * @param aNTypes = (O) number of entity types in the list
+     * @param aStats = (O) list of memory statistics per entity type
+     * @param aTotal = (O) totals for all entities and the IGES object
+     */
+    bool GetMemoryStats( size_t& aNTypes, IGES_MEMORY_STATS const*& aStats,
+                         IGES_MEMORY_STATS& aTotal );
 
     /**
      * Function Export
@@ -112,6 +190,19 @@ public:
     bool Export( DLL_IGES* newParent, IGES_ENTITY_308** packagedEntity );
     bool Export( IGES* newParent, IGES_ENTITY_308** packagedEntity );
 
+    /**
+     * Function BuildAssembly
+     * reads each distinct part file of @param aParts, in parallel where
+     * possible, and exports the parts into this model in the order given
+     * with one Singular Subfigure Instance per placement; the result does
+     * not depend on the number of threads. Returns true on success;
+     * see IGES::BuildAssembly() for the state of the model on failure.
+     *
+     * @param aParts = list of part descriptors
+     * @param aNParts = number of items in aParts
+     */
+    bool BuildAssembly( const IGES_ASSEMBLY_PART* aParts, size_t aNParts );
+
     /**
      * Function GetNewPartName
      * creates a new, and hopefully unique, part name. The part name may not be
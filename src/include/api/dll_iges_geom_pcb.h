@@ -104,6 +104,23 @@ public:
                              IGES_ENTITY_144**& aSurfaceList,
                              int& nSurfaces, double aTopZ, double aBotZ );
 
+    /**
+     * Function SetJoinCurves
+     * determines whether GetTrimmedPlane() renders the BREP representation
+     * of each boundary of a plane as a single NURBS curve (true) or as a
+     * Composite Curve with NURBS curves per segment of the outline (false,
+     * default).
+     */
+    void SetJoinCurves( bool aJoin );
+
+    /**
+     * Function SetExtrudeLoops
+     * determines whether GetVerticalSurface() renders the sides of each
+     * closed loop as a single Tabulated Cylinder (true) or as one or more
+     * surfaces per segment of the loop (false, default).
+     */
+    void SetExtrudeLoops( bool aExtrude );
+
     // retrieve the trimmed parametric surfaces representing the
     // top or bottom plane of the board
     // note: aSurfaceList [in/out] must be deleted [] by the caller
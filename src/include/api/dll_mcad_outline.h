@@ -124,6 +124,11 @@ public:
     bool GetErrors( char const**& anErrorList, int& aListSize );
     // clear all error messages
     void ClearErrors( void );
+    // enable or disable the indexed method of subtracting
+    // circles which cross the edge; it is enabled by default
+    // and must be used for castellations along axis-aligned
+    // edges (see MCAD_OUTLINE::SetFastCutouts())
+    void SetFastCutouts( bool aEnable );
     // sets aResult to 'true' if the outline is closed
     bool IsClosed( bool& aResult );
     // sets aResult to 'true' if the (closed) outline is contiguous
@@ -200,6 +205,11 @@ public:
     bool AddCutout( MCAD_SEGMENT* aCircle, bool overlaps, bool& error );
     bool AddCutout( DLL_MCAD_SEGMENT& aCircle, bool overlaps, bool& error );
 
+    // Replace runs of line segments in the (closed) outline and its cutouts
+    // which lie within aTolerance of a single line, arc or circle by that
+    // entity; existing arcs and circles are not altered.
+    bool Simplify( double aTolerance, bool& error );
+
 };
 
 #endif  // DLL_MCAD_OUTLINE_H
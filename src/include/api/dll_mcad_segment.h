@@ -104,6 +104,12 @@ public:
     bool GetIntersections( DLL_MCAD_SEGMENT& aSegment, MCAD_POINT*& aIntersectList,
         int& aNumIntersections, MCAD_INTERSECT_FLAG& flags );
 
+    // + calculate intersections with another segment; the points are
+    // returned within aResult and no memory is allocated
+    bool GetIntersections( MCAD_SEGMENT const* aSegment, MCAD_INTERSECTIONS& aResult );
+
+    bool GetIntersections( DLL_MCAD_SEGMENT& aSegment, MCAD_INTERSECTIONS& aResult );
+
     // + calculate the bottom-left and top-right rectangular bounds
     bool GetBoundingBox( MCAD_POINT& p0, MCAD_POINT& p1 );
 
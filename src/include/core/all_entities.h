@@ -31,6 +31,7 @@
 #include <core/entity100.h>
 #include <core/entity102.h>
 #include <core/entity104.h>
+#include <core/entity106.h>
 #include <core/entity108.h>
 #include <core/entity110.h>
 #include <core/entity120.h>
@@ -48,6 +49,7 @@
 #include <core/entity314.h>
 #include <core/entity406.h>
 #include <core/entity408.h>
+#include <core/entity416.h>
 #include <core/entity502.h>
 #include <core/entity504.h>
 #include <core/entity508.h>
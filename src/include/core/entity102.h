@@ -31,6 +31,7 @@
 
 #include <libigesconf.h>
 #include <core/iges_curve.h>
+#include <core/iges_children.h>
 
 // NOTE:
 //
@@ -45,8 +46,7 @@
 // * 116 *ENT_POINT
 // * 126 ENT_NURBS_CURVE
 // * 132 *ENT_CONNECT_POINT
-// * 106 ENT_COPIOUS_DATA FORMS: (Due to complexity, postpone any implementation of this)
-// *     Note: not necessarily all forms are supported; this needs to be checked carefully
+// * 106 ENT_COPIOUS_DATA FORMS:
 // *        1, 2, 3
 // *        11, 12, 13
 // *        63
@@ -97,13 +97,15 @@ protected:
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes );
 
     std::list<int> iCurves;
-    std::list<IGES_CURVE*> curves;
+    IGES_CHILDREN<IGES_CURVE> curves;
 
 public:
     // public functions for libIGES only
     virtual bool associate(std::vector<IGES_ENTITY *> *entities);
+    virtual void getRefIndices( std::vector<int>& aList );
     virtual bool unlink(IGES_ENTITY *aChild);
     virtual bool addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate);
     virtual bool delReference(IGES_ENTITY *aParentEntity);
@@ -125,9 +127,21 @@ public:
     virtual bool IsClosed( void );
     virtual int GetNCurves( void );
     virtual IGES_CURVE* GetCurve( int index );
+
+    /**
+     * Function GetCurves
+     * retrieves the pointers to the segments of the curve without
+     * copying and returns true if the curve has any segments.
+     *
+     * @param aListSize = number of segments
+     * @param aCurveList = set to point to the first segment pointer
+     */
+    bool GetCurves( size_t& aListSize, IGES_CURVE**& aCurveList );
     virtual bool GetStartPoint( MCAD_POINT& pt, bool xform = true );
     virtual bool GetEndPoint( MCAD_POINT& pt, bool xform = true );
     virtual int GetNSegments( void );
+    virtual bool GetPolyline( double aTolerance, std::vector<MCAD_POINT>& aPoints,
+                              bool xform = true );
 };
 
 #endif  // ENTITY_102_H
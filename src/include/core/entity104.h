@@ -79,6 +79,7 @@ protected:
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes );
 
 public:
     // public functions for libIGES only
@@ -0,0 +1,209 @@
+/*
+ * file: entity106.h
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/*
+ * Description: IGES Entity 106: Copious Data, Sections 4.6 (Forms 1..3),
+ * 4.7 (Linear Path, Forms 11..13) and 4.11 (Simple Closed Planar Curve,
+ * Form 63)
+ */
+
+#ifndef ENTITY_106_H
+#define ENTITY_106_H
+
+#include <vector>
+#include <libigesconf.h>
+#include <core/iges_curve.h>
+
+// NOTE:
+// The associated parameter data are:
+// + IP: Int: interpretation flag:
+//      1 = (x, y) pairs with a common Z value
+//      2 = (x, y, z) triples
+//      3 = (x, y, z, i, j, k) sextuples; each point has an associated vector
+// + N: Int: number of tuples
+// + ZT: Real: common Z value (IP = 1 only)
+// + [data]: Real: N tuples of 2, 3 or 6 values according to IP
+//
+// Forms:
+//   1: set of points, IP = 1
+//   2: set of points, IP = 2
+//   3: set of points with vectors, IP = 3
+//  11: piecewise linear curve (Linear Path), IP = 1
+//  12: piecewise linear curve (Linear Path), IP = 2
+//  13: piecewise linear curve (Linear Path), IP = 3
+//  63: simple closed planar curve, IP = 1; the last point
+//      coincides with the first point
+//
+// Forms 20, 21 (Centerline), 31..38 (Section) and 40 (Witness Line)
+// are annotation entities with IP = 1; their data are read and written
+// but they are not treated as curves. Entities of any other Form are
+// reported when a file is read and are discarded along with other
+// unsupported entities.
+//
+// Unused DE items:
+// + Structure
+//
+
+
+/**
+ * Class IGES_ENTITY_106
+ * represents a point set (Forms 1..3) or a piecewise linear curve
+ * (Forms 11..13, 63); the tuples are held in a single contiguous array
+ * in the order in which they appear in the parameter data.
+ */
+class IGES_ENTITY_106 : public IGES_CURVE
+{
+protected:
+
+    friend class IGES;
+    virtual bool format( int &index );
+    virtual bool rescale( double sf );
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes );
+
+    std::vector<double> data;   // N tuples of GetTupleSize() values
+
+public:
+    // public functions for libIGES only
+    virtual bool associate(std::vector<IGES_ENTITY *> *entities);
+    virtual bool unlink(IGES_ENTITY *aChild);
+    virtual bool isOrphaned( void );
+    virtual bool addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate);
+    virtual bool delReference(IGES_ENTITY *aParentEntity);
+    virtual bool readDE(IGES_RECORD *aRecord, std::ifstream &aFile, int &aSequenceVar);
+    virtual bool readPD(std::ifstream &aFile, int &aSequenceVar);
+
+public:
+    IGES_ENTITY_106( IGES* aParent );
+    virtual ~IGES_ENTITY_106();
+
+    // public variables
+    double ZT;  //< common Z value of all points (IP = 1)
+
+    // Inherited from IGES_ENTITY
+    virtual bool SetEntityForm(int aForm);
+    virtual bool SetHierarchy( IGES_STAT_HIER aHierarchy );
+
+    // Inherited from IGES_CURVE
+    virtual bool GetStartPoint( MCAD_POINT& pt, bool xform = true );
+    virtual bool GetEndPoint( MCAD_POINT& pt, bool xform = true );
+    virtual int GetNSegments( void );
+    virtual bool IsClosed( void );
+    virtual int GetNCurves( void );
+    virtual IGES_CURVE* GetCurve( int index );
+    virtual bool GetPolyline( double aTolerance, std::vector<MCAD_POINT>& aPoints,
+                              bool xform = true );
+
+    /**
+     * Function GetIP
+     * returns the interpretation flag (1, 2 or 3) implied by the Form
+     */
+    int GetIP( void ) const;
+
+    /**
+     * Function GetTupleSize
+     * returns the number of values per tuple (2, 3 or 6) implied by the Form
+     */
+    int GetTupleSize( void ) const;
+
+    /**
+     * Function GetNPoints
+     * returns the number of tuples
+     */
+    int GetNPoints( void ) const;
+
+    /**
+     * Function IsPointSet
+     * returns true if the entity is a set of unconnected points (Forms 1..3)
+     */
+    bool IsPointSet( void ) const;
+
+    /**
+     * Function IsLinearPath
+     * returns true if the entity is a piecewise linear curve (Forms 11..13, 63)
+     */
+    bool IsLinearPath( void ) const;
+
+    /**
+     * Function GetData
+     * retrieves the tuples and returns true if there is at least one tuple;
+     * the data remain valid until the entity is modified or destroyed.
+     *
+     * @param aNPoints = number of tuples
+     * @param aData = pointer to aNPoints * GetTupleSize() values
+     */
+    bool GetData( int& aNPoints, const double*& aData ) const;
+
+    /**
+     * Function SetData
+     * replaces the tuples and returns true on success; Form 63 requires
+     * that the last point coincide with the first and a Linear Path
+     * requires at least 2 points.
+     *
+     * @param aNPoints = number of tuples
+     * @param aData = aNPoints * GetTupleSize() values
+     */
+    bool SetData( int aNPoints, const double* aData );
+
+    /**
+     * Function SetPoints
+     * replaces the tuples with the given points and returns true on
+     * success; for IP = 1 the Z values are discarded in favor of ZT and
+     * for IP = 3 the associated vectors are set to zero.
+     *
+     * @param aPoints = list of points
+     */
+    bool SetPoints( const std::vector<MCAD_POINT>& aPoints );
+
+    /**
+     * Function GetPoints
+     * appends all points to the given list and returns true on success;
+     * for IP = 1 the Z value of each point is ZT.
+     *
+     * @param aPoints = list to which the points are appended
+     * @param xform = set to true to apply any associated transforms to the points
+     */
+    bool GetPoints( std::vector<MCAD_POINT>& aPoints, bool xform = true );
+
+    /**
+     * Function GetPoint
+     * retrieves the point with the given index and returns true on success.
+     *
+     * @param aIndex = index of the point (0 .. GetNPoints() - 1)
+     * @param pt = variable to store the point
+     * @param xform = set to true to apply any associated transforms to the point
+     */
+    bool GetPoint( int aIndex, MCAD_POINT& pt, bool xform = true );
+
+    /**
+     * Function GetVector
+     * retrieves the vector associated with the point with the given index
+     * (IP = 3 only) and returns true on success; transforms are not applied.
+     *
+     * @param aIndex = index of the point (0 .. GetNPoints() - 1)
+     * @param aVec = variable to store the vector
+     */
+    bool GetVector( int aIndex, MCAD_POINT& aVec ) const;
+};
+
+#endif  // ENTITY_106_H
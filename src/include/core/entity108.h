@@ -73,6 +73,7 @@ protected:
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes );
 
     // Type 108 parameters
     IGES_CURVE* PTR;    //< closed curve referenced by iPtr
@@ -81,6 +82,7 @@ protected:
 public:
     // public functions for internal libIGES use
     virtual bool associate(std::vector<IGES_ENTITY *> *entities);
+    virtual void getRefIndices( std::vector<int>& aList );
     virtual bool unlink(IGES_ENTITY *aChild);
     virtual bool isOrphaned( void );
     virtual bool addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate);
@@ -64,6 +64,7 @@ protected:
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes );
 
 public:
     // public functions for libIGES only
@@ -97,6 +98,8 @@ public:
     virtual bool IsClosed( void );
     virtual int GetNCurves( void );
     virtual IGES_CURVE* GetCurve( int index );
+    virtual bool GetPolyline( double aTolerance, std::vector<MCAD_POINT>& aPoints,
+                              bool xform = true );
 };
 
 #endif  // ENTITY_110_H
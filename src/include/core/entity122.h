@@ -61,6 +61,7 @@ protected:
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes );
 
     IGES_CURVE* DE;
     int iDE;
@@ -68,6 +69,7 @@ protected:
 public:
     // public functions for libIGES only
     virtual bool associate(std::vector<IGES_ENTITY *> *entities);
+    virtual void getRefIndices( std::vector<int>& aList );
     virtual bool unlink(IGES_ENTITY *aChild);
     virtual bool isOrphaned( void );
     virtual bool addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate);
@@ -29,6 +29,7 @@
 #ifndef ENTITY_126_H
 #define ENTITY_126_H
 
+#include <atomic>
 #include <libigesconf.h>
 #include <core/iges_curve.h>
 #include <geom/mcad_elements.h>
@@ -41,6 +42,8 @@
     #include <sisl.h>
 #endif
 
+class IGES_BEZIER_CURVE;
+
 
 // NOTE:
 // The associated parameter data are:
@@ -86,14 +89,29 @@ private:
     // norm: if provided the normal to the plane will be returned
     bool hasUniquePlane( MCAD_POINT* norm = NULL );
 #ifdef USE_SISL
-    SISLCurve* scurve;
+    // SISL representation of the curve; it is created on demand and
+    // published atomically so that concurrent queries do not race
+    std::atomic<SISLCurve*> scurve;
+    // retrieve the SISL curve, creating it if necessary
+    SISLCurve* getSISLCurve( void );
+    // delete the SISL curve; must not be invoked while queries are in progress
+    void freeSISLCurve( void );
 #endif
+    // piecewise Bezier representation of the curve; it is created on
+    // demand and published atomically in the same manner as scurve
+    std::atomic<IGES_BEZIER_CURVE*> bcurve;
+    // retrieve the Bezier representation, creating it if necessary
+    IGES_BEZIER_CURVE* getBezierCurve( void );
+    // delete the Bezier representation; must be invoked whenever the
+    // curve data changes and not while queries are in progress
+    void freeBezierCurve( void );
 
 protected:
 
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes );
     // note: IGES specifies knots, weights, and control points
     // while SISL merges control points and weights (x, y, z, w)
     // for rational B-splines and omits weights in the case of
@@ -139,6 +157,8 @@ public:
     virtual bool GetStartPoint( MCAD_POINT& pt, bool xform = true );
     virtual bool GetEndPoint( MCAD_POINT& pt, bool xform = true );
     virtual int GetNSegments( void );
+    virtual bool GetPolyline( double aTolerance, std::vector<MCAD_POINT>& aPoints,
+                              bool xform = true );
 
     /**
      * Function GetNURBSData
@@ -197,6 +217,32 @@ public:
      * returns true if the curve is planar.
      */
     bool GetNormal( MCAD_POINT& aNorm );
+
+    /**
+     * Function EvalPoints
+     * computes points on the curve at the given parameter values and
+     * returns true on success; all parameter values must lie within
+     * the range [V0, V1] of the curve.
+     *
+     * @param aNPoints = number of points to compute
+     * @param aParams = list of aNPoints parameter values
+     * @param aPoints = (O) list of aNPoints computed points
+     * @param xform = true to apply the entity's transform (if any)
+     */
+    bool EvalPoints( int aNPoints, const double* aParams, MCAD_POINT* aPoints,
+                     bool xform = true );
+
+    /**
+     * Function GetBoundingBox
+     * computes the bounding box of the curve and returns true on success;
+     * the box exceeds the curve by no more than the minimum resolution
+     * of the model.
+     *
+     * @param aMin = (O) minimum coordinates of the box
+     * @param aMax = (O) maximum coordinates of the box
+     * @param xform = true to apply the entity's transform (if any)
+     */
+    bool GetBoundingBox( MCAD_POINT& aMin, MCAD_POINT& aMax, bool xform = true );
 };
 
 #endif  // ENTITY_126_H
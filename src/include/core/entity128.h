@@ -29,10 +29,13 @@
 #ifndef ENTITY_128_H
 #define ENTITY_128_H
 
+#include <atomic>
 #include <libigesconf.h>
 #include <core/iges_entity.h>
 #include <geom/mcad_elements.h>
 
+class IGES_BEZIER_SURFACE;
+
 // NOTE:
 // The associated parameter data are:
 // K1: int: Upper index of sum of first parameter (note: not the number of knots)
@@ -81,11 +84,23 @@
  */
 class IGES_ENTITY_128 : public IGES_ENTITY
 {
+private:
+    // piecewise Bezier representation of the surface; it is created
+    // on demand and published atomically so that concurrent queries
+    // do not race
+    std::atomic<IGES_BEZIER_SURFACE*> bsurf;
+    // retrieve the Bezier representation, creating it if necessary
+    IGES_BEZIER_SURFACE* getBezierSurface( void );
+    // delete the Bezier representation; must be invoked whenever the
+    // surface data changes and not while queries are in progress
+    void freeBezierSurface( void );
+
 protected:
 
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes );
 
     int nKnots1;    // number of knots in parameter 1
     int nKnots2;    // number of knots in parameter 2
@@ -208,6 +223,58 @@ public:
      */
     bool isPeriodic2( void );
 
+    /**
+     * Function EvalPoints
+     * computes points on the surface at the given parameter pairs and
+     * returns true on success; all parameter values must lie within
+     * the ranges [U0, U1] and [V0, V1] of the surface.
+     *
+     * @param aNPoints = number of points to compute
+     * @param aUParams = list of aNPoints values of Parameter U
+     * @param aVParams = list of aNPoints values of Parameter V
+     * @param aPoints = (O) list of aNPoints computed points
+     * @param xform = true to apply the entity's transform (if any)
+     */
+    bool EvalPoints( int aNPoints, const double* aUParams, const double* aVParams,
+                     MCAD_POINT* aPoints, bool xform = true );
+
+    /**
+     * Function GetBoundingBox
+     * computes a box which encloses the surface and returns true on
+     * success; the box is derived from the control points of the
+     * Bezier patches of the surface and may exceed the surface.
+     *
+     * @param aMin = (O) minimum coordinates of the box
+     * @param aMax = (O) maximum coordinates of the box
+     * @param xform = true to apply the entity's transform (if any)
+     */
+    bool GetBoundingBox( MCAD_POINT& aMin, MCAD_POINT& aMax, bool xform = true );
+
+    /**
+     * Function EvalGrid
+     * computes points and optionally the first partial derivatives of
+     * the surface on the grid formed by the given lists of U and V
+     * parameter values and returns true on success. Results are ordered
+     * with U varying fastest; the result for (aUParams[i], aVParams[j])
+     * is at index i + j * aNU. All parameter values must lie within the
+     * ranges [U0, U1] and [V0, V1] of the surface. The evaluation is most
+     * efficient when the parameter values are sorted.
+     *
+     * @param aNU = number of values of Parameter U
+     * @param aUParams = list of aNU values of Parameter U
+     * @param aNV = number of values of Parameter V
+     * @param aVParams = list of aNV values of Parameter V
+     * @param aPoints = (O) list of aNU * aNV computed points
+     * @param aDerivU = (O) list of aNU * aNV partial derivatives with respect
+     * to U or NULL if they are not required
+     * @param aDerivV = (O) list of aNU * aNV partial derivatives with respect
+     * to V or NULL if they are not required
+     * @param xform = true to apply the entity's transform (if any)
+     */
+    bool EvalGrid( int aNU, const double* aUParams, int aNV, const double* aVParams,
+                   MCAD_POINT* aPoints, MCAD_POINT* aDerivU = NULL,
+                   MCAD_POINT* aDerivV = NULL, bool xform = true );
+
 };
 
 #endif  // ENTITY_128_H
@@ -27,10 +27,13 @@
 #ifndef ENTITY_144_H
 #define ENTITY_144_H
 
+#include <atomic>
 #include <libigesconf.h>
 #include <core/iges_entity.h>
+#include <core/iges_children.h>
 
 class IGES_ENTITY_142;
+class IGES_TRIM_INDEX;
 
 // NOTE:
 // The associated parameter data are:
@@ -53,6 +56,18 @@ class IGES_ENTITY_142;
  */
 class IGES_ENTITY_144 : public IGES_ENTITY
 {
+private:
+    // index of the parameter space boundaries; it is created on demand
+    // and published atomically so that concurrent queries do not race
+    std::atomic<IGES_TRIM_INDEX*> trimIndex;
+    // chordal tolerance used to flatten the boundaries (0 = default)
+    double trimTol;
+    // retrieve the boundary index, creating it if necessary
+    IGES_TRIM_INDEX* getTrimIndex( void );
+    // delete the boundary index; must be invoked whenever the boundaries
+    // change and not while queries are in progress
+    void freeTrimIndex( void );
+
 protected:
 
     int iPTS;
@@ -74,16 +89,17 @@ protected:
     // E198 (toroidal surface)
     IGES_ENTITY* PTS;               // surface entity
     IGES_ENTITY_142* PTO;           // outer curve
-    std::list<IGES_ENTITY_142*>PTI; // inner cutouts
-    std::vector<IGES_ENTITY_142*>vPTI;  // convenience for passing data via DLL
+    IGES_CHILDREN<IGES_ENTITY_142> PTI; // inner cutouts
 
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes );
 
 public:
     // public functions for libIGES only
     virtual bool associate(std::vector<IGES_ENTITY *> *entities);
+    virtual void getRefIndices( std::vector<int>& aList );
     virtual bool unlink(IGES_ENTITY *aChild);
     virtual bool isOrphaned( void );
     virtual bool addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate);
@@ -96,7 +112,6 @@ public:
     virtual ~IGES_ENTITY_144();
 
     // Inherited virtual functions
-    virtual void Compact( void );
     virtual bool SetEntityForm( int aForm );
     virtual bool SetEntityUse( IGES_STAT_USE aUseCase );
     virtual bool SetHierarchy( IGES_STAT_HIER aHierarchy );
@@ -170,9 +185,52 @@ public:
      * list of internal boundaries for the surface and returns
      * true if the curve was found and removed.
      *
+     * NOTE: the removed curve also drops its reference to this
+     * surface; a curve which is left without any parent is culled
+     * as an orphan when the model is written unless it is added
+     * to another entity.
+     *
      * @param aPtr = pointer to the inner boundary curve to be removed
      */
     bool DelPTI( IGES_ENTITY_142* aPtr );
+
+    /**
+     * Function SetTrimTolerance
+     * sets the maximum deviation of the polylines used to classify points
+     * from the parameter space boundary curves and discards the boundary
+     * index; the index must also be discarded via this function whenever
+     * a boundary curve is modified after points have been classified.
+     *
+     * @param aTolerance = chordal tolerance in parameter space or 0 to use
+     * 1e-6 of the extent of the parameter space
+     */
+    bool SetTrimTolerance( double aTolerance );
+
+    /**
+     * Function ClassifyPoint
+     * determines whether a point in the parameter space of the surface
+     * lies within the trimmed region and returns true on success.
+     *
+     * @param aU = first parameter of the point
+     * @param aV = second parameter of the point
+     * @param aInside = set to true if the point is within the trimmed region
+     */
+    bool ClassifyPoint( double aU, double aV, bool& aInside );
+
+    /**
+     * Function ClassifyPoints
+     * determines whether each of a set of points in the parameter space
+     * of the surface lies within the trimmed region and returns true on
+     * success. The boundaries are indexed on the first call so batches
+     * of points are classified in time proportional to their number.
+     *
+     * @param aNPoints = number of points
+     * @param aUParams = first parameter of each point
+     * @param aVParams = second parameter of each point
+     * @param aResult = array of aNPoints results (true = inside)
+     */
+    bool ClassifyPoints( int aNPoints, const double* aUParams,
+                         const double* aVParams, bool* aResult );
 };
 
 #endif  // ENTITY_144_H
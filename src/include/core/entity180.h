@@ -27,10 +27,13 @@
 #ifndef ENTITY_180_H
 #define ENTITY_180_H
 
+#include <atomic>
 #include <libigesconf.h>
 #include <geom/mcad_elements.h>
 #include <core/iges_entity.h>
 
+class IGES_CSG_PROGRAM;
+
 // NOTE:
 // The boolean operators are in Postfix Notation. Examples:
 // + DE1, DE2, DIFFERENCE,
@@ -63,11 +66,24 @@
  */
 class IGES_ENTITY_180 : public IGES_ENTITY
 {
+private:
+    // compiled form of the tree used to classify points; it is created
+    // on demand and published atomically so that concurrent queries do
+    // not race
+    std::atomic<IGES_CSG_PROGRAM*> csgProgram;
+    // retrieve the compiled tree, creating it if necessary
+    IGES_CSG_PROGRAM* getCSGProgram( void );
+    // delete the compiled tree; must be invoked whenever the tree
+    // changes and not while queries are in progress
+    void freeCSGProgram( void );
+
 protected:
 
     friend class IGES;
+    friend class IGES_CSG_PROGRAM;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes );
 
     std::list<BTREE_NODE*> nodes;
     bool typeOK( int aTypeNum );
@@ -75,6 +91,7 @@ protected:
 public:
     // public functions for libIGES only
     virtual bool associate(std::vector<IGES_ENTITY *> *entities);
+    virtual void getRefIndices( std::vector<int>& aList );
     virtual bool unlink(IGES_ENTITY *aChild);
     virtual bool isOrphaned( void );
     virtual bool addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate);
@@ -125,6 +142,37 @@ public:
      * returns a pointer to the internal list of BTREE operators and operands
      */
     BTREE_NODE* GetNode( int aIndex );
+
+    /**
+     * Function ResetClassifier
+     * discards the compiled form of the tree used to classify points;
+     * this must be invoked whenever an operand or its transform is
+     * modified after points have been classified.
+     */
+    void ResetClassifier( void );
+
+    /**
+     * Function ClassifyPoint
+     * determines whether a point lies within the solid and returns
+     * true on success.
+     *
+     * @param aPoint = point in model coordinates
+     * @param aInside = set to true if the point is within the solid
+     */
+    bool ClassifyPoint( const MCAD_POINT& aPoint, bool& aInside );
+
+    /**
+     * Function ClassifyPoints
+     * determines whether each of a set of points lies within the solid
+     * and returns true on success. The tree is compiled on the first
+     * call; only Right Circular Cylinders, Solids of Linear Extrusion
+     * and nested Boolean Trees are supported as operands.
+     *
+     * @param aNPoints = number of points
+     * @param aPoints = points in model coordinates
+     * @param aResult = array of aNPoints results (true = inside)
+     */
+    bool ClassifyPoints( int aNPoints, const MCAD_POINT* aPoints, bool* aResult );
 };
 
 #endif  // ENTITY_180_H
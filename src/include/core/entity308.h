@@ -31,6 +31,7 @@
 
 #include <libigesconf.h>
 #include <core/iges_entity.h>
+#include <core/iges_children.h>
 
 // NOTE:
 // The associated parameter data are:
@@ -61,17 +62,19 @@ class IGES_ENTITY_308 : public IGES_ENTITY
 protected:
 
     std::list< int > iDE;
+    std::string NAME;   // Name of this Subfigure Definition (Part Name or Subassembly Name)
 
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes );
 
 public:
-    std::list< IGES_ENTITY* > DE;       //< associated entities
-    std::vector< IGES_ENTITY* > m_DE;   // DE arranged for access across DLL
+    IGES_CHILDREN< IGES_ENTITY > DE;    //< associated entities
 
     // public functions for libIGES only
     virtual bool associate(std::vector<IGES_ENTITY *> *entities);
+    virtual void getRefIndices( std::vector<int>& aList );
     virtual bool unlink(IGES_ENTITY *aChild);
     virtual bool isOrphaned( void );
     virtual bool addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate);
@@ -94,7 +97,6 @@ public:
     virtual ~IGES_ENTITY_308();
 
     // Inherited virtual functions
-    virtual void Compact( void );
     virtual bool SetEntityForm( int aForm );
     virtual bool SetVisibility( bool isVisible );
     virtual bool SetEntityUse( IGES_STAT_USE aUseCase );
@@ -102,7 +104,6 @@ public:
 
     // parameters
     int DEPTH;          //< Depth Level of this instance
-    std::string NAME;   //< Name of this Subfigure Definition (Part Name or Subassembly Name)
     int N;              //< Number of entities comprising this Subfigure Definition
 
     /**
@@ -116,6 +117,23 @@ public:
      */
     bool GetDEList( size_t& aDESize, IGES_ENTITY**& aDEList );
 
+    /**
+     * Function GetName
+     * returns the NAME of this Subfigure Definition (Part Name or
+     * Subassembly Name); the name is empty if it was never set.
+     */
+    const std::string& GetName( void ) const;
+
+    /**
+     * Function SetName
+     * sets the NAME of this Subfigure Definition and updates the
+     * parent IGES object's name index so that the definition may
+     * be found via IGES::FindByName().
+     *
+     * @param aName = new name of the Subfigure Definition
+     */
+    void SetName( const std::string& aName );
+
 
     /**
      * Function AddDE
@@ -132,6 +150,11 @@ public:
      * comprising this Subfigure Definition and returns true if
      * the specified entity pointer was found and removed.
      *
+     * NOTE: the removed entity also drops its reference to this
+     * Subfigure Definition; an entity which is left without any
+     * parent is culled as an orphan when the model is written
+     * unless it is made independent or added to another entity.
+     *
      * @param aPtr = pointer of entity to be disassociated
      */
     bool DelDE( IGES_ENTITY* aPtr );
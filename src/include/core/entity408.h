@@ -34,10 +34,12 @@
 #include <core/iges_entity.h>
 
 class IGES_ENTITY_308;
+class IGES_ENTITY_416;
 
 // Note:
 // The associated parameter data are:
-// + DE: Int: pointer to Entity308 (Subfigure Definition)
+// + DE: Int: pointer to Entity308 (Subfigure Definition) or
+//            Entity416 (External Reference)
 // + X: Real: offset
 // + Y: Real
 // + Z: Real
@@ -62,13 +64,19 @@ protected:
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes );
 
     IGES_ENTITY_308* DE;    // Pointer to the Subfigure Definition Entity to be instantiated
+    IGES_ENTITY_416* extDE; // Pointer to an External Reference used in place of DE
     int iDE;                // Directory Entry index to the Subfigure Definition Entity
+    // External Reference written in place of DE while IGES::WriteLinked() is
+    // writing the Subfigure Definition to a separate file; not owned
+    IGES_ENTITY_416* linkDE;
 
 public:
     // public functions for libIGES only
     virtual bool associate(std::vector<IGES_ENTITY *> *entities);
+    virtual void getRefIndices( std::vector<int>& aList );
     virtual bool unlink(IGES_ENTITY *aChild);
     virtual bool isOrphaned( void );
     virtual bool addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate);
@@ -111,6 +119,27 @@ public:
      */
     bool SetDE( IGES_ENTITY_308* aPtr );
 
+    /**
+     * Function GetExternalRef
+     * retrieves a pointer to the External Reference Entity which is
+     * instantiated in place of a Subfigure Definition and returns true
+     * on success; the definition itself may be retrieved via
+     * IGES_ENTITY_416::GetDefinition().
+     *
+     * @param aPtr = handle to store pointer to the External Reference Entity
+     */
+    bool GetExternalRef( IGES_ENTITY_416*& aPtr );
+
+    /**
+     * Function SetExternalRef
+     * sets an External Reference Entity (Forms 0, 2, 3) to be instantiated
+     * in place of a Subfigure Definition and returns true on success; any
+     * associated Subfigure Definition is released.
+     *
+     * @param aPtr = pointer to the External Reference Entity to associate
+     */
+    bool SetExternalRef( IGES_ENTITY_416* aPtr );
+
     /**
      * Function GetDepthLevel
      * returns the nesting level of this entity; this function is used to
@@ -0,0 +1,143 @@
+/*
+ * file: entity416.h
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/*
+ * Description: IGES Entity 416: External Reference Entity, Section 4.149
+ */
+
+#ifndef ENTITY_416_H
+#define ENTITY_416_H
+
+#include <string>
+#include <libigesconf.h>
+#include <core/iges_entity.h>
+
+class IGES_ENTITY_308;
+
+// NOTE:
+// The associated parameter data are:
+// + FN: String: name of the external file (Forms 0, 2, 3) or
+//               library symbolic name (Form 4)
+// + EXTNAM: String: name of the referenced entity within the
+//               external file (Forms 0, 1, 2, 4)
+//
+// Forms:
+//  0: definition within an external file, referenced by name
+//  1: definition within the external files listed in a
+//     Property Entity (406-12), referenced by name
+//  2: entity within an external file, referenced by name
+//  3: an entire external file
+//  4: definition within an external library, referenced by name
+//
+// Within libIGES the name of a referenced definition is the
+// NAME of a Subfigure Definition Entity (308) in the external file.
+//
+// Unused DE items:
+// + Structure
+// + Line Font Pattern
+// + Level
+// + View
+// + Transformation Matrix
+// + Label Display Association
+// + Line Weight
+// + Color Number
+//
+
+
+/**
+ * Class IGES_ENTITY_416
+ * represents the External Reference Entity; this entity is
+ * instantiated via a Singular Subfigure Instance (408) in place
+ * of a Subfigure Definition (308) to include a part or subassembly
+ * which is stored in another file.
+ */
+class IGES_ENTITY_416 : public IGES_ENTITY
+{
+protected:
+
+    friend class IGES;
+    virtual bool format( int &index );
+    virtual bool rescale( double sf );
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes );
+
+    IGES* m_model;      // external file; loaded on demand
+
+public:
+    // public functions for libIGES only
+    virtual bool associate(std::vector<IGES_ENTITY *> *entities);
+    virtual bool unlink(IGES_ENTITY *aChild);
+    virtual bool isOrphaned( void );
+    virtual bool addReference(IGES_ENTITY *aParentEntity, bool &isDuplicate);
+    virtual bool delReference(IGES_ENTITY *aParentEntity);
+    virtual bool readDE(IGES_RECORD *aRecord, std::ifstream &aFile, int &aSequenceVar);
+    virtual bool readPD(std::ifstream &aFile, int &aSequenceVar);
+
+public:
+    IGES_ENTITY_416( IGES* aParent );
+    virtual ~IGES_ENTITY_416();
+
+    // Inherited virtual functions
+    virtual bool SetEntityForm( int aForm );
+    virtual bool SetHierarchy( IGES_STAT_HIER aHierarchy );
+
+    // parameters
+    std::string FN;         //< external file name or library symbolic name
+    std::string EXTNAM;     //< name of the referenced entity
+
+    /**
+     * Function GetModel
+     * returns the contents of the external file (Forms 0, 2, 3), reading
+     * the file on the first call, or NULL if the file cannot be read. A
+     * relative FN is taken relative to the directory of the file which
+     * the parent IGES object was last read from or written to. The model
+     * remains valid until Unload() is invoked or this entity is destroyed.
+     */
+    IGES* GetModel( void );
+
+    /**
+     * Function GetDefinition
+     * retrieves the Subfigure Definition named EXTNAM within the external
+     * file (Forms 0, 2) or the only top level Subfigure Definition of the
+     * file (Form 3), reading the file if necessary, and returns true on
+     * success.
+     *
+     * @param aPtr = handle to store pointer to the Subfigure Definition
+     */
+    bool GetDefinition( IGES_ENTITY_308*& aPtr );
+
+    /**
+     * Function IsLoaded
+     * returns true if the external file is currently held in memory
+     */
+    bool IsLoaded( void ) const { return NULL != m_model; }
+
+    /**
+     * Function Unload
+     * releases the contents of the external file; pointers previously
+     * obtained via GetModel() or GetDefinition() become invalid.
+     */
+    void Unload( void );
+};
+
+#endif  // ENTITY_416_H
@@ -61,6 +61,7 @@ protected:
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes );
 
 public:
     std::vector<MCAD_POINT> vertices;   //< list of vertices comprising this entity
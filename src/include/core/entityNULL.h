@@ -73,6 +73,7 @@ protected:
     void setEntityType( int aEntityID );
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes );
 
 public:
     // public functions for libIGES only
@@ -83,8 +84,8 @@ public:
     virtual bool delReference(IGES_ENTITY *aParentEntity);
     virtual bool readDE(IGES_RECORD *aRecord, std::ifstream &aFile, int &aSequenceVar);
     virtual bool readPD(std::ifstream &aFile, int &aSequenceVar);
-    virtual bool writeDE(std::ofstream &aFile);
-    virtual bool writePD(std::ofstream &aFile);
+    virtual bool writeDE(std::ostream &aFile);
+    virtual bool writePD(std::ostream &aFile);
 
 public:
     IGES_ENTITY_NULL( IGES* aParent );
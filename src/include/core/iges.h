@@ -37,6 +37,8 @@
 #include <core/iges_entity.h>
 
 class IGES_ENTITY_308;
+class IGES_DE_TABLE;
+class IGES_NAME_INDEX;
 
 /**
  * Struct IGES_GLOBAL
@@ -85,17 +87,24 @@ struct IGES_GLOBAL
 class IGES
 {
 private:
-    static int idxPartNum;                  //< index used to create Part Name
-    static int idxAssyNum;                  //< index used to create Assembly Name
     std::list< bool* > m_validFlags;        //< DLL layer validation flags
     std::vector< const char* > vStartSection;   //< temp. vector table for DLL access
+    std::vector< IGES_MEMORY_STATS > vMemStats; //< temp. memory report for DLL access
 
     std::list<std::string> startSection;    //< text from the Start section
     int                    nGlobSecLines;   //< number of lines in the Global section
     int                    nDESecLines;     //< number of lines in the Directory Entry section
     int                    nPDSecLines;     //< number of lines in the Parameter Data section
+    int                    nThreads;        //< number of worker threads (<= 0 = automatic)
+    bool                   orderedWrite;    //< write children before the entities referring to them
+    bool                   pipelinedRead;   //< associate entities while the Parameter Data is read
 
     std::vector<IGES_ENTITY*> entities;     //< all existing IGES entities and their data
+    IGES_DE_TABLE*            deTable;      //< optional table of DE attributes (NULL = not in use)
+    IGES_NAME_INDEX*          nameIndex;    //< index of part, assembly and property names
+    std::string               filePath;     //< path of the file last read or written
+
+    friend class IGES_ENTITY;
 
     // initialize internal data structures
     bool init(void);
@@ -104,14 +113,51 @@ private:
     bool readGlobals( IGES_RECORD& rec, std::ifstream& file );
     // read all Directory Entries (when a Parameter Data Entry is encountered. rewind to the start of that line)
     bool readDE( IGES_RECORD& rec, std::ifstream& file );
-    // read data based on existing entities' record on number of associated Parameter Data lines
-    bool readPD( IGES_RECORD& rec, std::ifstream& file );
-    // read the TERMINATE section and verify data
-    bool readTS( IGES_RECORD& rec, std::ifstream& file );
-    // write out the START SECTION
-    bool writeStart( std::ofstream& file );
+    // associates entities in a worker thread while Parameter Data is being read
+    class ASSOCIATE_JOB;
+    // read data based on existing entities' record on number of associated Parameter Data lines;
+    // if aJob is not NULL it is notified as each entity's data is read; if aNAssociated
+    // is not NULL each entity is associated as soon as its data is read for as long as
+    // it refers only to preceding entities and aNAssociated is set to the number of
+    // entities associated in this manner
+    bool readPD( IGES_RECORD& rec, std::ifstream& file, ASSOCIATE_JOB* aJob,
+                 size_t* aNAssociated = NULL );
+    // read the TERMINATE section and verify data; aNStartLines is the
+    // number of lines read from the Start section
+    bool readTS( IGES_RECORD& rec, std::ifstream& file, int aNStartLines );
+    // write out the START SECTION; if aOrdered is true a line is added
+    // to mark the file as dependency ordered
+    bool writeStart( std::ostream& file, bool aOrdered );
     // write out the GLOBAL SECTION
-    bool writeGlobals( std::ofstream& file );
+    bool writeGlobals( std::ostream& file );
+    // format all Parameter Data for output and set nPDSecLines; aTooLarge is
+    // set to true if the data exceeds the PD Sequence Number limit
+    bool formatPD( bool& aTooLarge );
+    // arrange aList so that every entity follows the entities it refers to
+    // within the current entity list; returns false if there is a cycle
+    bool orderEntities( std::vector<IGES_ENTITY*>& aList );
+    // write the current entity list to a file, in dependency order if so
+    // requested; if either section would exceed aMaxLines lines nothing is
+    // written and aTooLarge is set to true
+    bool writeFile( const char* aFileName, bool fOverwrite, bool fSync,
+                    int aMaxLines, bool& aTooLarge );
+    // write the sections of the file in the order of the current entity list;
+    // aOrdered indicates that the list is in dependency order
+    bool writeSections( const char* aFileName, bool fOverwrite, bool fSync,
+                        int aMaxLines, bool& aTooLarge, bool aOrdered );
+    // write the entities reachable from aRoots to a file, moving Subfigure
+    // Definitions into separate files as necessary to satisfy the line limit
+    struct LINK_STATE;
+    bool writeLinked( LINK_STATE& aState, const std::vector<size_t>& aRoots,
+                      const std::string& aFileName );
+    // jobs used to format Parameter Data in parallel
+    class FORMAT_JOB;
+    class RELOCATE_JOB;
+    // rescale all entities, in parallel where possible
+    bool rescale( double sf );
+    class RESCALE_JOB;
+    // job used to read the part files of an assembly in parallel
+    class ASSEMBLY_READ_JOB;
 
 public:
     IGES();
@@ -144,6 +190,43 @@ public:
     void Compact( void );
 
 
+    /**
+     * Function GetDETable
+     * returns the table of Directory Entry attributes of all entities,
+     * creating the table on first use and rebuilding it if entities
+     * have been added or removed since it was last built. The rows are
+     * in the order of the entity list and are kept up to date by the
+     * entities' attribute setters; the pointer remains valid until
+     * FreeDETable() is invoked or the IGES object is destroyed.
+     */
+    const IGES_DE_TABLE* GetDETable( void );
+
+
+    /**
+     * Function GetMemoryStats
+     * reports the memory used by the entities of each type present in
+     * this IGES object and returns true on success. The list is sorted
+     * by entity type and remains valid until the next invocation of
+     * this function or until the IGES object is destroyed.
+     *
+     * @param aNTypes = (O) number of entity types in the list
+     * @param aStats = (O) list of memory statistics per entity type
+     * @param aTotal = (O) totals for all entities; the memory used by the
+     * IGES object itself, its entity list and the DE table is included
+     * in the object and heap totals
+     */
+    bool GetMemoryStats( size_t& aNTypes, IGES_MEMORY_STATS const*& aStats,
+                         IGES_MEMORY_STATS& aTotal );
+
+
+    /**
+     * Function FreeDETable
+     * releases the table of Directory Entry attributes; the table
+     * is not maintained again until GetDETable() is invoked.
+     */
+    void FreeDETable( void );
+
+
     /**
      * Function Cull
      * culls all orphaned entities; if vicious = true then all top-level
@@ -171,12 +254,125 @@ public:
 
     /**
      * Function Write
-     * opens a file and writes out IGES data; returns true on success
+     * opens a file and writes out IGES data; returns true on success.
+     * The data is written to a temporary file which only replaces
+     * the named file once all data has been written, so an existing
+     * file is left intact if the write fails.
      *
      * @param aFileName = path to file to be written
      * @param fOverwrite = set to true if an existing file should be overwritten
+     * @param fSync = set to true to commit the data to the storage device
+     * before the file is replaced
+     */
+    bool Write( const char* aFileName, bool fOverwrite = false, bool fSync = false );
+
+
+    // NOTE:
+    // The sequence numbers of the fixed column format limit each section of
+    // an IGES file to 9,999,999 lines, hence a model may have at most about
+    // 5 million entities and 9,999,999 lines of Parameter Data. Larger models
+    // are exchanged as a set of linked files: a Subfigure Definition (308)
+    // which is only instantiated by Singular Subfigure Instances (408) is
+    // written to a file of its own and the instances in the referring file
+    // point to an External Reference (416, Form 0) which holds the name of
+    // that file and the NAME of the Subfigure Definition (Form 3 and the
+    // file alone if the definition has no name). Definitions are moved out
+    // from the top of the hierarchy down and only as far as necessary, and a
+    // definition shared by several files is written once. Each file is
+    // formatted and written in turn and its Parameter Data released before
+    // the next is started. On reading, a file is loaded only when its
+    // definition is requested via IGES_ENTITY_416::GetDefinition() and it
+    // may be released again via IGES_ENTITY_416::Unload().
+
+    /**
+     * Function WriteLinked
+     * writes out the IGES data as Write() does if it fits within a single
+     * file, otherwise as a main file and a set of files named after it
+     * (name_1.igs, name_2.igs, ...) holding Subfigure Definitions which are
+     * referred to via External Reference entities; returns true on success.
+     * The function fails if the model cannot be split finely enough.
+     *
+     * @param aFileName = path to the main file to be written
+     * @param fOverwrite = set to true if existing files should be overwritten
+     * @param aMaxLines = maximum number of lines in the Directory Entry or
+     * Parameter Data section of any file; values outside 1..9999999 select
+     * the limit imposed by the IGES format
+     */
+    bool WriteLinked( const char* aFileName, bool fOverwrite = false,
+                      int aMaxLines = 9999999 );
+
+
+    /**
+     * Function GetFilePath
+     * returns the path of the file which was last read or written or
+     * an empty string; relative External References are resolved
+     * against the directory of this path.
      */
-    bool Write( const char* aFileName, bool fOverwrite = false );
+    const char* GetFilePath( void ) const;
+
+
+    /**
+     * Function SetNThreads
+     * sets the number of threads which may be used to process
+     * independent entities, for example while formatting the
+     * Parameter Data for output; the output is identical regardless
+     * of the number of threads used.
+     *
+     * @param aNThreads = number of threads; 1 = process all data in the
+     * calling thread, <= 0 = use all available hardware threads (default)
+     */
+    void SetNThreads( int aNThreads );
+
+
+    /**
+     * Function GetNThreads
+     * returns the number of threads set via SetNThreads(); a value
+     * <= 0 indicates that the number of threads is chosen automatically.
+     */
+    int GetNThreads( void );
+
+
+    /**
+     * Function SetDependencyOrder
+     * sets whether the entities are written in dependency order, that is
+     * with every entity following all entities which it refers to, so that
+     * all Directory Entry pointers refer backwards. The Start section of
+     * such a file is marked so that Read() can associate each entity as
+     * soon as its Parameter Data has been read rather than after reading
+     * the entire file. If the references form a cycle the entities are
+     * written in the usual order and the file is not marked.
+     *
+     * @param aOrdered = true to write in dependency order (default: false)
+     */
+    void SetDependencyOrder( bool aOrdered );
+
+
+    /**
+     * Function GetDependencyOrder
+     * returns true if the entities are written in dependency order
+     */
+    bool GetDependencyOrder( void );
+
+
+    /**
+     * Function SetPipelinedRead
+     * sets whether Read() may associate the entities in a worker thread
+     * while the remaining Parameter Data is being read. The entities are
+     * associated in the same order as by the sequential path so the
+     * resulting model is identical; the pipeline is only used when more
+     * than one thread is available (see SetNThreads()) and the file is
+     * not dependency ordered.
+     *
+     * @param aPipelined = true to associate entities while reading (default: false)
+     */
+    void SetPipelinedRead( bool aPipelined );
+
+
+    /**
+     * Function GetPipelinedRead
+     * returns true if Read() may associate entities while reading
+     */
+    bool GetPipelinedRead( void );
 
 
     /**
@@ -193,29 +389,83 @@ public:
     bool Export( IGES* newParent, IGES_ENTITY_308** packagedEntity );
 
 
+    /**
+     * Function BuildAssembly
+     * adds parts and subassemblies to this model: each distinct file is
+     * read into a separate IGES object, in parallel according to
+     * SetNThreads(), and then exported into this model in the order in
+     * which the files first appear in @param aParts; each placement is
+     * instantiated via a Singular Subfigure Instance (408) with its own
+     * Transformation Matrix (124). A file which appears more than once is
+     * read and exported only once and all of its placements refer to the
+     * same Subfigure Definition. The result does not depend on the number
+     * of threads used. Returns true on success. All files are read before
+     * any part is exported, so if a file cannot be read then this model is
+     * not modified; if a part cannot be exported or instantiated then the
+     * parts and instances added before the failure remain in this model.
+     *
+     * @param aParts = list of part descriptors
+     * @param aNParts = number of items in aParts
+     */
+    bool BuildAssembly( const IGES_ASSEMBLY_PART* aParts, size_t aNParts );
+
+
     /**
      * Function GetNewPartName
-     * creates a new, and hopefully unique, part name. The part name may not be
-     * unique if a sub-assembly happens to have a sub-part with the same name,
-     * in which case a more comprehensive naming code must be developed.
+     * creates a new part name which is not used by any Subfigure Definition
+     * or Name Property within this model and which differs from all names
+     * previously created by this model.
      *
      * @param name = variable to store the part name
      */
     void GetNewPartName( std::string& name );
 
-    // create a new (hopefully unique) assembly name; the name may not be unique
-    // if a sub-assembly happens to have the same name
     /**
      * Function GetNewAssemblyName
-     * creates a new, and hopefully unique, assembly name. The assembly name may
-     * not be unique if a sub-assembly happens to have a sub-assembly with the
-     * same name, in which case a more comprehensive naming code must be developed.
+     * creates a new assembly name which is not used by any Subfigure Definition
+     * or Name Property within this model and which differs from all names
+     * previously created by this model.
      *
      * @param name = variable to store the assembly name
      */
     void GetNewAssemblyName( std::string& name );
 
 
+    /**
+     * Function FindByName
+     * appends all Subfigure Definitions (308) with the given NAME and all
+     * Name Properties (406, Form 15) with the given name to aList and
+     * returns the number of entities appended. The names are held in an
+     * index which is built on first use and kept up to date as entities
+     * are added or removed and as names are changed via
+     * IGES_ENTITY_308::SetName() or IGES_ENTITY_406::SetData().
+     *
+     * @param aName = name to look up
+     * @param aList = list to which the named entities are appended
+     */
+    size_t FindByName( const std::string& aName, std::vector<IGES_ENTITY*>& aList );
+
+
+    /**
+     * Function IsNameUsed
+     * returns true if a Subfigure Definition or Name Property within
+     * this model bears the given name
+     */
+    bool IsNameUsed( const std::string& aName );
+
+
+    /**
+     * Function MakeUniqueName
+     * appends a suffix '-n', n = 1.., to @param aName if a Subfigure
+     * Definition or Name Property within this model bears that name or
+     * if the name was previously returned by this function or by
+     * GetNewPartName() / GetNewAssemblyName(). The resulting name is
+     * reserved until an entity of this model takes it, so concurrent
+     * callers always obtain distinct names.
+     */
+    void MakeUniqueName( std::string& aName );
+
+
     /**
      * Function NewEntity
      * creates a new IGES entity with the specified type and returns
@@ -329,4 +329,53 @@ struct MCAD_API EDGE_DATA
     }
 };
 
+
+/**
+ * Struct IGES_MEMORY_STATS
+ * reports the memory used by all entities of one type or,
+ * in the case of totals, by all entities of an IGES object
+ */
+struct MCAD_API IGES_MEMORY_STATS
+{
+    int    entityType;  // entity type or -1 for totals
+    size_t count;       // number of entities
+    size_t objectBytes; // size of the entity objects
+    size_t heapBytes;   // memory owned by the entities: parameter data, cached
+                        // representations, comments and formatted output
+    size_t refBytes;    // memory used to link entities: lists of referring
+                        // entities and extra (optional) entities
+
+    IGES_MEMORY_STATS()
+    {
+        entityType = -1;
+        count = 0;
+        objectBytes = 0;
+        heapBytes = 0;
+        refBytes = 0;
+    }
+};
+
+
+struct MCAD_TRANSFORM;
+
+/**
+ * Struct IGES_ASSEMBLY_PART
+ * describes a part or subassembly to be added to an assembly
+ * via IGES::BuildAssembly(): the file containing the model and
+ * the placement of each instance of the model in the assembly
+ */
+struct MCAD_API IGES_ASSEMBLY_PART
+{
+    const char*           fileName;     // name of the part or subassembly file
+    size_t                nPlacements;  // number of instances
+    const MCAD_TRANSFORM* placements;   // transform of each instance
+
+    IGES_ASSEMBLY_PART()
+    {
+        fileName = NULL;
+        nPlacements = 0;
+        placements = NULL;
+    }
+};
+
 #endif  // IGES_BASE_H
@@ -0,0 +1,213 @@
+/*
+ * file: iges_bezier.h
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: piecewise Bezier representation of NURBS curves and
+ * surfaces; this is a cache derived from the B-Spline data of
+ * Entities 126 and 128 to speed up repeated evaluation.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef IGES_BEZIER_H
+#define IGES_BEZIER_H
+
+#include <vector>
+#include <libigesconf.h>
+#include <geom/mcad_elements.h>
+
+// NOTE:
+// The B-Spline is split at its interior knots by knot insertion
+// (evaluation of the blossom) and the pieces are restricted to the
+// parameter range of the entity. Each piece is kept as Bezier control
+// points for bounding and subdivision and as power basis coefficients
+// in the local parameter t = [0, 1] for evaluation by Horner's rule.
+// All points are stored in homogeneous form (wx, wy, wz, w); the
+// weight is 1 for polynomial B-Splines.
+
+
+/**
+ * Class IGES_BEZIER_CURVE
+ * is the piecewise Bezier representation of a B-Spline curve
+ */
+class IGES_BEZIER_CURVE
+{
+private:
+    int  m_order;
+    int  m_nSegs;
+    bool m_rational;
+    std::vector<double> m_breaks;   // m_nSegs + 1 parameter values bounding the pieces
+    std::vector<double> m_bezier;   // Bezier control points, m_order per piece
+    std::vector<double> m_power;    // power basis coefficients, m_order per piece
+
+    // returns the index of the piece containing the parameter value
+    int findSegment( double aParam ) const;
+
+public:
+    IGES_BEZIER_CURVE();
+
+    /**
+     * Function Build
+     * creates the piecewise Bezier representation of a B-Spline curve
+     * over the parameter range [aV0, aV1] and returns true on success.
+     *
+     * @param aNCoeffs = number of control points
+     * @param aOrder = order of the B-Spline (degree + 1)
+     * @param aKnots = knot vector (aNCoeffs + aOrder values)
+     * @param aCoeffs = control points (X, Y, Z) or (X, Y, Z, W) if rational
+     * @param aRational = true if the B-Spline is rational
+     * @param aV0 = first parameter value of the curve
+     * @param aV1 = last parameter value of the curve
+     */
+    bool Build( int aNCoeffs, int aOrder, const double* aKnots, const double* aCoeffs,
+                bool aRational, double aV0, double aV1 );
+
+    /**
+     * Function GetNSegments
+     * returns the number of Bezier pieces
+     */
+    int GetNSegments( void ) const;
+
+    /**
+     * Function GetOrder
+     * returns the order of the Bezier pieces (degree + 1)
+     */
+    int GetOrder( void ) const;
+
+    /**
+     * Function GetSegment
+     * returns the GetOrder() homogeneous Bezier control points of a
+     * piece or NULL if the index is out of range
+     *
+     * @param aIndex = index of the piece
+     * @param aStart = (O) first parameter value of the piece
+     * @param aEnd = (O) last parameter value of the piece
+     */
+    const double* GetSegment( int aIndex, double& aStart, double& aEnd ) const;
+
+    /**
+     * Function GetMemoryUsage
+     * returns the number of bytes used by this object and its data
+     */
+    size_t GetMemoryUsage( void ) const;
+
+    /**
+     * Function Evaluate
+     * computes the point at the given parameter value
+     *
+     * @param aParam = parameter value; values outside the range of the
+     * curve are clamped
+     * @param aPoint = (O) computed point
+     */
+    void Evaluate( double aParam, MCAD_POINT& aPoint ) const;
+
+    /**
+     * Function GetBounds
+     * computes the bounding box of the curve; pieces whose control
+     * polygon extends beyond the box are subdivided until the excess
+     * is within the given tolerance.
+     *
+     * @param aTransform = transform to apply to the curve or NULL
+     * @param aTolerance = allowable excess of the box over the curve
+     * @param aMin = (O) minimum coordinates
+     * @param aMax = (O) maximum coordinates
+     */
+    void GetBounds( const MCAD_TRANSFORM* aTransform, double aTolerance,
+                    MCAD_POINT& aMin, MCAD_POINT& aMax ) const;
+
+    /**
+     * Function Flatten
+     * appends points along the curve to the given list; pieces are
+     * subdivided until their control polygons lie within the given
+     * tolerance of the chord so that the polyline through the points
+     * deviates from the curve by no more than the tolerance.
+     *
+     * @param aTransform = transform to apply to the curve or NULL
+     * @param aTolerance = maximum deviation of the polyline from the curve
+     * @param aPoints = list to which the points are appended
+     */
+    void Flatten( const MCAD_TRANSFORM* aTransform, double aTolerance,
+                  std::vector<MCAD_POINT>& aPoints ) const;
+};
+
+
+/**
+ * Class IGES_BEZIER_SURFACE
+ * is the piecewise Bezier representation of a B-Spline surface
+ */
+class IGES_BEZIER_SURFACE
+{
+private:
+    int  m_order1;
+    int  m_order2;
+    int  m_nSegs1;
+    int  m_nSegs2;
+    bool m_rational;
+    std::vector<double> m_breaks1;  // parameter values bounding the pieces in U
+    std::vector<double> m_breaks2;  // parameter values bounding the pieces in V
+    std::vector<double> m_bezier;   // Bezier control points, m_order1 * m_order2 per patch
+    std::vector<double> m_power;    // power basis coefficients, m_order1 * m_order2 per patch
+
+public:
+    IGES_BEZIER_SURFACE();
+
+    /**
+     * Function Build
+     * creates the piecewise Bezier representation of a B-Spline surface
+     * over the parameter range [aU0, aU1] x [aV0, aV1] and returns true on
+     * success. Control points are ordered with U varying fastest.
+     */
+    bool Build( int aNCoeffs1, int aNCoeffs2, int aOrder1, int aOrder2,
+                const double* aKnots1, const double* aKnots2,
+                const double* aCoeffs, bool aRational,
+                double aU0, double aU1, double aV0, double aV1 );
+
+    /**
+     * Function GetNPatches
+     * returns the number of Bezier patches
+     */
+    int GetNPatches( void ) const;
+
+    /**
+     * Function GetMemoryUsage
+     * returns the number of bytes used by this object and its data
+     */
+    size_t GetMemoryUsage( void ) const;
+
+    /**
+     * Function Evaluate
+     * computes the point at the given parameter values; values outside
+     * the range of the surface are clamped.
+     */
+    void Evaluate( double aU, double aV, MCAD_POINT& aPoint ) const;
+
+    /**
+     * Function GetBounds
+     * computes a box enclosing the convex hulls of all patches
+     *
+     * @param aTransform = transform to apply to the surface or NULL
+     * @param aMin = (O) minimum coordinates
+     * @param aMax = (O) maximum coordinates
+     */
+    void GetBounds( const MCAD_TRANSFORM* aTransform,
+                    MCAD_POINT& aMin, MCAD_POINT& aMax ) const;
+};
+
+#endif  // IGES_BEZIER_H
@@ -0,0 +1,170 @@
+/*
+ * file: iges_children.h
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: ordered list of child entity pointers stored
+ * contiguously with a membership index.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef IGES_CHILDREN_H
+#define IGES_CHILDREN_H
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+
+// NOTE:
+// The children are kept in insertion order in a single vector so that
+// the list may be handed out as a (pointer, length) pair without copying.
+// Short lists are searched directly; once a list grows beyond
+// IGES_CHILDREN_INDEX_MIN items a hash set of its members is maintained
+// so that membership tests (and hence duplicate checks when adding
+// children) take constant time.
+
+#define IGES_CHILDREN_INDEX_MIN (16)
+
+
+/**
+ * Class IGES_CHILDREN
+ * is an ordered list of unique pointers to child entities
+ */
+template< class T >
+class IGES_CHILDREN
+{
+private:
+    std::vector< T* > m_items;
+    std::unordered_set< const T* > m_index;
+    bool m_indexed;
+
+    void buildIndex( void )
+    {
+        m_index.clear();
+        m_index.insert( m_items.begin(), m_items.end() );
+        m_indexed = true;
+    }
+
+public:
+    typedef typename std::vector< T* >::iterator iterator;
+    typedef typename std::vector< T* >::const_iterator const_iterator;
+    typedef typename std::vector< T* >::reverse_iterator reverse_iterator;
+
+    IGES_CHILDREN() : m_indexed( false ) {}
+
+    iterator begin( void ) { return m_items.begin(); }
+    iterator end( void ) { return m_items.end(); }
+    const_iterator begin( void ) const { return m_items.begin(); }
+    const_iterator end( void ) const { return m_items.end(); }
+    reverse_iterator rbegin( void ) { return m_items.rbegin(); }
+    reverse_iterator rend( void ) { return m_items.rend(); }
+
+    size_t size( void ) const { return m_items.size(); }
+    bool empty( void ) const { return m_items.empty(); }
+    T* front( void ) const { return m_items.front(); }
+    T* back( void ) const { return m_items.back(); }
+    T* operator[]( size_t aIndex ) const { return m_items[aIndex]; }
+
+    /**
+     * Function data
+     * returns a pointer to the contiguous list of children
+     * or NULL if the list is empty
+     */
+    T** data( void ) { return m_items.empty() ? NULL : &m_items[0]; }
+
+    /**
+     * Function contains
+     * returns true if aItem is in the list
+     */
+    bool contains( const T* aItem ) const
+    {
+        if( m_indexed )
+            return m_index.find( aItem ) != m_index.end();
+
+        return std::find( m_items.begin(), m_items.end(), aItem ) != m_items.end();
+    }
+
+    /**
+     * Function push_back
+     * appends aItem to the list and returns true, or returns
+     * false if the item is already in the list
+     */
+    bool push_back( T* aItem )
+    {
+        if( contains( aItem ) )
+            return false;
+
+        m_items.push_back( aItem );
+
+        if( m_indexed )
+            m_index.insert( aItem );
+        else if( m_items.size() > IGES_CHILDREN_INDEX_MIN )
+            buildIndex();
+
+        return true;
+    }
+
+    /**
+     * Function erase
+     * removes aItem from the list while preserving the order of the
+     * remaining items and returns true if the item was found
+     */
+    bool erase( const T* aItem )
+    {
+        if( m_indexed && m_index.erase( aItem ) == 0 )
+            return false;
+
+        iterator sI = std::find( m_items.begin(), m_items.end(), aItem );
+
+        if( sI == m_items.end() )
+            return false;
+
+        m_items.erase( sI );
+        return true;
+    }
+
+    /**
+     * Function GetHeapSize
+     * returns an estimate of the heap memory used by the list
+     * and its membership index
+     */
+    size_t GetHeapSize( void ) const
+    {
+        size_t nb = m_items.capacity() * sizeof( T* );
+
+        if( m_indexed )
+        {
+            nb += m_index.bucket_count() * sizeof( void* );
+            nb += m_index.size() * ( sizeof( const T* ) + sizeof( void* ) + sizeof( size_t ) );
+        }
+
+        return nb;
+    }
+
+    void clear( void )
+    {
+        m_items.clear();
+        m_index.clear();
+        m_indexed = false;
+    }
+};
+
+#endif  // IGES_CHILDREN_H
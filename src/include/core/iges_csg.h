@@ -0,0 +1,131 @@
+/*
+ * file: iges_csg.h
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: compiled form of a Boolean Tree (Entity 180) which
+ * classifies points as inside or outside of the solid.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef IGES_CSG_H
+#define IGES_CSG_H
+
+#include <vector>
+#include <libigesconf.h>
+#include <geom/mcad_elements.h>
+
+class IGES_ENTITY;
+class IGES_ENTITY_180;
+class IGES_TRIM_INDEX;
+
+// NOTE:
+// The Boolean Tree is flattened into a postfix program in which nested
+// trees are expanded in place; each primitive is reduced to a few affine
+// functions of the model coordinates:
+// + Right Circular Cylinder (E154): the height along the axis and the
+//   radial vector; the point is inside if 0 <= h <= H and |r| <= R
+// + Solid of Linear Extrusion (E164): the distance along the extrusion
+//   and the (u, v) coordinates of the point projected onto the plane of
+//   the closed curve along the extrusion direction; the point is inside
+//   if 0 <= t <= L and (u, v) is within the flattened curve
+//
+// Points are classified in blocks; every subtree of the program carries
+// a bounding box and a subtree is skipped entirely (all points outside)
+// when the bounding box of the block does not overlap it.
+
+
+/**
+ * Class IGES_CSG_PROGRAM
+ * classifies points against a Boolean Tree of CSG primitives
+ */
+class IGES_CSG_PROGRAM
+{
+private:
+    struct CSG_PRIMITIVE
+    {
+        int     type;       // entity type of the primitive
+        double  rows[4][4]; // affine functions (a.x + b.y + c.z + d) of the model coordinates
+        double  limit;      // height or extrusion length
+        double  radius2;    // squared radius of a cylinder
+        IGES_TRIM_INDEX* section;   // cross-section of an extrusion
+    };
+
+    struct CSG_INSTRUCTION
+    {
+        int     code;       // 0 = evaluate primitive, else BTREE_OPERATOR
+        int     prim;       // index of the primitive
+        int     start;      // first instruction of the subtree ending here
+        double  bmin[3];    // bounding box of the subtree
+        double  bmax[3];
+    };
+
+    std::vector<CSG_PRIMITIVE>   m_prims;
+    std::vector<CSG_INSTRUCTION> m_program;
+    // subtrees starting at each instruction, outermost first (CSR form)
+    std::vector<int> m_pruneStart;
+    std::vector<int> m_pruneEnd;
+    int m_maxDepth;
+
+    bool compileTree( IGES_ENTITY_180* aTree, const MCAD_TRANSFORM& aTransform,
+                      double aTolerance, int aLevel );
+    bool compileOperand( IGES_ENTITY* aEntity, const MCAD_TRANSFORM& aTransform,
+                         double aTolerance, int aLevel );
+    bool addCylinder( IGES_ENTITY* aEntity, const MCAD_TRANSFORM& aTransform );
+    bool addExtrusion( IGES_ENTITY* aEntity, const MCAD_TRANSFORM& aTransform,
+                       double aTolerance );
+    void evalPrimitive( const CSG_PRIMITIVE& aPrim, int aNPoints, const double* aX,
+                        const double* aY, const double* aZ, char* aResult ) const;
+    void clear( void );
+
+public:
+    IGES_CSG_PROGRAM();
+    ~IGES_CSG_PROGRAM();
+
+    /**
+     * Function Compile
+     * creates the program from a Boolean Tree and returns true on success;
+     * only Right Circular Cylinders, Solids of Linear Extrusion and nested
+     * Boolean Trees are supported as operands.
+     *
+     * @param aTree = Boolean Tree to compile
+     * @param aTolerance = maximum deviation of the flattened cross-sections
+     * of extrusions from their curves
+     */
+    bool Compile( IGES_ENTITY_180* aTree, double aTolerance );
+
+    /**
+     * Function Classify
+     * classifies a set of points given in model coordinates
+     *
+     * @param aNPoints = number of points
+     * @param aPoints = points to classify
+     * @param aResult = array of aNPoints results (true = inside the solid)
+     */
+    void Classify( int aNPoints, const MCAD_POINT* aPoints, bool* aResult ) const;
+
+    /**
+     * Function GetMemoryUsage
+     * returns the number of bytes used by this object and its data
+     */
+    size_t GetMemoryUsage( void ) const;
+};
+
+#endif  // IGES_CSG_H
@@ -44,6 +44,7 @@
 #include <iostream>
 #include <string>
 #include <list>
+#include <vector>
 
 #include <libigesconf.h>
 #include <core/iges_base.h>
@@ -140,6 +141,22 @@ public:
     virtual int GetNSegments( void ) = 0;
 
 
+    /**
+     * Function GetPolyline
+     * appends to the given list a sequence of points running from the
+     * start to the end of this curve such that the polyline through the
+     * points deviates from the curve by no more than the given tolerance;
+     * returns true on success. The default implementation reports that
+     * the curve type is not supported.
+     *
+     * @param aTolerance = maximum deviation of the polyline from the curve
+     * @param aPoints = list to which the points are appended
+     * @param xform = set to true to apply any associated transforms to the points
+     */
+    virtual bool GetPolyline( double aTolerance, std::vector<MCAD_POINT>& aPoints,
+                              bool xform = true );
+
+
     // members inherited from IGES_ENTITY
     virtual bool SetEntityForm( int aForm ) = 0;
 };
@@ -0,0 +1,172 @@
+/*
+ * file: iges_detable.h
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: compact table of the Directory Entry attributes of
+ * all entities within an IGES object.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef IGES_DETABLE_H
+#define IGES_DETABLE_H
+
+#include <cstddef>
+#include <vector>
+#include <libigesconf.h>
+#include <core/iges_base.h>
+
+class IGES_ENTITY;
+
+// NOTE:
+// The table holds one row per entity in the order of the IGES object's
+// entity list; each attribute is stored in its own contiguous column so
+// that a pass over a single attribute of all entities does not touch the
+// entity objects themselves. Attributes which refer to a definition
+// entity (level, color, line font) hold -1 in that case.
+//
+// The table is a mirror of the entity data and not its primary store:
+// it is built on demand by IGES::GetDETable() and discarded whenever
+// entities are created or removed, while the IGES_ENTITY setters update
+// the entity's own row while the table is current.
+
+#define IGES_DE_LABEL_SIZE (9)  // 8 characters + terminator
+
+// layout of the packed Status Number column
+#define IGES_DE_STAT_BLANK      (0x01)  // entity is blanked (not visible)
+#define IGES_DE_STAT_DEPENDS(x) ( ( (x) >> 1 ) & 0x03 )
+#define IGES_DE_STAT_USE(x)     ( ( (x) >> 3 ) & 0x07 )
+#define IGES_DE_STAT_HIER(x)    ( ( (x) >> 6 ) & 0x03 )
+
+
+/**
+ * Class IGES_DE_TABLE
+ * stores the Directory Entry attributes of a list of entities
+ * as a structure of arrays
+ */
+class IGES_DE_TABLE
+{
+private:
+    bool m_valid;
+    std::vector<IGES_ENTITY*>   m_entity;
+    std::vector<int>            m_type;
+    std::vector<int>            m_form;
+    std::vector<int>            m_level;
+    std::vector<int>            m_color;
+    std::vector<int>            m_lineFont;
+    std::vector<int>            m_lineWeight;
+    std::vector<unsigned char>  m_status;
+    std::vector<int>            m_subscript;
+    std::vector<int>            m_nRefs;
+    std::vector<char>           m_label;
+
+    void setRow( size_t aRow, IGES_ENTITY* aEntity );
+    size_t select( const std::vector<int>& aColumn, int aValue,
+                   std::vector<IGES_ENTITY*>& aList ) const;
+
+public:
+    IGES_DE_TABLE();
+
+    /**
+     * Function Build
+     * fills the table from the given list of entities and
+     * assigns each entity its row
+     */
+    void Build( const std::vector<IGES_ENTITY*>& aEntities );
+
+    /**
+     * Function Update
+     * refreshes the row of the given entity; the call is ignored
+     * if the table is not current or the entity has no row
+     */
+    void Update( IGES_ENTITY* aEntity );
+
+    /**
+     * Function Invalidate
+     * marks the table as out of date with respect to the entity list;
+     * the memory is retained for the next Build()
+     */
+    void Invalidate( void ) { m_valid = false; }
+
+    /**
+     * Function IsValid
+     * returns true if the table reflects the current entity list
+     */
+    bool IsValid( void ) const { return m_valid; }
+
+    size_t size( void ) const { return m_entity.size(); }
+
+    // columns of the table; each holds size() items
+    IGES_ENTITY* const* GetEntities( void ) const { return m_entity.empty() ? NULL : &m_entity[0]; }
+    const int* GetTypes( void ) const { return m_type.empty() ? NULL : &m_type[0]; }
+    const int* GetForms( void ) const { return m_form.empty() ? NULL : &m_form[0]; }
+    const int* GetLevels( void ) const { return m_level.empty() ? NULL : &m_level[0]; }
+    const int* GetColors( void ) const { return m_color.empty() ? NULL : &m_color[0]; }
+    const int* GetLineFonts( void ) const { return m_lineFont.empty() ? NULL : &m_lineFont[0]; }
+    const int* GetLineWeights( void ) const { return m_lineWeight.empty() ? NULL : &m_lineWeight[0]; }
+    const unsigned char* GetStatus( void ) const { return m_status.empty() ? NULL : &m_status[0]; }
+    const int* GetSubscripts( void ) const { return m_subscript.empty() ? NULL : &m_subscript[0]; }
+    const int* GetNRefs( void ) const { return m_nRefs.empty() ? NULL : &m_nRefs[0]; }
+
+    /**
+     * Function GetLabel
+     * returns the (at most 8 character) label of the entity in the given row
+     */
+    const char* GetLabel( size_t aRow ) const { return &m_label[aRow * IGES_DE_LABEL_SIZE]; }
+
+    /**
+     * Function SelectType
+     * appends all entities of the given type to aList and
+     * returns the number of entities appended
+     *
+     * @param aType = entity type
+     * @param aForm = form number or -1 for any form
+     */
+    size_t SelectType( int aType, int aForm, std::vector<IGES_ENTITY*>& aList ) const;
+
+    /**
+     * Function SelectLevel
+     * appends all entities on the given level to aList and
+     * returns the number of entities appended
+     */
+    size_t SelectLevel( int aLevel, std::vector<IGES_ENTITY*>& aList ) const;
+
+    /**
+     * Function SelectColor
+     * appends all entities with the given color number to aList and
+     * returns the number of entities appended
+     */
+    size_t SelectColor( int aColor, std::vector<IGES_ENTITY*>& aList ) const;
+
+    /**
+     * Function SelectUnreferenced
+     * appends all independent entities which have no referring entity
+     * (top level entities) to aList and returns the number appended
+     */
+    size_t SelectUnreferenced( std::vector<IGES_ENTITY*>& aList ) const;
+
+    /**
+     * Function GetMemoryUsage
+     * returns the number of bytes used by this object and its data
+     */
+    size_t GetMemoryUsage( void ) const;
+};
+
+#endif  // IGES_DETABLE_H
@@ -84,12 +84,24 @@ protected:
     std::vector<IGES_ENTITY*> extras;
     std::list<int> iExtras;
     /// list of optional comments
-    std::list<std::string> comments;
+    std::vector<std::string> comments;
+    /// c_str() of each comment, kept in step with comments
     std::vector< const char* > vcomments;
+    /// refresh the pointers in vcomments from index aFirst
+    void syncComments( size_t aFirst );
     /// data formatted for output (also used for reading PDs from file)
     std::string pdout;
+    /// row within the parent's DE table or -1
+    int deRow;
+    /// refresh this entity's row in the parent's DE table
+    void updateDE( void );
+    /// invokes updateDE() on leaving the scope of a setter
+    class DE_UPDATE;
+    /// assign a part, assembly or property name and update the parent's name index
+    void setName( std::string& aField, const std::string& aNewName );
 
     friend class IGES;
+    friend class IGES_DE_TABLE;
     int sequenceNumber;     //< first sequence number of this entity's Directory Entry
     bool massoc;            //< set true after associate() is invoked
 
@@ -113,6 +125,18 @@ protected:
     void         unformat( void );
 
 
+    /**
+     * Function relocatePD
+     * renumbers previously formatted Parameter Data so that it starts
+     * at the given Parameter Data Index; this allows entities to be
+     * formatted independently and placed in the PD section afterwards.
+     * The function returns true on success.
+     *
+     * @param aIndex = new Parameter Data Index of the first PD line
+     */
+    bool         relocatePD( int aIndex );
+
+
     /**
      * Function readExtraParams
      * reads optional (extra) PD parameters and returns true on success.
@@ -156,11 +180,33 @@ protected:
      * Function rescale
      * changes the internal scale; this routine may be invoked by the parent IGES object
      * to change the internal units or the Model Scale; returns true on success.
+     * The parent invokes this function for every entity, possibly from several
+     * threads at once, so an implementation must only modify the data owned by
+     * its own entity (parameters and cached representations) and must never
+     * rescale child entities, although it may inspect other entities.
      *
      * @param sf = scaling factor to apply to data
      */
     virtual bool rescale( double sf ) = 0;
 
+
+    /**
+     * Function getMemoryUsage
+     * reports the memory used by this entity; every entity class must
+     * report the memory which it owns in addition to getBaseHeapSize().
+     *
+     * @param aObjectBytes = (O) size of the entity object
+     * @param aHeapBytes = (O) memory owned by the entity, excluding the
+     * lists of referring and extra entities reported by getRefSize()
+     */
+    virtual void getMemoryUsage( size_t& aObjectBytes, size_t& aHeapBytes ) = 0;
+
+    // memory owned by the data common to all entities (label, comments, formatted output)
+    size_t getBaseHeapSize( void );
+
+    // memory used by the lists of referring entities and extra entities
+    size_t getRefSize( void );
+
 public:
     // public functions which must only be used internally by libIGES
 
@@ -202,6 +248,20 @@ public:
     virtual bool associate(std::vector<IGES_ENTITY *> *entities) = 0;
 
 
+    /**
+     * Function getRefIndices
+     * appends to aList the indices (within the list passed to associate())
+     * of all entities which associate() may access; the list is valid after
+     * the Parameter Data has been read and is used to decide when the entity
+     * may be associated while the remainder of a file is being read.
+     * Implementations must append the indices of their own Parameter Data
+     * references and invoke the base implementation.
+     *
+     * @param aList = list of entity indices to append to
+     */
+    virtual void getRefIndices( std::vector<int>& aList );
+
+
     // Routines to manage reference deletion
 
     /**
@@ -278,7 +338,7 @@ public:
      *
      * @param aFile = IGES output file
      */
-    virtual bool writeDE(std::ofstream &aFile);
+    virtual bool writeDE(std::ostream &aFile);
 
 
     /**
@@ -289,7 +349,7 @@ public:
      *
      * @param aFile = IGES output file
      */
-    virtual bool writePD(std::ofstream &aFile);
+    virtual bool writePD(std::ostream &aFile);
 
 
 public:
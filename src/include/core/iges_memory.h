@@ -0,0 +1,79 @@
+/*
+ * file: iges_memory.h
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: estimates of the heap memory owned by the standard
+ * containers used within libIGES; used for memory usage reports.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef IGES_MEMORY_H
+#define IGES_MEMORY_H
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <vector>
+
+// NOTE:
+// The figures exclude allocator overhead; list nodes are taken to hold
+// the item plus two links, which matches the common implementations.
+
+
+// heap memory used by the characters of a string; nothing is
+// counted when the text is held within the string object itself
+inline size_t HeapSize( const std::string& aString )
+{
+    const char* sp = (const char*)&aString;
+    const char* dp = aString.data();
+
+    if( dp >= sp && dp < sp + sizeof( aString ) )
+        return 0;
+
+    return aString.capacity() + 1;
+}
+
+
+template< class T >
+inline size_t HeapSize( const std::vector<T>& aVector )
+{
+    return aVector.capacity() * sizeof( T );
+}
+
+
+template< class T >
+inline size_t HeapSize( const std::list<T>& aList )
+{
+    return aList.size() * ( sizeof( T ) + 2 * sizeof( void* ) );
+}
+
+
+inline size_t HeapSize( const std::vector<std::string>& aVector )
+{
+    size_t nb = aVector.capacity() * sizeof( std::string );
+
+    for( size_t i = 0; i < aVector.size(); ++i )
+        nb += HeapSize( aVector[i] );
+
+    return nb;
+}
+
+#endif  // IGES_MEMORY_H
@@ -0,0 +1,157 @@
+/*
+ * file: iges_names.h
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: index of the names of the Subfigure Definitions
+ * and Name Properties within an IGES object.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef IGES_NAMES_H
+#define IGES_NAMES_H
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <libigesconf.h>
+
+class IGES_ENTITY;
+
+// NOTE:
+// The index maps each NAME of a Subfigure Definition (308) and each
+// name held by a Name Property (406, Form 15) to the entities bearing
+// that name; empty names are not indexed. Like the DE table the index
+// is a mirror of the entity data: it is built from the IGES object's
+// entity list on first use, entities added to or removed from the
+// list are added to or removed from the index, and names changed via
+// IGES_ENTITY_308::SetName() and IGES_ENTITY_406::SetData() are
+// updated in place. Since names may only be changed via those
+// functions each indexed entry is keyed by the entity's current name.
+//
+// Names returned by MakeUnique() and NewName() are reserved under the
+// same lock which checks them so that concurrent callers never obtain
+// the same name; a reservation is released when an entity takes the
+// name and is not affected by invalidating the index.
+//
+// All functions may be invoked from multiple threads.
+
+
+/**
+ * Class IGES_NAME_INDEX
+ * maps part, subassembly and property names to entities
+ * and allocates names which are unique within the model
+ */
+class IGES_NAME_INDEX
+{
+private:
+    mutable std::mutex m_mutex;
+    const std::vector<IGES_ENTITY*>* m_entities;
+    bool m_valid;
+    int  m_partNum;     // index used to create Part Names
+    int  m_assyNum;     // index used to create Assembly Names
+    std::unordered_multimap< std::string, IGES_ENTITY* > m_names;
+    std::unordered_set< std::string > m_reserved;  // names handed out but not yet taken
+
+    // retrieve the name of an entity; returns false if the entity is not named
+    static bool getName( IGES_ENTITY* aEntity, const std::string*& aName );
+    // build the index if necessary; the caller must hold the lock
+    void build( void );
+    // remove the entry for the given name and entity
+    void erase( const std::string& aName, IGES_ENTITY* aEntity );
+    // true if an entity currently bears the given name
+    bool inUse( const std::string& aName );
+    // true if the given name is in use or reserved
+    bool isTaken( const std::string& aName );
+
+public:
+    /**
+     * @param aEntities = entity list of the IGES object which owns the index
+     */
+    IGES_NAME_INDEX( const std::vector<IGES_ENTITY*>* aEntities );
+
+    /**
+     * Function Invalidate
+     * marks the index as out of date with respect to the entity list;
+     * it is rebuilt on next use.
+     */
+    void Invalidate( void );
+
+    /**
+     * Function Add
+     * adds the name of an entity which has been added to the entity list
+     */
+    void Add( IGES_ENTITY* aEntity );
+
+    /**
+     * Function Remove
+     * removes the name of an entity which is being removed from the entity list
+     */
+    void Remove( IGES_ENTITY* aEntity );
+
+    /**
+     * Function Rename
+     * assigns @param aNewName to the name string @param aField owned by
+     * @param aEntity and updates the index accordingly
+     */
+    void Rename( IGES_ENTITY* aEntity, std::string& aField, const std::string& aNewName );
+
+    /**
+     * Function Find
+     * appends all Subfigure Definitions and Name Properties with the
+     * given name to aList and returns the number of entities appended
+     */
+    size_t Find( const std::string& aName, std::vector<IGES_ENTITY*>& aList );
+
+    /**
+     * Function IsUsed
+     * returns true if any entity bears the given name
+     */
+    bool IsUsed( const std::string& aName );
+
+    /**
+     * Function MakeUnique
+     * appends a suffix '-n', n = 1.., to aName if the name is in use
+     * or reserved and reserves the resulting name
+     */
+    void MakeUnique( std::string& aName );
+
+    /**
+     * Function NewName
+     * creates a name of the form partYYYYDDDHHMMSSnnnn or
+     * assyYYYYDDDHHMMSSnnnn which is neither in use nor reserved
+     * and reserves it
+     *
+     * @param aAssembly = true to create an assembly name
+     * @param aName = variable to store the name
+     */
+    void NewName( bool aAssembly, std::string& aName );
+
+    /**
+     * Function GetMemoryUsage
+     * returns the number of bytes used by this object and its data
+     */
+    size_t GetMemoryUsage( void ) const;
+};
+
+#endif  // IGES_NAMES_H
@@ -0,0 +1,106 @@
+/*
+ * file: iges_parallel.h
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: internal helpers for distributing independent work
+ * items among a set of worker threads.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef IGES_PARALLEL_H
+#define IGES_PARALLEL_H
+
+#include <cstddef>
+#include <libigesconf.h>
+
+
+/**
+ * Class IGES_PARALLEL_JOB
+ * is a block of work consisting of independent, indexed items;
+ * RunParallelJob() hands out contiguous ranges of items to
+ * its worker threads. Implementations must not modify any
+ * data shared between items without their own synchronization.
+ */
+class IGES_PARALLEL_JOB
+{
+public:
+    virtual ~IGES_PARALLEL_JOB() {}
+
+    /**
+     * Function Process
+     * processes the items in the range [aFirst, aLast) and returns
+     * true on success; a failure causes all workers to stop taking
+     * new ranges.
+     *
+     * @param aFirst = index of the first item to process
+     * @param aLast = one past the index of the last item to process
+     */
+    virtual bool Process( size_t aFirst, size_t aLast ) = 0;
+};
+
+
+/**
+ * Function GetNWorkerThreads
+ * returns the number of threads to be used for a requested thread
+ * count; a request of 0 or less selects the number of hardware
+ * threads available to the process.
+ *
+ * @param aRequested = desired number of threads (<= 0 = automatic)
+ */
+int GetNWorkerThreads( int aRequested );
+
+
+/**
+ * Function RunParallelJob
+ * processes all items of a job using up to @param aNThreads threads
+ * (including the calling thread) and returns true if every range was
+ * processed successfully. If only a single thread is requested or
+ * there are too few items to be worth splitting then the job is run
+ * in the calling thread.
+ *
+ * @param aJob = job to be executed
+ * @param aNItems = total number of items in the job
+ * @param aNThreads = number of threads to use (<= 0 = automatic)
+ * @param aMinChunk = minimum number of items handed to a thread at one time
+ */
+bool RunParallelJob( IGES_PARALLEL_JOB& aJob, size_t aNItems, int aNThreads,
+                     size_t aMinChunk = 64 );
+
+
+/**
+ * Class IGES_CACHE_LOCK
+ * is a scoped lock which serializes access to the small lists which
+ * are built on demand to pass data across the DLL boundary and to
+ * the DLL layer validation flags; this allows query functions to be
+ * invoked from multiple threads on a model which is not being modified.
+ */
+class IGES_CACHE_LOCK
+{
+private:
+    IGES_CACHE_LOCK( const IGES_CACHE_LOCK& );
+    IGES_CACHE_LOCK& operator=( const IGES_CACHE_LOCK& );
+
+public:
+    IGES_CACHE_LOCK();
+    ~IGES_CACHE_LOCK();
+};
+
+#endif  // IGES_PARALLEL_H
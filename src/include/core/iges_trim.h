@@ -0,0 +1,102 @@
+/*
+ * file: iges_trim.h
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: index of the parameter space boundaries of a
+ * Trimmed Parametric Surface (Entity 144) which classifies points
+ * as inside or outside of the trimmed region.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef IGES_TRIM_H
+#define IGES_TRIM_H
+
+#include <vector>
+#include <libigesconf.h>
+#include <geom/mcad_elements.h>
+
+// NOTE:
+// The boundaries are closed polylines in the (u, v) plane (the X and Y
+// coordinates of the points). A point is inside the trimmed region if
+// a ray from the point crosses the boundaries an odd number of times;
+// with an outer boundary and non-overlapping holes within it this is
+// the region inside the outer boundary and outside all holes. When the
+// surface is bounded by its own edges (no outer boundary) the result
+// is inverted so that only the holes are excluded.
+//
+// The bounding box of the boundaries is divided into a uniform grid
+// of cells; each cell lists the edges which pass through it and
+// records whether its center is inside. A point is classified by
+// counting the crossings of the line from the center of its cell to
+// the point with the few edges of that cell.
+
+
+/**
+ * Class IGES_TRIM_INDEX
+ * classifies points in the parameter space of a trimmed surface
+ */
+class IGES_TRIM_INDEX
+{
+private:
+    bool   m_invert;            // true if the surface has no outer boundary
+    int    m_nx;                // number of cells in U
+    int    m_ny;                // number of cells in V
+    double m_x0;                // lower left corner of the grid
+    double m_y0;
+    double m_dx;                // cell size
+    double m_dy;
+    std::vector<double> m_edges;        // edges as (u0, v0, u1, v1)
+    std::vector<int>    m_cellStart;    // first entry of each cell in m_cellEdges
+    std::vector<int>    m_cellEdges;    // indices of the edges in each cell
+    std::vector<char>   m_cellInside;   // 1 if the center of the cell is inside
+
+    // count the crossings of the line from the center of cell aCell to (aU, aV)
+    int countCrossings( int aCell, double aU, double aV ) const;
+
+public:
+    IGES_TRIM_INDEX();
+
+    /**
+     * Function Build
+     * creates the index from a set of closed polylines and returns
+     * true on success.
+     *
+     * @param aLoops = boundaries; the last point of each loop is joined
+     * to the first point if they are not the same
+     * @param aHasOuter = true if the loops include an outer boundary,
+     * false if the surface is bounded by its own edges
+     */
+    bool Build( const std::vector< std::vector<MCAD_POINT> >& aLoops, bool aHasOuter );
+
+    /**
+     * Function IsInside
+     * returns true if the point (aU, aV) lies within the trimmed region
+     */
+    bool IsInside( double aU, double aV ) const;
+
+    /**
+     * Function GetMemoryUsage
+     * returns the number of bytes used by this object and its data
+     */
+    size_t GetMemoryUsage( void ) const;
+};
+
+#endif  // IGES_TRIM_H
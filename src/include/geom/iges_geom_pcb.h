@@ -73,7 +73,9 @@
 #include <geom/mcad_outline.h>
 
 class IGES_CURVE;
+class IGES_ENTITY;
 class IGES_ENTITY_126;
+class IGES_ENTITY_142;
 class IGES_ENTITY_144;
 
 class IGES_GEOM_PCB : public MCAD_OUTLINE
@@ -100,6 +102,24 @@ private:
                   double offX, double offY, double aScale,
                   double zHeight, MCAD_SEGMENT* aSegment, bool aReverse );
 
+    // routines to trim a plane with boundaries whose BREP representation
+    // is a single curve rather than a composite curve
+    bool trimJoined( IGES* aModel, IGES_ENTITY_144* aPlane, double aHeight, bool aReverse );
+    bool getJoinedBound( IGES* aModel, std::list<MCAD_SEGMENT*>& aSegments,
+                         IGES_ENTITY* aPTS, double aHeight, bool aReverse,
+                         IGES_ENTITY_142** aBound );
+
+    // routines to render the vertical sides of each closed loop as
+    // a single Tabulated Cylinder
+    bool extrudeLoops( IGES* aModel, std::vector<IGES_ENTITY_144*>& aSurface,
+                       double aTopZ, double aBotZ );
+    bool getLoopWall( IGES* aModel, std::vector<IGES_ENTITY_144*>& aSurface,
+                      double aTopZ, double aBotZ, std::list<MCAD_SEGMENT*>& aSegments,
+                      bool aReverse );
+
+    bool mJoinCurves;   // true if BREP trim boundaries are rendered as single curves
+    bool mExtrudeLoops; // true if each closed loop has a single vertical surface
+
 protected:
    // create a Trimmed Parametric Surface entity with only the PTS member instantiated
    IGES_ENTITY_144* getUntrimmedPlane( IGES* aModel, double aHeight, bool aReverse );
@@ -125,6 +145,35 @@ public:
                              std::vector<IGES_ENTITY_144*>& aSurface,
                              double aTopZ, double aBotZ );
 
+    /**
+     * Function SetJoinCurves
+     * determines how GetTrimmedPlane() renders the BREP (parameter space)
+     * representation of each boundary of a plane; by default it is a
+     * Composite Curve (Entity 102) with one or more NURBS curves per
+     * segment of the outline. If aJoin is true those NURBS curves are
+     * joined into a single NURBS curve (Entity 126) which is C0 continuous
+     * at the former segment ends. The geometric representation remains a
+     * Composite Curve of exact lines and arcs.
+     *
+     * @param aJoin is true if each BREP boundary shall be a single NURBS curve
+     */
+    void SetJoinCurves( bool aJoin );
+
+    /**
+     * Function SetExtrudeLoops
+     * determines how GetVerticalSurface() renders the sides of the outline,
+     * cutouts and drill holes; by default each line is a bilinear NURBS
+     * surface (Entity 128) and each arc one or more Surfaces of Revolution
+     * (Entity 120), each within its own Trimmed Parametric Surface. If
+     * aExtrude is true each closed loop is instead rendered as a single
+     * Tabulated Cylinder (Entity 122) whose directrix is the loop joined
+     * into one NURBS curve; arcs within the directrix are exact rational
+     * quadratic curves.
+     *
+     * @param aExtrude is true if each loop shall have a single side surface
+     */
+    void SetExtrudeLoops( bool aExtrude );
+
     // retrieve the trimmed parametric surfaces representing the
     // top or bottom plane of the board
     bool GetTrimmedPlane( IGES* aModel, bool& error,
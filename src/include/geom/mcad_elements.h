@@ -85,6 +85,32 @@ MCAD_API MCAD_POINT operator*(const double scalar, const MCAD_POINT& v);
 // pX = p0 - p1
 MCAD_API MCAD_POINT operator-(const MCAD_POINT& p0, const MCAD_POINT& p1);
 
+#ifdef USE_SISL
+// maximum number of points reported by an intersection of 2 segments
+#define MCAD_MAX_INTERSECTIONS (4)
+
+// intersections of 2 segments; the points are held within the
+// structure so that no dynamic allocation is required
+struct MCAD_API MCAD_INTERSECTIONS
+{
+    int                 npoints;    // number of valid entries in points[]
+    MCAD_INTERSECT_FLAG flags;      // special conditions of the intersection
+    MCAD_POINT          points[MCAD_MAX_INTERSECTIONS];
+
+    MCAD_INTERSECTIONS() : npoints( 0 ), flags( MCAD_IFLAG_NONE ) {}
+
+    // append a point; returns false if the list is full
+    bool Add( const MCAD_POINT& aPoint )
+    {
+        if( npoints >= MCAD_MAX_INTERSECTIONS )
+            return false;
+
+        points[npoints++] = aPoint;
+        return true;
+    }
+};
+#endif
+
 struct MCAD_API MCAD_MATRIX
 {
     double v[3][3];
@@ -0,0 +1,99 @@
+/*
+ * file: mcad_ofstream.h
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: buffered output file stream which overlaps the
+ * formatting of data with writes to disk and only replaces the
+ * target file once all data has been written successfully.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef MCAD_OFSTREAM_H
+#define MCAD_OFSTREAM_H
+
+#include <ostream>
+#include <string>
+#include <libigesconf.h>
+
+class MCAD_OFSTREAM_BUF;
+
+/**
+ * Class MCAD_OFSTREAM
+ * is an output stream which collects data in large buffers; while one
+ * buffer is being filled a background thread writes out the previous
+ * buffer. Data is written to a temporary file which replaces the target
+ * file only when Close() succeeds, so an existing file is preserved if
+ * the output is abandoned or fails.
+ */
+class MCAD_API MCAD_OFSTREAM : public std::ostream
+{
+private:
+    MCAD_OFSTREAM_BUF* m_buf;
+    std::string* m_filename;    // name of the file to be produced
+    std::string* m_tmpname;     // name of the temporary file being written
+    bool m_sync;                // true to sync data to the storage device on Close()
+
+public:
+    MCAD_OFSTREAM();
+
+    /**
+     * destroys the stream; if the stream is still open then
+     * the output is discarded as though Abort() was invoked.
+     */
+    ~MCAD_OFSTREAM();
+
+    /**
+     * Function Open
+     * creates a temporary file to receive the output destined for
+     * the named file and returns true on success; on failure the
+     * failbit is set.
+     *
+     * @param aFileName = name of the file to be produced
+     * @param aSync = true to commit all data to the storage device before
+     * the temporary file replaces the target file
+     */
+    bool Open( const char* aFileName, bool aSync = false );
+
+    /**
+     * Function IsOpen
+     * returns true if the stream is open
+     */
+    bool IsOpen( void );
+
+    /**
+     * Function Close
+     * writes out all pending data, closes the temporary file and
+     * renames it to the target file name; returns true on success.
+     * On failure the temporary file is deleted, any pre-existing
+     * target file is left untouched and the failbit is set.
+     */
+    bool Close( void );
+
+    /**
+     * Function Abort
+     * discards all output and deletes the temporary file; any
+     * pre-existing target file is left untouched.
+     */
+    void Abort( void );
+};
+
+#endif  // MCAD_OFSTREAM_H
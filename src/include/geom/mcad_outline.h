@@ -69,9 +69,11 @@
 
 #include <list>
 #include <string>
+#include <vector>
 #include <libigesconf.h>
 
 class MCAD_SEGMENT;
+struct MCAD_SEGMENT_INDEX;
 
 enum MCAD_OUTLINE_TYPE
 {
@@ -107,6 +109,17 @@ protected:
     bool opOutline( MCAD_SEGMENT* aCircle, bool& error, bool opsub );
     // operate on the generic outline (add/subtract)
     bool opOutline( MCAD_OUTLINE* aOutline, bool& error, bool opsub );
+    // subtract a circle which does not touch the outline or which crosses
+    // it at 2 points away from the segment endpoints; returns false if the
+    // general method must be used, otherwise aResult is set to the result
+    bool subCircleFast( MCAD_SEGMENT* aCircle, bool& aResult );
+    // discard the spatial index of the segments
+    void invalidateIndex( void );
+    // simplify a run of line segments given by the vertices aPts, append
+    // the resulting segments to aSegList and return the index of the
+    // first vertex of the last segment appended
+    size_t simplifyRun( const std::vector<MCAD_POINT>& aPts, double aTolerance,
+                      std::list<MCAD_SEGMENT*>& aSegList );
     // recalculate the bounding box
     void calcBoundingBox( void );
     // adjust the bounding box in preparation for rendering a surface
@@ -121,6 +134,8 @@ protected:
     std::list<MCAD_SEGMENT*> msegments; // list of segments
     std::list<MCAD_OUTLINE*> mcutouts;  // list of non-overlapping cutouts
     std::list<MCAD_SEGMENT*> mholes;    // list of non-overlapping holes
+    MCAD_SEGMENT_INDEX* mSegIndex;      // spatial index of msegments; built on demand
+    bool mFastCutouts;                  // true if subCircleFast() may be used
 
 public:
     MCAD_OUTLINE();
@@ -141,6 +156,15 @@ public:
     void AttachValidFlag( bool* aFlag );
     void DetachValidFlag( bool* aFlag );
 
+    // Enable or disable the indexed method of subtracting circles
+    // which cross the edge of the outline; it is enabled by default.
+    // The indexed method must be used for castellations along edges
+    // which are parallel to an axis: the inside/outside test of the
+    // general method casts rays which may graze the neighbouring
+    // castellations on such an edge and the hole is then misfiled as
+    // a drill hole. On other edges both methods give the same result.
+    void SetFastCutouts( bool aEnable );
+
     std::list<MCAD_SEGMENT*>* GetSegments( void );
     std::list<MCAD_OUTLINE*>* GetCutouts( void );
     std::list<MCAD_SEGMENT*>* GetDrillHoles( void );
@@ -183,6 +207,14 @@ public:
     // the two outlines may only intersect at 2 points.
     bool SubOutline( MCAD_SEGMENT* aCircle, bool& error );
 
+    // Simplify the outline and its cutouts prior to building surfaces:
+    // runs of line segments which lie within aTolerance of a single line
+    // are merged and runs which lie within aTolerance of a circular arc
+    // (or a whole circle) are replaced by that arc, so that an outline
+    // tessellated by an ECAD tool yields a few exact entities. Existing
+    // arcs and circles are not altered. The outline must be closed.
+    bool Simplify( double aTolerance, bool& error );
+
     // Add the given cutout in preparation for exporting a solid model.
     // If the cutout is known to be non-overlapping then the 'overlaps'
     // flag may be set to 'false' to skip overlap tests. If the user
@@ -71,22 +71,22 @@ protected:
 
     // check case where both segments are circles
     bool checkCircles( const MCAD_SEGMENT& aSegment,
-                       std::list<MCAD_POINT>& aIntersectList,
+                       MCAD_INTERSECTIONS& aResult,
                        MCAD_INTERSECT_FLAG& flags );
 
     // check case where both segments are arcs (one may be a circle)
     bool checkArcs( const MCAD_SEGMENT& aSegment,
-                    std::list<MCAD_POINT>& aIntersectList,
+                    MCAD_INTERSECTIONS& aResult,
                     MCAD_INTERSECT_FLAG& flags );
 
     // check case where one segment is an arc and one a line
     bool checkArcLine( const MCAD_SEGMENT& aSegment,
-                       std::list<MCAD_POINT>& aIntersectList,
+                       MCAD_INTERSECTIONS& aResult,
                        MCAD_INTERSECT_FLAG& flags );
 
     // check case where both segments are lines
     bool checkLines( const MCAD_SEGMENT& aSegment,
-                     std::list<MCAD_POINT>& aIntersectList,
+                     MCAD_INTERSECTIONS& aResult,
                      MCAD_INTERSECT_FLAG& flags );
 
     // reverse the point order if applicable
@@ -141,6 +141,11 @@ public:
                            std::list<MCAD_POINT>& aIntersectList,
                            MCAD_INTERSECT_FLAG& flags );
 
+    // + calculate intersections with another segment without any dynamic
+    //   allocation; aResult is cleared before the points are stored
+    bool GetIntersections( const MCAD_SEGMENT& aSegment,
+                           MCAD_INTERSECTIONS& aResult );
+
     // + calculate the bottom-left and top-right rectangular bounds
     bool GetBoundingBox( MCAD_POINT& p0, MCAD_POINT& p1 );
 
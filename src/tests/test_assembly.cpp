@@ -0,0 +1,286 @@
+/*
+ * file: test_assembly.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program writes two part files and assembles them
+ * via IGES::BuildAssembly() with one and with several threads; one
+ * part is listed twice and the other is first listed without any
+ * placements. Apart from the Global section each assembly must be
+ * identical to an assembly built by reading, exporting and placing
+ * each part in turn. An empty part list must succeed and a missing
+ * part file must fail without modifying the assembly.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <core/iges.h>
+#include <core/entity102.h>
+#include <core/entity110.h>
+#include <core/entity124.h>
+#include <core/entity128.h>
+#include <core/entity142.h>
+#include <core/entity144.h>
+#include <core/entity308.h>
+#include <core/entity408.h>
+
+#define PART_A "test_out_assembly_a.igs"
+#define PART_B "test_out_assembly_b.igs"
+#define ONAME "test_out_assembly.igs"
+// number of threads used for the parallel assembly
+#define NTHREADS (4)
+// number of parts in the part list
+#define NPARTS (4)
+
+using namespace std;
+
+
+// write a part consisting of a rectangular trimmed plane
+static bool writePart( const char* aFileName, double aWidth, double aHeight )
+{
+    IGES model;
+    IGES_ENTITY* ep = NULL;
+    IGES_ENTITY* sp = NULL;
+    IGES_ENTITY* bp = NULL;
+    double knots[4] = { 0.0, 0.0, 1.0, 1.0 };
+    double coeff[12] = { 0.0, 0.0, 0.0,  aWidth, 0.0, 0.0,
+                         0.0, aHeight, 0.0,  aWidth, aHeight, 0.0 };
+    double vu[5] = { 0.0, 1.0, 1.0, 0.0, 0.0 };
+    double vv[5] = { 0.0, 0.0, 1.0, 1.0, 0.0 };
+
+    if( !model.NewEntity( ENT_NURBS_SURFACE, &sp )
+        || !((IGES_ENTITY_128*)sp)->SetNURBSData( 2, 2, 2, 2, knots, knots, coeff,
+                                                  false, false, false, 0.0, 1.0, 0.0, 1.0 )
+        || !model.NewEntity( ENT_COMPOSITE_CURVE, &bp ) )
+        return false;
+
+    for( int i = 0; i < 4; ++i )
+    {
+        if( !model.NewEntity( ENT_LINE, &ep ) )
+            return false;
+
+        IGES_ENTITY_110* lp = (IGES_ENTITY_110*)ep;
+        lp->X1 = vu[i];
+        lp->Y1 = vv[i];
+        lp->X2 = vu[i + 1];
+        lp->Y2 = vv[i + 1];
+
+        if( !((IGES_ENTITY_102*)bp)->AddSegment( lp ) )
+            return false;
+    }
+
+    IGES_ENTITY* cp = NULL;
+
+    if( !model.NewEntity( ENT_CURVE_ON_PARAMETRIC_SURFACE, &cp )
+        || !((IGES_ENTITY_142*)cp)->SetSPTR( sp ) || !((IGES_ENTITY_142*)cp)->SetBPTR( bp )
+        || !model.NewEntity( ENT_TRIMMED_PARAMETRIC_SURFACE, &ep )
+        || !((IGES_ENTITY_144*)ep)->SetPTS( sp )
+        || !((IGES_ENTITY_144*)ep)->SetPTO( (IGES_ENTITY_142*)cp ) )
+        return false;
+
+    return model.Write( aFileName, true );
+}
+
+
+// write the model and return the file without its Global section
+static bool getOutput( IGES& aModel, string& aResult )
+{
+    aModel.SetNThreads( 1 );
+
+    if( !aModel.Write( ONAME, true ) )
+    {
+        cerr << "*** could not write '" << ONAME << "'\n";
+        return false;
+    }
+
+    ifstream file( ONAME, ios::in | ios::binary );
+    string line;
+    ostringstream data;
+
+    while( getline( file, line ) )
+    {
+        if( line.size() < 73 || 'G' != line[72] )
+            data << line << "\n";
+    }
+
+    aResult = data.str();
+    return true;
+}
+
+
+static size_t countEntities( IGES& aModel )
+{
+    size_t nTypes = 0;
+    IGES_MEMORY_STATS const* stats = NULL;
+    IGES_MEMORY_STATS total;
+
+    aModel.GetMemoryStats( nTypes, stats, total );
+    return total.count;
+}
+
+
+// read, export and place each part in turn
+static bool buildSerial( const vector<IGES_ASSEMBLY_PART>& aParts, string& aResult )
+{
+    IGES assy;
+    vector<string> names;
+    vector<IGES_ENTITY_308*> defs;
+
+    for( size_t i = 0; i < aParts.size(); ++i )
+    {
+        if( 0 == aParts[i].nPlacements )
+            continue;
+
+        IGES_ENTITY_308* def = NULL;
+
+        for( size_t j = 0; j < names.size() && NULL == def; ++j )
+        {
+            if( names[j] == aParts[i].fileName )
+                def = defs[j];
+        }
+
+        if( NULL == def )
+        {
+            IGES part;
+
+            if( !part.Read( aParts[i].fileName ) || !part.Export( &assy, &def ) || NULL == def )
+            {
+                cerr << "*** could not export '" << aParts[i].fileName << "'\n";
+                return false;
+            }
+
+            names.push_back( aParts[i].fileName );
+            defs.push_back( def );
+        }
+
+        for( size_t j = 0; j < aParts[i].nPlacements; ++j )
+        {
+            IGES_ENTITY* tx = NULL;
+            IGES_ENTITY* ep = NULL;
+
+            if( !assy.NewEntity( ENT_TRANSFORMATION_MATRIX, &tx )
+                || !assy.NewEntity( ENT_SINGULAR_SUBFIGURE_INSTANCE, &ep ) )
+                return false;
+
+            ((IGES_ENTITY_124*)tx)->T = aParts[i].placements[j];
+
+            if( !ep->SetTransform( tx ) || !((IGES_ENTITY_408*)ep)->SetDE( def ) )
+                return false;
+        }
+    }
+
+    return getOutput( assy, aResult );
+}
+
+
+static bool buildAssembly( const vector<IGES_ASSEMBLY_PART>& aParts, int aNThreads,
+                           string& aResult )
+{
+    IGES assy;
+
+    assy.SetNThreads( aNThreads );
+
+    if( !assy.BuildAssembly( aParts.empty() ? NULL : &aParts[0], aParts.size() ) )
+    {
+        cerr << "*** could not build the assembly with " << aNThreads << " threads\n";
+        return false;
+    }
+
+    return getOutput( assy, aResult );
+}
+
+
+int main()
+{
+    if( !writePart( PART_A, 10.0, 5.0 ) || !writePart( PART_B, 3.0, 4.0 ) )
+    {
+        cerr << "*** could not write the parts\n";
+        return -1;
+    }
+
+    vector<MCAD_TRANSFORM> placements( 5 );
+
+    for( size_t i = 0; i < placements.size(); ++i )
+    {
+        placements[i].T.x = 20.0 * i;
+        placements[i].T.y = -5.0 * i;
+    }
+
+    // A (2 placements), B (none), A (1 placement), B (2 placements)
+    const char* files[NPARTS] = { PART_A, PART_B, PART_A, PART_B };
+    size_t nPlace[NPARTS] = { 2, 0, 1, 2 };
+    size_t first[NPARTS] = { 0, 0, 2, 3 };
+    vector<IGES_ASSEMBLY_PART> parts( NPARTS );
+
+    for( int i = 0; i < NPARTS; ++i )
+    {
+        parts[i].fileName = files[i];
+        parts[i].nPlacements = nPlace[i];
+        parts[i].placements = nPlace[i] ? &placements[first[i]] : NULL;
+    }
+
+    string serial;
+    string single;
+    string parallel;
+
+    if( !buildSerial( parts, serial ) || !buildAssembly( parts, 1, single )
+        || !buildAssembly( parts, NTHREADS, parallel ) )
+        return -1;
+
+    if( serial != single || serial != parallel )
+    {
+        cerr << "*** the assemblies differ from the part by part assembly\n";
+        return -1;
+    }
+
+    // an empty part list leaves the model untouched
+    IGES assy;
+    vector<IGES_ASSEMBLY_PART> none;
+
+    if( !assy.BuildAssembly( none.empty() ? NULL : &none[0], none.size() )
+        || 0 != countEntities( assy ) )
+    {
+        cerr << "*** an empty part list was not accepted\n";
+        return -1;
+    }
+
+    // a part which cannot be read leaves the model untouched
+    if( !assy.BuildAssembly( &parts[0], 1 ) )
+    {
+        cerr << "*** could not build the assembly\n";
+        return -1;
+    }
+
+    size_t nEnt = countEntities( assy );
+    parts[3].fileName = "test_out_assembly_missing.igs";
+
+    if( assy.BuildAssembly( &parts[0], parts.size() ) || countEntities( assy ) != nEnt )
+    {
+        cerr << "*** a missing part file modified the assembly\n";
+        return -1;
+    }
+
+    cout << "assemblies match the part by part assembly\n";
+    return 0;
+}
@@ -0,0 +1,123 @@
+#
+# file: test_batch.cmake
+#
+# Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+#
+# Description: This script converts a set of sample boards in batch
+# mode with a cold component model cache and several threads, again
+# with the cache populated and once more with a cold cache and a
+# single thread; all runs must produce the same models. The default
+# cache directory is then created within a private temporary directory
+# and, on POSIX systems, must be refused once others may write to it.
+#
+# usage: cmake -DIDF2IGS=<idf2igs> -DSAMPLES=<dir> -DWORKDIR=<dir> -P test_batch.cmake
+#
+# This file is part of libIGES.
+#
+# libIGES is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# libIGES is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, If not, see
+# <http://www.gnu.org/licenses/> or write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+#
+
+# boards with and without components; pic_programmer and cylinder
+# share some component outlines
+set( BOARDS pic_programmer cylinder test_out0 crescent )
+
+set( BDIR "${WORKDIR}/boards" )
+set( CDIR "${WORKDIR}/cache" )
+set( TDIR "${WORKDIR}/tmp" )
+
+file( REMOVE_RECURSE "${WORKDIR}" )
+file( MAKE_DIRECTORY "${BDIR}" "${CDIR}" "${TDIR}" )
+
+foreach( B ${BOARDS} )
+    file( COPY "${SAMPLES}/${B}.emn" "${SAMPLES}/${B}.emp" DESTINATION "${BDIR}" )
+endforeach()
+
+# convert all boards and store the models without the Global section,
+# which contains the time of creation, in ${OUTVAR}
+macro( convert OUTVAR )
+    execute_process( COMMAND "${IDF2IGS}" ${ARGN} -b "${BDIR}"
+        RESULT_VARIABLE RES OUTPUT_QUIET ERROR_QUIET )
+
+    if( NOT RES EQUAL 0 )
+        message( FATAL_ERROR "*** idf2igs ${ARGN} failed (${RES})" )
+    endif()
+
+    set( ${OUTVAR} "" )
+
+    foreach( B ${BOARDS} )
+        if( NOT EXISTS "${BDIR}/${B}.igs" )
+            message( FATAL_ERROR "*** idf2igs ${ARGN} did not write ${B}.igs" )
+        endif()
+
+        file( READ "${BDIR}/${B}.igs" DATA )
+        string( REGEX REPLACE "[^\n]*G *[0-9]+\r?\n" "" DATA "${DATA}" )
+        string( MD5 SUM "${DATA}" )
+        list( APPEND ${OUTVAR} "${B}:${SUM}" )
+        file( REMOVE "${BDIR}/${B}.igs" )
+    endforeach()
+endmacro()
+
+convert( COLD -c "${CDIR}" -j 3 )
+
+file( GLOB CACHED "${CDIR}/*.igs" )
+
+if( NOT CACHED )
+    message( FATAL_ERROR "*** no component models were cached" )
+endif()
+
+convert( WARM -c "${CDIR}" -j 3 )
+
+if( NOT COLD STREQUAL WARM )
+    message( FATAL_ERROR "*** models built from the cache differ:\n${COLD}\n${WARM}" )
+endif()
+
+file( REMOVE_RECURSE "${CDIR}" )
+file( MAKE_DIRECTORY "${CDIR}" )
+convert( SERIAL -c "${CDIR}" -j 1 )
+
+if( NOT COLD STREQUAL SERIAL )
+    message( FATAL_ERROR "*** concurrent and serial conversions differ:\n${COLD}\n${SERIAL}" )
+endif()
+
+# default cache directory
+set( ENV{TMPDIR} "${TDIR}" )
+set( ENV{TEMP} "${TDIR}" )
+convert( DEFAULT -j 3 )
+
+file( GLOB DEFDIR "${TDIR}/idf2igs_cache*" )
+list( LENGTH DEFDIR NDEF )
+
+if( NOT NDEF EQUAL 1 )
+    message( FATAL_ERROR "*** the default cache directory was not created" )
+endif()
+
+file( GLOB CACHED "${DEFDIR}/*.igs" )
+
+if( NOT CACHED OR NOT COLD STREQUAL DEFAULT )
+    message( FATAL_ERROR "*** conversion with the default cache failed" )
+endif()
+
+if( UNIX )
+    execute_process( COMMAND chmod 0777 "${DEFDIR}" )
+    execute_process( COMMAND "${IDF2IGS}" -b "${BDIR}"
+        RESULT_VARIABLE RES OUTPUT_QUIET ERROR_QUIET )
+
+    if( RES EQUAL 0 )
+        message( FATAL_ERROR "*** a world writable cache directory was accepted" )
+    endif()
+endif()
+
+file( REMOVE_RECURSE "${WORKDIR}" )
@@ -0,0 +1,374 @@
+/*
+ * file: test_bezier.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program evaluates rational B-Spline curves (126)
+ * and surfaces (128) via their cached piecewise Bezier form and checks
+ * the results against a direct de Boor evaluation of the B-Spline data.
+ * The data of each entity is then replaced via SetNURBSData() and the
+ * model is converted to other units to verify that the cached form is
+ * discarded whenever the data changes.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <core/iges.h>
+#include <core/entity126.h>
+#include <core/entity128.h>
+
+// number of parameter values evaluated along each direction
+#define NEVAL (41)
+// maximum permissible deviation from the de Boor evaluation
+#define MAX_DEV (1e-9)
+
+using namespace std;
+
+// a B-Spline in IGES form: control points (X, Y, Z, W) and knots
+struct SPLINE
+{
+    int order;
+    vector<double> knots;
+    vector<double> coeffs;
+};
+
+
+// evaluates a rational B-Spline in homogeneous form via de Boor's algorithm
+// at a parameter value within [knots[order - 1], knots[nc]]; aCoeffs holds
+// nc homogeneous points (X*W, Y*W, Z*W, W)
+static void deBoor( int aOrder, const vector<double>& aKnots,
+                    const vector<double>& aCoeffs, double aParam, double* aResult )
+{
+    int nc = (int)aCoeffs.size() / 4;
+    int span = aOrder - 1;
+
+    while( span < nc - 1 && aParam >= aKnots[span + 1] )
+        ++span;
+
+    vector<double> d( aCoeffs.begin() + 4 * ( span - aOrder + 1 ),
+                      aCoeffs.begin() + 4 * ( span + 1 ) );
+
+    for( int r = 1; r < aOrder; ++r )
+    {
+        for( int j = aOrder - 1; j >= r; --j )
+        {
+            int i = span - aOrder + 1 + j;
+            double a = ( aParam - aKnots[i] ) / ( aKnots[i + aOrder - r] - aKnots[i] );
+
+            for( int k = 0; k < 4; ++k )
+                d[4 * j + k] = ( 1.0 - a ) * d[4 * ( j - 1 ) + k] + a * d[4 * j + k];
+        }
+    }
+
+    for( int k = 0; k < 4; ++k )
+        aResult[k] = d[4 * ( aOrder - 1 ) + k];
+
+    return;
+}
+
+
+static void homogenize( const vector<double>& aCoeffs, vector<double>& aResult )
+{
+    aResult = aCoeffs;
+
+    for( size_t i = 0; i < aResult.size(); i += 4 )
+    {
+        aResult[i] *= aResult[i + 3];
+        aResult[i + 1] *= aResult[i + 3];
+        aResult[i + 2] *= aResult[i + 3];
+    }
+
+    return;
+}
+
+
+static MCAD_POINT curvePoint( const SPLINE& aSpline, double aParam )
+{
+    vector<double> hc;
+    double p[4];
+
+    homogenize( aSpline.coeffs, hc );
+    deBoor( aSpline.order, aSpline.knots, hc, aParam, p );
+
+    return MCAD_POINT( p[0] / p[3], p[1] / p[3], p[2] / p[3] );
+}
+
+
+// the surface is evaluated along U for each control row in V and the
+// resulting points are then evaluated along V
+static MCAD_POINT surfacePoint( const SPLINE& aU, const SPLINE& aV, const vector<double>& aCoeffs,
+                                double aUParam, double aVParam )
+{
+    vector<double> hc;
+    homogenize( aCoeffs, hc );
+
+    int nu = (int)aU.knots.size() - aU.order;
+    int nv = (int)aV.knots.size() - aV.order;
+    vector<double> col( 4 * nv );
+
+    for( int j = 0; j < nv; ++j )
+    {
+        vector<double> row( hc.begin() + 4 * nu * j, hc.begin() + 4 * nu * ( j + 1 ) );
+        deBoor( aU.order, aU.knots, row, aUParam, &col[4 * j] );
+    }
+
+    double p[4];
+    deBoor( aV.order, aV.knots, col, aVParam, p );
+
+    return MCAD_POINT( p[0] / p[3], p[1] / p[3], p[2] / p[3] );
+}
+
+
+static bool samePoint( const MCAD_POINT& p0, const MCAD_POINT& p1 )
+{
+    return fabs( p0.x - p1.x ) <= MAX_DEV && fabs( p0.y - p1.y ) <= MAX_DEV
+        && fabs( p0.z - p1.z ) <= MAX_DEV;
+}
+
+
+// cubic with interior knots of unequal spacing; aVariant alters the
+// control points, the weights and the interior knots
+static void makeCurve( int aVariant, SPLINE& aSpline )
+{
+    aSpline.order = 4;
+    aSpline.knots.clear();
+    aSpline.coeffs.clear();
+
+    double kv[] = { 0.0, 0.0, 0.0, 0.0, 0.2, 0.45, 0.8, 1.0, 1.0, 1.0, 1.0 };
+
+    for( int i = 0; i < 11; ++i )
+    {
+        if( aVariant > 0 && i > 3 && i < 7 )
+            kv[i] = 0.1 * ( i - 2 );
+
+        aSpline.knots.push_back( kv[i] );
+    }
+
+    for( int i = 0; i < 7; ++i )
+    {
+        aSpline.coeffs.push_back( 10.0 * i + aVariant );
+        aSpline.coeffs.push_back( 5.0 * sin( i + aVariant ) );
+        aSpline.coeffs.push_back( 0.5 * i * aVariant );
+        aSpline.coeffs.push_back( 1.0 + 0.5 * ( ( i + aVariant ) % 3 ) );
+    }
+
+    return;
+}
+
+
+static bool checkCurve( IGES_ENTITY_126* aCurve, const SPLINE& aSpline, double aScale,
+                        const char* aStage )
+{
+    vector<double> params( NEVAL );
+    vector<MCAD_POINT> pts( NEVAL );
+
+    for( int i = 0; i < NEVAL; ++i )
+        params[i] = (double)i / ( NEVAL - 1 );
+
+    if( !aCurve->EvalPoints( NEVAL, &params[0], &pts[0] ) )
+    {
+        cerr << "*** " << aStage << ": could not evaluate the curve\n";
+        return false;
+    }
+
+    MCAD_POINT bMin;
+    MCAD_POINT bMax;
+
+    if( !aCurve->GetBoundingBox( bMin, bMax ) )
+    {
+        cerr << "*** " << aStage << ": could not compute the bounding box of the curve\n";
+        return false;
+    }
+
+    for( int i = 0; i < NEVAL; ++i )
+    {
+        MCAD_POINT p = curvePoint( aSpline, params[i] );
+        p = p * aScale;
+
+        if( !samePoint( p, pts[i] ) )
+        {
+            cerr << "*** " << aStage << ": curve point " << i << " differs from the B-Spline\n";
+            return false;
+        }
+
+        if( p.x < bMin.x - MAX_DEV || p.x > bMax.x + MAX_DEV
+            || p.y < bMin.y - MAX_DEV || p.y > bMax.y + MAX_DEV
+            || p.z < bMin.z - MAX_DEV || p.z > bMax.z + MAX_DEV )
+        {
+            cerr << "*** " << aStage << ": curve point " << i << " is outside the bounding box\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static bool setCurve( IGES_ENTITY_126* aCurve, const SPLINE& aSpline )
+{
+    return aCurve->SetNURBSData( (int)aSpline.coeffs.size() / 4, aSpline.order,
+                                 &aSpline.knots[0], &aSpline.coeffs[0], true, 0.0, 1.0 );
+}
+
+
+// biquadratic in U by cubic in V; aVariant alters the control points
+static void makeSurface( int aVariant, SPLINE& aU, SPLINE& aV, vector<double>& aCoeffs )
+{
+    double ku[] = { 0.0, 0.0, 0.0, 0.3, 1.0, 1.0, 1.0 };
+    double kv[] = { 0.0, 0.0, 0.0, 0.0, 0.6, 1.0, 1.0, 1.0, 1.0 };
+
+    aU.order = 3;
+    aU.knots.assign( ku, ku + 7 );
+    aV.order = 4;
+    aV.knots.assign( kv, kv + 9 );
+
+    if( aVariant > 0 )
+        aU.knots[3] = 0.55;
+
+    aCoeffs.clear();
+
+    for( int j = 0; j < 5; ++j )
+    {
+        for( int i = 0; i < 4; ++i )
+        {
+            aCoeffs.push_back( 3.0 * i );
+            aCoeffs.push_back( 2.0 * j );
+            aCoeffs.push_back( cos( i + j + aVariant ) );
+            aCoeffs.push_back( 1.0 + 0.25 * ( ( i + j + aVariant ) % 2 ) );
+        }
+    }
+
+    return;
+}
+
+
+static bool checkSurface( IGES_ENTITY_128* aSurface, const SPLINE& aU, const SPLINE& aV,
+                          const vector<double>& aCoeffs, double aScale, const char* aStage )
+{
+    vector<double> uParams;
+    vector<double> vParams;
+
+    for( int i = 0; i < NEVAL; ++i )
+    {
+        for( int j = 0; j < NEVAL; ++j )
+        {
+            uParams.push_back( (double)i / ( NEVAL - 1 ) );
+            vParams.push_back( (double)j / ( NEVAL - 1 ) );
+        }
+    }
+
+    vector<MCAD_POINT> pts( uParams.size() );
+
+    if( !aSurface->EvalPoints( (int)uParams.size(), &uParams[0], &vParams[0], &pts[0] ) )
+    {
+        cerr << "*** " << aStage << ": could not evaluate the surface\n";
+        return false;
+    }
+
+    for( size_t i = 0; i < pts.size(); ++i )
+    {
+        MCAD_POINT p = surfacePoint( aU, aV, aCoeffs, uParams[i], vParams[i] );
+        p = p * aScale;
+
+        if( !samePoint( p, pts[i] ) )
+        {
+            cerr << "*** " << aStage << ": surface point " << i << " differs from the B-Spline\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static bool setSurface( IGES_ENTITY_128* aSurface, const SPLINE& aU, const SPLINE& aV,
+                        const vector<double>& aCoeffs )
+{
+    int nu = (int)aU.knots.size() - aU.order;
+    int nv = (int)aV.knots.size() - aV.order;
+
+    return aSurface->SetNURBSData( nu, nv, aU.order, aV.order, &aU.knots[0], &aV.knots[0],
+                                   &aCoeffs[0], true, false, false, 0.0, 1.0, 0.0, 1.0 );
+}
+
+
+int main()
+{
+    IGES model;
+    IGES_ENTITY* ep = NULL;
+
+    if( !model.NewEntity( ENT_NURBS_CURVE, &ep ) )
+    {
+        cerr << "*** could not create a NURBS curve\n";
+        return -1;
+    }
+
+    IGES_ENTITY_126* curve = (IGES_ENTITY_126*)ep;
+
+    if( !model.NewEntity( ENT_NURBS_SURFACE, &ep ) )
+    {
+        cerr << "*** could not create a NURBS surface\n";
+        return -1;
+    }
+
+    IGES_ENTITY_128* surface = (IGES_ENTITY_128*)ep;
+
+    SPLINE c0;
+    SPLINE c1;
+    SPLINE u0;
+    SPLINE v0;
+    SPLINE u1;
+    SPLINE v1;
+    vector<double> s0;
+    vector<double> s1;
+
+    makeCurve( 0, c0 );
+    makeCurve( 1, c1 );
+    makeSurface( 0, u0, v0, s0 );
+    makeSurface( 1, u1, v1, s1 );
+
+    // the first evaluation builds the cached form
+    if( !setCurve( curve, c0 ) || !checkCurve( curve, c0, 1.0, "initial data" )
+        || !setSurface( surface, u0, v0, s0 )
+        || !checkSurface( surface, u0, v0, s0, 1.0, "initial data" ) )
+        return -1;
+
+    // new data must replace the cached form
+    if( !setCurve( curve, c1 ) || !checkCurve( curve, c1, 1.0, "new data" )
+        || !setSurface( surface, u1, v1, s1 )
+        || !checkSurface( surface, u1, v1, s1, 1.0, "new data" ) )
+        return -1;
+
+    // rescaling must replace the cached form
+    if( !model.ConvertUnits( UNIT_INCH ) )
+    {
+        cerr << "*** could not convert the model to inches\n";
+        return -1;
+    }
+
+    if( !checkCurve( curve, c1, 1.0 / 25.4, "rescaled data" )
+        || !checkSurface( surface, u1, v1, s1, 1.0 / 25.4, "rescaled data" ) )
+        return -1;
+
+    cout << "cached Bezier forms agree with the B-Spline data\n";
+    return 0;
+}
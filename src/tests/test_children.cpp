@@ -0,0 +1,249 @@
+/*
+ * file: test_children.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program adds, looks up and removes items in the
+ * child lists (IGES_CHILDREN) used by the Composite Curve, Subfigure
+ * Definition and Trimmed Surface entities, both below and above the
+ * size at which the membership index is built, and compares the lists
+ * with a reference list after each step. It then removes members of a
+ * Subfigure Definition (308) and checks that the removed entities no
+ * longer refer to the Subfigure.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <core/iges.h>
+#include <core/iges_children.h>
+#include <core/entity110.h>
+#include <core/entity308.h>
+
+// number of items; well above the size at which the index is built
+#define NITEMS (3 * IGES_CHILDREN_INDEX_MIN)
+
+using namespace std;
+
+
+// compare the list with the reference list and check the membership of all items
+static bool checkList( IGES_CHILDREN<int>& aList, const vector<int*>& aRef,
+                       int* aItems, const char* aStage )
+{
+    if( aList.size() != aRef.size() || aList.empty() != aRef.empty()
+        || ( aRef.empty() && NULL != aList.data() ) )
+    {
+        cerr << "*** " << aStage << ": expected " << aRef.size() << " items, got "
+            << aList.size() << "\n";
+        return false;
+    }
+
+    for( size_t i = 0; i < aRef.size(); ++i )
+    {
+        if( aList[i] != aRef[i] || aList.data()[i] != aRef[i] )
+        {
+            cerr << "*** " << aStage << ": item " << i << " is out of order\n";
+            return false;
+        }
+    }
+
+    for( int i = 0; i < NITEMS; ++i )
+    {
+        bool isRef = find( aRef.begin(), aRef.end(), &aItems[i] ) != aRef.end();
+
+        if( aList.contains( &aItems[i] ) != isRef )
+        {
+            cerr << "*** " << aStage << ": unexpected membership of item " << i << "\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+// add and remove items, crossing the index threshold in both directions
+static bool testList( void )
+{
+    int items[NITEMS];
+    IGES_CHILDREN<int> list;
+    vector<int*> ref;
+
+    for( int i = 0; i < NITEMS; ++i )
+    {
+        items[i] = i;
+
+        if( !list.push_back( &items[i] ) )
+        {
+            cerr << "*** could not add item " << i << "\n";
+            return false;
+        }
+
+        ref.push_back( &items[i] );
+
+        // duplicates are rejected with and without the index
+        if( list.push_back( &items[i] ) || list.push_back( &items[i / 2] ) )
+        {
+            cerr << "*** a duplicate of item " << i << " was accepted\n";
+            return false;
+        }
+
+        if( ( i == IGES_CHILDREN_INDEX_MIN - 1 || i == IGES_CHILDREN_INDEX_MIN
+            || i == IGES_CHILDREN_INDEX_MIN + 1 || i == NITEMS - 1 )
+            && !checkList( list, ref, items, "adding" ) )
+            return false;
+    }
+
+    // remove every third item, then the remaining items from the front
+    for( int i = 0; i < NITEMS; i += 3 )
+    {
+        ref.erase( find( ref.begin(), ref.end(), &items[i] ) );
+
+        if( !list.erase( &items[i] ) || list.erase( &items[i] ) )
+        {
+            cerr << "*** could not remove item " << i << " exactly once\n";
+            return false;
+        }
+    }
+
+    if( !checkList( list, ref, items, "removing every third item" ) )
+        return false;
+
+    // removed items may be added again at the end
+    if( !list.push_back( &items[0] ) )
+    {
+        cerr << "*** could not add a removed item again\n";
+        return false;
+    }
+
+    ref.push_back( &items[0] );
+
+    while( !ref.empty() )
+    {
+        if( !list.erase( ref.front() ) )
+        {
+            cerr << "*** could not remove item " << *ref.front() << "\n";
+            return false;
+        }
+
+        ref.erase( ref.begin() );
+
+        if( ref.size() <= IGES_CHILDREN_INDEX_MIN + 1
+            && !checkList( list, ref, items, "emptying the list" ) )
+            return false;
+    }
+
+    // a cleared list behaves as a new list
+    for( int i = 0; i < NITEMS; ++i )
+        list.push_back( &items[i] );
+
+    list.clear();
+
+    if( !checkList( list, ref, items, "clearing the list" ) )
+        return false;
+
+    if( !list.push_back( &items[1] ) || list.push_back( &items[1] ) || list.erase( &items[2] ) )
+    {
+        cerr << "*** unexpected result after clearing the list\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+// members removed from a Subfigure Definition drop their reference to it
+static bool testSubfigure( void )
+{
+    IGES model;
+    IGES_ENTITY* ep = NULL;
+
+    if( !model.NewEntity( ENT_SUBFIGURE_DEFINITION, &ep ) )
+    {
+        cerr << "*** could not create a Subfigure Definition\n";
+        return false;
+    }
+
+    IGES_ENTITY_308* sp = (IGES_ENTITY_308*)ep;
+    vector<IGES_ENTITY*> lines;
+
+    for( int i = 0; i < NITEMS; ++i )
+    {
+        if( !model.NewEntity( ENT_LINE, &ep ) || !sp->AddDE( ep ) )
+        {
+            cerr << "*** could not add a line to the Subfigure Definition\n";
+            return false;
+        }
+
+        ((IGES_ENTITY_110*)ep)->X2 = i + 1.0;
+        lines.push_back( ep );
+    }
+
+    size_t nDE = 0;
+    IGES_ENTITY** list = NULL;
+
+    // a duplicate member is silently ignored
+    if( !sp->AddDE( lines[3] ) || !sp->GetDEList( nDE, list ) || nDE != NITEMS
+        || lines[3]->getNRefs() != 1 )
+    {
+        cerr << "*** a duplicate member was added\n";
+        return false;
+    }
+
+    for( int i = 0; i < NITEMS; i += 2 )
+    {
+        if( !sp->DelDE( lines[i] ) || sp->DelDE( lines[i] ) )
+        {
+            cerr << "*** could not remove member " << i << " exactly once\n";
+            return false;
+        }
+    }
+
+    if( !sp->GetDEList( nDE, list ) || nDE != NITEMS / 2 )
+    {
+        cerr << "*** expected " << NITEMS / 2 << " members, got " << nDE << "\n";
+        return false;
+    }
+
+    for( int i = 0; i < NITEMS; ++i )
+    {
+        size_t nRefs = ( i & 1 ) ? 1 : 0;
+
+        if( lines[i]->getNRefs() != nRefs || ( ( i & 1 ) && list[i / 2] != lines[i] ) )
+        {
+            cerr << "*** line " << i << " has " << lines[i]->getNRefs()
+                << " references or is out of order\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+int main()
+{
+    if( !testList() || !testSubfigure() )
+        return -1;
+
+    cout << "child lists behave as ordered sets\n";
+    return 0;
+}
@@ -0,0 +1,322 @@
+/*
+ * file: test_copious.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program writes Copious Data entities (106) of
+ * each supported Form to a file, reads the file back and compares
+ * the tuples, the common Z value and the curve properties of the
+ * entities with the originals. A copy of the file in which one entity
+ * has an unsupported Form must still be read; that entity is dropped.
+ * The annotation Forms are not curves and must not be accepted as
+ * segments of a Composite Curve.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <core/iges.h>
+#include <core/iges_detable.h>
+#include <core/entity102.h>
+#include <core/entity106.h>
+
+#define ONAME "test_out_copious.igs"
+#define UNAME "test_out_copious_badform.igs"
+// a Form Number which is not defined for Copious Data
+#define BAD_FORM "      50"
+// number of tuples in each entity
+#define NPTS (25)
+// common Z value for IP = 1
+#define ZVAL (1.5)
+// maximum permissible deviation after writing and reading
+#define MAX_DEV (1e-6)
+
+using namespace std;
+
+static const int forms[] = { 1, 2, 3, 11, 12, 13, 63 };
+static const int nforms = sizeof( forms ) / sizeof( forms[0] );
+static const int annotations[] = { 20, 21, 31, 32, 33, 34, 35, 36, 37, 38, 40 };
+static const int nannotations = sizeof( annotations ) / sizeof( annotations[0] );
+
+
+// tuples along a circle; the last tuple of Form 63 closes the curve
+static void makeData( int aForm, int aTupleSize, vector<double>& aData )
+{
+    aData.clear();
+
+    for( int i = 0; i < NPTS; ++i )
+    {
+        double a = ( aForm == 63 ) ? 2.0 * M_PI * ( i % ( NPTS - 1 ) ) / ( NPTS - 1 )
+                                   : 2.0 * M_PI * i / NPTS;
+
+        aData.push_back( 10.0 * cos( a ) + aForm );
+        aData.push_back( 10.0 * sin( a ) );
+
+        if( aTupleSize > 2 )
+            aData.push_back( 0.1 * i );
+
+        if( aTupleSize > 3 )
+        {
+            aData.push_back( cos( a ) );
+            aData.push_back( sin( a ) );
+            aData.push_back( 0.0 );
+        }
+    }
+
+    return;
+}
+
+
+static bool writeFile( void )
+{
+    IGES model;
+
+    for( int i = 0; i < nforms; ++i )
+    {
+        IGES_ENTITY* ep = NULL;
+
+        if( !model.NewEntity( ENT_COPIOUS_DATA, &ep ) )
+        {
+            cerr << "*** could not create a Copious Data entity\n";
+            return false;
+        }
+
+        IGES_ENTITY_106* cp = (IGES_ENTITY_106*)ep;
+        vector<double> data;
+
+        if( !cp->SetEntityForm( forms[i] ) )
+        {
+            cerr << "*** could not set Form " << forms[i] << "\n";
+            return false;
+        }
+
+        makeData( forms[i], cp->GetTupleSize(), data );
+        cp->ZT = ZVAL;
+
+        if( !cp->SetData( NPTS, &data[0] ) )
+        {
+            cerr << "*** could not set the data of Form " << forms[i] << "\n";
+            return false;
+        }
+    }
+
+    if( !model.Write( ONAME, true ) )
+    {
+        cerr << "*** could not write '" << ONAME << "'\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+static bool checkEntity( IGES_ENTITY_106* cp )
+{
+    int form = cp->GetEntityForm();
+    int ts = cp->GetTupleSize();
+    int np = 0;
+    const double* dp = NULL;
+    vector<double> data;
+
+    makeData( form, ts, data );
+
+    if( !cp->GetData( np, dp ) || np != NPTS )
+    {
+        cerr << "*** Form " << form << ": expected " << NPTS << " tuples, got " << np << "\n";
+        return false;
+    }
+
+    for( int i = 0; i < NPTS * ts; ++i )
+    {
+        if( fabs( dp[i] - data[i] ) > MAX_DEV )
+        {
+            cerr << "*** Form " << form << ": value " << i << " differs\n";
+            return false;
+        }
+    }
+
+    if( cp->GetIP() == 1 && fabs( cp->ZT - ZVAL ) > MAX_DEV )
+    {
+        cerr << "*** Form " << form << ": ZT differs\n";
+        return false;
+    }
+
+    if( cp->IsClosed() != ( form == 63 ) )
+    {
+        cerr << "*** Form " << form << ": unexpected closure\n";
+        return false;
+    }
+
+    vector<MCAD_POINT> poly;
+    bool isPath = cp->GetPolyline( 0.01, poly );
+
+    if( isPath != cp->IsLinearPath() || ( isPath && poly.size() != NPTS ) )
+    {
+        cerr << "*** Form " << form << ": unexpected polyline\n";
+        return false;
+    }
+
+    MCAD_POINT p;
+
+    if( !cp->GetPoint( NPTS - 1, p ) || fabs( p.x - data[( NPTS - 1 ) * ts] ) > MAX_DEV
+        || fabs( p.z - ( ts == 2 ? ZVAL : data[( NPTS - 1 ) * ts + 2] ) ) > MAX_DEV )
+    {
+        cerr << "*** Form " << form << ": last point differs\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+static bool readFile( void )
+{
+    IGES model;
+
+    if( !model.Read( ONAME ) )
+    {
+        cerr << "*** could not read '" << ONAME << "'\n";
+        return false;
+    }
+
+    vector<IGES_ENTITY*> eList;
+
+    model.GetDETable()->SelectType( ENT_COPIOUS_DATA, -1, eList );
+    model.FreeDETable();
+
+    if( (int)eList.size() != nforms )
+    {
+        cerr << "*** expected " << nforms << " Copious Data entities, got "
+            << eList.size() << "\n";
+        return false;
+    }
+
+    for( size_t i = 0; i < eList.size(); ++i )
+    {
+        IGES_ENTITY_106* cp = (IGES_ENTITY_106*)eList[i];
+
+        if( cp->GetEntityForm() != forms[i] )
+        {
+            cerr << "*** entity " << i << ": expected Form " << forms[i]
+                << ", got " << cp->GetEntityForm() << "\n";
+            return false;
+        }
+
+        if( !checkEntity( cp ) )
+            return false;
+    }
+
+    return true;
+}
+
+
+// change the Form of the first entity and read the result; the Form
+// Number is field 15 (columns 33..40) of the second line of a DE
+static bool readBadForm( void )
+{
+    ifstream in( ONAME, ios::in | ios::binary );
+    ofstream out( UNAME, ios::out | ios::binary | ios::trunc );
+    string line;
+    int nDE = 0;
+
+    while( getline( in, line ) )
+    {
+        if( line.size() >= 73 && 'D' == line[72] && 2 == ++nDE )
+            line.replace( 32, 8, BAD_FORM );
+
+        out << line << "\n";
+    }
+
+    out.close();
+
+    IGES model;
+
+    if( nDE < 2 || !model.Read( UNAME ) )
+    {
+        cerr << "*** could not read '" << UNAME << "'\n";
+        return false;
+    }
+
+    vector<IGES_ENTITY*> eList;
+
+    model.GetDETable()->SelectType( ENT_COPIOUS_DATA, -1, eList );
+
+    if( (int)eList.size() != nforms - 1 || eList[0]->GetEntityForm() != forms[1] )
+    {
+        cerr << "*** the entity with an unsupported Form was not discarded\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+// only point sets and piecewise linear curves may become segments
+// of a Composite Curve
+static bool checkSegments( void )
+{
+    IGES model;
+
+    for( int i = 0; i < nforms + nannotations; ++i )
+    {
+        int form = ( i < nforms ) ? forms[i] : annotations[i - nforms];
+        bool isCurve = ( i < nforms ) && form > 10;
+        bool isSegment = ( i < nforms );
+        IGES_ENTITY* ep = NULL;
+        IGES_ENTITY* cc = NULL;
+
+        if( !model.NewEntity( ENT_COPIOUS_DATA, &ep ) || !ep->SetEntityForm( form )
+            || !model.NewEntity( ENT_COMPOSITE_CURVE, &cc ) )
+        {
+            cerr << "*** could not create the entities for Form " << form << "\n";
+            return false;
+        }
+
+        IGES_ENTITY_106* cp = (IGES_ENTITY_106*)ep;
+
+        if( ( 0 == cp->GetNCurves() ) != isCurve )
+        {
+            cerr << "*** Form " << form << ": GetNCurves() returned " << cp->GetNCurves() << "\n";
+            return false;
+        }
+
+        if( ((IGES_ENTITY_102*)cc)->AddSegment( cp ) != isSegment )
+        {
+            cerr << "*** Form " << form << ( isSegment ? " was not" : " was" )
+                << " accepted as a Composite Curve segment\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+int main()
+{
+    if( !writeFile() || !readFile() || !readBadForm() || !checkSegments() )
+        return -1;
+
+    cout << "Copious Data: " << nforms << " Forms written and read back\n";
+    return 0;
+}
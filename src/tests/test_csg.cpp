@@ -0,0 +1,343 @@
+/*
+ * file: test_csg.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program builds a Boolean Tree (180) with a
+ * transform from Right Circular Cylinders (154), Solids of Linear
+ * Extrusion (164) and a nested Boolean Tree with its own transform
+ * and classifies a grid of points against it; the answers are
+ * compared with a direct evaluation of the solid. An operand is
+ * then modified and the classifier reset, and finally an operand
+ * is appended to the tree, to check that the compiled form of the
+ * tree is not reused once it is stale.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <core/iges.h>
+#include <core/entity102.h>
+#include <core/entity110.h>
+#include <core/entity124.h>
+#include <core/entity154.h>
+#include <core/entity164.h>
+#include <core/entity180.h>
+
+// points closer than this to a face are not checked
+#define MARGIN (1e-3)
+
+using namespace std;
+
+// parameters of the solid which are modified by the test
+struct SOLID
+{
+    double radius;      // radius of the main cylinder
+    bool   hasBar;      // true once the bar has been appended
+};
+
+
+// The solid in the coordinates of the outer tree is:
+//   main cylinder: R = radius, axis Z, z in [1, 5] (the base is at
+//     the origin and the operand has a transform of (0, 0, 1))
+//   minus a square extrusion: |x|, |y| <= 1, z in [-1, 7]
+//   union the nested tree translated by (0, 0, 6):
+//     cylinder R = 1, z in [0, 2] intersect extrusion x in [0, 3],
+//     y in [-3, 3], z in [-1, 3]; that is a half cylinder
+//   union (once appended) a bar along X: a cylinder R = 0.5, axis X,
+//     x in [-4, 4] centered on z = 3
+// The outer tree is rotated 90 degrees about X and translated by (5, 0, 0).
+static bool inSolid( const SOLID& aSolid, const MCAD_POINT& aPoint, bool& aNear )
+{
+    // invert the transform of the outer tree: world = R.local + T with
+    // R: (x, y, z) -> (x, -z, y)
+    double x = aPoint.x - 5.0;
+    double y = aPoint.z;
+    double z = -aPoint.y;
+
+    double r2 = x * x + y * y;
+    double r = sqrt( r2 );
+
+    aNear = fabs( r - aSolid.radius ) < MARGIN || fabs( z - 1.0 ) < MARGIN
+        || fabs( z - 5.0 ) < MARGIN || fabs( fabs( x ) - 1.0 ) < MARGIN
+        || fabs( fabs( y ) - 1.0 ) < MARGIN || fabs( r - 1.0 ) < MARGIN
+        || fabs( z - 6.0 ) < MARGIN || fabs( z - 8.0 ) < MARGIN || fabs( x ) < MARGIN;
+
+    bool inMain = r <= aSolid.radius && z >= 1.0 && z <= 5.0
+        && !( fabs( x ) <= 1.0 && fabs( y ) <= 1.0 );
+
+    bool inHalf = r <= 1.0 && z >= 6.0 && z <= 8.0 && x >= 0.0;
+
+    bool inBar = false;
+
+    if( aSolid.hasBar )
+    {
+        double rb = sqrt( y * y + ( z - 3.0 ) * ( z - 3.0 ) );
+        inBar = rb <= 0.5 && x >= -4.0 && x <= 4.0;
+        aNear = aNear || fabs( rb - 0.5 ) < MARGIN || fabs( fabs( x ) - 4.0 ) < MARGIN;
+    }
+
+    return inMain || inHalf || inBar;
+}
+
+
+static IGES_ENTITY_124* newTransform( IGES& aModel, double aX, double aY, double aZ )
+{
+    IGES_ENTITY* ep = NULL;
+
+    if( !aModel.NewEntity( ENT_TRANSFORMATION_MATRIX, &ep ) )
+        return NULL;
+
+    IGES_ENTITY_124* tp = (IGES_ENTITY_124*)ep;
+    tp->T.T.x = aX;
+    tp->T.T.y = aY;
+    tp->T.T.z = aZ;
+
+    return tp;
+}
+
+
+static IGES_ENTITY_154* newCylinder( IGES& aModel, double aRadius, double aHeight,
+                                     const MCAD_POINT& aBase, const MCAD_POINT& aAxis )
+{
+    IGES_ENTITY* ep = NULL;
+
+    if( !aModel.NewEntity( ENT_RIGHT_CIRCULAR_CYLINDER, &ep ) )
+        return NULL;
+
+    IGES_ENTITY_154* cp = (IGES_ENTITY_154*)ep;
+    cp->R = aRadius;
+    cp->H = aHeight;
+    cp->X1 = aBase.x;
+    cp->Y1 = aBase.y;
+    cp->Z1 = aBase.z;
+    cp->I1 = aAxis.x;
+    cp->J1 = aAxis.y;
+    cp->K1 = aAxis.z;
+
+    return cp;
+}
+
+
+// rectangle [x0, x1] x [y0, y1] at z = aZ extruded along Z by aLength
+static IGES_ENTITY_164* newBox( IGES& aModel, double aX0, double aX1, double aY0, double aY1,
+                                double aZ, double aLength )
+{
+    IGES_ENTITY* ep = NULL;
+
+    if( !aModel.NewEntity( ENT_COMPOSITE_CURVE, &ep ) )
+        return NULL;
+
+    IGES_ENTITY_102* cc = (IGES_ENTITY_102*)ep;
+    double vx[5] = { aX0, aX1, aX1, aX0, aX0 };
+    double vy[5] = { aY0, aY0, aY1, aY1, aY0 };
+
+    for( int i = 0; i < 4; ++i )
+    {
+        if( !aModel.NewEntity( ENT_LINE, &ep ) )
+            return NULL;
+
+        IGES_ENTITY_110* lp = (IGES_ENTITY_110*)ep;
+        lp->X1 = vx[i];
+        lp->Y1 = vy[i];
+        lp->Z1 = aZ;
+        lp->X2 = vx[i + 1];
+        lp->Y2 = vy[i + 1];
+        lp->Z2 = aZ;
+
+        if( !cc->AddSegment( lp ) )
+            return NULL;
+    }
+
+    if( !aModel.NewEntity( ENT_SOLID_OF_LINEAR_EXTRUSION, &ep ) )
+        return NULL;
+
+    IGES_ENTITY_164* xp = (IGES_ENTITY_164*)ep;
+
+    if( !xp->SetClosedCurve( cc ) )
+        return NULL;
+
+    xp->L = aLength;
+    xp->I1 = 0.0;
+    xp->J1 = 0.0;
+    xp->K1 = 1.0;
+
+    return xp;
+}
+
+
+static bool checkTree( IGES_ENTITY_180* aTree, const SOLID& aSolid, const char* aStage )
+{
+    vector<MCAD_POINT> pts;
+
+    // the solid lies within x in [0, 10], y in [-9, 0], z in [-5, 5]
+    for( double x = -0.1237; x < 10.2; x += 0.2113 )
+    {
+        for( double y = -9.1173; y < 0.2; y += 0.2311 )
+        {
+            for( double z = -5.0917; z < 5.2; z += 0.2473 )
+                pts.push_back( MCAD_POINT( x, y, z ) );
+        }
+    }
+
+    std::unique_ptr<bool[]> result( new bool[pts.size()] );
+
+    if( !aTree->ClassifyPoints( (int)pts.size(), &pts[0], result.get() ) )
+    {
+        cerr << "*** " << aStage << ": could not classify the points\n";
+        return false;
+    }
+
+    size_t nIn = 0;
+    size_t nOut = 0;
+
+    for( size_t i = 0; i < pts.size(); ++i )
+    {
+        bool nearFace = false;
+        bool ref = inSolid( aSolid, pts[i], nearFace );
+
+        if( nearFace )
+            continue;
+
+        if( ref != result[i] )
+        {
+            cerr << "*** " << aStage << ": point (" << pts[i].x << ", " << pts[i].y
+                << ", " << pts[i].z << ") classified as "
+                << ( result[i] ? "inside" : "outside" ) << "\n";
+            return false;
+        }
+
+        if( ref )
+            ++nIn;
+        else
+            ++nOut;
+    }
+
+    // guard against a degenerate test
+    if( nIn < 100 || nOut < 100 )
+    {
+        cerr << "*** " << aStage << ": too few points inside (" << nIn
+            << ") or outside (" << nOut << ")\n";
+        return false;
+    }
+
+    // the single point query must agree with the batch query
+    bool in = !result[0];
+
+    if( !aTree->ClassifyPoint( pts[0], in ) || in != result[0] )
+    {
+        cerr << "*** " << aStage << ": single and batch classifications differ\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+int main()
+{
+    IGES model;
+    IGES_ENTITY* ep = NULL;
+    SOLID solid;
+
+    solid.radius = 2.0;
+    solid.hasBar = false;
+
+    // nested tree: half cylinder translated by (0, 0, 6)
+    IGES_ENTITY_154* halfCyl = newCylinder( model, 1.0, 2.0, MCAD_POINT( 0.0, 0.0, 0.0 ),
+                                            MCAD_POINT( 0.0, 0.0, 1.0 ) );
+    IGES_ENTITY_164* halfBox = newBox( model, 0.0, 3.0, -3.0, 3.0, -1.0, 4.0 );
+    IGES_ENTITY_124* halfTx = newTransform( model, 0.0, 0.0, 6.0 );
+
+    if( NULL == halfCyl || NULL == halfBox || NULL == halfTx
+        || !model.NewEntity( ENT_BOOLEAN_TREE, &ep ) )
+    {
+        cerr << "*** could not create the nested tree\n";
+        return -1;
+    }
+
+    IGES_ENTITY_180* nested = (IGES_ENTITY_180*)ep;
+
+    if( !nested->AddArg( halfCyl ) || !nested->AddArg( halfBox )
+        || !nested->AddOp( OP_INTERSECT ) || !nested->SetTransform( halfTx ) )
+    {
+        cerr << "*** could not build the nested tree\n";
+        return -1;
+    }
+
+    // outer tree: (main cylinder - square extrusion) + nested tree
+    IGES_ENTITY_154* mainCyl = newCylinder( model, solid.radius, 4.0, MCAD_POINT( 0.0, 0.0, 0.0 ),
+                                            MCAD_POINT( 0.0, 0.0, 1.0 ) );
+    IGES_ENTITY_124* mainTx = newTransform( model, 0.0, 0.0, 1.0 );
+    IGES_ENTITY_164* hole = newBox( model, -1.0, 1.0, -1.0, 1.0, -1.0, 8.0 );
+    IGES_ENTITY_124* treeTx = newTransform( model, 5.0, 0.0, 0.0 );
+
+    if( NULL == mainCyl || NULL == mainTx || NULL == hole || NULL == treeTx
+        || !mainCyl->SetTransform( mainTx ) || !model.NewEntity( ENT_BOOLEAN_TREE, &ep ) )
+    {
+        cerr << "*** could not create the outer tree\n";
+        return -1;
+    }
+
+    // rotate 90 degrees about X: (x, y, z) -> (x, -z, y)
+    treeTx->T.R.v[1][1] = 0.0;
+    treeTx->T.R.v[1][2] = -1.0;
+    treeTx->T.R.v[2][1] = 1.0;
+    treeTx->T.R.v[2][2] = 0.0;
+
+    IGES_ENTITY_180* tree = (IGES_ENTITY_180*)ep;
+
+    if( !tree->AddArg( mainCyl ) || !tree->AddArg( hole ) || !tree->AddOp( OP_DIFFERENCE )
+        || !tree->AddArg( nested ) || !tree->AddOp( OP_UNION ) || !tree->SetTransform( treeTx ) )
+    {
+        cerr << "*** could not build the outer tree\n";
+        return -1;
+    }
+
+    if( !checkTree( tree, solid, "initial tree" ) )
+        return -1;
+
+    // a modified operand is only seen once the classifier is reset
+    mainCyl->R = 3.0;
+    solid.radius = 3.0;
+    tree->ResetClassifier();
+
+    if( !checkTree( tree, solid, "modified operand" ) )
+        return -1;
+
+    // an appended operand must be seen without a reset
+    IGES_ENTITY_154* bar = newCylinder( model, 0.5, 8.0, MCAD_POINT( -4.0, 0.0, 3.0 ),
+                                        MCAD_POINT( 1.0, 0.0, 0.0 ) );
+    solid.hasBar = true;
+
+    if( NULL == bar || !tree->AddArg( bar ) || !tree->AddOp( OP_UNION ) )
+    {
+        cerr << "*** could not append an operand to the tree\n";
+        return -1;
+    }
+
+    if( !checkTree( tree, solid, "appended operand" ) )
+        return -1;
+
+    cout << "Boolean Tree classification agrees with the solid\n";
+    return 0;
+}
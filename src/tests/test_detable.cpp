@@ -0,0 +1,252 @@
+/*
+ * file: test_detable.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program creates, modifies and deletes entities
+ * while a Directory Entry attribute table is in use, writes the model
+ * and reads it back into an IGES object which already holds a table.
+ * After each step every row of the table is compared with the
+ * attributes of its entity and the table must list each entity of
+ * the model exactly once.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+#include <core/iges.h>
+#include <core/iges_detable.h>
+#include <core/entity102.h>
+#include <core/entity110.h>
+
+#define ONAME "test_out_detable.igs"
+#define NLINES (8)
+
+using namespace std;
+
+
+// compare every row with its entity and the number of rows with the model
+static bool checkTable( IGES& aModel, const char* aStage )
+{
+    const IGES_DE_TABLE* tp = aModel.GetDETable();
+    size_t nTypes = 0;
+    IGES_MEMORY_STATS const* stats = NULL;
+    IGES_MEMORY_STATS total;
+
+    if( NULL == tp || !tp->IsValid() || !aModel.GetMemoryStats( nTypes, stats, total ) )
+    {
+        cerr << "*** " << aStage << ": no table\n";
+        return false;
+    }
+
+    if( tp->size() != total.count )
+    {
+        cerr << "*** " << aStage << ": the table has " << tp->size() << " rows for "
+            << total.count << " entities\n";
+        return false;
+    }
+
+    set<IGES_ENTITY*> seen;
+
+    for( size_t i = 0; i < tp->size(); ++i )
+    {
+        IGES_ENTITY* ep = tp->GetEntities()[i];
+        int level = -1;
+        IGES_COLOR color = COLOR_NONE;
+        int weight = 0;
+        string label;
+
+        if( !seen.insert( ep ).second )
+        {
+            cerr << "*** " << aStage << ": row " << i << " repeats an entity\n";
+            return false;
+        }
+
+        if( !ep->GetLevel( level ) )
+            level = -1;
+
+        if( !ep->GetColor( color ) )
+            color = (IGES_COLOR)-1;
+
+        ep->GetLineWeightNum( weight );
+        ep->GetLabel( label );
+
+        if( tp->GetTypes()[i] != ep->GetEntityType()
+            || tp->GetForms()[i] != ep->GetEntityForm()
+            || tp->GetLevels()[i] != level
+            || tp->GetColors()[i] != (int)color
+            || tp->GetLineWeights()[i] != weight
+            || tp->GetNRefs()[i] != (int)ep->getNRefs()
+            || label.substr( 0, IGES_DE_LABEL_SIZE - 1 ) != tp->GetLabel( i ) )
+        {
+            cerr << "*** " << aStage << ": row " << i << " differs from its entity\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static IGES_ENTITY_110* newLine( IGES& aModel, int aIndex )
+{
+    IGES_ENTITY* ep = NULL;
+
+    if( !aModel.NewEntity( ENT_LINE, &ep ) )
+    {
+        cerr << "*** could not create a Line\n";
+        return NULL;
+    }
+
+    IGES_ENTITY_110* lp = (IGES_ENTITY_110*)ep;
+    lp->X1 = aIndex;
+    lp->X2 = aIndex + 1.0;
+
+    return lp;
+}
+
+
+int main()
+{
+    IGES model;
+    vector<IGES_ENTITY_110*> lines;
+
+    // the table of an empty model
+    if( !checkTable( model, "empty model" ) )
+        return -1;
+
+    for( int i = 0; i < NLINES; ++i )
+    {
+        IGES_ENTITY_110* lp = newLine( model, i );
+
+        if( NULL == lp || !lp->SetLevel( i % 3 ) || !lp->SetColor( (IGES_COLOR)( i % 4 + 1 ) ) )
+            return -1;
+
+        lines.push_back( lp );
+    }
+
+    if( !checkTable( model, "new entities" ) )
+        return -1;
+
+    // attributes set while the table is current update its rows
+    const IGES_DE_TABLE* tp = model.GetDETable();
+    vector<IGES_ENTITY*> eList;
+
+    if( !lines[1]->SetLevel( 42 ) || !lines[2]->SetColor( COLOR_CYAN )
+        || !lines[3]->SetLabel( "EDGE" ) || !lines[4]->SetLineWeightNum( 1 )
+        || 1 != tp->SelectLevel( 42, eList ) || eList[0] != lines[1] )
+    {
+        cerr << "*** the table was not updated by the attribute setters\n";
+        return -1;
+    }
+
+    if( !checkTable( model, "modified attributes" ) )
+        return -1;
+
+    // references added by a parent
+    IGES_ENTITY* ep = NULL;
+
+    if( !model.NewEntity( ENT_COMPOSITE_CURVE, &ep ) )
+    {
+        cerr << "*** could not create a Composite Curve\n";
+        return -1;
+    }
+
+    IGES_ENTITY_102* cc = (IGES_ENTITY_102*)ep;
+
+    if( !checkTable( model, "new parent" ) )
+        return -1;
+
+    for( int i = 0; i < 4; ++i )
+    {
+        if( !cc->AddSegment( lines[i] ) )
+        {
+            cerr << "*** could not add a segment to the Composite Curve\n";
+            return -1;
+        }
+    }
+
+    if( !checkTable( model, "new references" ) )
+        return -1;
+
+    // deleted entities leave the table
+    IGES_ENTITY_110* dp = lines[6];
+
+    if( !model.DelEntity( dp ) )
+    {
+        cerr << "*** could not delete a Line\n";
+        return -1;
+    }
+
+    lines.erase( lines.begin() + 6 );
+    tp = model.GetDETable();
+
+    for( size_t i = 0; i < tp->size(); ++i )
+    {
+        if( tp->GetEntities()[i] == (IGES_ENTITY*)dp )
+        {
+            cerr << "*** a deleted entity remains in the table\n";
+            return -1;
+        }
+    }
+
+    if( !checkTable( model, "deleted entity" ) )
+        return -1;
+
+    if( !model.Write( ONAME, true ) )
+    {
+        cerr << "*** could not write '" << ONAME << "'\n";
+        return -1;
+    }
+
+    size_t nTypes = 0;
+    IGES_MEMORY_STATS const* stats = NULL;
+    IGES_MEMORY_STATS written;
+
+    model.GetMemoryStats( nTypes, stats, written );
+
+    // read into a cleared model whose table was in use
+    if( !model.Clear() || !checkTable( model, "cleared model" ) )
+        return -1;
+
+    if( !model.Read( ONAME ) )
+    {
+        cerr << "*** could not read '" << ONAME << "'\n";
+        return -1;
+    }
+
+    if( !checkTable( model, "model read from file" ) )
+        return -1;
+
+    tp = model.GetDETable();
+    eList.clear();
+
+    if( tp->size() != written.count || 1 != tp->SelectLevel( 42, eList )
+        || 1 != tp->SelectType( ENT_COMPOSITE_CURVE, -1, eList ) )
+    {
+        cerr << "*** the model read from file has the wrong entities\n";
+        return -1;
+    }
+
+    cout << "the DE table follows the entity list\n";
+    return 0;
+}
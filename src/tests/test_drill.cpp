@@ -0,0 +1,369 @@
+/*
+ * file: test_drill.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program drills a board with rounded corners
+ * along all of its edges (castellated holes) and across its interior
+ * (vias). The holes are applied once with the indexed method of
+ * subtracting circles and once with the general method; the resulting
+ * outlines are compared and the time taken by each method is reported.
+ * The board is rotated since the general method misfiles castellations
+ * on edges parallel to an axis; an unrotated board is drilled with the
+ * indexed method only. Each castellation and each hole on a joint must
+ * be cut into the edge and each via must become a drill hole.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <api/dll_mcad_segment.h>
+#include <api/dll_mcad_outline.h>
+#include <geom/mcad_segment.h>
+
+// board dimensions, radius of the corners and rotation of the board;
+// the rotation keeps the rays cast by the general method's inside/outside
+// test from grazing the castellations along an edge
+#define BOARD_W (200.0)
+#define BOARD_H (100.0)
+#define BOARD_R (5.0)
+#define BOARD_ROT (20.0)
+// pitch and radius of the castellated holes
+#define EDGE_PITCH (0.3)
+#define EDGE_RAD (0.1)
+// pitch and radius of the vias
+#define VIA_PITCH (2.5)
+#define VIA_RAD (0.2)
+// maximum permissible deviation between the two methods
+#define MAX_DEV (1e-9)
+
+using namespace std;
+
+struct HOLE
+{
+    MCAD_POINT center;
+    double     radius;
+};
+
+// number of holes of each kind
+struct HOLE_COUNT
+{
+    int nEdge;      // castellations, each splitting a segment
+    int nJoint;     // holes centered on the joint of 2 segments
+    int nVia;       // holes clear of the edge
+};
+
+
+// create a point in the coordinates of a board rotated by aRot degrees
+static MCAD_POINT mkPoint( double x, double y, double aRot )
+{
+    double ca = cos( aRot * M_PI / 180.0 );
+    double sa = sin( aRot * M_PI / 180.0 );
+    MCAD_POINT p;
+    p.x = x * ca - y * sa;
+    p.y = x * sa + y * ca;
+    return p;
+}
+
+
+static void addHole( vector<HOLE>& aHoles, double x, double y, double r, double aRot )
+{
+    HOLE h;
+    h.center = mkPoint( x, y, aRot );
+    h.radius = r;
+    aHoles.push_back( h );
+}
+
+
+// castellations along the straight edges and the corner arcs,
+// holes centered on the joints of the edges and a field of vias
+static void makeHoles( vector<HOLE>& aHoles, double aRot, HOLE_COUNT& aCount )
+{
+    double x0 = BOARD_R + 1.0;
+    double x1 = BOARD_W - BOARD_R - 1.0;
+    double y0 = BOARD_R + 1.0;
+    double y1 = BOARD_H - BOARD_R - 1.0;
+
+    aCount.nEdge = 0;
+    aCount.nJoint = 0;
+    aCount.nVia = 0;
+
+    for( double x = x0; x < x1; x += EDGE_PITCH )
+    {
+        addHole( aHoles, x, 0.0, EDGE_RAD, aRot );
+        addHole( aHoles, x, BOARD_H, EDGE_RAD, aRot );
+        aCount.nEdge += 2;
+    }
+
+    for( double y = y0; y < y1; y += EDGE_PITCH )
+    {
+        addHole( aHoles, 0.0, y, EDGE_RAD, aRot );
+        addHole( aHoles, BOARD_W, y, EDGE_RAD, aRot );
+        aCount.nEdge += 2;
+    }
+
+    double cx[4] = { BOARD_W - BOARD_R, BOARD_W - BOARD_R, BOARD_R, BOARD_R };
+    double cy[4] = { BOARD_R, BOARD_H - BOARD_R, BOARD_H - BOARD_R, BOARD_R };
+
+    for( int i = 0; i < 4; ++i )
+    {
+        double a0 = ( i * 90.0 - 90.0 ) * M_PI / 180.0;
+
+        // castellations along the corner arc
+        for( int j = 1; j < 6; ++j )
+        {
+            double a = a0 + j * M_PI / 12.0;
+            addHole( aHoles, cx[i] + BOARD_R * cos( a ), cy[i] + BOARD_R * sin( a ),
+                     EDGE_RAD, aRot );
+            ++aCount.nEdge;
+        }
+
+        // holes on the joints between the arc and the straight edges
+        addHole( aHoles, cx[i] + BOARD_R * cos( a0 ), cy[i] + BOARD_R * sin( a0 ), 0.5, aRot );
+        addHole( aHoles, cx[i] + BOARD_R * cos( a0 + M_PI * 0.5 ),
+                 cy[i] + BOARD_R * sin( a0 + M_PI * 0.5 ), 0.5, aRot );
+        aCount.nJoint += 2;
+    }
+
+    for( double x = 2.0 * VIA_PITCH; x < BOARD_W - VIA_PITCH; x += VIA_PITCH )
+    {
+        for( double y = 2.0 * VIA_PITCH; y < BOARD_H - VIA_PITCH; y += VIA_PITCH )
+        {
+            addHole( aHoles, x, y, VIA_RAD, aRot );
+            ++aCount.nVia;
+        }
+    }
+
+    return;
+}
+
+
+static bool makeBoard( DLL_MCAD_OUTLINE& aBoard, double aRot )
+{
+    // CCW outline with arcs at the corners
+    MCAD_POINT v[8];
+    MCAD_POINT c[4];
+
+    v[0] = mkPoint( BOARD_R, 0.0, aRot );
+    v[1] = mkPoint( BOARD_W - BOARD_R, 0.0, aRot );
+    v[2] = mkPoint( BOARD_W, BOARD_R, aRot );
+    v[3] = mkPoint( BOARD_W, BOARD_H - BOARD_R, aRot );
+    v[4] = mkPoint( BOARD_W - BOARD_R, BOARD_H, aRot );
+    v[5] = mkPoint( BOARD_R, BOARD_H, aRot );
+    v[6] = mkPoint( 0.0, BOARD_H - BOARD_R, aRot );
+    v[7] = mkPoint( 0.0, BOARD_R, aRot );
+    c[0] = mkPoint( BOARD_W - BOARD_R, BOARD_R, aRot );
+    c[1] = mkPoint( BOARD_W - BOARD_R, BOARD_H - BOARD_R, aRot );
+    c[2] = mkPoint( BOARD_R, BOARD_H - BOARD_R, aRot );
+    c[3] = mkPoint( BOARD_R, BOARD_R, aRot );
+
+    bool error = false;
+
+    for( int i = 0; i < 4; ++i )
+    {
+        DLL_MCAD_SEGMENT line( true );
+        DLL_MCAD_SEGMENT arc( true );
+
+        if( !line.SetParams( v[2 * i], v[2 * i + 1] )
+            || !arc.SetParams( c[i], v[2 * i + 1], v[( 2 * i + 2 ) % 8], false )
+            || !aBoard.AddSegment( line, error )
+            || !aBoard.AddSegment( arc, error ) )
+        {
+            cerr << "*** could not create the board outline\n";
+            return false;
+        }
+    }
+
+    bool closed = false;
+
+    if( !aBoard.IsClosed( closed ) || !closed )
+    {
+        cerr << "*** the board outline is not closed\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+// drill all holes and return the time taken in microseconds or -1 on failure
+static long long drill( DLL_MCAD_OUTLINE& aBoard, const vector<HOLE>& aHoles, bool aFast )
+{
+    aBoard.SetFastCutouts( aFast );
+
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+    for( size_t i = 0; i < aHoles.size(); ++i )
+    {
+        DLL_MCAD_SEGMENT circ( true );
+        MCAD_POINT p = aHoles[i].center;
+        bool error = false;
+
+        p.x += aHoles[i].radius;
+
+        if( !circ.SetParams( aHoles[i].center, p, p, false )
+            || !aBoard.AddCutout( circ, true, error ) )
+        {
+            cerr << "*** could not drill hole " << i << " at (" << aHoles[i].center.x
+                << ", " << aHoles[i].center.y << ")\n";
+            return -1;
+        }
+    }
+
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+    return (long long)chrono::duration_cast< chrono::microseconds >( t1 - t0 ).count();
+}
+
+
+static bool samePoint( const MCAD_POINT& p0, const MCAD_POINT& p1 )
+{
+    return fabs( p0.x - p1.x ) <= MAX_DEV && fabs( p0.y - p1.y ) <= MAX_DEV;
+}
+
+
+static bool compare( DLL_MCAD_OUTLINE& aFast, DLL_MCAD_OUTLINE& aGeneral )
+{
+    MCAD_SEGMENT** sF = NULL;
+    MCAD_SEGMENT** sG = NULL;
+    int nF = 0;
+    int nG = 0;
+    bool ok = true;
+
+    aFast.GetSegments( sF, nF );
+    aGeneral.GetSegments( sG, nG );
+
+    if( nF != nG )
+    {
+        cerr << "*** number of segments differs (" << nF << " vs. " << nG << ")\n";
+        ok = false;
+    }
+
+    for( int i = 0; ok && i < nF; ++i )
+    {
+        if( sF[i]->GetSegType() != sG[i]->GetSegType()
+            || sF[i]->IsCW() != sG[i]->IsCW()
+            || !samePoint( sF[i]->GetStart(), sG[i]->GetStart() )
+            || !samePoint( sF[i]->GetEnd(), sG[i]->GetEnd() ) )
+        {
+            cerr << "*** segment " << i << " differs\n";
+            ok = false;
+        }
+    }
+
+    delete [] sF;
+    delete [] sG;
+
+    MCAD_SEGMENT** hF = NULL;
+    MCAD_SEGMENT** hG = NULL;
+
+    aFast.GetDrillHoles( hF, nF );
+    aGeneral.GetDrillHoles( hG, nG );
+
+    if( nF != nG )
+    {
+        cerr << "*** number of drill holes differs (" << nF << " vs. " << nG << ")\n";
+        ok = false;
+    }
+
+    delete [] hF;
+    delete [] hG;
+
+    return ok;
+}
+
+
+// every castellation adds an arc and splits a segment, every hole on a
+// joint replaces the joint with an arc and every via is a drill hole
+static bool checkCounts( DLL_MCAD_OUTLINE& aBoard, const HOLE_COUNT& aCount, const char* aName )
+{
+    MCAD_SEGMENT** segs = NULL;
+    int nSegs = 0;
+    int nHoles = 0;
+
+    aBoard.GetSegments( segs, nSegs );
+    delete [] segs;
+    aBoard.GetDrillHoles( segs, nHoles );
+    delete [] segs;
+
+    int nExpSegs = 8 + 2 * aCount.nEdge + aCount.nJoint;
+
+    if( nSegs != nExpSegs || nHoles != aCount.nVia )
+    {
+        cerr << "*** " << aName << ": expected " << nExpSegs << " segments and " << aCount.nVia
+            << " drill holes, got " << nSegs << " and " << nHoles << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+int main()
+{
+    vector<HOLE> holes;
+    HOLE_COUNT count;
+    makeHoles( holes, BOARD_ROT, count );
+
+    DLL_MCAD_OUTLINE fast( true );
+    DLL_MCAD_OUTLINE general( true );
+
+    if( !makeBoard( fast, BOARD_ROT ) || !makeBoard( general, BOARD_ROT ) )
+        return -1;
+
+    long long tFast = drill( fast, holes, true );
+    long long tGeneral = drill( general, holes, false );
+
+    if( tFast < 0 || tGeneral < 0 )
+        return -1;
+
+    MCAD_SEGMENT** segs = NULL;
+    int nSegs = 0;
+
+    fast.GetSegments( segs, nSegs );
+    delete [] segs;
+
+    cout << "board " << BOARD_W << " x " << BOARD_H << ": " << holes.size()
+        << " holes, " << nSegs << " segments in the final outline\n";
+    cout << "  indexed method: " << tFast << " us\n";
+    cout << "  general method: " << tGeneral << " us\n";
+
+    if( !compare( fast, general ) )
+    {
+        cerr << "*** the indexed and general methods produced different outlines\n";
+        return -1;
+    }
+
+    if( !checkCounts( fast, count, "rotated board" ) )
+        return -1;
+
+    // castellations along axis-aligned edges
+    vector<HOLE> aligned;
+    DLL_MCAD_OUTLINE board( true );
+    makeHoles( aligned, 0.0, count );
+
+    if( !makeBoard( board, 0.0 ) || drill( board, aligned, true ) < 0
+        || !checkCounts( board, count, "unrotated board" ) )
+        return -1;
+
+    return 0;
+}
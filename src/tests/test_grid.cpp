@@ -0,0 +1,352 @@
+/*
+ * file: test_grid.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program evaluates rational and polynomial NURBS
+ * surfaces on a regular grid of parameter values using the native
+ * grid evaluator of Entity 128. Points and first partial derivatives
+ * are checked against SISL and the time taken is compared with that
+ * of evaluating each point individually.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <sisl.h>
+#include <api/dll_iges.h>
+#include <api/dll_entity128.h>
+
+// number of grid lines in each parameter
+#define NGRID (256)
+// maximum permissible deviation from SISL, relative to the size of the surface
+#define MAX_DEV (1e-10)
+
+using namespace std;
+
+struct SURF_DATA
+{
+    const char*    name;
+    int            nCoeffs1;
+    int            nCoeffs2;
+    int            order1;
+    int            order2;
+    bool           rational;
+    vector<double> knots1;
+    vector<double> knots2;
+    vector<double> coeffs;  // X, Y, Z[, W] with U varying fastest
+    double         u0;
+    double         u1;
+    double         v0;
+    double         v1;
+};
+
+
+// a quarter of a torus: rational quadratic arcs in both parameters
+static void makeTorus( SURF_DATA& aSurf )
+{
+    static const double rMaj = 20.0;
+    static const double rMin = 5.0;
+    double w = sqrt( 0.5 );
+    // arc control points (cos, sin) and weights
+    double ac[3] = { 1.0, 1.0, 0.0 };
+    double as[3] = { 0.0, 1.0, 1.0 };
+    double aw[3] = { 1.0, w, 1.0 };
+
+    aSurf.name = "rational torus patch";
+    aSurf.nCoeffs1 = 3;
+    aSurf.nCoeffs2 = 3;
+    aSurf.order1 = 3;
+    aSurf.order2 = 3;
+    aSurf.rational = true;
+
+    for( int i = 0; i < 3; ++i )
+    {
+        aSurf.knots1.push_back( 0.0 );
+        aSurf.knots2.push_back( 0.0 );
+    }
+
+    for( int i = 0; i < 3; ++i )
+    {
+        aSurf.knots1.push_back( 1.0 );
+        aSurf.knots2.push_back( 1.0 );
+    }
+
+    // U runs around the minor circle, V around the major circle
+    for( int j = 0; j < 3; ++j )
+    {
+        for( int i = 0; i < 3; ++i )
+        {
+            double r = rMaj + rMin * ac[i];
+            aSurf.coeffs.push_back( r * ac[j] );
+            aSurf.coeffs.push_back( r * as[j] );
+            aSurf.coeffs.push_back( rMin * as[i] );
+            aSurf.coeffs.push_back( aw[i] * aw[j] );
+        }
+    }
+
+    // evaluate a portion of the surface only
+    aSurf.u0 = 0.1;
+    aSurf.u1 = 0.9;
+    aSurf.v0 = 0.0;
+    aSurf.v1 = 0.75;
+    return;
+}
+
+
+// a polynomial bicubic surface with interior knots of varying spacing
+static void makeBicubic( SURF_DATA& aSurf )
+{
+    aSurf.name = "polynomial bicubic surface";
+    aSurf.nCoeffs1 = 9;
+    aSurf.nCoeffs2 = 7;
+    aSurf.order1 = 4;
+    aSurf.order2 = 4;
+    aSurf.rational = false;
+
+    double k1[13] = { 0, 0, 0, 0, 0.1, 0.25, 0.5, 0.6, 0.8, 1, 1, 1, 1 };
+    double k2[11] = { 0, 0, 0, 0, 1, 1.5, 3, 4, 4, 4, 4 };
+
+    aSurf.knots1.assign( k1, k1 + 13 );
+    aSurf.knots2.assign( k2, k2 + 11 );
+
+    for( int j = 0; j < aSurf.nCoeffs2; ++j )
+    {
+        for( int i = 0; i < aSurf.nCoeffs1; ++i )
+        {
+            aSurf.coeffs.push_back( 10.0 * i );
+            aSurf.coeffs.push_back( 12.0 * j + sin( 0.7 * i ) );
+            aSurf.coeffs.push_back( 3.0 * cos( 0.9 * i + 0.4 * j ) );
+        }
+    }
+
+    aSurf.u0 = 0.0;
+    aSurf.u1 = 1.0;
+    aSurf.v0 = 0.5;
+    aSurf.v1 = 4.0;
+    return;
+}
+
+
+static double dist( const MCAD_POINT& p0, const double* p1 )
+{
+    double dx = p0.x - p1[0];
+    double dy = p0.y - p1[1];
+    double dz = p0.z - p1[2];
+
+    return sqrt( dx * dx + dy * dy + dz * dz );
+}
+
+
+static bool testSurface( DLL_IGES& aModel, SURF_DATA& aSurf )
+{
+    DLL_IGES_ENTITY_128 surf( aModel, true );
+
+    if( !surf.SetNURBSData( aSurf.nCoeffs1, aSurf.nCoeffs2, aSurf.order1, aSurf.order2,
+        &aSurf.knots1[0], &aSurf.knots2[0], &aSurf.coeffs[0], aSurf.rational,
+        false, false, aSurf.u0, aSurf.u1, aSurf.v0, aSurf.v1 ) )
+    {
+        cerr << "*** could not create " << aSurf.name << "\n";
+        return false;
+    }
+
+    vector<double> uList( NGRID );
+    vector<double> vList( NGRID );
+
+    for( int i = 0; i < NGRID; ++i )
+    {
+        uList[i] = aSurf.u0 + ( aSurf.u1 - aSurf.u0 ) * i / ( NGRID - 1 );
+        vList[i] = aSurf.v0 + ( aSurf.v1 - aSurf.v0 ) * i / ( NGRID - 1 );
+    }
+
+    int np = NGRID * NGRID;
+    vector<MCAD_POINT> pts( np );
+    vector<MCAD_POINT> du( np );
+    vector<MCAD_POINT> dv( np );
+
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+    if( !surf.EvalGrid( NGRID, &uList[0], NGRID, &vList[0], &pts[0], &du[0], &dv[0] ) )
+    {
+        cerr << "*** could not evaluate grid on " << aSurf.name << "\n";
+        return false;
+    }
+
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    vector<MCAD_POINT> pts1( np );
+
+    if( !surf.EvalGrid( NGRID, &uList[0], NGRID, &vList[0], &pts1[0] ) )
+    {
+        cerr << "*** could not evaluate grid on " << aSurf.name << "\n";
+        return false;
+    }
+
+    chrono::steady_clock::time_point t1a = chrono::steady_clock::now();
+
+    // per-point evaluation for comparison
+    vector<double> uPts( np );
+    vector<double> vPts( np );
+    vector<MCAD_POINT> pts2( np );
+
+    for( int j = 0; j < NGRID; ++j )
+    {
+        for( int i = 0; i < NGRID; ++i )
+        {
+            uPts[j * NGRID + i] = uList[i];
+            vPts[j * NGRID + i] = vList[j];
+        }
+    }
+
+    chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+
+    if( !surf.EvalPoints( np, &uPts[0], &vPts[0], &pts2[0] ) )
+    {
+        cerr << "*** could not evaluate points on " << aSurf.name << "\n";
+        return false;
+    }
+
+    chrono::steady_clock::time_point t3 = chrono::steady_clock::now();
+
+    // SISL expects homogeneous coordinates for rational surfaces
+    vector<double> scoeffs( aSurf.coeffs );
+
+    if( aSurf.rational )
+    {
+        for( size_t i = 0; i < scoeffs.size(); i += 4 )
+        {
+            scoeffs[i] *= scoeffs[i + 3];
+            scoeffs[i + 1] *= scoeffs[i + 3];
+            scoeffs[i + 2] *= scoeffs[i + 3];
+        }
+    }
+
+    SISLSurf* ss = newSurf( aSurf.nCoeffs1, aSurf.nCoeffs2, aSurf.order1, aSurf.order2,
+        &aSurf.knots1[0], &aSurf.knots2[0], &scoeffs[0], aSurf.rational ? 2 : 1, 3, 1 );
+
+    if( NULL == ss )
+    {
+        cerr << "*** could not create SISL surface\n";
+        return false;
+    }
+
+    double size = 0.0;
+    double devP = 0.0;
+    double devD = 0.0;
+    double devE = 0.0;
+    double eder[9];
+    double enorm[3];
+    double epar[2];
+    int ilfs = 0;
+    int ilft = 0;
+    int stat = 0;
+
+    chrono::steady_clock::time_point t4 = chrono::steady_clock::now();
+
+    for( int j = 0; j < NGRID && 0 == stat; ++j )
+    {
+        for( int i = 0; i < NGRID; ++i )
+        {
+            int idx = j * NGRID + i;
+            epar[0] = uList[i];
+            epar[1] = vList[j];
+            s1421( ss, 1, epar, &ilfs, &ilft, eder, enorm, &stat );
+
+            if( stat < 0 )
+            {
+                cerr << "*** SISL s1421() failed\n";
+                break;
+            }
+
+            double d = sqrt( eder[0] * eder[0] + eder[1] * eder[1] + eder[2] * eder[2] );
+
+            if( d > size )
+                size = d;
+
+            d = dist( pts[idx], eder );
+
+            if( d > devP )
+                devP = d;
+
+            d = dist( du[idx], &eder[3] );
+
+            if( d > devD )
+                devD = d;
+
+            d = dist( dv[idx], &eder[6] );
+
+            if( d > devD )
+                devD = d;
+
+            d = dist( pts1[idx], eder );
+
+            if( d > devP )
+                devP = d;
+
+            d = dist( pts2[idx], eder );
+
+            if( d > devE )
+                devE = d;
+        }
+    }
+
+    chrono::steady_clock::time_point t5 = chrono::steady_clock::now();
+    freeSurf( ss );
+
+    if( stat < 0 )
+        return false;
+
+    cout << aSurf.name << ": " << NGRID << " x " << NGRID << " grid\n";
+    cout << "  grid (points + derivatives): "
+        << chrono::duration_cast< chrono::microseconds >( t1 - t0 ).count() << " us\n";
+    cout << "  grid (points only):          "
+        << chrono::duration_cast< chrono::microseconds >( t1a - t1 ).count() << " us\n";
+    cout << "  per-point (points only):     "
+        << chrono::duration_cast< chrono::microseconds >( t3 - t2 ).count() << " us\n";
+    cout << "  SISL s1421 per point:        "
+        << chrono::duration_cast< chrono::microseconds >( t5 - t4 ).count() << " us\n";
+    cout << "  max deviation from SISL: points " << devP << ", derivatives "
+        << devD << ", per-point " << devE << "\n";
+
+    if( devP > MAX_DEV * size || devE > MAX_DEV * size || devD > MAX_DEV * size * 10.0 )
+    {
+        cerr << "*** deviation from SISL exceeds tolerance on " << aSurf.name << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+int main()
+{
+    DLL_IGES model;
+    SURF_DATA torus;
+    SURF_DATA bicubic;
+
+    makeTorus( torus );
+    makeBicubic( bicubic );
+
+    if( !testSurface( model, torus ) || !testSurface( model, bicubic ) )
+        return -1;
+
+    return 0;
+}
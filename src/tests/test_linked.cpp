@@ -0,0 +1,271 @@
+/*
+ * file: test_linked.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program writes a model of instanced Subfigure
+ * Definitions, one of which instances another unnamed definition,
+ * as a set of linked files with a small limit on the number of lines
+ * per section. Each file must name itself in its Global section. The
+ * main file is then read back and the definition of every instance
+ * is loaded via its External Reference and compared with the original.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <cstdio>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <core/iges.h>
+#include <core/iges_detable.h>
+#include <core/entity110.h>
+#include <core/entity308.h>
+#include <core/entity408.h>
+#include <core/entity416.h>
+
+#define ONAME "test_out_linked"
+// maximum number of lines in the DE or PD section of each file
+#define MAX_LINES (50)
+// number of lines in each Subfigure Definition
+#define NLINES (20)
+// number of files: the main file and one per definition
+#define NFILES (4)
+// number of top level instances of each named definition
+#define NINST_A (4)
+#define NINST_B (2)
+
+using namespace std;
+
+
+static string fileName( int aIndex )
+{
+    ostringstream ostr;
+    ostr << ONAME;
+
+    if( aIndex > 0 )
+        ostr << "_" << aIndex;
+
+    ostr << ".igs";
+    return ostr.str();
+}
+
+
+static IGES_ENTITY_308* newDefinition( IGES& aModel, const char* aName, double aLength )
+{
+    IGES_ENTITY* ep = NULL;
+
+    if( !aModel.NewEntity( ENT_SUBFIGURE_DEFINITION, &ep ) )
+        return NULL;
+
+    IGES_ENTITY_308* dp = (IGES_ENTITY_308*)ep;
+
+    if( aName )
+        dp->SetName( aName );
+
+    for( int i = 0; i < NLINES; ++i )
+    {
+        if( !aModel.NewEntity( ENT_LINE, &ep ) || !dp->AddDE( ep ) )
+            return NULL;
+
+        ((IGES_ENTITY_110*)ep)->Y1 = i;
+        ((IGES_ENTITY_110*)ep)->X2 = aLength;
+        ((IGES_ENTITY_110*)ep)->Y2 = i;
+    }
+
+    return dp;
+}
+
+
+static IGES_ENTITY_408* newInstance( IGES& aModel, IGES_ENTITY_308* aDef, double aX )
+{
+    IGES_ENTITY* ep = NULL;
+
+    if( !aModel.NewEntity( ENT_SINGULAR_SUBFIGURE_INSTANCE, &ep )
+        || !((IGES_ENTITY_408*)ep)->SetDE( aDef ) )
+        return NULL;
+
+    ((IGES_ENTITY_408*)ep)->X = aX;
+    return (IGES_ENTITY_408*)ep;
+}
+
+
+static bool writeModel( void )
+{
+    IGES model;
+    IGES_ENTITY_308* defA = newDefinition( model, "PART_A", 1.0 );
+    IGES_ENTITY_308* defB = newDefinition( model, "PART_B", 2.0 );
+    IGES_ENTITY_308* defC = newDefinition( model, NULL, 3.0 );
+
+    if( NULL == defA || NULL == defB || NULL == defC )
+        return false;
+
+    IGES_ENTITY_408* nested = newInstance( model, defC, 0.5 );
+
+    if( NULL == nested || !defB->AddDE( nested ) )
+        return false;
+
+    for( int i = 0; i < NINST_A + NINST_B; ++i )
+    {
+        if( NULL == newInstance( model, i < NINST_A ? defA : defB, 10.0 * i ) )
+            return false;
+    }
+
+    for( int i = 0; i <= NFILES; ++i )
+        remove( fileName( i ).c_str() );
+
+    return model.WriteLinked( fileName( 0 ).c_str(), true, MAX_LINES );
+}
+
+
+// the Global section of each file must name that file
+static bool checkGlobals( int aIndex )
+{
+    ifstream file( fileName( aIndex ).c_str(), ios::in | ios::binary );
+    string line;
+    string globs;
+
+    if( !file.is_open() )
+    {
+        cerr << "*** '" << fileName( aIndex ) << "' was not written\n";
+        return false;
+    }
+
+    while( getline( file, line ) )
+    {
+        if( line.size() >= 73 && 'G' == line[72] )
+            globs += line.substr( 0, 72 );
+    }
+
+    // the file name is the third parameter: 1H,,1H;,<n>H<name>,
+    ostringstream name;
+    name << fileName( aIndex ).size() << "H" << fileName( aIndex ) << ",";
+
+    if( globs.find( name.str() ) == string::npos )
+    {
+        cerr << "*** the Global section of '" << fileName( aIndex ) << "' names another file\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+// load the definition of an instance and check its members
+static bool checkInstance( IGES_ENTITY_408* aInst, const char* aName, bool aNested )
+{
+    IGES_ENTITY_416* xref = NULL;
+    IGES_ENTITY_308* def = NULL;
+    size_t nDE = 0;
+    IGES_ENTITY** list = NULL;
+
+    if( !aInst->GetExternalRef( xref ) || NULL == xref || !xref->GetDefinition( def )
+        || NULL == def || !def->GetDEList( nDE, list ) )
+    {
+        cerr << "*** could not load the definition of an instance\n";
+        return false;
+    }
+
+    if( def->GetName() != ( aName ? aName : "" ) || xref->GetEntityForm() != ( aName ? 0 : 3 )
+        || nDE != (size_t)( NLINES + ( aNested ? 1 : 0 ) ) )
+    {
+        cerr << "*** definition '" << def->GetName() << "' has " << nDE << " members\n";
+        return false;
+    }
+
+    for( size_t i = 0; i < nDE; ++i )
+    {
+        if( list[i]->GetEntityType() == ENT_SINGULAR_SUBFIGURE_INSTANCE )
+        {
+            if( !aNested || !checkInstance( (IGES_ENTITY_408*)list[i], NULL, false ) )
+                return false;
+        }
+        else if( list[i]->GetEntityType() != ENT_LINE )
+        {
+            cerr << "*** definition '" << def->GetName() << "' has an unexpected member\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+int main()
+{
+    if( !writeModel() )
+    {
+        cerr << "*** could not write '" << fileName( 0 ) << "'\n";
+        return -1;
+    }
+
+    for( int i = 0; i < NFILES; ++i )
+    {
+        if( !checkGlobals( i ) )
+            return -1;
+    }
+
+    if( ifstream( fileName( NFILES ).c_str() ).is_open() )
+    {
+        cerr << "*** more files than definitions were written\n";
+        return -1;
+    }
+
+    IGES model;
+
+    if( !model.Read( fileName( 0 ).c_str() ) )
+    {
+        cerr << "*** could not read '" << fileName( 0 ) << "'\n";
+        return -1;
+    }
+
+    vector<IGES_ENTITY*> eList;
+    model.GetDETable()->SelectType( ENT_SINGULAR_SUBFIGURE_INSTANCE, -1, eList );
+
+    if( eList.size() != NINST_A + NINST_B )
+    {
+        cerr << "*** expected " << NINST_A + NINST_B << " instances, got " << eList.size() << "\n";
+        return -1;
+    }
+
+    int nA = 0;
+
+    for( size_t i = 0; i < eList.size(); ++i )
+    {
+        IGES_ENTITY_408* ip = (IGES_ENTITY_408*)eList[i];
+        bool isA = ip->X < 10.0 * NINST_A - 1.0;
+
+        if( !checkInstance( ip, isA ? "PART_A" : "PART_B", !isA ) )
+            return -1;
+
+        if( isA )
+            ++nA;
+    }
+
+    if( NINST_A != nA )
+    {
+        cerr << "*** expected " << NINST_A << " instances of PART_A, got " << nA << "\n";
+        return -1;
+    }
+
+    cout << "linked files were written and resolved\n";
+    return 0;
+}
@@ -0,0 +1,211 @@
+/*
+ * file: test_memory.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program grows the coefficients of a NURBS Curve
+ * (126) and the points of a Copious Data entity (106) and checks that
+ * the memory reported for each entity type grows by at least the size
+ * of the added data. The totals of the model must equal the sums over
+ * the entity types plus the memory of the IGES object itself.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <vector>
+#include <core/iges.h>
+#include <core/entity106.h>
+#include <core/entity110.h>
+#include <core/entity126.h>
+
+// number of points added at each step
+#define NGROW (100)
+
+using namespace std;
+
+
+// retrieve the statistics of one entity type and check the totals
+static bool getStats( IGES& aModel, int aType, IGES_MEMORY_STATS& aStats )
+{
+    size_t nTypes = 0;
+    IGES_MEMORY_STATS const* stats = NULL;
+    IGES_MEMORY_STATS total;
+    IGES_MEMORY_STATS sum;
+    bool found = false;
+
+    if( !aModel.GetMemoryStats( nTypes, stats, total ) )
+    {
+        cerr << "*** could not retrieve the memory statistics\n";
+        return false;
+    }
+
+    for( size_t i = 0; i < nTypes; ++i )
+    {
+        if( i > 0 && stats[i].entityType <= stats[i - 1].entityType )
+        {
+            cerr << "*** the entity types are not sorted\n";
+            return false;
+        }
+
+        if( stats[i].entityType == aType )
+        {
+            aStats = stats[i];
+            found = true;
+        }
+
+        sum.count += stats[i].count;
+        sum.objectBytes += stats[i].objectBytes;
+        sum.heapBytes += stats[i].heapBytes;
+        sum.refBytes += stats[i].refBytes;
+    }
+
+    // the IGES object itself adds its own size and heap data
+    if( !found || total.count != sum.count || total.refBytes != sum.refBytes
+        || total.objectBytes != sum.objectBytes + sizeof( IGES )
+        || total.heapBytes < sum.heapBytes )
+    {
+        cerr << "*** the totals do not match the entity types\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+// add NGROW control points to a cubic NURBS Curve
+static bool growCurve( IGES_ENTITY_126* aCurve, int aNCoeff )
+{
+    vector<double> knots;
+    vector<double> coeffs;
+
+    for( int i = 0; i < 4; ++i )
+        knots.push_back( 0.0 );
+
+    for( int i = 1; i < aNCoeff - 3; ++i )
+        knots.push_back( (double)i );
+
+    for( int i = 0; i < 4; ++i )
+        knots.push_back( (double)( aNCoeff - 3 ) );
+
+    for( int i = 0; i < aNCoeff; ++i )
+    {
+        coeffs.push_back( (double)i );
+        coeffs.push_back( (double)( i & 1 ) );
+        coeffs.push_back( 0.0 );
+    }
+
+    return aCurve->SetNURBSData( aNCoeff, 4, &knots[0], &coeffs[0], false,
+                                 0.0, (double)( aNCoeff - 3 ) );
+}
+
+
+int main()
+{
+    IGES model;
+    IGES_ENTITY* ep = NULL;
+
+    if( !model.NewEntity( ENT_NURBS_CURVE, &ep ) )
+    {
+        cerr << "*** could not create a NURBS Curve\n";
+        return -1;
+    }
+
+    IGES_ENTITY_126* np = (IGES_ENTITY_126*)ep;
+
+    if( !model.NewEntity( ENT_COPIOUS_DATA, &ep ) || !ep->SetEntityForm( 12 ) )
+    {
+        cerr << "*** could not create a Copious Data entity\n";
+        return -1;
+    }
+
+    IGES_ENTITY_106* cp = (IGES_ENTITY_106*)ep;
+
+    // an unrelated entity which must not be affected
+    if( !model.NewEntity( ENT_LINE, &ep ) )
+    {
+        cerr << "*** could not create a Line\n";
+        return -1;
+    }
+
+    IGES_MEMORY_STATS s126;
+    IGES_MEMORY_STATS s106;
+    IGES_MEMORY_STATS s110;
+    vector<MCAD_POINT> pts;
+
+    if( !getStats( model, ENT_NURBS_CURVE, s126 ) || !getStats( model, ENT_COPIOUS_DATA, s106 )
+        || !getStats( model, ENT_LINE, s110 ) )
+        return -1;
+
+    for( int step = 1; step <= 3; ++step )
+    {
+        int nPts = step * NGROW;
+
+        for( int i = (int)pts.size(); i < nPts; ++i )
+        {
+            MCAD_POINT p;
+            p.x = i;
+            p.y = 0.5 * i;
+            pts.push_back( p );
+        }
+
+        if( !growCurve( np, nPts ) || !cp->SetPoints( pts ) )
+        {
+            cerr << "*** could not grow the entities to " << nPts << " points\n";
+            return -1;
+        }
+
+        IGES_MEMORY_STATS n126;
+        IGES_MEMORY_STATS n106;
+        IGES_MEMORY_STATS n110;
+
+        if( !getStats( model, ENT_NURBS_CURVE, n126 ) || !getStats( model, ENT_COPIOUS_DATA, n106 )
+            || !getStats( model, ENT_LINE, n110 ) )
+            return -1;
+
+        // NGROW knots and NGROW 3D coefficients; NGROW 3D points
+        if( n126.heapBytes < s126.heapBytes + 4 * NGROW * sizeof( double )
+            || n126.objectBytes != s126.objectBytes )
+        {
+            cerr << "*** NURBS Curve memory grew from " << s126.heapBytes << " to "
+                << n126.heapBytes << " bytes\n";
+            return -1;
+        }
+
+        if( n106.heapBytes < s106.heapBytes + 3 * NGROW * sizeof( double )
+            || n106.objectBytes != s106.objectBytes )
+        {
+            cerr << "*** Copious Data memory grew from " << s106.heapBytes << " to "
+                << n106.heapBytes << " bytes\n";
+            return -1;
+        }
+
+        if( n110.heapBytes != s110.heapBytes || n110.objectBytes != s110.objectBytes )
+        {
+            cerr << "*** the memory of an unchanged Line changed\n";
+            return -1;
+        }
+
+        s126 = n126;
+        s106 = n106;
+    }
+
+    cout << "memory statistics follow the entity data\n";
+    return 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * file: test_names.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program checks the name index of a model. Names
+ * returned by IGES::MakeUniqueName() and IGES::GetNewPartName() must
+ * be distinct even if they are not yet assigned and even if they are
+ * requested from several threads at once. Renamed and deleted
+ * Subfigure Definitions and Name Properties must no longer be found
+ * under their former names.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <core/iges.h>
+#include <core/entity308.h>
+#include <core/entity406.h>
+
+// number of threads requesting names
+#define NTHREADS (4)
+// number of names requested by each thread
+#define NNAMES (50)
+
+using namespace std;
+
+
+static IGES_ENTITY_308* newDefinition( IGES& aModel, const char* aName )
+{
+    IGES_ENTITY* ep = NULL;
+
+    if( !aModel.NewEntity( ENT_SUBFIGURE_DEFINITION, &ep ) )
+        return NULL;
+
+    ((IGES_ENTITY_308*)ep)->SetName( aName );
+    return (IGES_ENTITY_308*)ep;
+}
+
+
+// the number of entities found under the given name must match
+static bool checkFound( IGES& aModel, const char* aName, size_t aCount )
+{
+    vector<IGES_ENTITY*> found;
+    size_t nFound = aModel.FindByName( aName, found );
+
+    if( nFound != aCount || found.size() != aCount || aModel.IsNameUsed( aName ) != ( aCount > 0 ) )
+    {
+        cerr << "*** expected " << aCount << " entities named '" << aName << "', found "
+            << nFound << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+static void requestNames( IGES* aModel, vector<string>* aNames )
+{
+    for( int i = 0; i < NNAMES; ++i )
+    {
+        string name = "PART";
+        aModel->MakeUniqueName( name );
+        aNames->push_back( name );
+
+        aModel->GetNewPartName( name );
+        aNames->push_back( name );
+    }
+
+    return;
+}
+
+
+int main()
+{
+    IGES model;
+    IGES_ENTITY_308* defA = newDefinition( model, "PART" );
+    IGES_ENTITY_308* defB = newDefinition( model, "PART-1" );
+    IGES_ENTITY* ep = NULL;
+
+    if( NULL == defA || NULL == defB || !model.NewEntity( ENT_PROPERTY, &ep )
+        || !ep->SetEntityForm( 15 ) || !((IGES_ENTITY_406*)ep)->SetData( "PROP" ) )
+    {
+        cerr << "*** could not create the named entities\n";
+        return -1;
+    }
+
+    if( !checkFound( model, "PART", 1 ) || !checkFound( model, "PART-1", 1 )
+        || !checkFound( model, "PROP", 1 ) )
+        return -1;
+
+    // names which were handed out but not assigned are not reused
+    string n1 = "PART";
+    string n2 = "PART";
+    string n3 = "FREE";
+    string n4 = "FREE";
+
+    model.MakeUniqueName( n1 );
+    model.MakeUniqueName( n2 );
+    model.MakeUniqueName( n3 );
+    model.MakeUniqueName( n4 );
+
+    if( "PART-2" != n1 || "PART-3" != n2 || "FREE" != n3 || "FREE-1" != n4 )
+    {
+        cerr << "*** unexpected unique names: " << n1 << ", " << n2 << ", "
+            << n3 << ", " << n4 << "\n";
+        return -1;
+    }
+
+    // a reserved name is released when an entity takes it
+    if( !checkFound( model, "PART-2", 0 ) || NULL == newDefinition( model, "PART-2" )
+        || !checkFound( model, "PART-2", 1 ) )
+        return -1;
+
+    // renamed and deleted entities are removed from the index
+    defA->SetName( "RENAMED" );
+    ((IGES_ENTITY_406*)ep)->SetData( "PROP2" );
+
+    if( !checkFound( model, "PART", 0 ) || !checkFound( model, "RENAMED", 1 )
+        || !checkFound( model, "PROP", 0 ) || !checkFound( model, "PROP2", 1 ) )
+        return -1;
+
+    if( !model.DelEntity( defB ) || !model.DelEntity( ep ) )
+    {
+        cerr << "*** could not delete the named entities\n";
+        return -1;
+    }
+
+    if( !checkFound( model, "PART-1", 0 ) || !checkFound( model, "PROP2", 0 )
+        || !checkFound( model, "RENAMED", 1 ) )
+        return -1;
+
+    // concurrent requests never obtain the same name
+    vector< vector<string> > names( NTHREADS );
+    vector<thread> threads;
+
+    for( int i = 0; i < NTHREADS; ++i )
+        threads.push_back( thread( requestNames, &model, &names[i] ) );
+
+    for( int i = 0; i < NTHREADS; ++i )
+        threads[i].join();
+
+    set<string> unique;
+    unique.insert( n1 );
+    unique.insert( n2 );
+    unique.insert( n3 );
+    unique.insert( n4 );
+    unique.insert( "RENAMED" );
+
+    for( int i = 0; i < NTHREADS; ++i )
+        unique.insert( names[i].begin(), names[i].end() );
+
+    if( unique.size() != 5 + 2 * NTHREADS * NNAMES )
+    {
+        cerr << "*** " << 5 + 2 * NTHREADS * NNAMES - unique.size()
+            << " names were handed out more than once\n";
+        return -1;
+    }
+
+    cout << "names are unique and follow the entities\n";
+    return 0;
+}
@@ -0,0 +1,224 @@
+/*
+ * file: test_notch.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program subtracts rectangular outlines from two
+ * edges of a square board and adds rectangles to the other two edges.
+ * In each case a single edge of the board crosses two sides of the
+ * rectangle, which used to produce duplicate intersections. The
+ * vertices of the resulting outlines are compared with the expected
+ * vertices and points are classified as inside or outside the board.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <cmath>
+#include <api/dll_mcad_segment.h>
+#include <api/dll_mcad_outline.h>
+#include <geom/mcad_segment.h>
+
+// maximum permissible deviation of a vertex
+#define MAX_DEV (1e-9)
+
+using namespace std;
+
+
+// add a CCW rectangle of lines to an empty outline
+static bool makeRect( DLL_MCAD_OUTLINE& aOutline, double aX0, double aY0,
+                      double aX1, double aY1 )
+{
+    MCAD_POINT v[4];
+
+    v[0].x = aX0;
+    v[0].y = aY0;
+    v[1].x = aX1;
+    v[1].y = aY0;
+    v[2].x = aX1;
+    v[2].y = aY1;
+    v[3].x = aX0;
+    v[3].y = aY1;
+
+    bool error = false;
+
+    for( int i = 0; i < 4; ++i )
+    {
+        DLL_MCAD_SEGMENT line( true );
+
+        if( !line.SetParams( v[i], v[( i + 1 ) % 4] ) || !aOutline.AddSegment( line, error ) )
+        {
+            cerr << "*** could not create a rectangle\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+// compare the vertices of the outline with the expected CCW vertices;
+// the outline may start at any of the vertices
+static bool checkOutline( DLL_MCAD_OUTLINE& aOutline, const double (*aVertex)[2],
+                          int aNVertex, const char* aStage )
+{
+    MCAD_SEGMENT** segs = NULL;
+    int nSegs = 0;
+    bool closed = false;
+    bool contiguous = false;
+
+    if( !aOutline.IsClosed( closed ) || !closed
+        || !aOutline.IsContiguous( contiguous ) || !contiguous )
+    {
+        cerr << "*** " << aStage << ": the outline is not closed\n";
+        return false;
+    }
+
+    aOutline.GetSegments( segs, nSegs );
+
+    int first = -1;
+
+    for( int i = 0; i < nSegs && first < 0; ++i )
+    {
+        if( fabs( segs[i]->GetStart().x - aVertex[0][0] ) <= MAX_DEV
+            && fabs( segs[i]->GetStart().y - aVertex[0][1] ) <= MAX_DEV )
+            first = i;
+    }
+
+    bool ok = ( nSegs == aNVertex && first >= 0 );
+
+    for( int i = 0; ok && i < nSegs; ++i )
+    {
+        MCAD_SEGMENT* sp = segs[( first + i ) % nSegs];
+
+        if( MCAD_SEGTYPE_LINE != sp->GetSegType()
+            || fabs( sp->GetStart().x - aVertex[i][0] ) > MAX_DEV
+            || fabs( sp->GetStart().y - aVertex[i][1] ) > MAX_DEV )
+        {
+            cerr << "*** " << aStage << ": vertex " << i << " is at (" << sp->GetStart().x
+                << ", " << sp->GetStart().y << ")\n";
+            ok = false;
+        }
+    }
+
+    if( nSegs != aNVertex || first < 0 )
+        cerr << "*** " << aStage << ": expected " << aNVertex << " segments, got " << nSegs << "\n";
+
+    delete [] segs;
+    return ok;
+}
+
+
+// classify a point and compare with the expected result
+static bool checkPoint( DLL_MCAD_OUTLINE& aOutline, double aX, double aY, bool aInside,
+                        const char* aStage )
+{
+    MCAD_POINT p;
+    bool error = false;
+
+    p.x = aX;
+    p.y = aY;
+
+    if( aOutline.IsInside( p, error ) != aInside || error )
+    {
+        cerr << "*** " << aStage << ": (" << aX << ", " << aY << ") should be "
+            << ( aInside ? "inside" : "outside" ) << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+// subtract or add a rectangle and check the resulting outline
+static bool applyRect( DLL_MCAD_OUTLINE& aBoard, bool aSubtract, double aX0, double aY0,
+                       double aX1, double aY1, const double (*aVertex)[2], int aNVertex,
+                       double aInX, double aInY, double aOutX, double aOutY )
+{
+    const char* stage = aSubtract ? "subtraction" : "addition";
+    DLL_MCAD_OUTLINE rect( true );
+    bool error = false;
+
+    if( !makeRect( rect, aX0, aY0, aX1, aY1 ) )
+        return false;
+
+    if( !( aSubtract ? aBoard.SubOutline( rect, error ) : aBoard.AddOutline( rect, error ) )
+        || error )
+    {
+        cerr << "*** " << stage << " of (" << aX0 << ", " << aY0 << ") - (" << aX1
+            << ", " << aY1 << ") failed\n";
+        return false;
+    }
+
+    return checkOutline( aBoard, aVertex, aNVertex, stage )
+        && checkPoint( aBoard, aInX, aInY, true, stage )
+        && checkPoint( aBoard, aOutX, aOutY, false, stage );
+}
+
+
+int main()
+{
+    DLL_MCAD_OUTLINE board( true );
+
+    if( !makeRect( board, 0.0, 0.0, 10.0, 10.0 ) )
+        return -1;
+
+    // Each rectangle crosses a single edge of the board. The first
+    // intersection found on the notch in the bottom edge and on the tab
+    // on the top edge is followed by a part of the rectangle which lies
+    // within the board; for the other two rectangles it is followed by
+    // a part outside the board.
+
+    // a notch in the bottom edge
+    const double v0[8][2] = { { 0.0, 0.0 }, { 3.0, 0.0 }, { 3.0, 2.0 }, { 5.0, 2.0 },
+                              { 5.0, 0.0 }, { 10.0, 0.0 }, { 10.0, 10.0 }, { 0.0, 10.0 } };
+
+    if( !applyRect( board, true, 3.0, -2.0, 5.0, 2.0, v0, 8, 4.0, 3.0, 4.0, 1.0 ) )
+        return -1;
+
+    // a notch in the right edge
+    const double v1[12][2] = { { 0.0, 0.0 }, { 3.0, 0.0 }, { 3.0, 2.0 }, { 5.0, 2.0 },
+                               { 5.0, 0.0 }, { 10.0, 0.0 }, { 10.0, 4.0 }, { 9.0, 4.0 },
+                               { 9.0, 6.0 }, { 10.0, 6.0 }, { 10.0, 10.0 }, { 0.0, 10.0 } };
+
+    if( !applyRect( board, true, 9.0, 4.0, 12.0, 6.0, v1, 12, 8.5, 5.0, 9.5, 5.0 ) )
+        return -1;
+
+    // a tab on the top edge
+    const double v2[16][2] = { { 0.0, 0.0 }, { 3.0, 0.0 }, { 3.0, 2.0 }, { 5.0, 2.0 },
+                               { 5.0, 0.0 }, { 10.0, 0.0 }, { 10.0, 4.0 }, { 9.0, 4.0 },
+                               { 9.0, 6.0 }, { 10.0, 6.0 }, { 10.0, 10.0 }, { 5.0, 10.0 },
+                               { 5.0, 12.0 }, { 3.0, 12.0 }, { 3.0, 10.0 }, { 0.0, 10.0 } };
+
+    if( !applyRect( board, false, 3.0, 9.0, 5.0, 12.0, v2, 16, 4.0, 11.0, 2.0, 11.0 ) )
+        return -1;
+
+    // a tab on the left edge
+    const double v3[20][2] = { { 0.0, 0.0 }, { 3.0, 0.0 }, { 3.0, 2.0 }, { 5.0, 2.0 },
+                               { 5.0, 0.0 }, { 10.0, 0.0 }, { 10.0, 4.0 }, { 9.0, 4.0 },
+                               { 9.0, 6.0 }, { 10.0, 6.0 }, { 10.0, 10.0 }, { 5.0, 10.0 },
+                               { 5.0, 12.0 }, { 3.0, 12.0 }, { 3.0, 10.0 }, { 0.0, 10.0 },
+                               { 0.0, 6.0 }, { -2.0, 6.0 }, { -2.0, 4.0 }, { 0.0, 4.0 } };
+
+    if( !applyRect( board, false, -2.0, 4.0, 1.0, 6.0, v3, 20, -1.0, 5.0, -1.0, 7.0 ) )
+        return -1;
+
+    cout << "outlines crossing an edge twice were subtracted and added\n";
+    return 0;
+}
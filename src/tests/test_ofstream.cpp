@@ -0,0 +1,195 @@
+/*
+ * file: test_ofstream.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program writes several buffers worth of data
+ * through MCAD_OFSTREAM over an existing file. When the output is
+ * abandoned via Abort() or by destroying the open stream, and when
+ * the temporary file cannot be renamed to the target, the target
+ * must be left untouched and the temporary file must be removed.
+ * A successful Close() must replace the target with the new data.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <cstdio>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <geom/mcad_ofstream.h>
+
+#if defined( _WIN32 )
+    #include <direct.h>
+    #define MKDIR( name ) _mkdir( name )
+#else
+    #include <sys/stat.h>
+    #define MKDIR( name ) mkdir( name, 0755 )
+#endif
+
+#define ONAME "test_out_ofstream.txt"
+// a directory which the temporary file cannot replace
+#define DNAME "test_out_ofstream.dir"
+#define DFILE DNAME "/keep.txt"
+#define ORIGINAL "original contents\n"
+// number of lines written; several times the size of the output buffers
+#define NLINES (100000)
+
+using namespace std;
+
+
+static bool exists( const string& aFileName )
+{
+    return ifstream( aFileName.c_str() ).is_open();
+}
+
+
+static string readFile( const char* aFileName )
+{
+    ifstream file( aFileName, ios::in | ios::binary );
+    ostringstream data;
+
+    data << file.rdbuf();
+    return data.str();
+}
+
+
+static bool writeOriginal( const char* aFileName )
+{
+    ofstream file( aFileName, ios::out | ios::binary | ios::trunc );
+    file << ORIGINAL;
+    file.close();
+    return !file.fail();
+}
+
+
+// open the stream over the given file and write NLINES lines to it
+static bool fill( MCAD_OFSTREAM& aStream, const char* aFileName, string& aData )
+{
+    ostringstream data;
+
+    for( int i = 0; i < NLINES; ++i )
+        data << "line " << i << " of the replacement data\n";
+
+    aData = data.str();
+
+    if( !aStream.Open( aFileName ) )
+    {
+        cerr << "*** could not open a stream for '" << aFileName << "'\n";
+        return false;
+    }
+
+    aStream << aData;
+
+    if( !exists( string( aFileName ) + ".tmp" ) )
+    {
+        cerr << "*** no temporary file was created for '" << aFileName << "'\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+// the target must hold the given data and the temporary file must be gone
+static bool checkFile( const char* aFileName, const string& aData, const char* aCase )
+{
+    if( readFile( aFileName ) != aData )
+    {
+        cerr << "*** " << aCase << ": the contents of '" << aFileName << "' are wrong\n";
+        return false;
+    }
+
+    if( exists( string( aFileName ) + ".tmp" ) )
+    {
+        cerr << "*** " << aCase << ": the temporary file was not removed\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+int main()
+{
+    string data;
+
+    if( !writeOriginal( ONAME ) )
+    {
+        cerr << "*** could not write '" << ONAME << "'\n";
+        return -1;
+    }
+
+    // Abort() discards the output
+    MCAD_OFSTREAM ofs;
+
+    if( !fill( ofs, ONAME, data ) )
+        return -1;
+
+    ofs.Abort();
+
+    if( ofs.IsOpen() || !checkFile( ONAME, ORIGINAL, "Abort()" ) )
+        return -1;
+
+    // destroying an open stream discards the output
+    {
+        MCAD_OFSTREAM tmp;
+
+        if( !fill( tmp, ONAME, data ) )
+            return -1;
+    }
+
+    if( !checkFile( ONAME, ORIGINAL, "destructor" ) )
+        return -1;
+
+    // a directory cannot be replaced by the temporary file
+    MKDIR( DNAME );
+
+    if( !writeOriginal( DFILE ) || !fill( ofs, DNAME, data ) )
+        return -1;
+
+    if( ofs.Close() || !ofs.fail() || ofs.IsOpen() )
+    {
+        cerr << "*** the temporary file replaced the directory '" << DNAME << "'\n";
+        return -1;
+    }
+
+    if( !checkFile( DFILE, ORIGINAL, "failed rename" )
+        || exists( string( DNAME ) + ".tmp" ) )
+    {
+        if( exists( string( DNAME ) + ".tmp" ) )
+            cerr << "*** failed rename: the temporary file was not removed\n";
+
+        return -1;
+    }
+
+    // a successful Close() replaces the target
+    if( !fill( ofs, ONAME, data ) )
+        return -1;
+
+    if( !ofs.Close() || !checkFile( ONAME, data, "Close()" ) )
+    {
+        cerr << "*** the output did not replace '" << ONAME << "'\n";
+        return -1;
+    }
+
+    cout << "output streams leave the target untouched unless they succeed\n";
+    return 0;
+}
@@ -0,0 +1,303 @@
+/*
+ * file: test_order.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program creates a Composite Curve before its
+ * segments and its transform so that the entity list contains forward
+ * references, writes the model in dependency order, reads the file
+ * back and checks that every entity follows the entities it refers to.
+ * A file written in the usual order and then marked as dependency
+ * ordered must still be read with all associations intact, and a
+ * model whose references form a cycle must be written without the mark.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <core/iges.h>
+#include <core/iges_detable.h>
+#include <core/entity102.h>
+#include <core/entity110.h>
+#include <core/entity124.h>
+
+#define ONAME "test_out_order.igs"
+#define UNAME "test_out_order_marked.igs"
+#define CNAME "test_out_order_cycle.igs"
+// the Start section line which marks a dependency ordered file
+#define MARK "# libIGES: entities follow the entities they refer to"
+
+using namespace std;
+
+
+static bool writeFile( bool aOrdered )
+{
+    IGES model;
+    IGES_ENTITY* ep = NULL;
+
+    // the parent is created first
+    if( !model.NewEntity( ENT_COMPOSITE_CURVE, &ep ) )
+    {
+        cerr << "*** could not create a Composite Curve\n";
+        return false;
+    }
+
+    IGES_ENTITY_102* cc = (IGES_ENTITY_102*)ep;
+
+    if( !model.NewEntity( ENT_TRANSFORMATION_MATRIX, &ep ) || !cc->SetTransform( ep ) )
+    {
+        cerr << "*** could not add a transform to the Composite Curve\n";
+        return false;
+    }
+
+    ((IGES_ENTITY_124*)ep)->T.T.x = 10.0;
+
+    double vx[5] = { 0.0, 10.0, 10.0, 0.0, 0.0 };
+    double vy[5] = { 0.0, 0.0, 5.0, 5.0, 0.0 };
+
+    for( int i = 0; i < 4; ++i )
+    {
+        if( !model.NewEntity( ENT_LINE, &ep ) )
+        {
+            cerr << "*** could not create a Line\n";
+            return false;
+        }
+
+        IGES_ENTITY_110* lp = (IGES_ENTITY_110*)ep;
+        lp->X1 = vx[i];
+        lp->Y1 = vy[i];
+        lp->X2 = vx[i + 1];
+        lp->Y2 = vy[i + 1];
+
+        if( !cc->AddSegment( lp ) )
+        {
+            cerr << "*** could not add a segment to the Composite Curve\n";
+            return false;
+        }
+    }
+
+    model.SetDependencyOrder( aOrdered );
+
+    if( !model.Write( ONAME, true ) )
+    {
+        cerr << "*** could not write '" << ONAME << "'\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+static bool checkCurve( IGES_ENTITY_102* aCurve )
+{
+    MCAD_POINT p;
+
+    if( !aCurve->IsClosed() || !aCurve->GetStartPoint( p ) || p.x != 10.0 || p.y != 0.0 )
+    {
+        cerr << "*** the Composite Curve differs from the original\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+// when aOrdered is true the children must precede the Composite Curve
+static bool readFile( const char* aFileName, bool aOrdered )
+{
+    IGES model;
+
+    if( !model.Read( aFileName ) )
+    {
+        cerr << "*** could not read '" << aFileName << "'\n";
+        return false;
+    }
+
+    // the mark is not retained in the Start section
+    if( 1 != model.GetNHeaderLines() )
+    {
+        cerr << "*** expected 1 Start section line, got " << model.GetNHeaderLines() << "\n";
+        return false;
+    }
+
+    vector<IGES_ENTITY*> eList;
+
+    model.GetDETable()->SelectType( ENT_COMPOSITE_CURVE, -1, eList );
+    model.FreeDETable();
+
+    if( 1 != eList.size() )
+    {
+        cerr << "*** expected 1 Composite Curve, got " << eList.size() << "\n";
+        return false;
+    }
+
+    IGES_ENTITY_102* cc = (IGES_ENTITY_102*)eList[0];
+    IGES_ENTITY* tx = NULL;
+    size_t nSegs = 0;
+    IGES_CURVE** segs = NULL;
+
+    if( !cc->GetTransform( &tx ) || NULL == tx || !cc->GetCurves( nSegs, segs ) || 4 != nSegs )
+    {
+        cerr << "*** the Composite Curve lost its transform or segments\n";
+        return false;
+    }
+
+    if( !aOrdered )
+        return checkCurve( cc );
+
+    if( tx->getDESequence() > cc->getDESequence() )
+    {
+        cerr << "*** the transform follows the Composite Curve\n";
+        return false;
+    }
+
+    for( size_t i = 0; i < nSegs; ++i )
+    {
+        if( segs[i]->getDESequence() > cc->getDESequence() )
+        {
+            cerr << "*** segment " << i << " follows the Composite Curve\n";
+            return false;
+        }
+    }
+
+    return checkCurve( cc );
+}
+
+
+// mark a file written in the usual order, where the Composite Curve
+// precedes its children; the entities must still be associated
+static bool readMarked( void )
+{
+    ifstream in( ONAME, ios::in | ios::binary );
+    ofstream out( UNAME, ios::out | ios::binary | ios::trunc );
+    string line;
+    int nS = 0;
+    bool marked = false;
+
+    while( getline( in, line ) )
+    {
+        if( line.size() >= 73 && 'S' == line[72] )
+        {
+            ++nS;
+        }
+        else if( !marked && nS > 0 && line.size() >= 73 && 'G' == line[72] )
+        {
+            marked = true;
+            // append the mark to the Start section as the writer does
+            out << setw( 72 ) << left << MARK << "S" << setw( 7 ) << right << ++nS << "\n";
+        }
+        else if( line.size() >= 73 && 'T' == line[72] )
+        {
+            ostringstream count;
+            count << "S" << setw( 7 ) << nS;
+            line.replace( 0, 8, count.str() );
+        }
+
+        out << line << "\n";
+    }
+
+    out.close();
+
+    if( !marked )
+    {
+        cerr << "*** no Start section in '" << ONAME << "'\n";
+        return false;
+    }
+
+    return readFile( UNAME, false );
+}
+
+
+// entities whose references form a cycle cannot be ordered; the
+// file must be written in the usual order and without the mark
+static bool writeCycle( void )
+{
+    IGES model;
+    IGES_ENTITY* tx[3];
+
+    for( int i = 0; i < 3; ++i )
+    {
+        if( !model.NewEntity( ENT_TRANSFORMATION_MATRIX, &tx[i] ) )
+        {
+            cerr << "*** could not create a transform\n";
+            return false;
+        }
+    }
+
+    for( int i = 0; i < 3; ++i )
+    {
+        if( !tx[i]->SetTransform( tx[(i + 1) % 3] ) )
+        {
+            cerr << "*** could not create a cycle of transforms\n";
+            return false;
+        }
+    }
+
+    model.SetDependencyOrder( true );
+
+    if( !model.Write( CNAME, true ) )
+    {
+        cerr << "*** could not write '" << CNAME << "'\n";
+        return false;
+    }
+
+    ifstream in( CNAME, ios::in | ios::binary );
+    string line;
+    int nS = 0;
+
+    while( getline( in, line ) )
+    {
+        if( line.size() < 73 || 'S' != line[72] )
+            continue;
+
+        ++nS;
+
+        if( 0 == line.compare( 0, sizeof( MARK ) - 1, MARK ) )
+        {
+            cerr << "*** a file with a reference cycle is marked as dependency ordered\n";
+            return false;
+        }
+    }
+
+    if( 0 == nS )
+    {
+        cerr << "*** no Start section in '" << CNAME << "'\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+int main()
+{
+    if( !writeFile( true ) || !readFile( ONAME, true ) )
+        return -1;
+
+    if( !writeFile( false ) || !readMarked() || !writeCycle() )
+        return -1;
+
+    cout << "dependency ordered files written and read back\n";
+    return 0;
+}
@@ -31,11 +31,14 @@
 
 #include <iostream>
 #include <cmath>
+#include <vector>
 #include <api/dll_iges.h>
 #include <geom/geom_wall.h>
 #include <geom/geom_cylinder.h>
 #include <api/dll_mcad_segment.h>
 #include <api/dll_iges_geom_pcb.h>
+#include <geom/mcad_segment.h>
+#include <geom/mcad_outline.h>
 
 using namespace std;
 
@@ -50,6 +53,8 @@ int test_addr( void );
 //   + primeA: set to true to test operations on Outline A (Circle),
 //             false for Outline B (square).
 int test_otln( bool subs, bool primeA );
+// take a tessellated outline with a tessellated cutout and simplify it
+int test_simplify( void );
 
 int main()
 {
@@ -120,6 +125,15 @@ int main()
 
     }
 
+    if( 1 )
+    {
+        if( test_simplify() )
+        {
+            cout << "[FAIL]: test_simplify() encountered problems\n";
+            return -1;
+        }
+    }
+
     cout << "[OK]: All tests passed\n";
     return 0;
 }
@@ -1010,3 +1024,150 @@ int test_otln( bool subs, bool primeA )
 
     return 0;
 }
+
+
+// create a closed outline from a list of CCW vertices
+static bool makePolygon( DLL_MCAD_OUTLINE& aOutline, const vector<MCAD_POINT>& aPts )
+{
+    bool error = false;
+
+    for( size_t i = 0; i < aPts.size(); ++i )
+    {
+        DLL_MCAD_SEGMENT seg( true );
+
+        if( !seg.SetParams( aPts[i], aPts[( i + 1 ) % aPts.size()] )
+            || !aOutline.AddSegment( seg, error ) )
+            return false;
+    }
+
+    bool ret = false;
+    return aOutline.IsClosed( ret ) && ret;
+}
+
+
+int test_simplify( void )
+{
+    // a 20 x 10 board with corners of radius 3 split into 16 segments
+    // each and edges split into 10 collinear segments each, and a hole
+    // of radius 2 split into 72 segments
+    vector<MCAD_POINT> pts;
+    MCAD_POINT p;
+    double cx[4] = { 7.0, -7.0, -7.0, 7.0 };
+    double cy[4] = { 2.0, 2.0, -2.0, -2.0 };
+    p.z = 0.0;
+
+    for( int i = 0; i < 4; ++i )
+    {
+        for( int j = 0; j < 16; ++j )
+        {
+            double a = ( i * 90.0 + j * 90.0 / 16.0 ) * M_PI / 180.0;
+            p.x = cx[i] + 3.0 * cos( a );
+            p.y = cy[i] + 3.0 * sin( a );
+            pts.push_back( p );
+        }
+
+        // the edge from the end of this corner to the start of the next one
+        double a = ( i + 1 ) * M_PI * 0.5;
+        MCAD_POINT p0;
+        MCAD_POINT p1;
+        p0.x = cx[i] + 3.0 * cos( a );
+        p0.y = cy[i] + 3.0 * sin( a );
+        p1.x = cx[( i + 1 ) % 4] + 3.0 * cos( a );
+        p1.y = cy[( i + 1 ) % 4] + 3.0 * sin( a );
+
+        for( int j = 0; j < 10; ++j )
+        {
+            p.x = p0.x + ( p1.x - p0.x ) * j / 10.0;
+            p.y = p0.y + ( p1.y - p0.y ) * j / 10.0;
+            pts.push_back( p );
+        }
+    }
+
+    DLL_IGES_GEOM_PCB otln( true );
+
+    if( !makePolygon( otln, pts ) )
+    {
+        cout << "* [FAIL]: could not create the board outline\n";
+        return -1;
+    }
+
+    pts.clear();
+
+    for( int j = 0; j < 72; ++j )
+    {
+        double a = j * M_PI / 36.0;
+        p.x = 2.0 * cos( a );
+        p.y = 2.0 * sin( a );
+        pts.push_back( p );
+    }
+
+    DLL_MCAD_OUTLINE hole( true );
+    bool error = false;
+
+    if( !makePolygon( hole, pts ) || !otln.AddCutout( hole, false, error ) )
+    {
+        cout << "* [FAIL]: could not create the cutout\n";
+        return -1;
+    }
+
+    if( !otln.Simplify( 0.01, error ) )
+    {
+        cout << "* [FAIL]: could not simplify the outline\n";
+        return -1;
+    }
+
+    MCAD_SEGMENT** segs = NULL;
+    MCAD_OUTLINE** cutouts = NULL;
+    int nSegs = 0;
+    int nCutouts = 0;
+    int nArcs = 0;
+    bool ret = false;
+
+    otln.GetSegments( segs, nSegs );
+
+    for( int i = 0; i < nSegs; ++i )
+    {
+        if( MCAD_SEGTYPE_ARC == segs[i]->GetSegType() )
+            ++nArcs;
+    }
+
+    delete [] segs;
+
+    if( 8 != nSegs || 4 != nArcs || !otln.IsContiguous( ret ) || !ret )
+    {
+        cout << "* [FAIL]: expected 4 lines and 4 arcs, got " << nSegs << " segments\n";
+        return -1;
+    }
+
+    otln.GetCutouts( cutouts, nCutouts );
+
+    if( 1 != nCutouts || 1 != cutouts[0]->GetSegments()->size()
+        || MCAD_SEGTYPE_CIRCLE != cutouts[0]->GetSegments()->front()->GetSegType() )
+    {
+        cout << "* [FAIL]: expected the cutout to become a circle\n";
+        delete [] cutouts;
+        return -1;
+    }
+
+    delete [] cutouts;
+
+    DLL_IGES model;
+    IGES_ENTITY_144** res = NULL;
+    int nSurfs = 0;
+
+    bool ok = otln.GetVerticalSurface( model.GetRawPtr(), error, res, nSurfs, 0.8, -0.8 )
+        && otln.GetTrimmedPlane( model.GetRawPtr(), error, res, nSurfs, 0.8, false )
+        && otln.GetTrimmedPlane( model.GetRawPtr(), error, res, nSurfs, -0.8, true );
+
+    // the list holds the surfaces of all successful calls
+    delete [] res;
+
+    if( !ok )
+    {
+        cout << "* [FAIL]: could not create the board surfaces, error: " << error << "\n";
+        return -1;
+    }
+
+    model.Write( "test_oln_simplify.igs", true );
+    return 0;
+}
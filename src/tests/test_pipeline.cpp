@@ -0,0 +1,223 @@
+/*
+ * file: test_pipeline.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program writes a model in which most entities
+ * refer to entities further down the file and reads it with a single
+ * thread and again with several threads while associating entities
+ * as the Parameter Data is read. The entity lists of both models,
+ * including the references of each entity and the first entity
+ * referring to it, must be identical, and apart from the Global
+ * section so must the files written from both models.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <core/iges.h>
+#include <core/iges_detable.h>
+#include <core/entity100.h>
+#include <core/entity102.h>
+#include <core/entity110.h>
+#include <core/entity124.h>
+#include <core/entity308.h>
+#include <core/entity408.h>
+
+#define MNAME "test_out_pipeline_model.igs"
+#define ONAME "test_out_pipeline.igs"
+// number of threads used for the pipelined read
+#define NTHREADS (4)
+// number of Composite Curves and Subfigure Instances
+#define NITEMS (60)
+
+using namespace std;
+
+
+// parents are created before their children so that the
+// Directory Entry pointers of the written file refer forward
+static bool writeModel( void )
+{
+    IGES model;
+    IGES_ENTITY* ep = NULL;
+    vector<IGES_ENTITY_408*> instances;
+
+    for( int i = 0; i < NITEMS; ++i )
+    {
+        if( !model.NewEntity( ENT_SINGULAR_SUBFIGURE_INSTANCE, &ep ) )
+            return false;
+
+        ((IGES_ENTITY_408*)ep)->X = 10.0 * i;
+        instances.push_back( (IGES_ENTITY_408*)ep );
+    }
+
+    if( !model.NewEntity( ENT_SUBFIGURE_DEFINITION, &ep ) )
+        return false;
+
+    IGES_ENTITY_308* sp = (IGES_ENTITY_308*)ep;
+
+    for( int i = 0; i < NITEMS; ++i )
+    {
+        if( !instances[i]->SetDE( sp ) )
+            return false;
+    }
+
+    for( int i = 0; i < NITEMS; ++i )
+    {
+        IGES_ENTITY* tx = NULL;
+
+        if( !model.NewEntity( ENT_COMPOSITE_CURVE, &ep ) || !sp->AddDE( ep )
+            || !model.NewEntity( ENT_TRANSFORMATION_MATRIX, &tx ) || !ep->SetTransform( tx ) )
+            return false;
+
+        IGES_ENTITY_102* cc = (IGES_ENTITY_102*)ep;
+        ((IGES_ENTITY_124*)tx)->T.T.y = 2.0 * i;
+
+        double vx[4] = { 0.0, 5.0, 5.0, 0.0 };
+        double vy[4] = { 0.0, 0.0, 1.0 + i, 1.0 + i };
+
+        for( int j = 0; j < 3; ++j )
+        {
+            if( !model.NewEntity( ENT_LINE, &ep ) )
+                return false;
+
+            IGES_ENTITY_110* lp = (IGES_ENTITY_110*)ep;
+            lp->X1 = vx[j];
+            lp->Y1 = vy[j];
+            lp->X2 = vx[j + 1];
+            lp->Y2 = vy[j + 1];
+
+            if( !cc->AddSegment( lp ) )
+                return false;
+        }
+
+        // the closing segment
+        if( !model.NewEntity( ENT_CIRCULAR_ARC, &ep ) )
+            return false;
+
+        IGES_ENTITY_100* ap = (IGES_ENTITY_100*)ep;
+        ap->yCenter = 0.5 * ( 1.0 + i );
+        ap->xStart = 0.0;
+        ap->yStart = 1.0 + i;
+        ap->xEnd = 0.0;
+        ap->yEnd = 0.0;
+
+        if( !cc->AddSegment( ap ) )
+            return false;
+    }
+
+    return model.Write( MNAME, true );
+}
+
+
+// describe the entities of a model in their order, including
+// their references and the first entity referring to each
+static bool describe( int aNThreads, bool aPipelined, string& aGraph, string& aOutput )
+{
+    IGES model;
+
+    model.SetNThreads( aNThreads );
+    model.SetPipelinedRead( aPipelined );
+
+    if( !model.Read( MNAME ) )
+    {
+        cerr << "*** could not read '" << MNAME << "' with " << aNThreads << " threads\n";
+        return false;
+    }
+
+    const IGES_DE_TABLE* tp = model.GetDETable();
+    ostringstream graph;
+
+    for( size_t i = 0; i < tp->size(); ++i )
+    {
+        IGES_ENTITY* ep = tp->GetEntities()[i];
+        IGES_ENTITY* pp = ep->getFirstParentRef();
+        vector<int> refs;
+
+        ep->getRefIndices( refs );
+        graph << ep->GetEntityType() << "," << ep->GetEntityForm() << ","
+            << ep->getDESequence() << "," << ep->getNRefs() << ","
+            << ( pp ? pp->getDESequence() : -1 ) << ":";
+
+        for( size_t j = 0; j < refs.size(); ++j )
+            graph << " " << refs[j];
+
+        graph << "\n";
+    }
+
+    aGraph = graph.str();
+    model.SetNThreads( 1 );
+
+    if( tp->size() < 4 * NITEMS || !model.Write( ONAME, true ) )
+    {
+        cerr << "*** could not write '" << ONAME << "'\n";
+        return false;
+    }
+
+    ifstream file( ONAME, ios::in | ios::binary );
+    string line;
+    ostringstream data;
+
+    while( getline( file, line ) )
+    {
+        if( line.size() < 73 || 'G' != line[72] )
+            data << line << "\n";
+    }
+
+    aOutput = data.str();
+    return true;
+}
+
+
+int main()
+{
+    if( !writeModel() )
+    {
+        cerr << "*** could not write '" << MNAME << "'\n";
+        return -1;
+    }
+
+    string graph1;
+    string graphN;
+    string output1;
+    string outputN;
+
+    if( !describe( 1, false, graph1, output1 ) || !describe( NTHREADS, true, graphN, outputN ) )
+        return -1;
+
+    if( graph1 != graphN )
+    {
+        cerr << "*** the entities read with 1 and " << NTHREADS << " threads differ\n";
+        return -1;
+    }
+
+    if( output1 != outputN )
+    {
+        cerr << "*** the files written after reading with 1 and " << NTHREADS
+            << " threads differ\n";
+        return -1;
+    }
+
+    cout << "pipelined reading matches sequential reading\n";
+    return 0;
+}
@@ -7,7 +7,10 @@
  *  This is a test suite for the IGES_GEOM_PCB class; in addition
  * to creating the vertical walls as in test_outline.cpp, the
  * objects should be enclosed solids with the appropriately trimmed
- * planes at the top and bottom of the vertical walls.
+ * planes at the top and bottom of the vertical walls. test_join()
+ * checks that a joined BREP curve follows the Composite Curve which
+ * it replaces and test_extrude() checks that each closed loop is
+ * swept into a single Tabulated Cylinder facing away from the board.
  *
  * This file is part of libIGES.
  *
@@ -36,6 +39,11 @@
 #include <geom/geom_cylinder.h>
 #include <api/dll_mcad_segment.h>
 #include <api/dll_iges_geom_pcb.h>
+#include <core/entity102.h>
+#include <core/entity122.h>
+#include <core/entity126.h>
+#include <core/entity142.h>
+#include <core/entity144.h>
 
 using namespace std;
 
@@ -59,6 +67,10 @@ int test_addr( void );
 //   + primeA: set to true to test operations on Outline A (Circle),
 //             false for Outline B (square).
 int test_otln( bool subs, bool primeA );
+// compare the trimmed planes of an outline with and without joined BREP curves
+int test_join( void );
+// render the sides of an outline and its drill hole as one surface per loop
+int test_extrude( void );
 
 int main()
 {
@@ -147,6 +159,24 @@ int main()
 
     }
 
+    if( 1 )
+    {
+        if( test_join() )
+        {
+            cout << "[FAIL]: test_join() encountered problems\n";
+            return -1;
+        }
+    }
+
+    if( 1 )
+    {
+        if( test_extrude() )
+        {
+            cout << "[FAIL]: test_extrude() encountered problems\n";
+            return -1;
+        }
+    }
+
     cout << "[OK]: All tests passed\n";
     return 0;
 }
@@ -1253,3 +1283,279 @@ int test_cc1( void )
     model.Write( "test_c-c1.igs", true );
     return 0;
 }
+
+
+// create a rectangle with one rounded corner and a drill hole
+static bool makeJoinOutline( DLL_IGES_GEOM_PCB& aOutline )
+{
+    MCAD_POINT p[6];
+    p[0].x = 0.0;
+    p[0].y = 0.0;
+    p[1].x = 4.0;
+    p[1].y = 0.0;
+    p[2].x = 4.0;
+    p[2].y = 1.5;
+    p[3].x = 3.5;
+    p[3].y = 2.0;
+    p[4].x = 0.0;
+    p[4].y = 2.0;
+    p[5].x = 3.5;   // center of the rounded corner
+    p[5].y = 1.5;
+
+    bool error = false;
+
+    for( int i = 0; i < 5; ++i )
+    {
+        DLL_MCAD_SEGMENT seg( true );
+
+        if( 2 == i )
+            seg.SetParams( p[5], p[2], p[3], false );
+        else
+            seg.SetParams( p[i], p[( i + 1 ) % 5] );
+
+        if( !aOutline.AddSegment( seg, error ) )
+            return false;
+    }
+
+    MCAD_POINT c[2];
+    c[0].x = 2.0;
+    c[0].y = 1.0;
+    c[1].x = 2.5;
+    c[1].y = 1.0;
+
+    DLL_MCAD_SEGMENT hole( true );
+    hole.SetParams( c[0], c[1], c[1], false );
+
+    return aOutline.AddCutout( hole, true, error );
+}
+
+
+// retrieve the BREP curves of the PTO and the first PTI of a plane
+static bool getBounds( IGES_ENTITY_144* aPlane, IGES_ENTITY* aBound[2] )
+{
+    IGES_ENTITY_142* scurve[2];
+    IGES_ENTITY_142** ptiList = NULL;
+    size_t nPTI = 0;
+
+    if( !aPlane->GetPTO( scurve[0] ) || !aPlane->GetPTIList( nPTI, ptiList ) || nPTI != 1 )
+        return false;
+
+    scurve[1] = ptiList[0];
+
+    for( int i = 0; i < 2; ++i )
+    {
+        if( !scurve[i]->GetBPTR( &aBound[i] ) )
+            return false;
+    }
+
+    return true;
+}
+
+
+int test_join( void )
+{
+    DLL_IGES_GEOM_PCB otln0( true );
+    DLL_IGES_GEOM_PCB otln1( true );
+    DLL_IGES_GEOM_PCB* otln[2] = { &otln0, &otln1 };
+    DLL_IGES model;
+    IGES_ENTITY_144** res = NULL;
+    int nSurfs = 0;
+    bool error = false;
+
+    for( int i = 0; i < 2; ++i )
+    {
+        if( !makeJoinOutline( *otln[i] ) )
+        {
+            cout << "* [FAIL]: could not create the outline\n";
+            return -1;
+        }
+
+        otln[i]->SetJoinCurves( 1 == i );
+
+        if( !otln[i]->GetTrimmedPlane( model.GetRawPtr(), error, res, nSurfs, BTOP, false ) )
+        {
+            cout << "* [FAIL]: could not create planar structures, error: " << error << "\n";
+            delete [] res;
+            return -1;
+        }
+    }
+
+    IGES_ENTITY* bound[2][2];
+
+    if( 2 != nSurfs || !getBounds( res[0], bound[0] ) || !getBounds( res[1], bound[1] ) )
+    {
+        cout << "* [FAIL]: the planes were not trimmed as expected\n";
+        delete [] res;
+        return -1;
+    }
+
+    delete [] res;
+
+    // each joined curve must pass through the ends of all the curves of
+    // the composite curve which it replaces
+    for( int i = 0; i < 2; ++i )
+    {
+        if( ENT_COMPOSITE_CURVE != bound[0][i]->GetEntityType()
+            || ENT_NURBS_CURVE != bound[1][i]->GetEntityType() )
+        {
+            cout << "* [FAIL]: unexpected BREP curve types\n";
+            return -1;
+        }
+
+        IGES_CURVE** curves = NULL;
+        size_t nCurves = 0;
+        int nCoeff;
+        int order;
+        double* knot;
+        double* coeff;
+        bool isRational;
+        bool isClosed;
+        bool isPeriodic;
+        double v0;
+        double v1;
+
+        if( !((IGES_ENTITY_102*)bound[0][i])->GetCurves( nCurves, curves )
+            || !((IGES_ENTITY_126*)bound[1][i])->GetNURBSData( nCoeff, order, &knot, &coeff,
+                isRational, isClosed, isPeriodic, v0, v1 ) )
+        {
+            cout << "* [FAIL]: could not retrieve the BREP curves\n";
+            return -1;
+        }
+
+        int stride = isRational ? 4 : 3;
+        int nFound = 0;
+        int j = 0;
+
+        for( size_t k = 0; k < nCurves; ++k )
+        {
+            MCAD_POINT p0;
+            curves[k]->GetStartPoint( p0, false );
+
+            // the ends of the curves are control points in the same order
+            while( j < nCoeff && ( fabs( coeff[j * stride] - p0.x ) > 1e-9
+                   || fabs( coeff[j * stride + 1] - p0.y ) > 1e-9 ) )
+                ++j;
+
+            if( j < nCoeff )
+                ++nFound;
+        }
+
+        MCAD_POINT p0;
+        MCAD_POINT p1;
+        ((IGES_ENTITY_126*)bound[1][i])->GetStartPoint( p0, false );
+        ((IGES_ENTITY_126*)bound[1][i])->GetEndPoint( p1, false );
+
+        if( nFound != (int)nCurves || fabs( p0.x - p1.x ) > 1e-9 || fabs( p0.y - p1.y ) > 1e-9 )
+        {
+            cout << "* [FAIL]: joined curve " << i << " does not follow the composite curve ("
+                << nFound << " of " << nCurves << " joints found)\n";
+            return -1;
+        }
+    }
+
+    model.Write( "test_join.igs", true );
+    return 0;
+}
+
+
+// true if the point lies on the outline created by makeJoinOutline()
+static bool onJoinOutline( const MCAD_POINT& p )
+{
+    double tol = 1e-9;
+
+    if( ( fabs( p.y ) < tol && p.x > -tol && p.x < 4.0 + tol )
+        || ( fabs( p.x - 4.0 ) < tol && p.y > -tol && p.y < 1.5 + tol )
+        || ( fabs( p.y - 2.0 ) < tol && p.x > -tol && p.x < 3.5 + tol )
+        || ( fabs( p.x ) < tol && p.y > -tol && p.y < 2.0 + tol ) )
+        return true;
+
+    double dx = p.x - 3.5;
+    double dy = p.y - 1.5;
+
+    return dx > -tol && dy > -tol && fabs( sqrt( dx * dx + dy * dy ) - 0.5 ) < tol;
+}
+
+
+int test_extrude( void )
+{
+    DLL_IGES_GEOM_PCB otln( true );
+    DLL_IGES model;
+    IGES_ENTITY_144** res = NULL;
+    int nSurfs = 0;
+    bool error = false;
+
+    if( !makeJoinOutline( otln ) )
+    {
+        cout << "* [FAIL]: could not create the outline\n";
+        return -1;
+    }
+
+    otln.SetExtrudeLoops( true );
+
+    if( !otln.GetVerticalSurface( model.GetRawPtr(), error, res, nSurfs, BTOP, BBOT ) )
+    {
+        cout << "* [FAIL]: could not create vertical surfaces, error: " << error << "\n";
+        delete [] res;
+        return -1;
+    }
+
+    if( 2 != nSurfs )
+    {
+        cout << "* [FAIL]: expected 2 vertical surfaces, got " << nSurfs << "\n";
+        delete [] res;
+        return -1;
+    }
+
+    // the outline is swept up from the bottom and the drill hole down from
+    // the top so that both surfaces face away from the board material
+    for( int i = 0; i < 2; ++i )
+    {
+        IGES_ENTITY* pts = NULL;
+        IGES_CURVE* dc = NULL;
+        vector<MCAD_POINT> pl;
+
+        if( !res[i]->GetPTS( pts ) || ENT_TABULATED_CYLINDER != pts->GetEntityType()
+            || !((IGES_ENTITY_122*)pts)->GetDE( dc ) || !dc->GetPolyline( 1e-6, pl, false )
+            || pl.size() < 8 )
+        {
+            cout << "* [FAIL]: surface " << i << " is not a tabulated cylinder\n";
+            delete [] res;
+            return -1;
+        }
+
+        IGES_ENTITY_122* tc = (IGES_ENTITY_122*)pts;
+        double z0 = ( 0 == i ) ? BBOT : BTOP;
+        double z1 = ( 0 == i ) ? BTOP : BBOT;
+        double area = 0.0;
+        bool ok = fabs( tc->LZ - z1 ) < 1e-12 && fabs( pl.front().x - pl.back().x ) < 1e-9
+                  && fabs( pl.front().y - pl.back().y ) < 1e-9;
+
+        for( size_t j = 0; ok && j < pl.size(); ++j )
+        {
+            double dx = pl[j].x - 2.0;
+            double dy = pl[j].y - 1.0;
+
+            if( fabs( pl[j].z - z0 ) > 1e-12 )
+                ok = false;
+            else if( 0 == i )
+                ok = onJoinOutline( pl[j] );
+            else
+                ok = fabs( sqrt( dx * dx + dy * dy ) - 0.5 ) < 1e-9;
+
+            if( j > 0 )
+                area += pl[j - 1].x * pl[j].y - pl[j].x * pl[j - 1].y;
+        }
+
+        // both directrices run counterclockwise
+        if( !ok || area <= 0.0 )
+        {
+            cout << "* [FAIL]: the directrix of surface " << i << " does not follow its loop\n";
+            delete [] res;
+            return -1;
+        }
+    }
+
+    delete [] res;
+    model.Write( "test_extrude.igs", true );
+    return 0;
+}
@@ -0,0 +1,263 @@
+/*
+ * file: test_rescale.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program writes a model of lines, arcs, Copious
+ * Data, NURBS curves, transforms and a trimmed surface whose boundary
+ * is given in parameter space. The model is read back, its units are
+ * converted and its model scale changed with a single thread and
+ * again with several threads and each result is written. Apart from
+ * the Global section, which holds the file name and the time of
+ * creation, the files must be byte-identical and must differ from the
+ * unscaled model.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <core/iges.h>
+#include <core/entity100.h>
+#include <core/entity102.h>
+#include <core/entity106.h>
+#include <core/entity110.h>
+#include <core/entity124.h>
+#include <core/entity126.h>
+#include <core/entity128.h>
+#include <core/entity142.h>
+#include <core/entity144.h>
+
+#define MNAME "test_out_rescale_model.igs"
+#define ONAME "test_out_rescale.igs"
+// number of threads used for the parallel conversion
+#define NTHREADS (4)
+// number of items of each kind in the model
+#define NITEMS (40)
+
+using namespace std;
+
+
+// cubic NURBS curve through NITEMS / 4 control points with the given offset
+static IGES_ENTITY_126* newCurve( IGES& aModel, double aOffset )
+{
+    IGES_ENTITY* ep = NULL;
+    int nCoeff = NITEMS / 4;
+    vector<double> knots( 4, 0.0 );
+    vector<double> coeffs;
+
+    for( int i = 1; i < nCoeff - 3; ++i )
+        knots.push_back( (double)i );
+
+    knots.insert( knots.end(), 4, (double)( nCoeff - 3 ) );
+
+    for( int i = 0; i < nCoeff; ++i )
+    {
+        coeffs.push_back( aOffset + i * 0.25 );
+        coeffs.push_back( aOffset + ( i & 1 ) * 0.5 );
+        coeffs.push_back( 0.0 );
+    }
+
+    if( !aModel.NewEntity( ENT_NURBS_CURVE, &ep )
+        || !((IGES_ENTITY_126*)ep)->SetNURBSData( nCoeff, 4, &knots[0], &coeffs[0], false,
+                                                  0.0, (double)( nCoeff - 3 ) ) )
+        return NULL;
+
+    return (IGES_ENTITY_126*)ep;
+}
+
+
+static bool writeModel( void )
+{
+    IGES model;
+    IGES_ENTITY* ep = NULL;
+
+    for( int i = 0; i < NITEMS; ++i )
+    {
+        IGES_ENTITY* tx = NULL;
+
+        if( !model.NewEntity( ENT_TRANSFORMATION_MATRIX, &tx ) )
+            return false;
+
+        ((IGES_ENTITY_124*)tx)->T.T.x = 1.5 * i;
+        ((IGES_ENTITY_124*)tx)->T.T.z = -0.5 * i;
+
+        if( !model.NewEntity( ENT_LINE, &ep ) )
+            return false;
+
+        IGES_ENTITY_110* lp = (IGES_ENTITY_110*)ep;
+        lp->X1 = i;
+        lp->Y2 = 2.0 + i;
+        lp->Z2 = 0.1 * i;
+
+        if( ( i & 1 ) && !lp->SetTransform( tx ) )
+            return false;
+
+        if( !model.NewEntity( ENT_CIRCULAR_ARC, &ep ) )
+            return false;
+
+        IGES_ENTITY_100* ap = (IGES_ENTITY_100*)ep;
+        ap->zOffset = 0.3 * i;
+        ap->xCenter = i;
+        ap->xStart = i + 1.0 + 0.01 * i;
+        ap->xEnd = ap->xStart;
+
+        if( !( i & 1 ) && !ap->SetTransform( tx ) )
+            return false;
+
+        if( !model.NewEntity( ENT_COPIOUS_DATA, &ep ) || !ep->SetEntityForm( 12 ) )
+            return false;
+
+        vector<MCAD_POINT> pts( 3 );
+
+        for( int j = 0; j < 3; ++j )
+        {
+            pts[j].x = i + j;
+            pts[j].y = 0.7 * j;
+            pts[j].z = -0.2 * i;
+        }
+
+        if( !((IGES_ENTITY_106*)ep)->SetPoints( pts ) )
+            return false;
+    }
+
+    // model space curves, some of them within single segment Composite Curves
+    IGES_ENTITY_102* cc = NULL;
+
+    for( int i = 0; i < NITEMS / 2; ++i )
+    {
+        IGES_ENTITY_126* np = newCurve( model, 3.0 * i );
+
+        if( NULL == np )
+            return false;
+
+        if( 0 == ( i & 3 ) )
+        {
+            if( !model.NewEntity( ENT_COMPOSITE_CURVE, &ep ) )
+                return false;
+
+            cc = (IGES_ENTITY_102*)ep;
+        }
+
+        if( 1 == ( i & 3 ) && !cc->AddSegment( np ) )
+            return false;
+    }
+
+    // a trimmed plane; the boundary curve in parameter space is not scaled
+    double knots[4] = { 0.0, 0.0, 10.0, 10.0 };
+    double coeff[12] = { 0.0, 0.0, 1.0,  10.0, 0.0, 1.0,
+                         0.0, 10.0, 1.0,  10.0, 10.0, 1.0 };
+    IGES_ENTITY* sp = NULL;
+    IGES_ENTITY* bp = NULL;
+    IGES_ENTITY_126* pc = newCurve( model, 1.0 );
+
+    if( NULL == pc || !model.NewEntity( ENT_NURBS_SURFACE, &sp )
+        || !((IGES_ENTITY_128*)sp)->SetNURBSData( 2, 2, 2, 2, knots, knots, coeff,
+                                                  false, false, false, 0.0, 10.0, 0.0, 10.0 )
+        || !model.NewEntity( ENT_CURVE_ON_PARAMETRIC_SURFACE, &bp )
+        || !((IGES_ENTITY_142*)bp)->SetSPTR( sp ) || !((IGES_ENTITY_142*)bp)->SetBPTR( pc )
+        || !model.NewEntity( ENT_TRIMMED_PARAMETRIC_SURFACE, &ep )
+        || !((IGES_ENTITY_144*)ep)->SetPTS( sp ) || !((IGES_ENTITY_144*)ep)->SetPTO( (IGES_ENTITY_142*)bp ) )
+        return false;
+
+    return model.Write( MNAME, true );
+}
+
+
+// read a model, rescale it with the given number of threads and
+// return the written file without its Global section
+static bool convert( const char* aFileName, int aNThreads, bool aRescale, string& aResult )
+{
+    IGES model;
+
+    // only the rescaling is done in parallel
+    model.SetNThreads( 1 );
+
+    if( !model.Read( aFileName ) )
+    {
+        cerr << "*** could not read '" << aFileName << "'\n";
+        return false;
+    }
+
+    model.SetNThreads( aNThreads );
+
+    if( aRescale && ( !model.ConvertUnits( UNIT_METER ) || !model.ConvertUnits( UNIT_MIL )
+        || !model.ChangeModelScale( 2.5 ) ) )
+    {
+        cerr << "*** could not rescale the model with " << aNThreads << " threads\n";
+        return false;
+    }
+
+    model.SetNThreads( 1 );
+
+    if( !model.Write( ONAME, true ) )
+    {
+        cerr << "*** could not write '" << ONAME << "'\n";
+        return false;
+    }
+
+    ifstream file( ONAME, ios::in | ios::binary );
+    string line;
+    ostringstream data;
+
+    while( getline( file, line ) )
+    {
+        if( line.size() < 73 || 'G' != line[72] )
+            data << line << "\n";
+    }
+
+    aResult = data.str();
+    return !aResult.empty();
+}
+
+
+int main()
+{
+    if( !writeModel() )
+    {
+        cerr << "*** could not write '" << MNAME << "'\n";
+        return -1;
+    }
+
+    string unscaled;
+    string serial;
+    string parallel;
+
+    if( !convert( MNAME, 1, false, unscaled ) || !convert( MNAME, 1, true, serial )
+        || !convert( MNAME, NTHREADS, true, parallel ) )
+        return -1;
+
+    if( serial == unscaled )
+    {
+        cerr << "*** the model was not rescaled\n";
+        return -1;
+    }
+
+    if( serial != parallel )
+    {
+        cerr << "*** serial and parallel rescaling differ\n";
+        return -1;
+    }
+
+    cout << "parallel rescaling matches serial rescaling\n";
+    return 0;
+}
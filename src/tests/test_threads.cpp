@@ -0,0 +1,345 @@
+/*
+ * file: test_threads.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program creates a model containing a large
+ * number of curves and evaluates the end points and every point of
+ * the flattened polyline of each curve from 32 threads at once; the
+ * results are checked against those of an identical model evaluated
+ * from a single thread. The program
+ * is intended to be run under a thread sanitizer to verify that
+ * read-only queries on a model are free of data races. The model is
+ * then written with a single thread and with several threads; apart
+ * from the Global section, which holds the time of creation, the
+ * files must be byte-identical.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include <api/dll_iges.h>
+#include <api/all_api_entities.h>
+#include <core/iges_curve.h>
+
+#define NTHREADS (32)
+// number of threads used to write the model in parallel
+#define NWRITERS (4)
+#define ONAME "test_out_threads.igs"
+#define NCURVES (600)
+// tolerance used to flatten the curves into polylines
+#define FLAT_TOL (1e-3)
+
+using namespace std;
+
+struct CURVE_REF
+{
+    IGES_ENTITY*     curve;
+    IGES_ENTITY_TYPE type;
+    MCAD_POINT       start;
+    MCAD_POINT       end;
+    std::vector<MCAD_POINT> points;     // every point of the flattened curve
+};
+
+// create a set of lines, arcs and NURBS curves of various orders
+static bool makeCurves( DLL_IGES& aModel, std::vector<CURVE_REF>& aCurveList )
+{
+    for( int i = 0; i < NCURVES; ++i )
+    {
+        double d = 0.01 * i;
+        DLL_IGES_ENTITY* ep = NULL;
+
+        switch( i % 4 )
+        {
+            case 0:
+            {
+                DLL_IGES_ENTITY_110* lp = new DLL_IGES_ENTITY_110( aModel, true );
+                MCAD_POINT p0( d, 0.0, 0.0 );
+                MCAD_POINT p1( d + 1.0, 2.0, 0.5 );
+                lp->SetLineStart( p0 );
+                lp->SetLineEnd( p1 );
+                ep = lp;
+                break;
+            }
+
+            case 1:
+            {
+                DLL_IGES_ENTITY_100* ap = new DLL_IGES_ENTITY_100( aModel, true );
+                ap->SetCircleCenter( d, d, 0.0 );
+                ap->SetCircleStart( d + 1.0, d );
+                ap->SetCircleEnd( d, d + 1.0 );
+                ep = ap;
+                break;
+            }
+
+            default:
+            {
+                // cubic polynomial or quadratic rational curve
+                bool rational = ( 3 == i % 4 );
+                int order = rational ? 3 : 4;
+                int nc = order + 2;
+                std::vector<double> knots;
+                std::vector<double> coeffs;
+
+                for( int k = 0; k < order; ++k )
+                    knots.push_back( 0.0 );
+
+                for( int k = 1; k < nc - order + 1; ++k )
+                    knots.push_back( (double)k / (nc - order + 1) );
+
+                for( int k = 0; k < order; ++k )
+                    knots.push_back( 1.0 );
+
+                for( int k = 0; k < nc; ++k )
+                {
+                    coeffs.push_back( d + k );
+                    coeffs.push_back( sin( d + k ) );
+                    coeffs.push_back( 0.1 * k );
+
+                    if( rational )
+                        coeffs.push_back( 1.0 + 0.25 * ( k % 2 ) );
+                }
+
+                DLL_IGES_ENTITY_126* np = new DLL_IGES_ENTITY_126( aModel, true );
+
+                if( !np->SetNURBSData( nc, order, &knots[0], &coeffs[0], rational,
+                    0.0, 1.0 ) )
+                {
+                    cerr << "*** could not set NURBS data on curve " << i << "\n";
+                    delete np;
+                    return false;
+                }
+
+                ep = np;
+                break;
+            }
+        }
+
+        CURVE_REF ref;
+        ref.curve = ep->GetRawPtr();
+        ref.type = ep->GetEntityType();
+        delete ep;
+
+        if( NULL == ref.curve )
+        {
+            cerr << "*** could not create curve " << i << "\n";
+            return false;
+        }
+
+        aCurveList.push_back( ref );
+    }
+
+    return true;
+}
+
+
+// create an API object of the appropriate type to manipulate a curve
+static DLL_IGES_CURVE* newCurveAPI( DLL_IGES& aModel, const CURVE_REF& aCurve )
+{
+    DLL_IGES_CURVE* cp = NULL;
+
+    switch( aCurve.type )
+    {
+        case ENT_CIRCULAR_ARC:
+            cp = new DLL_IGES_ENTITY_100( aModel, false );
+            break;
+
+        case ENT_LINE:
+            cp = new DLL_IGES_ENTITY_110( aModel, false );
+            break;
+
+        default:
+            cp = new DLL_IGES_ENTITY_126( aModel, false );
+            break;
+    }
+
+    if( !cp->Attach( aCurve.curve ) )
+    {
+        delete cp;
+        return NULL;
+    }
+
+    return cp;
+}
+
+
+static bool samePoint( const MCAD_POINT& p0, const MCAD_POINT& p1 )
+{
+    return fabs( p0.x - p1.x ) < 1e-12 && fabs( p0.y - p1.y ) < 1e-12
+        && fabs( p0.z - p1.z ) < 1e-12;
+}
+
+
+static bool samePoints( const std::vector<MCAD_POINT>& aList0,
+                        const std::vector<MCAD_POINT>& aList1 )
+{
+    if( aList0.size() != aList1.size() )
+        return false;
+
+    for( size_t i = 0; i < aList0.size(); ++i )
+    {
+        if( !samePoint( aList0[i], aList1[i] ) )
+            return false;
+    }
+
+    return true;
+}
+
+
+// evaluate all curves, starting at a different curve in each thread
+static void evalCurves( DLL_IGES* aModel, const std::vector<CURVE_REF>* aRefList,
+                        int aOffset, int* aNErrors )
+{
+    size_t nc = aRefList->size();
+    MCAD_POINT p0;
+    MCAD_POINT p1;
+    std::vector<MCAD_POINT> points;
+
+    for( size_t i = 0; i < nc; ++i )
+    {
+        const CURVE_REF& ref = (*aRefList)[( i + aOffset ) % nc];
+        DLL_IGES_CURVE* cp = newCurveAPI( *aModel, ref );
+
+        if( NULL == cp )
+        {
+            ++(*aNErrors);
+            continue;
+        }
+
+        if( !cp->GetStartPoint( p0 ) || !cp->GetEndPoint( p1 )
+            || !samePoint( p0, ref.start ) || !samePoint( p1, ref.end ) )
+        {
+            ++(*aNErrors);
+        }
+
+        // the entire curve is compared so that corruption of the
+        // interior of a curve is also detected
+        points.clear();
+
+        if( !((IGES_CURVE*)ref.curve)->GetPolyline( FLAT_TOL, points )
+            || !samePoints( points, ref.points ) )
+        {
+            ++(*aNErrors);
+        }
+
+        delete cp;
+    }
+
+    return;
+}
+
+
+// write the model and return the file without its Global section
+static bool writeModel( DLL_IGES& aModel, int aNThreads, std::string& aResult )
+{
+    if( !aModel.SetNThreads( aNThreads ) || !aModel.Write( ONAME, true ) )
+    {
+        cerr << "*** could not write '" << ONAME << "' with " << aNThreads << " threads\n";
+        return false;
+    }
+
+    ifstream file( ONAME, ios::in | ios::binary );
+    std::string line;
+    ostringstream data;
+
+    while( getline( file, line ) )
+    {
+        if( line.size() < 73 || 'G' != line[72] )
+            data << line << "\n";
+    }
+
+    aResult = data.str();
+    return !aResult.empty();
+}
+
+
+int main()
+{
+    // the reference model is evaluated from a single thread
+    DLL_IGES refModel;
+    DLL_IGES model;
+    std::vector<CURVE_REF> refCurves;
+    std::vector<CURVE_REF> refList;
+
+    if( !makeCurves( refModel, refCurves ) || !makeCurves( model, refList ) )
+        return -1;
+
+    for( size_t i = 0; i < refCurves.size(); ++i )
+    {
+        DLL_IGES_CURVE* cp = newCurveAPI( refModel, refCurves[i] );
+
+        if( NULL == cp || !cp->GetStartPoint( refList[i].start )
+            || !cp->GetEndPoint( refList[i].end )
+            || !((IGES_CURVE*)refCurves[i].curve)->GetPolyline( FLAT_TOL, refList[i].points )
+            || refList[i].points.size() < 2 )
+        {
+            cerr << "*** could not evaluate reference curve " << i << "\n";
+            delete cp;
+            return -1;
+        }
+
+        delete cp;
+    }
+
+    int nErrors[NTHREADS];
+    std::vector<std::thread> workers;
+
+    for( int i = 0; i < NTHREADS; ++i )
+    {
+        nErrors[i] = 0;
+        workers.push_back( std::thread( evalCurves, &model, &refList,
+            i * NCURVES / NTHREADS, &nErrors[i] ) );
+    }
+
+    int nTotal = 0;
+
+    for( int i = 0; i < NTHREADS; ++i )
+    {
+        workers[i].join();
+        nTotal += nErrors[i];
+    }
+
+    if( nTotal > 0 )
+    {
+        cerr << "*** " << nTotal << " curve evaluations failed or differed\n";
+        return -1;
+    }
+
+    std::string serial;
+    std::string parallel;
+
+    if( !writeModel( model, 1, serial ) || !writeModel( model, NWRITERS, parallel ) )
+        return -1;
+
+    if( serial != parallel )
+    {
+        cerr << "*** the files written with 1 and " << NWRITERS << " threads differ\n";
+        return -1;
+    }
+
+    cout << "evaluated " << NCURVES << " curves from " << NTHREADS << " threads\n";
+    cout << "wrote identical files with 1 and " << NWRITERS << " threads\n";
+    return 0;
+}
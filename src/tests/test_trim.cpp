@@ -0,0 +1,357 @@
+/*
+ * file: test_trim.cpp
+ *
+ * Copyright 2026, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program trims a planar NURBS surface with a
+ * square outer boundary, a circular hole and a triangular hole and
+ * classifies a grid of points, points just either side of each
+ * boundary segment and vertex and points on the boundaries via the
+ * indexed Trimmed Surface (144) classifier. The answers are compared
+ * with a brute force even-odd test of the same flattened boundaries;
+ * points on a boundary may be classified either way. The outer
+ * boundary is then removed to check that the index is rebuilt.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, If not, see
+ * <http://www.gnu.org/licenses/> or write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <core/iges.h>
+#include <core/entity100.h>
+#include <core/entity102.h>
+#include <core/entity110.h>
+#include <core/entity128.h>
+#include <core/entity142.h>
+#include <core/entity144.h>
+
+// extent of the parameter space
+#define PEXT (10.0)
+// tolerance used to flatten the boundaries
+#define FLAT_TOL (1e-3)
+// offset of the points near a boundary
+#define NEAR_OFFSET (1e-7)
+// number of grid points along each parameter
+#define NGRID (101)
+
+using namespace std;
+
+typedef vector< vector<MCAD_POINT> > LOOPS;
+
+
+// even-odd test against every segment of every loop
+static bool bruteInside( const LOOPS& aLoops, bool aHasOuter, double aU, double aV )
+{
+    bool inside = false;
+
+    for( size_t i = 0; i < aLoops.size(); ++i )
+    {
+        const vector<MCAD_POINT>& lp = aLoops[i];
+
+        for( size_t j = 0, k = lp.size() - 1; j < lp.size(); k = j++ )
+        {
+            if( ( lp[j].y > aV ) != ( lp[k].y > aV )
+                && aU < lp[j].x + ( aV - lp[j].y ) * ( lp[k].x - lp[j].x ) / ( lp[k].y - lp[j].y ) )
+                inside = !inside;
+        }
+    }
+
+    // without an outer boundary the surface is bounded by its own boundary
+    return aHasOuter ? inside : !inside;
+}
+
+
+static IGES_ENTITY_110* newLine( IGES& aModel, double aX1, double aY1, double aX2, double aY2 )
+{
+    IGES_ENTITY* ep = NULL;
+
+    if( !aModel.NewEntity( ENT_LINE, &ep ) )
+        return NULL;
+
+    IGES_ENTITY_110* lp = (IGES_ENTITY_110*)ep;
+    lp->X1 = aX1;
+    lp->Y1 = aY1;
+    lp->X2 = aX2;
+    lp->Y2 = aY2;
+
+    return lp;
+}
+
+
+// closed polygon of lines in the (u, v) plane
+static IGES_ENTITY* newPolygon( IGES& aModel, int aNVertex, const double* aU, const double* aV )
+{
+    IGES_ENTITY* ep = NULL;
+
+    if( !aModel.NewEntity( ENT_COMPOSITE_CURVE, &ep ) )
+        return NULL;
+
+    IGES_ENTITY_102* cc = (IGES_ENTITY_102*)ep;
+
+    for( int i = 0; i < aNVertex; ++i )
+    {
+        int j = ( i + 1 ) % aNVertex;
+        IGES_ENTITY_110* lp = newLine( aModel, aU[i], aV[i], aU[j], aV[j] );
+
+        if( NULL == lp || !cc->AddSegment( lp ) )
+            return NULL;
+    }
+
+    return cc;
+}
+
+
+static IGES_ENTITY_142* newBoundary( IGES& aModel, IGES_ENTITY* aSurface, IGES_ENTITY* aCurve )
+{
+    IGES_ENTITY* ep = NULL;
+
+    if( NULL == aCurve || !aModel.NewEntity( ENT_CURVE_ON_PARAMETRIC_SURFACE, &ep ) )
+        return NULL;
+
+    IGES_ENTITY_142* bp = (IGES_ENTITY_142*)ep;
+
+    if( !bp->SetSPTR( aSurface ) || !bp->SetBPTR( aCurve ) )
+        return NULL;
+
+    return bp;
+}
+
+
+// bilinear plane z = 0 over [0, PEXT] x [0, PEXT]
+static IGES_ENTITY* newSurface( IGES& aModel )
+{
+    IGES_ENTITY* ep = NULL;
+
+    if( !aModel.NewEntity( ENT_NURBS_SURFACE, &ep ) )
+        return NULL;
+
+    double knots[4] = { 0.0, 0.0, PEXT, PEXT };
+    double coeff[12] = { 0.0, 0.0, 0.0,  PEXT, 0.0, 0.0,
+                         0.0, PEXT, 0.0,  PEXT, PEXT, 0.0 };
+
+    if( !((IGES_ENTITY_128*)ep)->SetNURBSData( 2, 2, 2, 2, knots, knots, coeff,
+        false, false, false, 0.0, PEXT, 0.0, PEXT ) )
+        return NULL;
+
+    return ep;
+}
+
+
+static bool flatten( IGES_ENTITY_142* aBound, LOOPS& aLoops )
+{
+    IGES_ENTITY* ep = NULL;
+
+    aLoops.push_back( vector<MCAD_POINT>() );
+
+    if( !aBound->GetBPTR( &ep )
+        || !((IGES_CURVE*)ep)->GetPolyline( FLAT_TOL, aLoops.back(), false )
+        || aLoops.back().size() < 3 )
+    {
+        cerr << "*** could not flatten a boundary\n";
+        return false;
+    }
+
+    // the brute force test expects open rings
+    MCAD_POINT& p0 = aLoops.back().front();
+    MCAD_POINT& p1 = aLoops.back().back();
+
+    if( p0.x == p1.x && p0.y == p1.y )
+        aLoops.back().pop_back();
+
+    return true;
+}
+
+
+static bool checkPoints( IGES_ENTITY_144* aTrim, const LOOPS& aLoops, bool aHasOuter )
+{
+    vector<double> pu;
+    vector<double> pv;
+    // number of points which must agree with the brute force test
+    size_t nExact = 0;
+
+    for( int i = 0; i < NGRID; ++i )
+    {
+        for( int j = 0; j < NGRID; ++j )
+        {
+            // extend a little beyond the parameter space
+            pu.push_back( -0.5 + ( PEXT + 1.0 ) * i / ( NGRID - 1 ) + 1e-4 );
+            pv.push_back( -0.5 + ( PEXT + 1.0 ) * j / ( NGRID - 1 ) + 2e-4 );
+        }
+    }
+
+    // points either side of each segment and near each vertex
+    for( size_t i = 0; i < aLoops.size(); ++i )
+    {
+        const vector<MCAD_POINT>& lp = aLoops[i];
+
+        for( size_t j = 0; j < lp.size(); ++j )
+        {
+            const MCAD_POINT& p0 = lp[j];
+            const MCAD_POINT& p1 = lp[( j + 1 ) % lp.size()];
+            double dx = p1.x - p0.x;
+            double dy = p1.y - p0.y;
+            double dl = sqrt( dx * dx + dy * dy );
+            double nx = -dy / dl * NEAR_OFFSET;
+            double ny = dx / dl * NEAR_OFFSET;
+            double f[3] = { 0.5, 0.01, 0.99 };
+
+            for( int k = 0; k < 3; ++k )
+            {
+                pu.push_back( p0.x + f[k] * dx + nx );
+                pv.push_back( p0.y + f[k] * dy + ny );
+                pu.push_back( p0.x + f[k] * dx - nx );
+                pv.push_back( p0.y + f[k] * dy - ny );
+            }
+        }
+    }
+
+    nExact = pu.size();
+
+    // points on each vertex and segment
+    for( size_t i = 0; i < aLoops.size(); ++i )
+    {
+        const vector<MCAD_POINT>& lp = aLoops[i];
+
+        for( size_t j = 0; j < lp.size(); ++j )
+        {
+            const MCAD_POINT& p1 = lp[( j + 1 ) % lp.size()];
+
+            pu.push_back( lp[j].x );
+            pv.push_back( lp[j].y );
+            pu.push_back( 0.5 * ( lp[j].x + p1.x ) );
+            pv.push_back( 0.5 * ( lp[j].y + p1.y ) );
+        }
+    }
+
+    std::unique_ptr<bool[]> result( new bool[pu.size()] );
+
+    if( !aTrim->ClassifyPoints( (int)pu.size(), &pu[0], &pv[0], result.get() ) )
+    {
+        cerr << "*** could not classify the points\n";
+        return false;
+    }
+
+    size_t nIn = 0;
+
+    for( size_t i = 0; i < nExact; ++i )
+    {
+        bool ref = bruteInside( aLoops, aHasOuter, pu[i], pv[i] );
+
+        if( ref != result[i] )
+        {
+            cerr << "*** point (" << pu[i] << ", " << pv[i] << ") classified as "
+                << ( result[i] ? "inside" : "outside" ) << "\n";
+            return false;
+        }
+
+        if( ref )
+            ++nIn;
+    }
+
+    // guard against a degenerate test
+    if( 0 == nIn || nExact == nIn )
+    {
+        cerr << "*** all points were classified alike\n";
+        return false;
+    }
+
+    // the single point query must agree with the batch query
+    bool in = !result[0];
+
+    if( !aTrim->ClassifyPoint( pu[0], pv[0], in ) || in != result[0] )
+    {
+        cerr << "*** single and batch classifications differ\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+int main()
+{
+    IGES model;
+    IGES_ENTITY* ep = NULL;
+    IGES_ENTITY* sp = newSurface( model );
+
+    if( NULL == sp || !model.NewEntity( ENT_TRIMMED_PARAMETRIC_SURFACE, &ep ) )
+    {
+        cerr << "*** could not create the Trimmed Surface\n";
+        return -1;
+    }
+
+    IGES_ENTITY_144* tp = (IGES_ENTITY_144*)ep;
+
+    // outer boundary at the edges of the parameter space
+    double ou[4] = { 0.0, PEXT, PEXT, 0.0 };
+    double ov[4] = { 0.0, 0.0, PEXT, PEXT };
+    // triangular hole with no axis-aligned edges
+    double tu[3] = { 6.0, 9.0, 7.1 };
+    double tv[3] = { 1.3, 2.1, 4.7 };
+
+    IGES_ENTITY_100* cp = NULL;
+
+    if( model.NewEntity( ENT_CIRCULAR_ARC, &ep ) )
+    {
+        cp = (IGES_ENTITY_100*)ep;
+        cp->xCenter = 3.0;
+        cp->yCenter = 6.0;
+        cp->xStart = 5.0;
+        cp->yStart = 6.0;
+        cp->xEnd = 5.0;
+        cp->yEnd = 6.0;
+    }
+
+    IGES_ENTITY_142* pto = newBoundary( model, sp, newPolygon( model, 4, ou, ov ) );
+    IGES_ENTITY_142* hole1 = newBoundary( model, sp, cp );
+    IGES_ENTITY_142* hole2 = newBoundary( model, sp, newPolygon( model, 3, tu, tv ) );
+
+    if( NULL == pto || NULL == hole1 || NULL == hole2 || !tp->SetPTS( sp )
+        || !tp->SetPTO( pto ) || !tp->AddPTI( hole1 ) || !tp->AddPTI( hole2 )
+        || !tp->SetTrimTolerance( FLAT_TOL ) )
+    {
+        cerr << "*** could not trim the surface\n";
+        return -1;
+    }
+
+    LOOPS loops;
+
+    if( !flatten( pto, loops ) || !flatten( hole1, loops ) || !flatten( hole2, loops ) )
+        return -1;
+
+    if( !checkPoints( tp, loops, true ) )
+        return -1;
+
+    // the surface is now bounded by its own boundary
+    if( !tp->SetPTO( NULL ) )
+    {
+        cerr << "*** could not remove the outer boundary\n";
+        return -1;
+    }
+
+    loops.erase( loops.begin() );
+
+    if( !checkPoints( tp, loops, false ) )
+        return -1;
+
+    cout << "indexed trim classification agrees with brute force\n";
+    return 0;
+}